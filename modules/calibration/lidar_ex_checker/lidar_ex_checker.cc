@@ -26,6 +26,7 @@
 #include "modules/calibration/lidar_ex_checker/lidar_ex_checker.h"
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
+#include "modules/perception/lib/pcl_util/point_cloud_converter.h"
 
 namespace apollo {
 namespace calibration {
@@ -144,17 +145,13 @@ void LidarExChecker::OnPointCloud(const sensor_msgs::PointCloud2& message) {
     return;
   }
 
+  // read the points straight from the message, without nan.
   pcl::PointCloud<PointXYZIT> cld;
-  pcl::fromROSMsg(message, cld);
-
-  pcl::PointCloud<PointXYZIT> tmp_cld;
-  tmp_cld.header = cld.header;
-  for (uint32_t i = 0; i < cld.points.size(); ++i) {
-    if (pcl_isfinite(cld.points[i].x)) {
-      tmp_cld.push_back(cld.points[i]);
-    }
+  pcl_conversions::toPCL(message.header, cld.header);
+  if (!apollo::perception::pcl_util::ConvertPointCloud(message, &cld)) {
+    AERROR << "failed to convert the point cloud, it has no float x, y, z.";
+    return;
   }
-  cld = tmp_cld;
 
   if (clouds_.size() < cloud_count_) {
     last_position_ = position;
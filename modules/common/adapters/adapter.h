@@ -23,7 +23,6 @@
 
 #include <functional>
 #include <limits>
-#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -35,6 +34,7 @@
 #include "google/protobuf/message.h"
 
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/adapters/snapshot_queue.h"
 #include "modules/common/proto/header.pb.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/file.h"
@@ -69,9 +69,10 @@ using enable_if_t = typename std::enable_if<B, T>::type;
  * its corresponding data type.
  *
  * \par
- * Under the hood, a queue is used to store the current and historical
- * messages. In most cases, the underlying data type is a proto, though
- * this is not necessary.
+ * Under the hood, a \class SnapshotQueue is used to store the current
+ * and historical messages, so that Observe() takes an immutable view of
+ * the queue in O(1) without copying the history. In most cases, the
+ * underlying data type is a proto, though this is not necessary.
  *
  * \note
  * Adapter::Observe() is thread-safe, but calling it from
@@ -85,7 +86,7 @@ class Adapter {
   /// underlying data.
   typedef D DataType;
 
-  typedef typename std::list<std::shared_ptr<D>>::const_iterator Iterator;
+  typedef typename SnapshotQueue<D>::Iterator Iterator;
   typedef typename std::function<void(const D&)> Callback;
 
   /**
@@ -102,6 +103,7 @@ class Adapter {
           size_t message_num, const std::string& dump_dir = "/tmp")
       : topic_name_(topic_name),
         message_num_(message_num),
+        data_queue_(message_num),
         enable_dump_(FLAGS_enable_adapter_dump),
         dump_path_(dump_dir + "/" + adapter_name) {
     if (HasSequenceNumber<D>()) {
@@ -160,12 +162,14 @@ class Adapter {
   }
 
   /**
-   * @brief copy the data_queue_ into the observing queue to create a
-   * view of data up to the call time for the user.
+   * @brief take a snapshot of the data_queue_ as the observing queue to
+   * create a view of data up to the call time for the user. No message
+   * is copied.
    */
   void Observe() {
+    auto snapshot = data_queue_.GetSnapshot();
     std::lock_guard<std::mutex> lock(mutex_);
-    observed_queue_ = data_queue_;
+    observed_queue_ = std::move(snapshot);
   }
 
   /**
@@ -180,8 +184,7 @@ class Adapter {
    * @brief returns TRUE if the adapter has received any message.
    */
   bool HasReceived() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return !data_queue_.empty();
+    return !data_queue_.GetSnapshot().empty();
   }
 
   /**
@@ -219,8 +222,13 @@ class Adapter {
    * @brief returns an iterator representing the head of the observing
    * queue. The caller can use it to iterate over the observed data
    * from the head. The API also supports range based for loop.
+   *
+   * /note
+   * The iterators read the observing queue itself: they are invalidated by
+   * the next call to Observe(), which must not run while iterating.
    */
   Iterator begin() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return observed_queue_.begin();
   }
 
@@ -228,8 +236,12 @@ class Adapter {
    * @brief returns an iterator representing the tail of the observing
    * queue. The caller can use it to iterate over the observed data
    * from the head. The API also supports range based for loop.
+   *
+   * /note
+   * Invalidated by the next call to Observe(), as begin().
    */
   Iterator end() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return observed_queue_.end();
   }
 
@@ -292,10 +304,10 @@ class Adapter {
    * @brief Clear the data received so far.
    */
   void ClearData() {
+    data_queue_.Clear();
     // Lock the queue.
     std::lock_guard<std::mutex> lock(mutex_);
-    data_queue_.clear();
-    observed_queue_.clear();
+    observed_queue_ = typename SnapshotQueue<D>::Snapshot();
   }
 
   /**
@@ -427,12 +439,7 @@ class Adapter {
       return;
     }
 
-    // Lock the queue.
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (data_queue_.size() + 1 > message_num_) {
-      data_queue_.pop_back();
-    }
-    data_queue_.push_front(std::make_shared<D>(data));
+    data_queue_.Push(std::make_shared<D>(data));
   }
 
   /**
@@ -446,9 +453,9 @@ class Adapter {
    * @brief Updates the message delay upon receiving a new message.
    */
   void UpdateDelay(const D& new_msg) {
-    if (!data_queue_.empty()) {
-      std::lock_guard<std::mutex> lock(mutex_);
-      delay_ms_ = CalculateDelayInMs(new_msg, *data_queue_.front());
+    const auto latest = data_queue_.GetSnapshot();
+    if (!latest.empty()) {
+      delay_ms_ = CalculateDelayInMs(new_msg, *latest.front());
     }
   }
 
@@ -513,16 +520,16 @@ class Adapter {
   size_t message_num_ = 0;
 
   /// The received data. Its size is no more than message_num_
-  std::list<std::shared_ptr<D>> data_queue_;
+  SnapshotQueue<D> data_queue_;
 
   /// It is the snapshot of the data queue. The snapshot is taken when
   /// Observe() is called.
-  std::list<std::shared_ptr<D>> observed_queue_;
+  typename SnapshotQueue<D>::Snapshot observed_queue_;
 
   /// User defined function when receiving a message
   std::vector<Callback> receive_callbacks_;
 
-  /// The mutex guarding data_queue_ and observed_queue_
+  /// The mutex guarding observed_queue_
   mutable std::mutex mutex_;
 
   /// Whether dumping is enabled.
@@ -0,0 +1,207 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Compares Adapter::Observe()/FeedData() against the previous
+ * list-copying implementation while a publisher thread feeds messages at
+ * 100 Hz to 1 kHz.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/adapters/adapter.h"
+#include "modules/localization/proto/localization.pb.h"
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+using apollo::localization::LocalizationEstimate;
+
+namespace {
+
+/**
+ * @class ListAdapter
+ * @brief the data path of the previous Adapter implementation: a
+ * std::list of messages copied as a whole on every Observe().
+ */
+template <typename D>
+class ListAdapter {
+ public:
+  explicit ListAdapter(size_t message_num) : message_num_(message_num) {}
+
+  void FeedData(const D& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (data_queue_.size() + 1 > message_num_) {
+      data_queue_.pop_back();
+    }
+    data_queue_.push_front(std::make_shared<D>(data));
+  }
+
+  void Observe() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    observed_queue_ = data_queue_;
+  }
+
+  const D& GetLatestObserved() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return *observed_queue_.front();
+  }
+
+ private:
+  size_t message_num_ = 0;
+  std::list<std::shared_ptr<D>> data_queue_;
+  std::list<std::shared_ptr<D>> observed_queue_;
+  mutable std::mutex mutex_;
+};
+
+LocalizationEstimate MakeMessage(const int seq) {
+  LocalizationEstimate msg;
+  msg.mutable_header()->set_sequence_num(seq);
+  msg.mutable_header()->set_timestamp_sec(seq * 0.01);
+  auto* pose = msg.mutable_pose();
+  pose->mutable_position()->set_x(587000.0 + seq);
+  pose->mutable_position()->set_y(4141000.0 + seq);
+  pose->mutable_orientation()->set_qw(1.0);
+  pose->mutable_linear_velocity()->set_x(10.0);
+  return msg;
+}
+
+/**
+ * @class Publisher
+ * @brief feeds messages into an adapter from a separate thread at a fixed
+ * rate, emulating the ROS callback thread.
+ */
+template <typename AdapterType>
+class Publisher {
+ public:
+  Publisher(AdapterType* adapter, const int rate_hz) {
+    const auto period = std::chrono::microseconds(1000000 / rate_hz);
+    thread_ = std::thread([this, adapter, period]() {
+      const auto msg = MakeMessage(0);
+      auto next = std::chrono::steady_clock::now();
+      while (!stop_) {
+        adapter->FeedData(msg);
+        next += period;
+        std::this_thread::sleep_until(next);
+      }
+    });
+  }
+
+  ~Publisher() {
+    stop_ = true;
+    thread_.join();
+  }
+
+ private:
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+}  // namespace
+
+// Args: {publish rate in Hz, history size}.
+void ObserveArgs(benchmark::internal::Benchmark* b) {
+  for (const int history : {10, 100}) {
+    for (const int rate_hz : {100, 1000}) {
+      b->Args({rate_hz, history});
+    }
+  }
+  b->UseRealTime();
+}
+
+template <typename AdapterType>
+void Prefill(AdapterType* adapter, const size_t message_num) {
+  for (size_t i = 0; i < message_num; ++i) {
+    adapter->FeedData(MakeMessage(static_cast<int>(i)));
+  }
+}
+
+void BM_ListAdapterObserve(benchmark::State& state) {
+  ListAdapter<LocalizationEstimate> adapter(state.range(1));
+  Prefill(&adapter, state.range(1));
+  Publisher<ListAdapter<LocalizationEstimate>> publisher(
+      &adapter, static_cast<int>(state.range(0)));
+  while (state.KeepRunning()) {
+    adapter.Observe();
+    benchmark::DoNotOptimize(adapter.GetLatestObserved());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ListAdapterObserve)->Apply(ObserveArgs);
+
+void BM_AdapterObserve(benchmark::State& state) {
+  Adapter<LocalizationEstimate> adapter("local", "local_topic",
+                                        state.range(1));
+  Prefill(&adapter, state.range(1));
+  Publisher<Adapter<LocalizationEstimate>> publisher(
+      &adapter, static_cast<int>(state.range(0)));
+  while (state.KeepRunning()) {
+    adapter.Observe();
+    benchmark::DoNotOptimize(adapter.GetLatestObserved());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AdapterObserve)->Apply(ObserveArgs);
+
+// Measures the enqueueing cost of the receiving side while the main loop
+// observes at 100 Hz.
+// Arg: history size.
+template <typename AdapterType>
+void RunFeedData(benchmark::State& state, AdapterType* adapter) {
+  Prefill(adapter, state.range(0));
+  std::atomic<bool> stop(false);
+  std::thread observer([adapter, &stop]() {
+    while (!stop) {
+      adapter->Observe();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+  const auto msg = MakeMessage(0);
+  while (state.KeepRunning()) {
+    adapter->FeedData(msg);
+  }
+  stop = true;
+  observer.join();
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ListAdapterFeedData(benchmark::State& state) {
+  ListAdapter<LocalizationEstimate> adapter(state.range(0));
+  RunFeedData(state, &adapter);
+}
+BENCHMARK(BM_ListAdapterFeedData)->Arg(10)->Arg(100);
+
+void BM_AdapterFeedData(benchmark::State& state) {
+  Adapter<LocalizationEstimate> adapter("local", "local_topic",
+                                        state.range(0));
+  RunFeedData(state, &adapter);
+}
+BENCHMARK(BM_AdapterFeedData)->Arg(10)->Arg(100);
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
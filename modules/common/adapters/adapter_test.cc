@@ -113,6 +113,24 @@ TEST(AdapterTest, History) {
   }
 }
 
+TEST(AdapterTest, ClearData) {
+  IntegerAdapter adapter("Integer", "integer_topic", 3);
+  adapter.OnReceive(1);
+  adapter.OnReceive(2);
+  EXPECT_TRUE(adapter.HasReceived());
+  adapter.Observe();
+  EXPECT_FALSE(adapter.Empty());
+
+  adapter.ClearData();
+  EXPECT_FALSE(adapter.HasReceived());
+  EXPECT_TRUE(adapter.Empty());
+
+  adapter.OnReceive(3);
+  adapter.Observe();
+  EXPECT_EQ(3, adapter.GetLatestObserved());
+  EXPECT_EQ(3, adapter.GetOldestObserved());
+}
+
 TEST(AdapterTest, Callback) {
   IntegerAdapter adapter("Integer", "integer_topic", 3);
 
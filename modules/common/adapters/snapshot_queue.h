@@ -0,0 +1,238 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_ADAPTERS_SNAPSHOT_QUEUE_H_
+#define MODULES_ADAPTERS_SNAPSHOT_QUEUE_H_
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @namespace apollo::common::adapter
+ * @brief apollo::common::adapter
+ */
+namespace apollo {
+namespace common {
+namespace adapter {
+
+/**
+ * @class SnapshotQueue
+ * @brief a bounded history of messages, newest first, from which
+ * immutable snapshots can be taken in O(1).
+ *
+ * \par
+ * Messages are appended into fixed-size blocks of `capacity` slots. A
+ * slot is written exactly once, before the message count covering it is
+ * published, and is never modified afterwards. A snapshot only holds the
+ * current and the previous block together with the number of messages
+ * it covers in the current block, so taking a snapshot copies two
+ * pointers, and pushing a message never touches the slots that an
+ * existing snapshot can read. At most two blocks per live snapshot are
+ * kept alive.
+ *
+ * \par
+ * Push(), GetSnapshot() and Clear() are thread-safe. A Snapshot can be read
+ * from any thread without locking.
+ */
+template <typename T>
+class SnapshotQueue {
+ private:
+  struct Block {
+    explicit Block(const size_t capacity) : slots(capacity) {}
+    std::vector<std::shared_ptr<T>> slots;
+  };
+
+ public:
+  class Snapshot;
+
+  /**
+   * @class Iterator
+   * @brief a bidirectional iterator over a Snapshot, from the newest
+   * message to the oldest.
+   */
+  class Iterator {
+   public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef std::shared_ptr<T> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::shared_ptr<T>* pointer;
+    typedef const std::shared_ptr<T>& reference;
+
+    Iterator() = default;
+
+    reference operator*() const {
+      return snapshot_->at(index_);
+    }
+    pointer operator->() const {
+      return &snapshot_->at(index_);
+    }
+    Iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator it = *this;
+      ++index_;
+      return it;
+    }
+    Iterator& operator--() {
+      --index_;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator it = *this;
+      --index_;
+      return it;
+    }
+    bool operator==(const Iterator& other) const {
+      return snapshot_ == other.snapshot_ && index_ == other.index_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class Snapshot;
+    Iterator(const Snapshot* snapshot, const size_t index)
+        : snapshot_(snapshot), index_(index) {}
+
+    const Snapshot* snapshot_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  /**
+   * @class Snapshot
+   * @brief an immutable view of the queue at the time it was taken.
+   */
+  class Snapshot {
+   public:
+    Snapshot() = default;
+
+    size_t size() const {
+      return size_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    /**
+     * @brief returns the i-th newest message; at(0) is the newest one.
+     */
+    const std::shared_ptr<T>& at(const size_t i) const {
+      if (i < count_) {
+        return current_->slots[count_ - 1 - i];
+      }
+      return previous_->slots[previous_->slots.size() - 1 - (i - count_)];
+    }
+
+    const std::shared_ptr<T>& front() const {
+      return at(0);
+    }
+    const std::shared_ptr<T>& back() const {
+      return at(size_ - 1);
+    }
+
+    Iterator begin() const {
+      return Iterator(this, 0);
+    }
+    Iterator end() const {
+      return Iterator(this, size_);
+    }
+
+   private:
+    friend class SnapshotQueue;
+
+    std::shared_ptr<const Block> current_;
+    std::shared_ptr<const Block> previous_;
+    size_t count_ = 0;
+    size_t size_ = 0;
+  };
+
+  /**
+   * @brief constructs a queue holding at most `capacity` messages.
+   */
+  explicit SnapshotQueue(const size_t capacity) : capacity_(capacity) {}
+
+  /**
+   * @brief pushes a message as the newest one, evicting the oldest one
+   * if the queue is full.
+   */
+  void Push(std::shared_ptr<T> message) {
+    std::lock_guard<std::mutex> push_lock(push_mutex_);
+    if (!current_ || count_ == capacity_) {
+      previous_ = current_;
+      current_ = std::make_shared<Block>(capacity_);
+      count_ = 0;
+    }
+    // Nobody can read this slot before the new count is published below.
+    current_->slots[count_++] = std::move(message);
+
+    Snapshot next;
+    next.current_ = current_;
+    next.previous_ = previous_;
+    next.count_ = count_;
+    next.size_ = previous_ ? capacity_ : count_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    published_ = std::move(next);
+  }
+
+  /**
+   * @brief returns a snapshot of all the messages pushed so far.
+   */
+  Snapshot GetSnapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_;
+  }
+
+  /**
+   * @brief drops all the messages. Existing snapshots remain valid.
+   */
+  void Clear() {
+    std::lock_guard<std::mutex> push_lock(push_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_.reset();
+    previous_.reset();
+    count_ = 0;
+    published_ = Snapshot();
+  }
+
+ private:
+  const size_t capacity_;
+
+  /// Writer state, guarded by push_mutex_.
+  std::shared_ptr<Block> current_;
+  std::shared_ptr<Block> previous_;
+  size_t count_ = 0;
+  std::mutex push_mutex_;
+
+  /// The latest published snapshot, guarded by mutex_, which is only held
+  /// while a snapshot is copied.
+  Snapshot published_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_ADAPTERS_SNAPSHOT_QUEUE_H_
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/adapters/snapshot_queue.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+namespace {
+
+std::vector<int> ToVector(const SnapshotQueue<int>::Snapshot& snapshot) {
+  std::vector<int> values;
+  for (const auto& item : snapshot) {
+    values.push_back(*item);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(SnapshotQueueTest, Empty) {
+  SnapshotQueue<int> queue(3);
+  auto snapshot = queue.GetSnapshot();
+  EXPECT_TRUE(snapshot.empty());
+  EXPECT_EQ(0, snapshot.size());
+  EXPECT_TRUE(snapshot.begin() == snapshot.end());
+}
+
+TEST(SnapshotQueueTest, NewestFirst) {
+  SnapshotQueue<int> queue(3);
+  for (int i = 1; i <= 7; ++i) {
+    queue.Push(std::make_shared<int>(i));
+    auto snapshot = queue.GetSnapshot();
+    EXPECT_EQ(std::min(i, 3), snapshot.size());
+    EXPECT_EQ(i, *snapshot.front());
+    EXPECT_EQ(std::max(1, i - 2), *snapshot.back());
+  }
+  EXPECT_EQ(std::vector<int>({7, 6, 5}), ToVector(queue.GetSnapshot()));
+}
+
+TEST(SnapshotQueueTest, SnapshotIsImmutable) {
+  SnapshotQueue<int> queue(3);
+  queue.Push(std::make_shared<int>(1));
+  queue.Push(std::make_shared<int>(2));
+  auto snapshot = queue.GetSnapshot();
+  for (int i = 3; i <= 10; ++i) {
+    queue.Push(std::make_shared<int>(i));
+  }
+  EXPECT_EQ(std::vector<int>({2, 1}), ToVector(snapshot));
+  EXPECT_EQ(std::vector<int>({10, 9, 8}), ToVector(queue.GetSnapshot()));
+
+  queue.Clear();
+  EXPECT_TRUE(queue.GetSnapshot().empty());
+  EXPECT_EQ(std::vector<int>({2, 1}), ToVector(snapshot));
+}
+
+TEST(SnapshotQueueTest, BidirectionalIterator) {
+  SnapshotQueue<int> queue(4);
+  for (int i = 1; i <= 6; ++i) {
+    queue.Push(std::make_shared<int>(i));
+  }
+  auto snapshot = queue.GetSnapshot();
+  auto it = snapshot.end();
+  std::vector<int> reversed;
+  while (it != snapshot.begin()) {
+    --it;
+    reversed.push_back(**it);
+  }
+  EXPECT_EQ(std::vector<int>({3, 4, 5, 6}), reversed);
+}
+
+TEST(SnapshotQueueTest, ConcurrentPushAndSnapshot) {
+  const int kCapacity = 5;
+  const int kNumMessages = 20000;
+  SnapshotQueue<int> queue(kCapacity);
+  std::atomic<bool> done(false);
+  std::thread writer([&queue, &done]() {
+    for (int i = 1; i <= kNumMessages; ++i) {
+      queue.Push(std::make_shared<int>(i));
+    }
+    done = true;
+  });
+  while (!done) {
+    auto snapshot = queue.GetSnapshot();
+    if (snapshot.empty()) {
+      continue;
+    }
+    // Messages in a snapshot are always consecutive and newest first.
+    int expected = *snapshot.front();
+    for (const auto& item : snapshot) {
+      ASSERT_EQ(expected, *item);
+      --expected;
+    }
+  }
+  writer.join();
+  EXPECT_EQ(kNumMessages, *queue.GetSnapshot().front());
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,408 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the templated FlatAABoxKDTree2d class.
+ */
+
+#ifndef MODULES_COMMON_MATH_FLAT_AABOXKDTREE2D_H_
+#define MODULES_COMMON_MATH_FLAT_AABOXKDTREE2D_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "modules/common/log.h"
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/math_utils.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief The math namespace deals with a number of useful mathematical objects.
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class FlatAABoxKDTree2d
+ * @brief A KD-tree of axis-aligned bounding boxes with the same partitions
+ *        and results as AABoxKDTree2d, stored in a few contiguous arrays
+ *        instead of one heap allocation per node.
+ *
+ * The nodes are stored in pre-order in one vector, each with its bounding
+ * box, so that a pruning test reads one node. The objects of the nodes are
+ * stored in the same pre-order in shared arrays, so the objects of a subtree
+ * form one range.
+ */
+template <class ObjectType>
+class FlatAABoxKDTree2d {
+ public:
+  using ObjectPtr = const ObjectType *;
+
+  /**
+   * @brief Contructor which takes a vector of objects and parameters.
+   * @param params Parameters to build the KD-tree.
+   */
+  FlatAABoxKDTree2d(const std::vector<ObjectType> &objects,
+                    const AABoxKDTreeParams &params) {
+    if (!objects.empty()) {
+      std::vector<ObjectPtr> object_ptrs;
+      object_ptrs.reserve(objects.size());
+      for (const auto &object : objects) {
+        object_ptrs.push_back(&object);
+      }
+      objects_sorted_by_min_.reserve(objects.size());
+      objects_sorted_by_max_.reserve(objects.size());
+      objects_sorted_by_min_bound_.reserve(objects.size());
+      objects_sorted_by_max_bound_.reserve(objects.size());
+      BuildNode(object_ptrs, params, 0);
+    }
+  }
+
+  /**
+   * @brief Get the nearest object to a target point.
+   * @param point The target point. Search it's nearest object.
+   * @return The nearest object to the target point.
+   */
+  ObjectPtr GetNearestObject(const Vec2d &point) const {
+    ObjectPtr nearest_object = nullptr;
+    if (!nodes_.empty()) {
+      double min_distance_sqr = std::numeric_limits<double>::infinity();
+      GetNearestObjectInternal(0, point, &min_distance_sqr, &nearest_object);
+    }
+    return nearest_object;
+  }
+
+  /**
+   * @brief Get objects within a distance to a point.
+   * @param point The center point of the range to search objects.
+   * @param distance The radius of the range to search objects.
+   * @return All objects within the specified distance to the specified point.
+   */
+  std::vector<ObjectPtr> GetObjects(const Vec2d &point,
+                                    const double distance) const {
+    std::vector<ObjectPtr> result_objects;
+    if (!nodes_.empty()) {
+      GetObjectsInternal(0, point, distance, Square(distance),
+                         &result_objects);
+    }
+    return result_objects;
+  }
+
+  /**
+   * @brief Get the axis-aligned bounding box of the objects.
+   * @return The axis-aligned bounding box of the objects.
+   */
+  AABox2d GetBoundingBox() const {
+    return nodes_.empty() ? AABox2d()
+                          : AABox2d({nodes_[0].min_x, nodes_[0].min_y},
+                                    {nodes_[0].max_x, nodes_[0].max_y});
+  }
+
+ private:
+  enum Partition {
+    PARTITION_X = 1,
+    PARTITION_Y = 2,
+  };
+
+  struct Node {
+    // The bounding box of the objects of the subtree.
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+    double mid_x = 0.0;
+    double mid_y = 0.0;
+    // The indices of the children, or -1.
+    int left_subnode = -1;
+    int right_subnode = -1;
+    // The objects of the node are [objects_begin, objects_end) in the sorted
+    // object arrays, and the objects of its subtree are
+    // [objects_begin, subtree_objects_end).
+    int objects_begin = 0;
+    int objects_end = 0;
+    int subtree_objects_end = 0;
+    Partition partition = PARTITION_X;
+    double partition_position = 0.0;
+  };
+
+  int BuildNode(const std::vector<ObjectPtr> &objects,
+                const AABoxKDTreeParams &params, const int depth) {
+    CHECK(!objects.empty());
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+
+    Node node;
+    ComputeBoundary(objects, &node);
+    const double length_x = node.max_x - node.min_x;
+    const double length_y = node.max_y - node.min_y;
+    if (length_x >= length_y) {
+      node.partition = PARTITION_X;
+      node.partition_position = node.mid_x;
+    } else {
+      node.partition = PARTITION_Y;
+      node.partition_position = node.mid_y;
+    }
+
+    std::vector<ObjectPtr> left_subnode_objects;
+    std::vector<ObjectPtr> right_subnode_objects;
+    if (SplitToSubNodes(objects, params, depth, std::max(length_x, length_y))) {
+      std::vector<ObjectPtr> other_objects;
+      for (ObjectPtr object : objects) {
+        const AABox2d &aabox = object->aabox();
+        const bool partition_x = node.partition == PARTITION_X;
+        if ((partition_x ? aabox.max_x() : aabox.max_y()) <=
+            node.partition_position) {
+          left_subnode_objects.push_back(object);
+        } else if ((partition_x ? aabox.min_x() : aabox.min_y()) >=
+                   node.partition_position) {
+          right_subnode_objects.push_back(object);
+        } else {
+          other_objects.push_back(object);
+        }
+      }
+      AddObjects(other_objects, node.partition, &node);
+    } else {
+      AddObjects(objects, node.partition, &node);
+    }
+
+    if (!left_subnode_objects.empty()) {
+      node.left_subnode = BuildNode(left_subnode_objects, params, depth + 1);
+    }
+    if (!right_subnode_objects.empty()) {
+      node.right_subnode = BuildNode(right_subnode_objects, params, depth + 1);
+    }
+    node.subtree_objects_end = static_cast<int>(objects_sorted_by_min_.size());
+    nodes_[index] = node;
+    return index;
+  }
+
+  static void ComputeBoundary(const std::vector<ObjectPtr> &objects,
+                              Node *const node) {
+    node->min_x = std::numeric_limits<double>::infinity();
+    node->min_y = std::numeric_limits<double>::infinity();
+    node->max_x = -std::numeric_limits<double>::infinity();
+    node->max_y = -std::numeric_limits<double>::infinity();
+    for (ObjectPtr object : objects) {
+      node->min_x = std::min(node->min_x, object->aabox().min_x());
+      node->max_x = std::max(node->max_x, object->aabox().max_x());
+      node->min_y = std::min(node->min_y, object->aabox().min_y());
+      node->max_y = std::max(node->max_y, object->aabox().max_y());
+    }
+    node->mid_x = (node->min_x + node->max_x) / 2.0;
+    node->mid_y = (node->min_y + node->max_y) / 2.0;
+  }
+
+  bool SplitToSubNodes(const std::vector<ObjectPtr> &objects,
+                       const AABoxKDTreeParams &params, const int depth,
+                       const double max_dimension) const {
+    if (params.max_depth >= 0 && depth >= params.max_depth) {
+      return false;
+    }
+    if (static_cast<int>(objects.size()) <= std::max(1, params.max_leaf_size)) {
+      return false;
+    }
+    if (params.max_leaf_dimension >= 0.0 &&
+        max_dimension <= params.max_leaf_dimension) {
+      return false;
+    }
+    return true;
+  }
+
+  void AddObjects(const std::vector<ObjectPtr> &objects,
+                  const Partition partition, Node *const node) {
+    std::vector<ObjectPtr> sorted_by_min = objects;
+    std::vector<ObjectPtr> sorted_by_max = objects;
+    std::sort(sorted_by_min.begin(), sorted_by_min.end(),
+              [&](ObjectPtr obj1, ObjectPtr obj2) {
+                return partition == PARTITION_X
+                           ? obj1->aabox().min_x() < obj2->aabox().min_x()
+                           : obj1->aabox().min_y() < obj2->aabox().min_y();
+              });
+    std::sort(sorted_by_max.begin(), sorted_by_max.end(),
+              [&](ObjectPtr obj1, ObjectPtr obj2) {
+                return partition == PARTITION_X
+                           ? obj1->aabox().max_x() > obj2->aabox().max_x()
+                           : obj1->aabox().max_y() > obj2->aabox().max_y();
+              });
+    node->objects_begin = static_cast<int>(objects_sorted_by_min_.size());
+    for (ObjectPtr object : sorted_by_min) {
+      objects_sorted_by_min_.push_back(object);
+      objects_sorted_by_min_bound_.push_back(partition == PARTITION_X
+                                                 ? object->aabox().min_x()
+                                                 : object->aabox().min_y());
+    }
+    for (ObjectPtr object : sorted_by_max) {
+      objects_sorted_by_max_.push_back(object);
+      objects_sorted_by_max_bound_.push_back(partition == PARTITION_X
+                                                 ? object->aabox().max_x()
+                                                 : object->aabox().max_y());
+    }
+    node->objects_end = static_cast<int>(objects_sorted_by_min_.size());
+  }
+
+  static double LowerDistanceSquareToPoint(const Node &node,
+                                           const Vec2d &point) {
+    double dx = 0.0;
+    if (point.x() < node.min_x) {
+      dx = node.min_x - point.x();
+    } else if (point.x() > node.max_x) {
+      dx = point.x() - node.max_x;
+    }
+    double dy = 0.0;
+    if (point.y() < node.min_y) {
+      dy = node.min_y - point.y();
+    } else if (point.y() > node.max_y) {
+      dy = point.y() - node.max_y;
+    }
+    return dx * dx + dy * dy;
+  }
+
+  static double UpperDistanceSquareToPoint(const Node &node,
+                                           const Vec2d &point) {
+    const double dx = (point.x() > node.mid_x ? (point.x() - node.min_x)
+                                              : (point.x() - node.max_x));
+    const double dy = (point.y() > node.mid_y ? (point.y() - node.min_y)
+                                              : (point.y() - node.max_y));
+    return dx * dx + dy * dy;
+  }
+
+  void GetObjectsInternal(const int index, const Vec2d &point,
+                          const double distance, const double distance_sqr,
+                          std::vector<ObjectPtr> *const result_objects) const {
+    const Node &node = nodes_[index];
+    if (LowerDistanceSquareToPoint(node, point) > distance_sqr) {
+      return;
+    }
+    if (UpperDistanceSquareToPoint(node, point) <= distance_sqr) {
+      result_objects->insert(
+          result_objects->end(),
+          objects_sorted_by_min_.begin() + node.objects_begin,
+          objects_sorted_by_min_.begin() + node.subtree_objects_end);
+      return;
+    }
+    const double pvalue =
+        (node.partition == PARTITION_X ? point.x() : point.y());
+    if (pvalue < node.partition_position) {
+      const double limit = pvalue + distance;
+      for (int i = node.objects_begin; i < node.objects_end; ++i) {
+        if (objects_sorted_by_min_bound_[i] > limit) {
+          break;
+        }
+        ObjectPtr object = objects_sorted_by_min_[i];
+        if (object->DistanceSquareTo(point) <= distance_sqr) {
+          result_objects->push_back(object);
+        }
+      }
+    } else {
+      const double limit = pvalue - distance;
+      for (int i = node.objects_begin; i < node.objects_end; ++i) {
+        if (objects_sorted_by_max_bound_[i] < limit) {
+          break;
+        }
+        ObjectPtr object = objects_sorted_by_max_[i];
+        if (object->DistanceSquareTo(point) <= distance_sqr) {
+          result_objects->push_back(object);
+        }
+      }
+    }
+    if (node.left_subnode >= 0) {
+      GetObjectsInternal(node.left_subnode, point, distance, distance_sqr,
+                         result_objects);
+    }
+    if (node.right_subnode >= 0) {
+      GetObjectsInternal(node.right_subnode, point, distance, distance_sqr,
+                         result_objects);
+    }
+  }
+
+  void GetNearestObjectInternal(const int index, const Vec2d &point,
+                                double *const min_distance_sqr,
+                                ObjectPtr *const nearest_object) const {
+    const Node &node = nodes_[index];
+    if (LowerDistanceSquareToPoint(node, point) >=
+        *min_distance_sqr - kMathEpsilon) {
+      return;
+    }
+    const double pvalue =
+        (node.partition == PARTITION_X ? point.x() : point.y());
+    const bool search_left_first = (pvalue < node.partition_position);
+    const int first_subnode =
+        search_left_first ? node.left_subnode : node.right_subnode;
+    if (first_subnode >= 0) {
+      GetNearestObjectInternal(first_subnode, point, min_distance_sqr,
+                               nearest_object);
+    }
+    if (*min_distance_sqr <= kMathEpsilon) {
+      return;
+    }
+
+    if (search_left_first) {
+      for (int i = node.objects_begin; i < node.objects_end; ++i) {
+        const double bound = objects_sorted_by_min_bound_[i];
+        if (bound > pvalue && Square(bound - pvalue) > *min_distance_sqr) {
+          break;
+        }
+        ObjectPtr object = objects_sorted_by_min_[i];
+        const double distance_sqr = object->DistanceSquareTo(point);
+        if (distance_sqr < *min_distance_sqr) {
+          *min_distance_sqr = distance_sqr;
+          *nearest_object = object;
+        }
+      }
+    } else {
+      for (int i = node.objects_begin; i < node.objects_end; ++i) {
+        const double bound = objects_sorted_by_max_bound_[i];
+        if (bound < pvalue && Square(bound - pvalue) > *min_distance_sqr) {
+          break;
+        }
+        ObjectPtr object = objects_sorted_by_max_[i];
+        const double distance_sqr = object->DistanceSquareTo(point);
+        if (distance_sqr < *min_distance_sqr) {
+          *min_distance_sqr = distance_sqr;
+          *nearest_object = object;
+        }
+      }
+    }
+    if (*min_distance_sqr <= kMathEpsilon) {
+      return;
+    }
+    const int second_subnode =
+        search_left_first ? node.right_subnode : node.left_subnode;
+    if (second_subnode >= 0) {
+      GetNearestObjectInternal(second_subnode, point, min_distance_sqr,
+                               nearest_object);
+    }
+  }
+
+ private:
+  std::vector<Node> nodes_;
+
+  std::vector<ObjectPtr> objects_sorted_by_min_;
+  std::vector<ObjectPtr> objects_sorted_by_max_;
+  std::vector<double> objects_sorted_by_min_bound_;
+  std::vector<double> objects_sorted_by_max_bound_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif /* MODULES_COMMON_MATH_FLAT_AABOXKDTREE2D_H_ */
@@ -17,6 +17,7 @@
 #ifndef MODULES_COMMON_UTIL_LRU_CACHE_H_
 #define MODULES_COMMON_UTIL_LRU_CACHE_H_
 
+#include <functional>
 #include <iostream>
 #include <mutex>
 #include <unordered_map>
@@ -43,7 +44,7 @@ struct Node {
       : key(key), val(std::forward<VV>(val)), prev(nullptr), next(nullptr) {}
 };
 
-template <class K, class V>
+template <class K, class V, class Hash = std::hash<K>>
 class LRUCache {
  public:
   LRUCache() : capacity_(kDefaultCapacity), map_(0), head_(), tail_() {
@@ -157,6 +158,13 @@ class LRUCache {
     return nullptr;
   }
 
+  Node<K, V>* Last() {
+    if (size()) {
+      return tail_.prev;
+    }
+    return nullptr;
+  }
+
   bool Contains(const K& key) { return map_.find(key) != map_.end(); }
 
   bool Prioritize(const K& key) {
@@ -171,7 +179,7 @@ class LRUCache {
 
   void Clear() {
     map_.clear();
-    size_ = 0;
+    Init();
   }
 
  private:
@@ -179,7 +187,7 @@ class LRUCache {
 
   const size_t capacity_;
   size_t size_;
-  std::unordered_map<K, Node<K, V>> map_;
+  std::unordered_map<K, Node<K, V>, Hash> map_;
   Node<K, V> head_;
   Node<K, V> tail_;
 
@@ -242,15 +250,17 @@ class LRUCache {
   }
 
   V* Get(const K& key, bool silent) {
-    if (Contains(key)) {
-      auto* node = &map_[key];
-      if (!silent) {
-        Detach(node);
-        Attach(node);
-      }
-      return &node->val;
+    // find() alone, so that silent lookups do not race with each other
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return nullptr;
     }
-    return nullptr;
+    auto* node = &it->second;
+    if (!silent) {
+      Detach(node);
+      Attach(node);
+    }
+    return &node->val;
   }
 
   bool GetCopy(const K& key, const V* val, bool silent) {
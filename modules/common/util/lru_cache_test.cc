@@ -68,6 +68,27 @@ TEST(LRUCache, General) {
   }
 }
 
+TEST(LRUCache, ReuseAfterClear) {
+  LRUCache<int, int> lru(CAPACITY);
+  for (int i = 0; i < CAPACITY; ++i) {
+    lru.Put(i, i);
+  }
+  lru.Clear();
+  EXPECT_TRUE(lru.Empty());
+  EXPECT_EQ(nullptr, lru.First());
+  EXPECT_EQ(nullptr, lru.Last());
+
+  for (int i = 0; i < TEST_NUM; ++i) {
+    lru.Put(i, i * 10);
+  }
+  EXPECT_EQ(static_cast<size_t>(CAPACITY), lru.size());
+  EXPECT_EQ(TEST_NUM - 1, lru.First()->key);
+  EXPECT_EQ(TEST_NUM - CAPACITY, lru.Last()->key);
+  EXPECT_EQ(nullptr, lru.Get(0));
+  ASSERT_NE(nullptr, lru.Get(TEST_NUM - CAPACITY));
+  EXPECT_EQ((TEST_NUM - CAPACITY) * 10, *lru.Get(TEST_NUM - CAPACITY));
+}
+
 }  // namespace util
 }  // namespace common
 }  // namespace apollo
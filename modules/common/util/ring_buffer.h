@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the RingBuffer class.
+ */
+
+#ifndef MODULES_COMMON_UTIL_RING_BUFFER_H_
+#define MODULES_COMMON_UTIL_RING_BUFFER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "modules/common/log.h"
+
+/**
+ * @namespace apollo::common::util
+ * @brief apollo::common::util
+ */
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class RingBuffer
+ * @brief A double ended queue of preallocated elements, which are reused
+ * rather than destroyed when they leave the queue.
+ *
+ * An element is added to the front in two steps: NextFront() returns an
+ * element outside of the queue, with the content it had when it left the
+ * queue, and PushFront() adds it. So the element can be filled in place, while
+ * the queue is still unchanged. The capacity doubles when the queue is full.
+ */
+template <typename T>
+class RingBuffer {
+ public:
+  explicit RingBuffer(const size_t capacity)
+      : elements_(std::max(capacity, static_cast<size_t>(1))) {}
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  size_t capacity() const { return elements_.size(); }
+
+  /**
+   * @brief Gets the i-th element from the front.
+   */
+  const T& operator[](const size_t i) const {
+    DCHECK_LT(i, size_);
+    return elements_[Index(i)];
+  }
+
+  T& operator[](const size_t i) {
+    DCHECK_LT(i, size_);
+    return elements_[Index(i)];
+  }
+
+  const T& front() const { return (*this)[0]; }
+
+  T& front() { return (*this)[0]; }
+
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  T& back() { return (*this)[size_ - 1]; }
+
+  /**
+   * @brief Gets the element the next PushFront() adds to the front. It is not
+   * in the queue until then.
+   */
+  T* NextFront() {
+    if (size_ == elements_.size()) {
+      Grow();
+    }
+    return &elements_[Index(elements_.size() - 1)];
+  }
+
+  /**
+   * @brief Adds the element returned by NextFront() to the front.
+   */
+  void PushFront() {
+    CHECK_LT(size_, elements_.size()) << "PushFront() without NextFront().";
+    front_ = Index(elements_.size() - 1);
+    ++size_;
+  }
+
+  /**
+   * @brief Removes the back element, which is kept for a later NextFront().
+   */
+  void PopBack() {
+    DCHECK_GT(size_, 0);
+    --size_;
+  }
+
+  /**
+   * @brief Removes all the elements, which are kept for later NextFront().
+   */
+  void Clear() { size_ = 0; }
+
+ private:
+  size_t Index(const size_t i) const {
+    return (front_ + i) % elements_.size();
+  }
+
+  void Grow() {
+    std::vector<T> elements(elements_.size() * 2);
+    for (size_t i = 0; i < size_; ++i) {
+      using std::swap;
+      swap(elements[i], elements_[Index(i)]);
+    }
+    elements_.swap(elements);
+    front_ = 0;
+  }
+
+  std::vector<T> elements_;
+  size_t front_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_RING_BUFFER_H_
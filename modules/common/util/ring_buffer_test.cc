@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/ring_buffer.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(RingBuffer, PushFrontPopBack) {
+  RingBuffer<int> ring(3);
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(3u, ring.capacity());
+  for (int i = 0; i < 10; ++i) {
+    if (ring.size() == 3) {
+      ring.PopBack();
+    }
+    *ring.NextFront() = i;
+    ring.PushFront();
+    EXPECT_EQ(i, ring.front());
+    EXPECT_EQ(std::max(0, i - 2), ring.back());
+    for (size_t j = 0; j < ring.size(); ++j) {
+      EXPECT_EQ(i - static_cast<int>(j), ring[j]);
+    }
+  }
+  EXPECT_EQ(3u, ring.size());
+  EXPECT_EQ(3u, ring.capacity());
+}
+
+TEST(RingBuffer, Grow) {
+  RingBuffer<std::string> ring(2);
+  for (int i = 0; i < 5; ++i) {
+    *ring.NextFront() = std::to_string(i);
+    ring.PushFront();
+  }
+  EXPECT_EQ(5u, ring.size());
+  EXPECT_EQ(8u, ring.capacity());
+  for (size_t i = 0; i < ring.size(); ++i) {
+    EXPECT_EQ(std::to_string(4 - i), ring[i]);
+  }
+}
+
+TEST(RingBuffer, ReuseElements) {
+  RingBuffer<std::vector<int>> ring(2);
+  ring.NextFront()->assign(100, 1);
+  ring.PushFront();
+  ring.NextFront()->assign(100, 2);
+  ring.PushFront();
+  ring.PopBack();
+
+  // the popped element is the next front, with its content.
+  std::vector<int>* next_front = ring.NextFront();
+  EXPECT_EQ(100u, next_front->size());
+  EXPECT_EQ(1, next_front->front());
+  const int* data = next_front->data();
+  next_front->assign(50, 3);
+  EXPECT_EQ(data, next_front->data());
+  ring.PushFront();
+  EXPECT_EQ(3, ring.front().front());
+  EXPECT_EQ(2, ring.back().front());
+
+  ring.Clear();
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(2u, ring.capacity());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace apollo {
+namespace common {
+namespace util {
+
+ThreadPool::ThreadPool(const size_t num_threads) {
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (stop_ && tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+void ParallelFor(ThreadPool* pool, const size_t begin, const size_t end,
+                 const std::function<void(size_t)>& func) {
+  if (begin >= end) {
+    return;
+  }
+  const size_t num_items = end - begin;
+  const size_t num_chunks =
+      pool == nullptr ? 1 : std::min(num_items, pool->size() + 1);
+  if (num_chunks <= 1) {
+    for (size_t i = begin; i < end; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  const size_t chunk_size = (num_items + num_chunks - 1) / num_chunks;
+  std::vector<std::future<void>> futures;
+  futures.reserve(num_chunks - 1);
+  for (size_t chunk_begin = begin + chunk_size; chunk_begin < end;
+       chunk_begin += chunk_size) {
+    const size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+    futures.push_back(pool->Push([&func, chunk_begin, chunk_end]() {
+      for (size_t i = chunk_begin; i < chunk_end; ++i) {
+        func(i);
+      }
+    }));
+  }
+  // The calling thread takes the first chunk. The workers keep a reference
+  // to func, so every chunk is waited for before the first exception, if
+  // any, is rethrown.
+  std::exception_ptr exception;
+  try {
+    for (size_t i = begin; i < std::min(end, begin + chunk_size); ++i) {
+      func(i);
+    }
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
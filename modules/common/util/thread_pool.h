@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A fixed-size thread pool and a blocking parallel-for on top of it.
+ */
+
+#ifndef MODULES_COMMON_UTIL_THREAD_POOL_H_
+#define MODULES_COMMON_UTIL_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace apollo::common::util
+ * @brief apollo::common::util
+ */
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class ThreadPool
+ * @brief a pool of worker threads running tasks in FIFO order. The
+ * workers are started in the constructor and joined in the destructor,
+ * after all the pending tasks are done.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief starts `num_threads` workers. With zero workers, every task
+   * runs synchronously in the thread calling Push().
+   */
+  explicit ThreadPool(const size_t num_threads);
+
+  ~ThreadPool();
+
+  /**
+   * @brief returns the number of worker threads.
+   */
+  size_t size() const {
+    return workers_.size();
+  }
+
+  /**
+   * @brief schedules a task.
+   * @return a future holding the result (or the exception) of the task.
+   */
+  template <typename F>
+  std::future<typename std::result_of<F()>::type> Push(F&& f) {
+    using ResultType = typename std::result_of<F()>::type;
+    auto task = std::make_shared<std::packaged_task<ResultType()>>(
+        std::forward<F>(f));
+    auto future = task->get_future();
+    if (workers_.empty()) {
+      (*task)();
+      return future;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace([task]() { (*task)(); });
+    }
+    condition_.notify_one();
+    return future;
+  }
+
+ private:
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_ = false;
+};
+
+/**
+ * @brief calls func(i) for every i in [begin, end), spreading the calls
+ * over the workers of the pool and the calling thread, and blocks until
+ * all of them are done. Indices are handed out in contiguous chunks, so
+ * func must not depend on the order of the calls. A null pool runs the
+ * loop in the calling thread.
+ */
+void ParallelFor(ThreadPool* pool, const size_t begin, const size_t end,
+                 const std::function<void(size_t)>& func);
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_THREAD_POOL_H_
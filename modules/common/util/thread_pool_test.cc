@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ThreadPoolTest, Push) {
+  ThreadPool pool(4);
+  EXPECT_EQ(4, pool.size());
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 100; ++i) {
+    futures.push_back(pool.Push([i]() { return i * i; }));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i * i, futures[i].get());
+  }
+}
+
+TEST(ThreadPoolTest, NoWorker) {
+  ThreadPool pool(0);
+  int value = 0;
+  auto future = pool.Push([&value]() { value = 7; });
+  // The task runs synchronously without worker threads.
+  EXPECT_EQ(7, value);
+  future.get();
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+  ThreadPool pool(3);
+  for (const size_t num_items : {0, 1, 2, 5, 1000}) {
+    std::vector<int> visited(num_items, 0);
+    ParallelFor(&pool, 0, num_items, [&visited](size_t i) { ++visited[i]; });
+    EXPECT_EQ(std::vector<int>(num_items, 1), visited);
+  }
+
+  std::atomic<int> sum(0);
+  ParallelFor(nullptr, 10, 20, [&sum](size_t i) { sum += i; });
+  EXPECT_EQ(145, sum);
+}
+
+TEST(ThreadPoolTest, ParallelForException) {
+  ThreadPool pool(3);
+  // The calling thread throws at the start of its chunk, or a worker at the
+  // start of its own: the 3 other chunks of 25 are done before ParallelFor()
+  // rethrows.
+  for (const size_t throwing_index : {0, 50}) {
+    std::atomic<int> done(0);
+    EXPECT_THROW(ParallelFor(&pool, 0, 100,
+                             [&done, throwing_index](size_t i) {
+                               if (i == throwing_index) {
+                                 throw std::runtime_error("failed");
+                               }
+                               std::this_thread::sleep_for(
+                                   std::chrono::microseconds(100));
+                               ++done;
+                             }),
+                 std::runtime_error);
+    EXPECT_EQ(75, done);
+  }
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -23,6 +23,7 @@
 #define MODULES_COMMON_UTIL_H_
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -54,6 +55,14 @@ bool IsProtoEqual(const ProtoA& a, const ProtoB& b) {
   return google::protobuf::util::MessageDifferencer::Equals(a, b);
 }
 
+/**
+ * @brief mixes the hash of value into seed, as boost::hash_combine does.
+ */
+template <typename T>
+void HashCombine(const T& value, size_t* seed) {
+  *seed ^= std::hash<T>()(value) + 0x9e3779b9 + (*seed << 6) + (*seed >> 2);
+}
+
 struct PairHash {
   template <typename T, typename U>
   size_t operator()(const std::pair<T, U>& pair) const {
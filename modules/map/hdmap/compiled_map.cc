@@ -0,0 +1,739 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file compiled_map.cc
+ **/
+
+#include "modules/map/hdmap/compiled_map.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "modules/common/log.h"
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/math_utils.h"
+#include "modules/common/math/polygon2d.h"
+#include "modules/map/hdmap/hdmap_common.h"
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Polygon2d;
+using apollo::common::math::Vec2d;
+
+/*
+ * The file is a FileHeader followed by 8-byte aligned blocks, which the
+ * header and the records address by their byte offset in the file. For every
+ * object type there are:
+ *   - records: an ObjectRecord per object, sorted by id.
+ *   - elements: an Element per segment or polygon of the objects.
+ *   - nodes: the tree over the elements. The elements of every node are the
+ *     contiguous range [begin, end), and node 0 is the root.
+ *   - points: the points of the polygons.
+ */
+struct CompiledMap::Block {
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct CompiledMap::ObjectRecord {
+  Block id;
+  Block proto;
+  /// Only set for lanes.
+  Block road_id;
+  Block section_id;
+};
+
+struct CompiledMap::Point {
+  double x;
+  double y;
+};
+
+struct CompiledMap::Element {
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+  /// The segment, for the types with segments.
+  Point start;
+  Point end;
+  int32_t object_index;
+  /// The index of the segment in the object.
+  int32_t part_index;
+  /// The range of the polygon in the points, for the types with polygons.
+  uint32_t points_begin;
+  uint32_t points_end;
+};
+
+struct CompiledMap::Node {
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+  uint32_t begin;
+  uint32_t end;
+  /// -1 for leaves.
+  int32_t left;
+  int32_t right;
+};
+
+struct CompiledMap::FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t file_size;
+  struct Table {
+    Block records;
+    Block elements;
+    Block nodes;
+    Block points;
+  } tables[NUM_OBJECT_TYPES];
+};
+
+namespace {
+
+const char kMagic[8] = {'A', 'P', 'O', 'L', 'L', 'O', 'H', 'D'};
+const uint32_t kVersion = 1;
+const uint32_t kByteOrder = 0x01020304;
+const uint64_t kAlignment = 8;
+
+bool IsPolygonType(const CompiledMap::ObjectType type) {
+  return type == CompiledMap::JUNCTION || type == CompiledMap::CROSSWALK ||
+         type == CompiledMap::CLEAR_AREA;
+}
+
+double LowerDistanceSquareToPoint(const double min_x, const double min_y,
+                                  const double max_x, const double max_y,
+                                  const Vec2d& point) {
+  double dx = 0.0;
+  if (point.x() < min_x) {
+    dx = min_x - point.x();
+  } else if (point.x() > max_x) {
+    dx = point.x() - max_x;
+  }
+  double dy = 0.0;
+  if (point.y() < min_y) {
+    dy = min_y - point.y();
+  } else if (point.y() > max_y) {
+    dy = point.y() - max_y;
+  }
+  return dx * dx + dy * dy;
+}
+
+template <class Box>
+double LowerDistanceSquareToPoint(const Box& box, const Vec2d& point) {
+  return LowerDistanceSquareToPoint(box.min_x, box.min_y, box.max_x, box.max_y,
+                                    point);
+}
+
+/**
+ * @class TableBuilder
+ * @brief builds the blocks of an object type.
+ */
+class TableBuilder {
+ public:
+  using Element = CompiledMap::Element;
+  using Node = CompiledMap::Node;
+  using Point = CompiledMap::Point;
+
+  void AddSegments(const int object_index,
+                   const std::vector<LineSegment2d>& segments) {
+    for (size_t i = 0; i < segments.size(); ++i) {
+      const auto& segment = segments[i];
+      Element element;
+      std::memset(&element, 0, sizeof(element));
+      element.min_x = std::min(segment.start().x(), segment.end().x());
+      element.min_y = std::min(segment.start().y(), segment.end().y());
+      element.max_x = std::max(segment.start().x(), segment.end().x());
+      element.max_y = std::max(segment.start().y(), segment.end().y());
+      element.start = {segment.start().x(), segment.start().y()};
+      element.end = {segment.end().x(), segment.end().y()};
+      element.object_index = object_index;
+      element.part_index = static_cast<int32_t>(i);
+      elements_.push_back(element);
+    }
+  }
+
+  void AddPolygon(const int object_index, const Polygon2d& polygon) {
+    Element element;
+    std::memset(&element, 0, sizeof(element));
+    const auto box = polygon.AABoundingBox();
+    element.min_x = box.min_x();
+    element.min_y = box.min_y();
+    element.max_x = box.max_x();
+    element.max_y = box.max_y();
+    element.object_index = object_index;
+    element.points_begin = static_cast<uint32_t>(points_.size());
+    for (const auto& point : polygon.points()) {
+      points_.push_back({point.x(), point.y()});
+    }
+    element.points_end = static_cast<uint32_t>(points_.size());
+    elements_.push_back(element);
+  }
+
+  /**
+   * @brief builds the tree with the same leaf criteria as AABoxKDTree2d.
+   */
+  void BuildTree(const int max_leaf_size, const double max_leaf_dimension) {
+    nodes_.clear();
+    if (!elements_.empty()) {
+      BuildNode(0, elements_.size(), max_leaf_size, max_leaf_dimension);
+    }
+  }
+
+  const std::vector<Element>& elements() const { return elements_; }
+  const std::vector<Node>& nodes() const { return nodes_; }
+  const std::vector<Point>& points() const { return points_; }
+
+ private:
+  int BuildNode(const size_t begin, const size_t end, const int max_leaf_size,
+                const double max_leaf_dimension) {
+    Node node;
+    std::memset(&node, 0, sizeof(node));
+    node.min_x = std::numeric_limits<double>::infinity();
+    node.min_y = std::numeric_limits<double>::infinity();
+    node.max_x = -std::numeric_limits<double>::infinity();
+    node.max_y = -std::numeric_limits<double>::infinity();
+    for (size_t i = begin; i < end; ++i) {
+      node.min_x = std::min(node.min_x, elements_[i].min_x);
+      node.min_y = std::min(node.min_y, elements_[i].min_y);
+      node.max_x = std::max(node.max_x, elements_[i].max_x);
+      node.max_y = std::max(node.max_y, elements_[i].max_y);
+    }
+    node.begin = static_cast<uint32_t>(begin);
+    node.end = static_cast<uint32_t>(end);
+    node.left = -1;
+    node.right = -1;
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.push_back(node);
+
+    const double width = node.max_x - node.min_x;
+    const double height = node.max_y - node.min_y;
+    if (end - begin <= static_cast<size_t>(std::max(1, max_leaf_size)) ||
+        std::max(width, height) <= max_leaf_dimension) {
+      return index;
+    }
+    // Splits at the median of the centers along the longer side.
+    const bool split_x = width >= height;
+    const size_t mid = begin + (end - begin) / 2;
+    std::nth_element(elements_.begin() + begin, elements_.begin() + mid,
+                     elements_.begin() + end,
+                     [split_x](const Element& e1, const Element& e2) {
+                       return split_x
+                                  ? e1.min_x + e1.max_x < e2.min_x + e2.max_x
+                                  : e1.min_y + e1.max_y < e2.min_y + e2.max_y;
+                     });
+    const int left = BuildNode(begin, mid, max_leaf_size, max_leaf_dimension);
+    const int right = BuildNode(mid, end, max_leaf_size, max_leaf_dimension);
+    nodes_[index].left = left;
+    nodes_[index].right = right;
+    return index;
+  }
+
+  std::vector<Element> elements_;
+  std::vector<Node> nodes_;
+  std::vector<Point> points_;
+};
+
+/**
+ * @class FileBuilder
+ * @brief appends aligned blocks to the content of a file.
+ */
+class FileBuilder {
+ public:
+  explicit FileBuilder(const size_t header_size) : buffer_(header_size, '\0') {}
+
+  CompiledMap::Block Append(const void* data, const size_t size) {
+    buffer_.resize((buffer_.size() + kAlignment - 1) / kAlignment * kAlignment,
+                   '\0');
+    CompiledMap::Block block = {buffer_.size(), size};
+    buffer_.append(static_cast<const char*>(data), size);
+    return block;
+  }
+
+  CompiledMap::Block Append(const std::string& data) {
+    return Append(data.data(), data.size());
+  }
+
+  template <class T>
+  CompiledMap::Block Append(const std::vector<T>& data) {
+    return Append(data.data(), data.size() * sizeof(T));
+  }
+
+  std::string* buffer() { return &buffer_; }
+
+ private:
+  std::string buffer_;
+};
+
+
+/**
+ * @class MapCompiler
+ * @brief lays out a map in the compiled format.
+ */
+class MapCompiler {
+ public:
+  explicit MapCompiler(const Map& map)
+      : map_(map), file_builder_(sizeof(CompiledMap::FileHeader)) {
+    std::memset(&header_, 0, sizeof(header_));
+    for (const auto& road : map_.road()) {
+      for (const auto& section : road.section()) {
+        for (const auto& lane_id : section.lane_id()) {
+          lane_roads_[lane_id.id()] =
+              std::make_pair(road.id().id(), section.id().id());
+        }
+      }
+    }
+  }
+
+  bool Compile(std::string* content) {
+    // The same leaf criteria as the KD-trees of HDMapImpl.
+    const double kMaxLeafDimension = 5.0;  // meters.
+    if (!AddTable(CompiledMap::LANE, map_.lane(), &AddSegments<LaneInfo, Lane>,
+                  16, kMaxLeafDimension) ||
+        !AddTable(CompiledMap::JUNCTION, map_.junction(),
+                  &AddPolygons<JunctionInfo, Junction>, 1, kMaxLeafDimension) ||
+        !AddTable(CompiledMap::SIGNAL, map_.signal(),
+                  &AddSegments<SignalInfo, Signal>, 4, kMaxLeafDimension) ||
+        !AddTable(CompiledMap::CROSSWALK, map_.crosswalk(),
+                  &AddPolygons<CrosswalkInfo, Crosswalk>, 1,
+                  kMaxLeafDimension) ||
+        !AddTable(CompiledMap::STOP_SIGN, map_.stop_sign(),
+                  &AddSegments<StopSignInfo, StopSign>, 4, kMaxLeafDimension) ||
+        !AddTable(CompiledMap::YIELD_SIGN, map_.yield(),
+                  &AddSegments<YieldSignInfo, YieldSign>, 4,
+                  kMaxLeafDimension) ||
+        !AddTable(CompiledMap::CLEAR_AREA, map_.clear_area(),
+                  &AddPolygons<ClearAreaInfo, ClearArea>, 4,
+                  kMaxLeafDimension) ||
+        !AddTable(CompiledMap::SPEED_BUMP, map_.speed_bump(),
+                  &AddSegments<SpeedBumpInfo, SpeedBump>, 4,
+                  kMaxLeafDimension) ||
+        !AddTable<Overlap>(CompiledMap::OVERLAP, map_.overlap(), nullptr, 0,
+                           kMaxLeafDimension) ||
+        !AddTable<Road>(CompiledMap::ROAD, map_.road(), nullptr, 0,
+                        kMaxLeafDimension)) {
+      return false;
+    }
+
+    std::memcpy(header_.magic, kMagic, sizeof(kMagic));
+    header_.version = kVersion;
+    header_.byte_order = kByteOrder;
+    header_.file_size = file_builder_.buffer()->size();
+    std::memcpy(&(*file_builder_.buffer())[0], &header_, sizeof(header_));
+    content->swap(*file_builder_.buffer());
+    return true;
+  }
+
+ private:
+  template <class Proto>
+  using GeometryAdder = void (*)(const std::vector<const Proto*>&,
+                                 TableBuilder*);
+
+  template <class Info, class Proto>
+  static void AddSegments(const std::vector<const Proto*>& protos,
+                          TableBuilder* table_builder) {
+    for (size_t i = 0; i < protos.size(); ++i) {
+      const Info info(*protos[i]);
+      table_builder->AddSegments(static_cast<int>(i), info.segments());
+    }
+  }
+
+  template <class Info, class Proto>
+  static void AddPolygons(const std::vector<const Proto*>& protos,
+                          TableBuilder* table_builder) {
+    for (size_t i = 0; i < protos.size(); ++i) {
+      const Info info(*protos[i]);
+      table_builder->AddPolygon(static_cast<int>(i), info.polygon());
+    }
+  }
+
+  template <class Proto>
+  bool AddTable(const CompiledMap::ObjectType type,
+                const google::protobuf::RepeatedPtrField<Proto>& protos,
+                GeometryAdder<Proto> add_geometry, const int max_leaf_size,
+                const double max_leaf_dimension) {
+    std::vector<const Proto*> sorted;
+    for (const auto& proto : protos) {
+      sorted.push_back(&proto);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Proto* proto1, const Proto* proto2) {
+                return proto1->id().id() < proto2->id().id();
+              });
+
+    std::vector<CompiledMap::ObjectRecord> records;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+      const auto& id = sorted[i]->id().id();
+      if (i > 0 && id == sorted[i - 1]->id().id()) {
+        AERROR << "Duplicated map object id: " << id;
+        return false;
+      }
+      std::string data;
+      if (!sorted[i]->SerializeToString(&data)) {
+        AERROR << "Failed to serialize map object: " << id;
+        return false;
+      }
+      CompiledMap::ObjectRecord record;
+      std::memset(&record, 0, sizeof(record));
+      record.id = file_builder_.Append(id);
+      record.proto = file_builder_.Append(data);
+      AddRoadIds(*sorted[i], &record);
+      records.push_back(record);
+    }
+
+    TableBuilder table_builder;
+    if (add_geometry != nullptr) {
+      add_geometry(sorted, &table_builder);
+      table_builder.BuildTree(max_leaf_size, max_leaf_dimension);
+    }
+
+    auto* table = &header_.tables[type];
+    table->records = file_builder_.Append(records);
+    table->elements = file_builder_.Append(table_builder.elements());
+    table->nodes = file_builder_.Append(table_builder.nodes());
+    table->points = file_builder_.Append(table_builder.points());
+    return true;
+  }
+
+  template <class Proto>
+  void AddRoadIds(const Proto& proto, CompiledMap::ObjectRecord* record) {}
+
+  void AddRoadIds(const Lane& lane, CompiledMap::ObjectRecord* record) {
+    const auto it = lane_roads_.find(lane.id().id());
+    if (it != lane_roads_.end()) {
+      record->road_id = file_builder_.Append(it->second.first);
+      record->section_id = file_builder_.Append(it->second.second);
+    }
+  }
+
+  const Map& map_;
+  FileBuilder file_builder_;
+  CompiledMap::FileHeader header_;
+  /// The road id and the section id of the lanes.
+  std::unordered_map<std::string, std::pair<std::string, std::string>>
+      lane_roads_;
+};
+
+}  // namespace
+
+CompiledMap::CompiledMap(const char* data, const size_t size)
+    : data_(data), size_(size) {}
+
+CompiledMap::~CompiledMap() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+bool CompiledMap::Compile(const Map& map, const std::string& filename) {
+  std::string content;
+  if (!MapCompiler(map).Compile(&content)) {
+    return false;
+  }
+  std::ofstream file(filename, std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    AERROR << "Failed to open " << filename;
+    return false;
+  }
+  file.write(content.data(), content.size());
+  file.close();
+  if (!file) {
+    AERROR << "Failed to write " << filename;
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<CompiledMap> CompiledMap::Open(const std::string& filename) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AERROR << "Failed to open " << filename;
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) < sizeof(FileHeader)) {
+    AERROR << filename << " is not a compiled map.";
+    close(fd);
+    return nullptr;
+  }
+  const size_t size = file_stat.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    AERROR << "Failed to mmap " << filename;
+    return nullptr;
+  }
+
+  std::unique_ptr<CompiledMap> compiled_map(
+      new CompiledMap(static_cast<const char*>(data), size));
+  if (!compiled_map->Validate()) {
+    AERROR << filename << " is not a valid compiled map of version "
+           << kVersion;
+    return nullptr;
+  }
+  return compiled_map;
+}
+
+bool CompiledMap::Validate() const {
+  const auto& file_header = header();
+  if (std::memcmp(file_header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      file_header.version != kVersion || file_header.byte_order != kByteOrder ||
+      file_header.file_size != size_) {
+    return false;
+  }
+  const auto valid_block = [this](const Block& block, const size_t item_size) {
+    return block.offset % kAlignment == 0 && block.offset <= size_ &&
+           block.size <= size_ - block.offset && block.size % item_size == 0;
+  };
+  // Checks every index of the file, so that a query can never read out of
+  // the mapping.
+  for (int type = 0; type < NUM_OBJECT_TYPES; ++type) {
+    const auto& table = file_header.tables[type];
+    if (!valid_block(table.records, sizeof(ObjectRecord)) ||
+        !valid_block(table.elements, sizeof(Element)) ||
+        !valid_block(table.nodes, sizeof(Node)) ||
+        !valid_block(table.points, sizeof(Point))) {
+      return false;
+    }
+    const uint64_t num_records = table.records.size / sizeof(ObjectRecord);
+    const auto* records = Array<ObjectRecord>(table.records);
+    for (uint64_t i = 0; i < num_records; ++i) {
+      for (const auto* block : {&records[i].id, &records[i].proto,
+                                &records[i].road_id, &records[i].section_id}) {
+        if (block->offset > size_ || block->size > size_ - block->offset) {
+          return false;
+        }
+      }
+    }
+    const uint64_t num_elements = table.elements.size / sizeof(Element);
+    const uint64_t num_points = table.points.size / sizeof(Point);
+    const auto* elements = Array<Element>(table.elements);
+    for (uint64_t i = 0; i < num_elements; ++i) {
+      const auto& element = elements[i];
+      if (element.object_index < 0 ||
+          static_cast<uint64_t>(element.object_index) >= num_records ||
+          element.points_begin > element.points_end ||
+          element.points_end > num_points ||
+          (IsPolygonType(static_cast<ObjectType>(type)) &&
+           element.points_end - element.points_begin < 3)) {
+        return false;
+      }
+    }
+    const uint64_t num_nodes = table.nodes.size / sizeof(Node);
+    if (num_nodes == 0 && num_elements > 0) {
+      return false;
+    }
+    const auto* nodes = Array<Node>(table.nodes);
+    for (uint64_t i = 0; i < num_nodes; ++i) {
+      const auto& node = nodes[i];
+      // Children always come after their parent, so there is no cycle.
+      const bool is_leaf = node.left < 0 && node.right < 0;
+      if (node.begin > node.end || node.end > num_elements ||
+          (!is_leaf &&
+           (node.left <= static_cast<int64_t>(i) ||
+            node.right <= static_cast<int64_t>(i) ||
+            static_cast<uint64_t>(node.left) >= num_nodes ||
+            static_cast<uint64_t>(node.right) >= num_nodes))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+const CompiledMap::FileHeader& CompiledMap::header() const {
+  return *reinterpret_cast<const FileHeader*>(data_);
+}
+
+template <class T>
+const T* CompiledMap::Array(const Block& block) const {
+  return reinterpret_cast<const T*>(data_ + block.offset);
+}
+
+const CompiledMap::ObjectRecord& CompiledMap::record(const ObjectType type,
+                                                     const int index) const {
+  CHECK_GE(index, 0);
+  CHECK_LT(index, NumObjects(type));
+  return Array<ObjectRecord>(header().tables[type].records)[index];
+}
+
+std::string CompiledMap::GetString(const Block& block) const {
+  return std::string(data_ + block.offset, block.size);
+}
+
+int CompiledMap::NumObjects(const ObjectType type) const {
+  return static_cast<int>(header().tables[type].records.size /
+                          sizeof(ObjectRecord));
+}
+
+int CompiledMap::FindObject(const ObjectType type,
+                            const std::string& id) const {
+  const auto* records = Array<ObjectRecord>(header().tables[type].records);
+  int low = 0;
+  int high = NumObjects(type);
+  while (low < high) {
+    const int mid = (low + high) / 2;
+    const auto& record_id = records[mid].id;
+    const int compare =
+        id.compare(0, id.size(), data_ + record_id.offset, record_id.size);
+    if (compare == 0) {
+      return mid;
+    } else if (compare < 0) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return -1;
+}
+
+std::string CompiledMap::ObjectId(const ObjectType type,
+                                  const int index) const {
+  return GetString(record(type, index).id);
+}
+
+bool CompiledMap::ParseObject(const ObjectType type, const int index,
+                              google::protobuf::Message* proto) const {
+  CHECK_NOTNULL(proto);
+  const auto& block = record(type, index).proto;
+  return proto->ParseFromArray(data_ + block.offset,
+                               static_cast<int>(block.size));
+}
+
+std::string CompiledMap::LaneRoadId(const int index) const {
+  return GetString(record(LANE, index).road_id);
+}
+
+std::string CompiledMap::LaneSectionId(const int index) const {
+  return GetString(record(LANE, index).section_id);
+}
+
+double CompiledMap::DistanceSquareTo(const ObjectType type,
+                                     const Element& element,
+                                     const Vec2d& point) const {
+  if (IsPolygonType(type)) {
+    const auto* points = Array<Point>(header().tables[type].points);
+    std::vector<Vec2d> polygon_points;
+    for (uint32_t i = element.points_begin; i < element.points_end; ++i) {
+      polygon_points.emplace_back(points[i].x, points[i].y);
+    }
+    return Polygon2d(polygon_points).DistanceSquareTo(point);
+  }
+  return LineSegment2d({element.start.x, element.start.y},
+                       {element.end.x, element.end.y})
+      .DistanceSquareTo(point);
+}
+
+void CompiledMap::SearchObjects(const ObjectType type, const Vec2d& point,
+                                const double distance,
+                                std::vector<int>* indices) const {
+  CHECK_NOTNULL(indices)->clear();
+  const auto& table = header().tables[type];
+  const auto* nodes = Array<Node>(table.nodes);
+  const auto* elements = Array<Element>(table.elements);
+  if (table.nodes.size == 0) {
+    return;
+  }
+  const double distance_sqr = distance * distance;
+  std::vector<int> stack = {0};
+  while (!stack.empty()) {
+    const auto& node = nodes[stack.back()];
+    stack.pop_back();
+    if (LowerDistanceSquareToPoint(node, point) > distance_sqr) {
+      continue;
+    }
+    if (node.left >= 0) {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+      continue;
+    }
+    for (uint32_t i = node.begin; i < node.end; ++i) {
+      const auto& element = elements[i];
+      if (LowerDistanceSquareToPoint(element, point) <= distance_sqr &&
+          DistanceSquareTo(type, element, point) <= distance_sqr) {
+        indices->push_back(element.object_index);
+      }
+    }
+  }
+  std::sort(indices->begin(), indices->end());
+  indices->erase(std::unique(indices->begin(), indices->end()),
+                 indices->end());
+}
+
+bool CompiledMap::GetNearestLaneSegment(const Vec2d& point, int* lane_index,
+                                        int* segment_index) const {
+  CHECK_NOTNULL(lane_index);
+  CHECK_NOTNULL(segment_index);
+  const auto& table = header().tables[LANE];
+  const auto* nodes = Array<Node>(table.nodes);
+  const auto* elements = Array<Element>(table.elements);
+  if (table.nodes.size == 0) {
+    return false;
+  }
+  double min_distance_sqr = std::numeric_limits<double>::infinity();
+  const Element* nearest = nullptr;
+  std::vector<int> stack = {0};
+  while (!stack.empty()) {
+    const auto& node = nodes[stack.back()];
+    stack.pop_back();
+    if (LowerDistanceSquareToPoint(node, point) >=
+        min_distance_sqr - common::math::kMathEpsilon) {
+      continue;
+    }
+    if (node.left >= 0) {
+      // Visits the nearer child first.
+      const bool left_first =
+          LowerDistanceSquareToPoint(nodes[node.left], point) <=
+          LowerDistanceSquareToPoint(nodes[node.right], point);
+      stack.push_back(left_first ? node.right : node.left);
+      stack.push_back(left_first ? node.left : node.right);
+      continue;
+    }
+    for (uint32_t i = node.begin; i < node.end; ++i) {
+      const auto& element = elements[i];
+      if (LowerDistanceSquareToPoint(element, point) >= min_distance_sqr) {
+        continue;
+      }
+      const double distance_sqr = DistanceSquareTo(LANE, element, point);
+      if (distance_sqr < min_distance_sqr) {
+        min_distance_sqr = distance_sqr;
+        nearest = &element;
+      }
+    }
+  }
+  if (nearest == nullptr) {
+    return false;
+  }
+  *lane_index = nearest->object_index;
+  *segment_index = nearest->part_index;
+  return true;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file compiled_map.h
+ * @brief Defines the CompiledMap class, a memory-mappable HD map.
+ */
+
+#ifndef MODULES_MAP_HDMAP_COMPILED_MAP_H_
+#define MODULES_MAP_HDMAP_COMPILED_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/message.h"
+
+#include "modules/common/math/vec2d.h"
+#include "modules/map/proto/map.pb.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @class CompiledMap
+ * @brief A read-only HD map in a flat binary format which is mmap'd, so the
+ * pages are shared by all the processes which open the same file.
+ *
+ * \par
+ * For every object type, the file holds the serialized objects sorted by id,
+ * and for the types with a geometry, the segments or polygons of the objects
+ * along with a prebuilt bounding volume tree over them. Opening a map only
+ * validates the header: objects are parsed on demand, and the spatial queries
+ * run on the mapped tree directly.
+ *
+ * \par
+ * The file is written in the byte order of the host, which is checked when it
+ * is opened.
+ */
+class CompiledMap {
+ public:
+  enum ObjectType {
+    LANE = 0,
+    JUNCTION,
+    SIGNAL,
+    CROSSWALK,
+    STOP_SIGN,
+    YIELD_SIGN,
+    CLEAR_AREA,
+    SPEED_BUMP,
+    OVERLAP,
+    ROAD,
+    NUM_OBJECT_TYPES,
+  };
+
+  ~CompiledMap();
+
+  /**
+   * @brief compiles a map and writes it to a file.
+   * @return false if the map is invalid or the file can not be written.
+   */
+  static bool Compile(const Map& map, const std::string& filename);
+
+  /**
+   * @brief maps a compiled map file into memory.
+   * @return nullptr if the file can not be mapped or is not a valid compiled
+   * map of this version.
+   */
+  static std::unique_ptr<CompiledMap> Open(const std::string& filename);
+
+  int NumObjects(const ObjectType type) const;
+
+  /**
+   * @brief returns the index of the object with the given id, or -1.
+   */
+  int FindObject(const ObjectType type, const std::string& id) const;
+
+  std::string ObjectId(const ObjectType type, const int index) const;
+
+  /**
+   * @brief parses the object at index into proto, which has to be the
+   * message of the object type.
+   */
+  bool ParseObject(const ObjectType type, const int index,
+                   google::protobuf::Message* proto) const;
+
+  /**
+   * @brief returns the ids of the road and of the road section of a lane,
+   * which are empty if the lane is not on a road.
+   */
+  std::string LaneRoadId(const int index) const;
+  std::string LaneSectionId(const int index) const;
+
+  /**
+   * @brief finds the objects whose geometry is within distance of point.
+   * @param indices the indices of the objects, sorted and without duplicates.
+   */
+  void SearchObjects(const ObjectType type,
+                     const apollo::common::math::Vec2d& point,
+                     const double distance, std::vector<int>* indices) const;
+
+  /**
+   * @brief finds the lane segment nearest to point.
+   * @param lane_index the index of the lane.
+   * @param segment_index the index of the segment in the lane.
+   * @return false if there is no lane.
+   */
+  bool GetNearestLaneSegment(const apollo::common::math::Vec2d& point,
+                             int* lane_index, int* segment_index) const;
+
+  /// The layout of the file, see compiled_map.cc.
+  struct FileHeader;
+  struct Block;
+  struct ObjectRecord;
+  struct Element;
+  struct Node;
+  struct Point;
+
+ private:
+  CompiledMap(const char* data, const size_t size);
+
+  bool Validate() const;
+
+  const FileHeader& header() const;
+  const ObjectRecord& record(const ObjectType type, const int index) const;
+  std::string GetString(const Block& block) const;
+
+  template <class T>
+  const T* Array(const Block& block) const;
+
+  double DistanceSquareTo(const ObjectType type, const Element& element,
+                          const apollo::common::math::Vec2d& point) const;
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
+
+#endif  // MODULES_MAP_HDMAP_COMPILED_MAP_H_
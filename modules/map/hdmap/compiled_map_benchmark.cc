@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the startup of the HD map from a pb map and from a
+ * compiled map.
+ **/
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/compiled_map.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+
+namespace apollo {
+namespace hdmap {
+
+namespace {
+
+const char kMapFile[] = "modules/map/hdmap/test-data/base_map.bin";
+const char kCompiledMapFile[] = "/tmp/compiled_map_benchmark.cmap";
+
+// Arg 0 loads the pb map, and arg 1 the compiled map.
+std::string MapFile(const int compiled) {
+  if (!compiled) {
+    return kMapFile;
+  }
+  static const bool compiled_map = [] {
+    Map map;
+    CHECK(common::util::GetProtoFromFile(kMapFile, &map));
+    return CompiledMap::Compile(map, kCompiledMapFile);
+  }();
+  CHECK(compiled_map);
+  return kCompiledMapFile;
+}
+
+std::vector<common::PointENU> QueryPoints() {
+  Map map;
+  CHECK(common::util::GetProtoFromFile(kMapFile, &map));
+  std::vector<common::PointENU> points;
+  for (const auto& lane : map.lane()) {
+    const auto& point = lane.central_curve().segment(0).line_segment().point(0);
+    common::PointENU query_point;
+    query_point.set_x(point.x() + 1.0);
+    query_point.set_y(point.y() + 1.0);
+    points.push_back(query_point);
+  }
+  return points;
+}
+
+}  // namespace
+
+// Arg: 0 for the pb map, 1 for the compiled map.
+void BM_LoadMap(benchmark::State& state) {
+  const std::string map_file = MapFile(state.range(0));
+  while (state.KeepRunning()) {
+    HDMapImpl hdmap;
+    CHECK_EQ(0, hdmap.LoadMapFromFile(map_file));
+  }
+}
+BENCHMARK(BM_LoadMap)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// The time to the first answers: loading the map, then finding the nearest
+// lane of a point next to every lane, which builds all the lanes of a
+// compiled map.
+// Arg: 0 for the pb map, 1 for the compiled map.
+void BM_LoadMapAndQuery(benchmark::State& state) {
+  const std::string map_file = MapFile(state.range(0));
+  const auto points = QueryPoints();
+  while (state.KeepRunning()) {
+    HDMapImpl hdmap;
+    CHECK_EQ(0, hdmap.LoadMapFromFile(map_file));
+    for (const auto& point : points) {
+      LaneInfoConstPtr lane;
+      double s = 0.0;
+      double l = 0.0;
+      CHECK_EQ(0, hdmap.GetNearestLane(point, &lane, &s, &l));
+      benchmark::DoNotOptimize(lane);
+    }
+  }
+}
+BENCHMARK(BM_LoadMapAndQuery)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+}  // namespace hdmap
+}  // namespace apollo
+
+BENCHMARK_MAIN();
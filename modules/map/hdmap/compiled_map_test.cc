@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/compiled_map.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+#include "modules/map/hdmap/hdmap_util.h"
+
+namespace apollo {
+namespace hdmap {
+
+namespace {
+
+constexpr char kMapFilename[] = "modules/map/hdmap/test-data/base_map.bin";
+
+template <class InfoPtr>
+std::set<std::string> Ids(const std::vector<InfoPtr>& infos) {
+  std::set<std::string> ids;
+  for (const auto& info : infos) {
+    ids.insert(info->id().id());
+  }
+  return ids;
+}
+
+}  // namespace
+
+class CompiledMapTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    ASSERT_TRUE(common::util::GetProtoFromFile(kMapFilename, &map_));
+    ASSERT_EQ(0, proto_map_.LoadMapFromFile(kMapFilename));
+    const char* temp_dir = std::getenv("TEST_TMPDIR");
+    compiled_map_filename_ =
+        std::string(temp_dir == nullptr ? "/tmp" : temp_dir) + "/base_map.cmap";
+    ASSERT_TRUE(CompiledMap::Compile(map_, compiled_map_filename_));
+    ASSERT_EQ(0, compiled_map_.LoadMapFromFile(compiled_map_filename_));
+  }
+
+ protected:
+  // Points around the lanes of the map.
+  std::vector<common::PointENU> SamplePoints() const {
+    std::vector<common::PointENU> points;
+    for (int i = 0; i < map_.lane_size(); i += 3) {
+      const auto& segment = map_.lane(i).central_curve().segment(0);
+      const auto& lane_point = segment.line_segment().point(0);
+      for (const double offset : {-6.3, 0.0, 2.1}) {
+        common::PointENU point;
+        point.set_x(lane_point.x() + offset);
+        point.set_y(lane_point.y() - offset * 0.5);
+        points.push_back(point);
+      }
+    }
+    return points;
+  }
+
+  Map map_;
+  HDMapImpl proto_map_;
+  HDMapImpl compiled_map_;
+  std::string compiled_map_filename_;
+};
+
+TEST_F(CompiledMapTest, GetObjectsById) {
+  for (const auto& lane : map_.lane()) {
+    const auto expected = proto_map_.GetLaneById(lane.id());
+    const auto compiled = compiled_map_.GetLaneById(lane.id());
+    ASSERT_TRUE(compiled != nullptr) << lane.id().id();
+    EXPECT_EQ(expected->lane().DebugString(), compiled->lane().DebugString());
+    EXPECT_EQ(expected->road_id().id(), compiled->road_id().id());
+    EXPECT_EQ(expected->section_id().id(), compiled->section_id().id());
+    EXPECT_EQ(expected->overlaps().size(), compiled->overlaps().size());
+    EXPECT_EQ(expected->cross_lanes().size(), compiled->cross_lanes().size());
+    EXPECT_EQ(expected->signals().size(), compiled->signals().size());
+    EXPECT_EQ(expected->stop_signs().size(), compiled->stop_signs().size());
+    EXPECT_EQ(expected->crosswalks().size(), compiled->crosswalks().size());
+    EXPECT_EQ(expected->junctions().size(), compiled->junctions().size());
+    EXPECT_DOUBLE_EQ(expected->total_length(), compiled->total_length());
+    // Built once.
+    EXPECT_EQ(compiled, compiled_map_.GetLaneById(lane.id()));
+  }
+  for (const auto& junction : map_.junction()) {
+    const auto compiled = compiled_map_.GetJunctionById(junction.id());
+    ASSERT_TRUE(compiled != nullptr) << junction.id().id();
+    EXPECT_EQ(junction.DebugString(), compiled->junction().DebugString());
+  }
+  for (const auto& road : map_.road()) {
+    EXPECT_TRUE(compiled_map_.GetRoadById(road.id()) != nullptr);
+  }
+  EXPECT_TRUE(compiled_map_.GetSignalById(MakeMapId("1278")) != nullptr);
+  EXPECT_TRUE(compiled_map_.GetCrosswalkById(MakeMapId("1277")) != nullptr);
+  EXPECT_TRUE(compiled_map_.GetLaneById(MakeMapId("1")) == nullptr);
+  EXPECT_TRUE(compiled_map_.GetJunctionById(MakeMapId("1")) == nullptr);
+}
+
+TEST_F(CompiledMapTest, SearchObjects) {
+  for (const auto& point : SamplePoints()) {
+    for (const double distance : {0.5, 5.0, 20.0}) {
+      std::vector<LaneInfoConstPtr> expected_lanes;
+      std::vector<LaneInfoConstPtr> lanes;
+      EXPECT_EQ(0, proto_map_.GetLanes(point, distance, &expected_lanes));
+      EXPECT_EQ(0, compiled_map_.GetLanes(point, distance, &lanes));
+      EXPECT_EQ(Ids(expected_lanes), Ids(lanes));
+
+      std::vector<JunctionInfoConstPtr> expected_junctions;
+      std::vector<JunctionInfoConstPtr> junctions;
+      EXPECT_EQ(0,
+                proto_map_.GetJunctions(point, distance, &expected_junctions));
+      EXPECT_EQ(0, compiled_map_.GetJunctions(point, distance, &junctions));
+      EXPECT_EQ(Ids(expected_junctions), Ids(junctions));
+
+      std::vector<CrosswalkInfoConstPtr> expected_crosswalks;
+      std::vector<CrosswalkInfoConstPtr> crosswalks;
+      EXPECT_EQ(0, proto_map_.GetCrosswalks(point, distance,
+                                            &expected_crosswalks));
+      EXPECT_EQ(0, compiled_map_.GetCrosswalks(point, distance, &crosswalks));
+      EXPECT_EQ(Ids(expected_crosswalks), Ids(crosswalks));
+
+      std::vector<SignalInfoConstPtr> expected_signals;
+      std::vector<SignalInfoConstPtr> signals;
+      EXPECT_EQ(0, proto_map_.GetSignals(point, distance, &expected_signals));
+      EXPECT_EQ(0, compiled_map_.GetSignals(point, distance, &signals));
+      EXPECT_EQ(Ids(expected_signals), Ids(signals));
+
+      std::vector<StopSignInfoConstPtr> expected_stop_signs;
+      std::vector<StopSignInfoConstPtr> stop_signs;
+      EXPECT_EQ(0, proto_map_.GetStopSigns(point, distance,
+                                           &expected_stop_signs));
+      EXPECT_EQ(0, compiled_map_.GetStopSigns(point, distance, &stop_signs));
+      EXPECT_EQ(Ids(expected_stop_signs), Ids(stop_signs));
+    }
+  }
+}
+
+TEST_F(CompiledMapTest, GetNearestLane) {
+  for (const auto& point : SamplePoints()) {
+    LaneInfoConstPtr expected_lane;
+    double expected_s = 0.0;
+    double expected_l = 0.0;
+    ASSERT_EQ(0, proto_map_.GetNearestLane(point, &expected_lane, &expected_s,
+                                           &expected_l));
+    LaneInfoConstPtr lane;
+    double s = 0.0;
+    double l = 0.0;
+    ASSERT_EQ(0, compiled_map_.GetNearestLane(point, &lane, &s, &l));
+    // Connected lanes share their end points, so the nearest lane is only
+    // unique up to a tie in the distance.
+    const common::math::Vec2d xy(point.x(), point.y());
+    EXPECT_NEAR(expected_lane->DistanceTo(xy), lane->DistanceTo(xy), 1e-6);
+    if (expected_lane->id().id() == lane->id().id()) {
+      EXPECT_NEAR(expected_s, s, 1e-6);
+      EXPECT_NEAR(expected_l, l, 1e-6);
+    }
+  }
+}
+
+TEST_F(CompiledMapTest, RejectsOtherFiles) {
+  EXPECT_TRUE(CompiledMap::Open(kMapFilename) == nullptr);
+  EXPECT_TRUE(CompiledMap::Open("/nonexistent/base_map.cmap") == nullptr);
+
+  // A truncated file.
+  std::ifstream input(compiled_map_filename_, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(input)),
+                            std::istreambuf_iterator<char>());
+  const std::string truncated_filename = compiled_map_filename_ + ".truncated";
+  std::ofstream output(truncated_filename, std::ios::binary);
+  output << content.substr(0, content.size() / 2);
+  output.close();
+  EXPECT_TRUE(CompiledMap::Open(truncated_filename) == nullptr);
+}
+
+}  // namespace hdmap
+}  // namespace apollo
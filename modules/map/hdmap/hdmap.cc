@@ -118,6 +118,19 @@ int HDMap::GetNearestLane(const common::PointENU& point,
   return impl_.GetNearestLane(point, nearest_lane, nearest_s, nearest_l);
 }
 
+int HDMap::GetNearestLanes(
+    const std::vector<apollo::common::PointENU>& points,
+    std::vector<LaneInfoConstPtr>* nearest_lanes,
+    std::vector<double>* nearest_s, std::vector<double>* nearest_l) const {
+  return impl_.GetNearestLanes(points, nearest_lanes, nearest_s, nearest_l);
+}
+
+int HDMap::GetLanes(const std::vector<apollo::common::PointENU>& points,
+                    const double distance,
+                    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  return impl_.GetLanes(points, distance, lanes);
+}
+
 int HDMap::GetNearestLaneWithHeading(const apollo::common::PointENU& point,
                                      const double distance,
                                      const double central_heading,
@@ -160,6 +160,31 @@ class HDMap {
   int GetNearestLane(const apollo::common::PointENU& point,
                      LaneInfoConstPtr* nearest_lane,
                      double* nearest_s, double* nearest_l) const;
+  /**
+   * @brief get the nearest lanes of many points at once, with the same
+   * results as GetNearestLane() point by point.
+   * @param points the target points
+   * @param nearest_lanes the nearest lane of every point
+   * @param nearest_s the offset of every point along its nearest lane
+   * @param nearest_l the lateral offset of every point from its nearest lane
+   * @return 0:success, otherwise, failed.
+   */
+  int GetNearestLanes(const std::vector<apollo::common::PointENU>& points,
+                      std::vector<LaneInfoConstPtr>* nearest_lanes,
+                      std::vector<double>* nearest_s,
+                      std::vector<double>* nearest_l) const;
+  /**
+   * @brief get all lanes in certain range of many points at once. Nearby
+   * points share one search of the map, and the distances to the segments
+   * found are computed with SIMD instructions.
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param lanes the lanes in the range of every point
+   * @return 0:success, otherwise failed
+   */
+  int GetLanes(const std::vector<apollo::common::PointENU>& points,
+               const double distance,
+               std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
   /**
    * @brief get the nearest lane within a certain range by pose
    * @param point the target position
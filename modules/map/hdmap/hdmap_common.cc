@@ -398,34 +398,33 @@ void LaneInfo::UpdateOverlaps(const HDMapImpl &map_instance) {
       if (object_id == lane_.id().id()) {
         continue;
       }
-      const auto &object_map_id = MakeMapId(object_id);
-      if (map_instance.GetLaneById(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::LANE, object_id)) {
         cross_lanes_.emplace_back(overlap_ptr);
       }
-      if (map_instance.GetSignalById(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::SIGNAL, object_id)) {
         signals_.emplace_back(overlap_ptr);
       }
-      if (map_instance.GetYieldSignById(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::YIELD_SIGN, object_id)) {
         yield_signs_.emplace_back(overlap_ptr);
       }
-      if (map_instance.GetStopSignById(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::STOP_SIGN, object_id)) {
         stop_signs_.emplace_back(overlap_ptr);
       }
-      if (map_instance.GetCrosswalkById(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::CROSSWALK, object_id)) {
         crosswalks_.emplace_back(overlap_ptr);
       }
-      if (map_instance.GetJunctionById(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::JUNCTION, object_id)) {
         junctions_.emplace_back(overlap_ptr);
       }
-      if (map_instance.GetClearAreaById(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::CLEAR_AREA, object_id)) {
         clear_areas_.emplace_back(overlap_ptr);
       }
-      if (map_instance.GetSpeedBumpById(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::SPEED_BUMP, object_id)) {
         speed_bumps_.emplace_back(overlap_ptr);
       }
       // TODO(all): support parking
       /*
-      if (map_instance.get_parking_space_by_id(object_map_id) != nullptr) {
+      if (map_instance.HasObject(CompiledMap::PARKING_SPACE, object_id)) {
         parking_spaces_.emplace_back(overlap_ptr);
       }
       */
@@ -16,7 +16,12 @@ limitations under the License.
 #include "modules/map/hdmap/hdmap_impl.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <unordered_set>
+#include <utility>
+
+#include "Eigen/Core"
 
 #include "modules/common/util/file.h"
 #include "modules/common/util/string_util.h"
@@ -26,6 +31,7 @@ namespace apollo {
 namespace hdmap {
 namespace {
 
+using apollo::common::math::AABox2d;
 using apollo::common::math::AABoxKDTreeParams;
 using apollo::common::math::Vec2d;
 using apollo::common::PointENU;
@@ -36,11 +42,119 @@ Id CreateHDMapId(const std::string& string_id) {
   return id;
 }
 
+// The points of a batch query are grouped by the cells of a grid, and the
+// points of a group share one search of the lane segment KD-tree.
+const double kBatchCellSize = 4.0;  // meters.
+const size_t kMaxBatchGroupSize = 64;
+// Smaller groups are searched point by point.
+const size_t kMinBatchGroupSize = 4;
+// Covers the rounding of the distances in the search radius of a group.
+const double kBatchSearchBuffer = 1e-6;  // meters.
+
+std::vector<Vec2d> ToVec2d(const std::vector<PointENU>& points) {
+  std::vector<Vec2d> xy_points;
+  xy_points.reserve(points.size());
+  for (const auto& point : points) {
+    xy_points.emplace_back(point.x(), point.y());
+  }
+  return xy_points;
+}
+
+std::vector<std::vector<int>> GroupNearbyPoints(
+    const std::vector<Vec2d>& points) {
+  std::vector<std::pair<std::pair<int64_t, int64_t>, int>> cells;
+  cells.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    cells.emplace_back(
+        std::make_pair(
+            static_cast<int64_t>(std::floor(points[i].x() / kBatchCellSize)),
+            static_cast<int64_t>(std::floor(points[i].y() / kBatchCellSize))),
+        static_cast<int>(i));
+  }
+  std::sort(cells.begin(), cells.end());
+
+  std::vector<std::vector<int>> groups;
+  for (size_t i = 0; i < cells.size(); ++i) {
+    if (i == 0 || cells[i].first != cells[i - 1].first ||
+        groups.back().size() >= kMaxBatchGroupSize) {
+      groups.emplace_back();
+    }
+    groups.back().push_back(cells[i].second);
+  }
+  return groups;
+}
+
+void GetBoundingCircle(const std::vector<Vec2d>& points,
+                       const std::vector<int>& indices, Vec2d* center,
+                       double* radius) {
+  AABox2d box(points[indices.front()], points[indices.front()]);
+  for (const int index : indices) {
+    box.MergeFrom(points[index]);
+  }
+  *center = box.center();
+  *radius = std::hypot(box.half_length(), box.half_width());
+}
+
+/**
+ * @class SegmentArrays
+ * @brief lane segments packed as arrays, so that Eigen computes the distances
+ * from a point to all of them with SIMD instructions.
+ */
+class SegmentArrays {
+ public:
+  explicit SegmentArrays(const std::vector<const LaneSegmentBox*>& segments)
+      : start_x_(segments.size()),
+        start_y_(segments.size()),
+        unit_x_(segments.size()),
+        unit_y_(segments.size()),
+        length_(segments.size()) {
+    for (size_t i = 0; i < segments.size(); ++i) {
+      const auto& segment = *segments[i]->geo_object();
+      start_x_[i] = segment.start().x();
+      start_y_[i] = segment.start().y();
+      unit_x_[i] = segment.unit_direction().x();
+      unit_y_[i] = segment.unit_direction().y();
+      length_[i] = segment.length();
+    }
+  }
+
+  // Not thread safe: the arrays of the differences are reused between calls.
+  void DistanceSquareTo(const Vec2d& point, Eigen::ArrayXd* distance_sqr) {
+    dx_ = point.x() - start_x_;
+    dy_ = point.y() - start_y_;
+    proj_ = (dx_ * unit_x_ + dy_ * unit_y_).max(0.0).min(length_);
+    *distance_sqr =
+        (dx_ - proj_ * unit_x_).square() + (dy_ - proj_ * unit_y_).square();
+  }
+
+ private:
+  Eigen::ArrayXd start_x_;
+  Eigen::ArrayXd start_y_;
+  Eigen::ArrayXd unit_x_;
+  Eigen::ArrayXd unit_y_;
+  Eigen::ArrayXd length_;
+  Eigen::ArrayXd dx_;
+  Eigen::ArrayXd dy_;
+  Eigen::ArrayXd proj_;
+};
+
 }  // namespace
 
 int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
   Clear();
 
+  if (apollo::common::util::EndWith(map_filename, ".cmap")) {
+    compiled_map_ = CompiledMap::Open(map_filename);
+    if (compiled_map_ == nullptr) {
+      return -1;
+    }
+    for (int type = 0; type < CompiledMap::NUM_OBJECT_TYPES; ++type) {
+      compiled_objects_[type].resize(compiled_map_->NumObjects(
+          static_cast<CompiledMap::ObjectType>(type)));
+    }
+    return 0;
+  }
+
   if (apollo::common::util::EndWith(map_filename, ".xml")) {
     if (!adapter::OpendriveAdapter::LoadData(map_filename, &map_)) {
       return -1;
@@ -111,51 +225,88 @@ int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
 }
 
 LaneInfoConstPtr HDMapImpl::GetLaneById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<LaneInfo, Lane>(CompiledMap::LANE, id);
+  }
   LaneTable::const_iterator it = lane_table_.find(id.id());
   return it != lane_table_.end() ? it->second : nullptr;
 }
 
 JunctionInfoConstPtr HDMapImpl::GetJunctionById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<JunctionInfo, Junction>(
+        CompiledMap::JUNCTION, id);
+  }
   JunctionTable::const_iterator it = junction_table_.find(id.id());
   return it != junction_table_.end() ? it->second : nullptr;
 }
 
 SignalInfoConstPtr HDMapImpl::GetSignalById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<SignalInfo, Signal>(CompiledMap::SIGNAL, id);
+  }
   SignalTable::const_iterator it = signal_table_.find(id.id());
   return it != signal_table_.end() ? it->second : nullptr;
 }
 
 CrosswalkInfoConstPtr HDMapImpl::GetCrosswalkById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<CrosswalkInfo, Crosswalk>(
+        CompiledMap::CROSSWALK, id);
+  }
   CrosswalkTable::const_iterator it = crosswalk_table_.find(id.id());
   return it != crosswalk_table_.end() ? it->second : nullptr;
 }
 
 StopSignInfoConstPtr HDMapImpl::GetStopSignById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<StopSignInfo, StopSign>(
+        CompiledMap::STOP_SIGN, id);
+  }
   StopSignTable::const_iterator it = stop_sign_table_.find(id.id());
   return it != stop_sign_table_.end() ? it->second : nullptr;
 }
 
 YieldSignInfoConstPtr HDMapImpl::GetYieldSignById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<YieldSignInfo, YieldSign>(
+        CompiledMap::YIELD_SIGN, id);
+  }
   YieldSignTable::const_iterator it = yield_sign_table_.find(id.id());
   return it != yield_sign_table_.end() ? it->second : nullptr;
 }
 
 ClearAreaInfoConstPtr HDMapImpl::GetClearAreaById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<ClearAreaInfo, ClearArea>(
+        CompiledMap::CLEAR_AREA, id);
+  }
   ClearAreaTable::const_iterator it = clear_area_table_.find(id.id());
   return it != clear_area_table_.end() ? it->second : nullptr;
 }
 
 SpeedBumpInfoConstPtr HDMapImpl::GetSpeedBumpById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<SpeedBumpInfo, SpeedBump>(
+        CompiledMap::SPEED_BUMP, id);
+  }
   SpeedBumpTable::const_iterator it = speed_bump_table_.find(id.id());
   return it != speed_bump_table_.end() ? it->second : nullptr;
 }
 
 OverlapInfoConstPtr HDMapImpl::GetOverlapById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<OverlapInfo, Overlap>(
+        CompiledMap::OVERLAP, id);
+  }
   OverlapTable::const_iterator it = overlap_table_.find(id.id());
   return it != overlap_table_.end() ? it->second : nullptr;
 }
 
 RoadInfoConstPtr HDMapImpl::GetRoadById(const Id& id) const {
+  if (compiled_map_ != nullptr) {
+    return GetCompiledObjectById<RoadInfo, Road>(CompiledMap::ROAD, id);
+  }
   RoadTable::const_iterator it = road_table_.find(id.id());
   return it != road_table_.end() ? it->second : nullptr;
 }
@@ -167,14 +318,14 @@ int HDMapImpl::GetLanes(const PointENU& point, double distance,
 
 int HDMapImpl::GetLanes(const Vec2d& point, double distance,
                         std::vector<LaneInfoConstPtr>* lanes) const {
-  if (lanes == nullptr || lane_segment_kdtree_ == nullptr) {
+  if (lanes == nullptr) {
     return -1;
   }
 
   lanes->clear();
   std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *lane_segment_kdtree_, &ids);
+  const int status = SearchObjects(CompiledMap::LANE, point, distance,
+                                   lane_segment_kdtree_, &ids);
   if (status < 0) {
     return status;
   }
@@ -219,13 +370,13 @@ int HDMapImpl::GetJunctions(
 int HDMapImpl::GetJunctions(
     const Vec2d& point, double distance,
     std::vector<JunctionInfoConstPtr>* junctions) const {
-  if (junctions == nullptr || junction_polygon_kdtree_ == nullptr) {
+  if (junctions == nullptr) {
     return -1;
   }
   junctions->clear();
   std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *junction_polygon_kdtree_, &ids);
+  const int status = SearchObjects(CompiledMap::JUNCTION, point, distance,
+                                   junction_polygon_kdtree_, &ids);
   if (status < 0) {
     return status;
   }
@@ -242,13 +393,13 @@ int HDMapImpl::GetSignals(const PointENU& point, double distance,
 
 int HDMapImpl::GetSignals(const Vec2d& point, double distance,
                           std::vector<SignalInfoConstPtr>* signals) const {
-  if (signals == nullptr || signal_segment_kdtree_ == nullptr) {
+  if (signals == nullptr) {
     return -1;
   }
   signals->clear();
   std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *signal_segment_kdtree_, &ids);
+  const int status = SearchObjects(CompiledMap::SIGNAL, point, distance,
+                                   signal_segment_kdtree_, &ids);
   if (status < 0) {
     return status;
   }
@@ -267,13 +418,13 @@ int HDMapImpl::GetCrosswalks(
 int HDMapImpl::GetCrosswalks(
     const Vec2d& point, double distance,
     std::vector<CrosswalkInfoConstPtr>* crosswalks) const {
-  if (crosswalks == nullptr || crosswalk_polygon_kdtree_ == nullptr) {
+  if (crosswalks == nullptr) {
     return -1;
   }
   crosswalks->clear();
   std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *crosswalk_polygon_kdtree_, &ids);
+  const int status = SearchObjects(CompiledMap::CROSSWALK, point, distance,
+                                   crosswalk_polygon_kdtree_, &ids);
   if (status < 0) {
     return status;
   }
@@ -292,13 +443,13 @@ int HDMapImpl::GetStopSigns(
 int HDMapImpl::GetStopSigns(
     const Vec2d& point, double distance,
     std::vector<StopSignInfoConstPtr>* stop_signs) const {
-  if (stop_signs == nullptr || stop_sign_segment_kdtree_ == nullptr) {
+  if (stop_signs == nullptr) {
     return -1;
   }
   stop_signs->clear();
   std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *stop_sign_segment_kdtree_, &ids);
+  const int status = SearchObjects(CompiledMap::STOP_SIGN, point, distance,
+                                   stop_sign_segment_kdtree_, &ids);
   if (status < 0) {
     return status;
   }
@@ -317,13 +468,13 @@ int HDMapImpl::GetYieldSigns(
 int HDMapImpl::GetYieldSigns(
     const Vec2d& point, double distance,
     std::vector<YieldSignInfoConstPtr>* yield_signs) const {
-  if (yield_signs == nullptr || yield_sign_segment_kdtree_ == nullptr) {
+  if (yield_signs == nullptr) {
     return -1;
   }
   yield_signs->clear();
   std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *yield_sign_segment_kdtree_, &ids);
+  const int status = SearchObjects(CompiledMap::YIELD_SIGN, point, distance,
+                                   yield_sign_segment_kdtree_, &ids);
   if (status < 0) {
     return status;
   }
@@ -343,13 +494,13 @@ int HDMapImpl::GetClearAreas(
 int HDMapImpl::GetClearAreas(
     const Vec2d& point, double distance,
     std::vector<ClearAreaInfoConstPtr>* clear_areas) const {
-  if (clear_areas == nullptr || clear_area_polygon_kdtree_ == nullptr) {
+  if (clear_areas == nullptr) {
     return -1;
   }
   clear_areas->clear();
   std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *clear_area_polygon_kdtree_, &ids);
+  const int status = SearchObjects(CompiledMap::CLEAR_AREA, point, distance,
+                                   clear_area_polygon_kdtree_, &ids);
   if (status < 0) {
     return status;
   }
@@ -369,13 +520,13 @@ int HDMapImpl::GetSpeedBumps(
 int HDMapImpl::GetSpeedBumps(
     const Vec2d& point, double distance,
     std::vector<SpeedBumpInfoConstPtr>* speed_bumps) const {
-  if (speed_bumps == nullptr || speed_bump_segment_kdtree_ == nullptr) {
+  if (speed_bumps == nullptr) {
     return -1;
   }
   speed_bumps->clear();
   std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *speed_bump_segment_kdtree_, &ids);
+  const int status = SearchObjects(CompiledMap::SPEED_BUMP, point, distance,
+                                   speed_bump_segment_kdtree_, &ids);
   if (status < 0) {
     return status;
   }
@@ -399,14 +550,26 @@ int HDMapImpl::GetNearestLane(const Vec2d& point,
   CHECK_NOTNULL(nearest_lane);
   CHECK_NOTNULL(nearest_s);
   CHECK_NOTNULL(nearest_l);
-  const auto* segment_object = lane_segment_kdtree_->GetNearestObject(point);
-  if (segment_object == nullptr) {
-    return -1;
+  int id = 0;
+  if (compiled_map_ != nullptr) {
+    int lane_index = 0;
+    if (!compiled_map_->GetNearestLaneSegment(point, &lane_index, &id)) {
+      return -1;
+    }
+    *nearest_lane =
+        GetCompiledObject<LaneInfo, Lane>(CompiledMap::LANE, lane_index);
+  } else {
+    if (lane_segment_kdtree_ == nullptr) {
+      return -1;
+    }
+    const auto* segment_object = lane_segment_kdtree_->GetNearestObject(point);
+    if (segment_object == nullptr) {
+      return -1;
+    }
+    *nearest_lane = GetLaneById(segment_object->object()->id());
+    id = segment_object->id();
   }
-  const Id& lane_id = segment_object->object()->id();
-  *nearest_lane = GetLaneById(lane_id);
   CHECK(*nearest_lane);
-  const int id = segment_object->id();
   const auto& segment = (*nearest_lane)->segments()[id];
   Vec2d nearest_pt;
   segment.DistanceTo(point, &nearest_pt);
@@ -417,6 +580,68 @@ int HDMapImpl::GetNearestLane(const Vec2d& point,
   return 0;
 }
 
+int HDMapImpl::GetNearestLanes(const std::vector<PointENU>& points,
+                               std::vector<LaneInfoConstPtr>* nearest_lanes,
+                               std::vector<double>* nearest_s,
+                               std::vector<double>* nearest_l) const {
+  CHECK_NOTNULL(nearest_lanes)->assign(points.size(), nullptr);
+  CHECK_NOTNULL(nearest_s)->assign(points.size(), 0.0);
+  CHECK_NOTNULL(nearest_l)->assign(points.size(), 0.0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (GetNearestLane(points[i], &(*nearest_lanes)[i], &(*nearest_s)[i],
+                       &(*nearest_l)[i]) != 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int HDMapImpl::GetLanes(
+    const std::vector<PointENU>& points, const double distance,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  CHECK_NOTNULL(lanes)->assign(points.size(), {});
+  if (compiled_map_ != nullptr || lane_segment_kdtree_ == nullptr) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (GetLanes(points[i], distance, &(*lanes)[i]) != 0) {
+        return -1;
+      }
+    }
+    return 0;
+  }
+
+  const auto xy_points = ToVec2d(points);
+  const double distance_sqr_limit = distance * distance;
+  Eigen::ArrayXd distance_sqr;
+  for (const auto& group : GroupNearbyPoints(xy_points)) {
+    if (group.size() < kMinBatchGroupSize) {
+      for (const int index : group) {
+        if (GetLanes(xy_points[index], distance, &(*lanes)[index]) != 0) {
+          return -1;
+        }
+      }
+      continue;
+    }
+    Vec2d center;
+    double radius = 0.0;
+    GetBoundingCircle(xy_points, group, &center, &radius);
+    const auto candidates = lane_segment_kdtree_->GetObjects(
+        center, distance + radius + kBatchSearchBuffer);
+    SegmentArrays segment_arrays(candidates);
+    for (const int index : group) {
+      segment_arrays.DistanceSquareTo(xy_points[index], &distance_sqr);
+      std::unordered_set<const LaneInfo*> lane_set;
+      for (Eigen::ArrayXd::Index i = 0; i < distance_sqr.size(); ++i) {
+        if (distance_sqr[i] <= distance_sqr_limit &&
+            lane_set.insert(candidates[i]->object()).second) {
+          (*lanes)[index].emplace_back(
+              GetLaneById(candidates[i]->object()->id()));
+        }
+      }
+    }
+  }
+  return 0;
+}
+
 int HDMapImpl::GetNearestLaneWithHeading(
     const PointENU& point, const double distance, const double central_heading,
     const double max_heading_difference, LaneInfoConstPtr* nearest_lane,
@@ -657,6 +882,105 @@ void HDMapImpl::BuildSpeedBumpSegmentKDTree() {
                      &speed_bump_segment_kdtree_);
 }
 
+template <class KDTree>
+int HDMapImpl::SearchObjects(const CompiledMap::ObjectType type,
+                             const Vec2d& center, const double radius,
+                             const std::unique_ptr<KDTree>& kdtree,
+                             std::vector<std::string>* const results) const {
+  if (results == nullptr) {
+    return -1;
+  }
+  if (compiled_map_ == nullptr) {
+    return kdtree == nullptr ? -1
+                             : SearchObjects(center, radius, *kdtree, results);
+  }
+  std::vector<int> indices;
+  compiled_map_->SearchObjects(type, center, radius, &indices);
+  results->clear();
+  for (const int index : indices) {
+    results->push_back(compiled_map_->ObjectId(type, index));
+  }
+  return 0;
+}
+
+template <class Info, class Proto>
+std::shared_ptr<Info> HDMapImpl::GetCompiledObject(
+    const CompiledMap::ObjectType type, const int index) const {
+  auto& objects = compiled_objects_[type];
+  {
+    std::lock_guard<std::mutex> lock(compiled_objects_mutex_);
+    if (objects[index] != nullptr) {
+      return std::static_pointer_cast<Info>(objects[index]);
+    }
+  }
+
+  // The info refers to the proto, so both live in one allocation. It is
+  // built without the lock, as building a lane looks up its overlaps.
+  struct Holder {
+    Proto proto;
+    std::unique_ptr<Info> info;
+  };
+  std::shared_ptr<Holder> holder(new Holder());
+  CHECK(compiled_map_->ParseObject(type, index, &holder->proto))
+      << "Failed to parse map object " << compiled_map_->ObjectId(type, index);
+  holder->info.reset(new Info(holder->proto));
+  InitCompiledObject(index, holder->info.get());
+  std::shared_ptr<Info> info(holder, holder->info.get());
+
+  std::lock_guard<std::mutex> lock(compiled_objects_mutex_);
+  if (objects[index] == nullptr) {
+    objects[index] = info;
+  }
+  return std::static_pointer_cast<Info>(objects[index]);
+}
+
+template <class Info, class Proto>
+std::shared_ptr<Info> HDMapImpl::GetCompiledObjectById(
+    const CompiledMap::ObjectType type, const Id& id) const {
+  const int index = compiled_map_->FindObject(type, id.id());
+  return index < 0 ? nullptr : GetCompiledObject<Info, Proto>(type, index);
+}
+
+void HDMapImpl::InitCompiledObject(const int index, LaneInfo* info) const {
+  const std::string road_id = compiled_map_->LaneRoadId(index);
+  if (!road_id.empty()) {
+    info->set_road_id(CreateHDMapId(road_id));
+    info->set_section_id(CreateHDMapId(compiled_map_->LaneSectionId(index)));
+  }
+  info->PostProcess(*this);
+}
+
+bool HDMapImpl::HasObject(const CompiledMap::ObjectType type,
+                          const std::string& id) const {
+  if (compiled_map_ != nullptr) {
+    return compiled_map_->FindObject(type, id) >= 0;
+  }
+  switch (type) {
+    case CompiledMap::LANE:
+      return lane_table_.count(id) > 0;
+    case CompiledMap::JUNCTION:
+      return junction_table_.count(id) > 0;
+    case CompiledMap::SIGNAL:
+      return signal_table_.count(id) > 0;
+    case CompiledMap::CROSSWALK:
+      return crosswalk_table_.count(id) > 0;
+    case CompiledMap::STOP_SIGN:
+      return stop_sign_table_.count(id) > 0;
+    case CompiledMap::YIELD_SIGN:
+      return yield_sign_table_.count(id) > 0;
+    case CompiledMap::CLEAR_AREA:
+      return clear_area_table_.count(id) > 0;
+    case CompiledMap::SPEED_BUMP:
+      return speed_bump_table_.count(id) > 0;
+    case CompiledMap::OVERLAP:
+      return overlap_table_.count(id) > 0;
+    case CompiledMap::ROAD:
+      return road_table_.count(id) > 0;
+    default:
+      return false;
+  }
+}
+
 template <class KDTree>
 int HDMapImpl::SearchObjects(const Vec2d& center, const double radius,
                              const KDTree& kdtree,
@@ -675,6 +999,10 @@ int HDMapImpl::SearchObjects(const Vec2d& center, const double radius,
 
 void HDMapImpl::Clear() {
   map_.Clear();
+  compiled_map_.reset(nullptr);
+  for (auto& objects : compiled_objects_) {
+    objects.clear();
+  }
   lane_table_.clear();
   junction_table_.clear();
   signal_table_.clear();
@@ -17,6 +17,7 @@ limitations under the License.
 #define MODULES_MAP_HDMAP_HDMAP_IMPL_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +27,7 @@ limitations under the License.
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/polygon2d.h"
 #include "modules/common/math/vec2d.h"
+#include "modules/map/hdmap/compiled_map.h"
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/map/proto/map.pb.h"
 #include "modules/map/proto/map_crosswalk.pb.h"
@@ -74,7 +76,8 @@ class HDMapImpl {
 
  public:
   /**
-  * @brief load map from local file
+  * @brief load map from local file. A compiled map (.cmap) is mmap'd, and
+  * its objects are only built on their first access.
   * @param map_filename path of map data file
   * @return 0:success, otherwise failed
   */
@@ -184,6 +187,31 @@ class HDMapImpl {
   int GetNearestLane(const apollo::common::PointENU& point,
                      LaneInfoConstPtr* nearest_lane, double* nearest_s,
                      double* nearest_l) const;
+  /**
+   * @brief get the nearest lanes of many points at once, with the same
+   * results as GetNearestLane() point by point.
+   * @param points the target points
+   * @param nearest_lanes the nearest lane of every point
+   * @param nearest_s the offset of every point along its nearest lane
+   * @param nearest_l the lateral offset of every point from its nearest lane
+   * @return 0:success, otherwise, failed.
+   */
+  int GetNearestLanes(const std::vector<apollo::common::PointENU>& points,
+                      std::vector<LaneInfoConstPtr>* nearest_lanes,
+                      std::vector<double>* nearest_s,
+                      std::vector<double>* nearest_l) const;
+  /**
+   * @brief get all lanes in certain range of many points at once. Nearby
+   * points share one search of the map, and the distances to the segments
+   * found are computed with SIMD instructions.
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param lanes the lanes in the range of every point
+   * @return 0:success, otherwise failed
+   */
+  int GetLanes(const std::vector<apollo::common::PointENU>& points,
+               const double distance,
+               std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
   /**
    * @brief get the nearest lane within a certain range by pose
    * @param point the target position
@@ -283,11 +311,50 @@ class HDMapImpl {
                            const double radius, const KDTree& kdtree,
                            std::vector<std::string>* const results);
 
+  /**
+   * @brief searches the objects of a type in the compiled map if there is
+   * one, otherwise in kdtree.
+   */
+  template <class KDTree>
+  int SearchObjects(const CompiledMap::ObjectType type,
+                    const apollo::common::math::Vec2d& center,
+                    const double radius, const std::unique_ptr<KDTree>& kdtree,
+                    std::vector<std::string>* const results) const;
+
+  /**
+   * @brief returns the object at index of the compiled map, which is built
+   * on its first access.
+   */
+  template <class Info, class Proto>
+  std::shared_ptr<Info> GetCompiledObject(const CompiledMap::ObjectType type,
+                                          const int index) const;
+  template <class Info, class Proto>
+  std::shared_ptr<Info> GetCompiledObjectById(
+      const CompiledMap::ObjectType type, const Id& id) const;
+
+  template <class Info>
+  void InitCompiledObject(const int index, Info* info) const {}
+  void InitCompiledObject(const int index, LaneInfo* info) const;
+
+  /**
+   * @brief checks if an object exists, without building it.
+   */
+  bool HasObject(const CompiledMap::ObjectType type,
+                 const std::string& id) const;
+
   void Clear();
 
+  friend class LaneInfo;
+
  private:
   Map map_;
 
+  std::unique_ptr<CompiledMap> compiled_map_;
+  /// The objects of the compiled map built so far, by type and index.
+  mutable std::vector<std::shared_ptr<void>>
+      compiled_objects_[CompiledMap::NUM_OBJECT_TYPES];
+  mutable std::mutex compiled_objects_mutex_;
+
   LaneTable lane_table_;
   JunctionTable junction_table_;
   CrosswalkTable crosswalk_table_;
@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the lane queries of HDMapImpl point by point against the
+ * batch queries.
+ **/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+
+namespace apollo {
+namespace hdmap {
+
+namespace {
+
+const char kMapFile[] = "modules/map/hdmap/test-data/base_map.bin";
+
+const HDMapImpl& GetMap() {
+  static const HDMapImpl* hdmap = [] {
+    auto* map = new HDMapImpl();
+    CHECK_EQ(0, map->LoadMapFromFile(kMapFile));
+    return map;
+  }();
+  return *hdmap;
+}
+
+// Points around the center lines, like the obstacles of a scene. The points
+// are either all over the map, or within 50 meters of one point, like the
+// points of a lidar scan.
+std::vector<common::PointENU> QueryPoints(const int num_points,
+                                          const bool in_scene) {
+  Map map;
+  CHECK(common::util::GetProtoFromFile(kMapFile, &map));
+  std::vector<common::PointENU> lane_points;
+  for (const auto& lane : map.lane()) {
+    for (const auto& segment : lane.central_curve().segment()) {
+      for (const auto& point : segment.line_segment().point()) {
+        lane_points.push_back(point);
+      }
+    }
+  }
+  std::mt19937 random_engine(2017);
+  std::uniform_real_distribution<double> offset(-3.0, 3.0);
+  if (in_scene) {
+    const auto center = lane_points[lane_points.size() / 2];
+    const double kSceneRadius = 50.0;
+    lane_points.erase(
+        std::remove_if(lane_points.begin(), lane_points.end(),
+                       [&center, kSceneRadius](const common::PointENU& point) {
+                         return std::hypot(point.x() - center.x(),
+                                           point.y() - center.y()) >
+                                kSceneRadius;
+                       }),
+        lane_points.end());
+  }
+  std::uniform_int_distribution<size_t> index(0, lane_points.size() - 1);
+  std::vector<common::PointENU> points;
+  for (int i = 0; i < num_points; ++i) {
+    common::PointENU point = lane_points[index(random_engine)];
+    point.set_x(point.x() + offset(random_engine));
+    point.set_y(point.y() + offset(random_engine));
+    points.push_back(point);
+  }
+  return points;
+}
+
+void QueryArgs(benchmark::internal::Benchmark* benchmark) {
+  for (const int in_scene : {0, 1}) {
+    for (const int num_points : {1000, 10000}) {
+      benchmark->Args({num_points, in_scene});
+    }
+  }
+}
+
+}  // namespace
+
+// Args: {number of points, 1 if the points are in one scene}.
+void BM_GetNearestLane(benchmark::State& state) {
+  const auto& hdmap = GetMap();
+  const auto points = QueryPoints(state.range(0), state.range(1));
+  while (state.KeepRunning()) {
+    for (const auto& point : points) {
+      LaneInfoConstPtr lane;
+      double s = 0.0;
+      double l = 0.0;
+      CHECK_EQ(0, hdmap.GetNearestLane(point, &lane, &s, &l));
+      benchmark::DoNotOptimize(lane);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_GetNearestLane)->Apply(QueryArgs);
+
+// Args: {number of points, 1 if the points are in one scene}.
+void BM_GetNearestLanes(benchmark::State& state) {
+  const auto& hdmap = GetMap();
+  const auto points = QueryPoints(state.range(0), state.range(1));
+  while (state.KeepRunning()) {
+    std::vector<LaneInfoConstPtr> lanes;
+    std::vector<double> s;
+    std::vector<double> l;
+    CHECK_EQ(0, hdmap.GetNearestLanes(points, &lanes, &s, &l));
+    benchmark::DoNotOptimize(lanes);
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_GetNearestLanes)->Apply(QueryArgs);
+
+// Args: {number of points, 1 if the points are in one scene}.
+void BM_GetLanes(benchmark::State& state) {
+  const auto& hdmap = GetMap();
+  const auto points = QueryPoints(state.range(0), state.range(1));
+  const double kDistance = 3.0;
+  while (state.KeepRunning()) {
+    for (const auto& point : points) {
+      std::vector<LaneInfoConstPtr> lanes;
+      CHECK_EQ(0, hdmap.GetLanes(point, kDistance, &lanes));
+      benchmark::DoNotOptimize(lanes);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_GetLanes)->Apply(QueryArgs);
+
+// Args: {number of points, 1 if the points are in one scene}.
+void BM_GetLanesOfPoints(benchmark::State& state) {
+  const auto& hdmap = GetMap();
+  const auto points = QueryPoints(state.range(0), state.range(1));
+  const double kDistance = 3.0;
+  while (state.KeepRunning()) {
+    std::vector<std::vector<LaneInfoConstPtr>> lanes;
+    CHECK_EQ(0, hdmap.GetLanes(points, kDistance, &lanes));
+    benchmark::DoNotOptimize(lanes);
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_GetLanesOfPoints)->Apply(QueryArgs);
+
+}  // namespace hdmap
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -14,6 +14,8 @@ limitations under the License.
 =========================================================================*/
 
 #include <algorithm>
+#include <random>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -24,6 +26,19 @@ namespace {
 
 constexpr char kMapFilename[] = "modules/map/hdmap/test-data/base_map.bin";
 
+std::vector<apollo::common::PointENU> RandomPoints(const int num_points) {
+  std::mt19937 random_engine(2017);
+  std::uniform_real_distribution<double> offset(-150.0, 150.0);
+  std::vector<apollo::common::PointENU> points;
+  for (int i = 0; i < num_points; ++i) {
+    apollo::common::PointENU point;
+    point.set_x(586424.09 + offset(random_engine));
+    point.set_y(4140727.02 + offset(random_engine));
+    points.push_back(point);
+  }
+  return points;
+}
+
 }  // namespace
 
 namespace apollo {
@@ -349,5 +364,46 @@ TEST_F(HDMapImplTestSuite, GetRoadBoundaries) {
   EXPECT_EQ(1, junctions.size());
 }
 
+TEST_F(HDMapImplTestSuite, GetNearestLanes) {
+  const auto points = RandomPoints(500);
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<double> s;
+  std::vector<double> l;
+  EXPECT_EQ(0, hdmap_impl_.GetNearestLanes(points, &lanes, &s, &l));
+  ASSERT_EQ(points.size(), lanes.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    LaneInfoConstPtr expected_lane;
+    double expected_s = 0.0;
+    double expected_l = 0.0;
+    EXPECT_EQ(0, hdmap_impl_.GetNearestLane(points[i], &expected_lane,
+                                            &expected_s, &expected_l));
+    ASSERT_TRUE(lanes[i] != nullptr);
+    // Connected lanes and segments share their end points, so the nearest
+    // segment is only unique up to a tie in the distance, and so is l.
+    const common::math::Vec2d point(points[i].x(), points[i].y());
+    EXPECT_NEAR(expected_lane->DistanceTo(point), lanes[i]->DistanceTo(point),
+                1e-6);
+    if (expected_lane == lanes[i]) {
+      EXPECT_NEAR(expected_s, s[i], 1e-6);
+    }
+  }
+}
+
+TEST_F(HDMapImplTestSuite, GetLanesOfPoints) {
+  const auto points = RandomPoints(500);
+  for (const double distance : {1.0, 5.0}) {
+    std::vector<std::vector<LaneInfoConstPtr>> lanes;
+    EXPECT_EQ(0, hdmap_impl_.GetLanes(points, distance, &lanes));
+    ASSERT_EQ(points.size(), lanes.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      std::vector<LaneInfoConstPtr> expected_lanes;
+      EXPECT_EQ(0, hdmap_impl_.GetLanes(points[i], distance, &expected_lanes));
+      EXPECT_EQ(std::set<LaneInfoConstPtr>(expected_lanes.begin(),
+                                           expected_lanes.end()),
+                std::set<LaneInfoConstPtr>(lanes[i].begin(), lanes[i].end()));
+    }
+  }
+}
+
 }  // namespace hdmap
 }  // namespace apollo
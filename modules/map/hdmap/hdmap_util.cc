@@ -66,12 +66,14 @@ std::unique_ptr<HDMap> CreateMap(const std::string& map_file_path) {
 
 std::unique_ptr<HDMap> HDMapUtil::base_map_ = nullptr;
 std::mutex HDMapUtil::base_map_mutex_;
+std::atomic<uint64_t> HDMapUtil::base_map_version_(0);
 
 const HDMap* HDMapUtil::BaseMapPtr() {
   if (base_map_ == nullptr) {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
     if (base_map_ == nullptr) {  // Double check.
       base_map_ = CreateMap(BaseMapFile());
+      ++base_map_version_;
     }
   }
   return base_map_.get();
@@ -84,8 +86,11 @@ const HDMap& HDMapUtil::BaseMap() {
 bool HDMapUtil::ReloadBaseMap() {
   std::lock_guard<std::mutex> lock(base_map_mutex_);
   base_map_ = CreateMap(BaseMapFile());
+  ++base_map_version_;
   return base_map_ != nullptr;
 }
 
+uint64_t HDMapUtil::BaseMapVersion() { return base_map_version_; }
+
 }  // namespace hdmap
 }  // namespace apollo
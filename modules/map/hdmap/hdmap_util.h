@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef MODULES_MAP_HDMAP_HDMAP_UTIL_H_
 #define MODULES_MAP_HDMAP_HDMAP_UTIL_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -84,11 +86,16 @@ class HDMapUtil {
   // Reload the base map from the file specified by global flags.
   static bool ReloadBaseMap();
 
+  // The number of times the base map has been loaded, so that the caches of
+  // base map objects can tell when they are stale.
+  static uint64_t BaseMapVersion();
+
  private:
   HDMapUtil() = delete;
 
   static std::unique_ptr<HDMap> base_map_;
   static std::mutex base_map_mutex_;
+  static std::atomic<uint64_t> base_map_version_;
 };
 
 }  // namespace hdmap
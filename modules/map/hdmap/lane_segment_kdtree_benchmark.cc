@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks building and querying the lane segment KD-tree of the
+ * demo maps with AABoxKDTree2d and FlatAABoxKDTree2d.
+ **/
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/log.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/flat_aaboxkdtree2d.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/hdmap_common.h"
+#include "modules/map/proto/map.pb.h"
+
+namespace apollo {
+namespace hdmap {
+
+namespace {
+
+using apollo::common::math::AABox2d;
+using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::FlatAABoxKDTree2d;
+using apollo::common::math::Vec2d;
+
+const char* const kMapFiles[] = {
+    "modules/map/data/demo/base_map.txt",
+    "modules/map/data/demo/sim_map.txt",
+    "modules/map/hdmap/test-data/base_map.bin",
+};
+
+using FlatLaneSegmentKDTree = FlatAABoxKDTree2d<LaneSegmentBox>;
+
+/**
+ * @class LaneSegments
+ * @brief The lane segment boxes of a map, as HDMapImpl builds them, and query
+ * points scattered around the lanes.
+ */
+class LaneSegments {
+ public:
+  explicit LaneSegments(const char* map_file) {
+    Map map;
+    CHECK(common::util::GetProtoFromFile(map_file, &map)) << map_file;
+    for (const auto& lane : map.lane()) {
+      lanes_.emplace_back(new LaneInfo(lane));
+    }
+    for (const auto& lane : lanes_) {
+      for (size_t id = 0; id < lane->segments().size(); ++id) {
+        const auto& segment = lane->segments()[id];
+        boxes_.emplace_back(AABox2d(segment.start(), segment.end()),
+                            lane.get(), &segment, id);
+      }
+    }
+
+    std::mt19937 random_engine(2017);
+    std::uniform_int_distribution<size_t> box_index(0, boxes_.size() - 1);
+    std::uniform_real_distribution<double> offset(-5.0, 5.0);
+    const int kNumPoints = 1000;
+    for (int i = 0; i < kNumPoints; ++i) {
+      const auto& segment = *boxes_[box_index(random_engine)].geo_object();
+      points_.emplace_back(segment.start().x() + offset(random_engine),
+                           segment.start().y() + offset(random_engine));
+    }
+  }
+
+  static AABoxKDTreeParams Params() {
+    // The parameters of HDMapImpl::BuildLaneSegmentKDTree().
+    AABoxKDTreeParams params;
+    params.max_leaf_dimension = 5.0;  // meters.
+    params.max_leaf_size = 16;
+    return params;
+  }
+
+  const std::vector<LaneSegmentBox>& boxes() const { return boxes_; }
+  const std::vector<Vec2d>& points() const { return points_; }
+
+ private:
+  std::vector<std::unique_ptr<LaneInfo>> lanes_;
+  std::vector<LaneSegmentBox> boxes_;
+  std::vector<Vec2d> points_;
+};
+
+const LaneSegments& GetLaneSegments(const int map_index) {
+  static std::vector<std::unique_ptr<LaneSegments>> lane_segments(
+      sizeof(kMapFiles) / sizeof(kMapFiles[0]));
+  auto& segments = lane_segments[map_index];
+  if (segments == nullptr) {
+    segments.reset(new LaneSegments(kMapFiles[map_index]));
+  }
+  return *segments;
+}
+
+void MapArgs(benchmark::internal::Benchmark* benchmark) {
+  for (size_t i = 0; i < sizeof(kMapFiles) / sizeof(kMapFiles[0]); ++i) {
+    benchmark->Arg(i);
+  }
+}
+
+}  // namespace
+
+// Arg: the index of the map in kMapFiles.
+template <class KDTree>
+void BM_Build(benchmark::State& state) {
+  const auto& segments = GetLaneSegments(state.range(0));
+  while (state.KeepRunning()) {
+    KDTree kdtree(segments.boxes(), LaneSegments::Params());
+    benchmark::DoNotOptimize(kdtree);
+  }
+  state.SetItemsProcessed(state.iterations() * segments.boxes().size());
+}
+BENCHMARK_TEMPLATE(BM_Build, LaneSegmentKDTree)->Apply(MapArgs);
+BENCHMARK_TEMPLATE(BM_Build, FlatLaneSegmentKDTree)->Apply(MapArgs);
+
+// Arg: the index of the map in kMapFiles.
+template <class KDTree>
+void BM_GetNearestObject(benchmark::State& state) {
+  const auto& segments = GetLaneSegments(state.range(0));
+  const KDTree kdtree(segments.boxes(), LaneSegments::Params());
+  while (state.KeepRunning()) {
+    for (const auto& point : segments.points()) {
+      benchmark::DoNotOptimize(kdtree.GetNearestObject(point));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * segments.points().size());
+}
+BENCHMARK_TEMPLATE(BM_GetNearestObject, LaneSegmentKDTree)->Apply(MapArgs);
+BENCHMARK_TEMPLATE(BM_GetNearestObject, FlatLaneSegmentKDTree)
+    ->Apply(MapArgs);
+
+// Arg: the index of the map in kMapFiles.
+template <class KDTree>
+void BM_GetObjects(benchmark::State& state) {
+  const auto& segments = GetLaneSegments(state.range(0));
+  const KDTree kdtree(segments.boxes(), LaneSegments::Params());
+  const double kDistance = 10.0;
+  while (state.KeepRunning()) {
+    for (const auto& point : segments.points()) {
+      benchmark::DoNotOptimize(kdtree.GetObjects(point, kDistance));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * segments.points().size());
+}
+BENCHMARK_TEMPLATE(BM_GetObjects, LaneSegmentKDTree)->Apply(MapArgs);
+BENCHMARK_TEMPLATE(BM_GetObjects, FlatLaneSegmentKDTree)->Apply(MapArgs);
+
+}  // namespace hdmap
+}  // namespace apollo
+
+BENCHMARK_MAIN();
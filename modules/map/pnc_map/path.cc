@@ -21,6 +21,8 @@
 #include <limits>
 #include <unordered_map>
 
+#include "Eigen/Core"
+
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/polygon2d.h"
@@ -42,6 +44,11 @@ namespace {
 
 const double kSampleDistance = 0.25;
 
+// The number of segments of a block of Path::GetProjections(), and the buffer
+// of its block bounds which covers the rounding errors of the distances.
+const int kProjectionBlockSize = 16;
+const double kProjectionBuffer = 1e-6;
+
 bool find_lane_segment(const MapPathPoint& p1, const MapPathPoint& p2,
                        LaneSegment* const lane_segment) {
   for (const auto& wp1 : p1.lane_waypoints()) {
@@ -55,6 +62,21 @@ bool find_lane_segment(const MapPathPoint& p1, const MapPathPoint& p2,
   return false;
 }
 
+bool SamePathPoint(const MapPathPoint& p1, const MapPathPoint& p2) {
+  if (p1.x() != p2.x() || p1.y() != p2.y() || p1.heading() != p2.heading() ||
+      p1.lane_waypoints().size() != p2.lane_waypoints().size()) {
+    return false;
+  }
+  for (size_t i = 0; i < p1.lane_waypoints().size(); ++i) {
+    const auto& wp1 = p1.lane_waypoints()[i];
+    const auto& wp2 = p2.lane_waypoints()[i];
+    if (wp1.lane != wp2.lane || wp1.s != wp2.s) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 std::string LaneWaypoint::DebugString() const {
@@ -105,14 +127,14 @@ std::string PathOverlap::DebugString() const {
 
 Path::Path(std::vector<MapPathPoint> path_points)
     : path_points_(std::move(path_points)) {
-  Init();
+  Init(nullptr);
 }
 
 Path::Path(std::vector<MapPathPoint> path_points,
            std::vector<LaneSegment> lane_segments)
     : path_points_(std::move(path_points)),
       lane_segments_(std::move(lane_segments)) {
-  Init();
+  Init(nullptr);
 }
 
 Path::Path(std::vector<MapPathPoint> path_points,
@@ -120,25 +142,61 @@ Path::Path(std::vector<MapPathPoint> path_points,
            const double max_approximation_error)
     : path_points_(std::move(path_points)),
       lane_segments_(std::move(lane_segments)) {
-  Init();
+  Init(nullptr);
+  if (max_approximation_error > 0.0) {
+    use_path_approximation_ = true;
+    approximation_ = PathApproximation(*this, max_approximation_error);
+  }
+}
+
+Path::Path(std::vector<MapPathPoint> path_points,
+           std::vector<LaneSegment> lane_segments,
+           const double max_approximation_error, const Path& base)
+    : path_points_(std::move(path_points)),
+      lane_segments_(std::move(lane_segments)) {
+  Init(&base);
   if (max_approximation_error > 0.0) {
     use_path_approximation_ = true;
     approximation_ = PathApproximation(*this, max_approximation_error);
   }
 }
 
-void Path::Init() {
-  InitPoints();
-  InitLaneSegments();
+void Path::Init(const Path* base) {
+  num_points_ = static_cast<int>(path_points_.size());
+  CHECK_GE(num_points_, 2);
+  const std::vector<int> base_segment_ids =
+      base == nullptr ? std::vector<int>(num_points_ - 1, -1)
+                      : MatchSegments(*base);
+  InitPoints(base, base_segment_ids);
+  InitLaneSegments(base, base_segment_ids);
   InitPointIndex();
   InitWidth();
   InitOverlaps();
+  InitProjectionBlocks();
 }
 
-void Path::InitPoints() {
-  num_points_ = static_cast<int>(path_points_.size());
-  CHECK_GE(num_points_, 2);
+std::vector<int> Path::MatchSegments(const Path& base) const {
+  std::vector<int> base_segment_ids(num_points_ - 1, -1);
+  // The first points of this path may be new, e.g. when its first lane
+  // segment starts later along the lane than in base.
+  const int kMaxNewPoints = 3;
+  for (int i = 0; i < std::min(kMaxNewPoints, num_points_ - 1); ++i) {
+    for (int k = 0; k + 1 < base.num_points_; ++k) {
+      if (!SamePathPoint(path_points_[i], base.path_points_[k])) {
+        continue;
+      }
+      while (i + 1 < num_points_ && k + 1 < base.num_points_ &&
+             SamePathPoint(path_points_[i + 1], base.path_points_[k + 1])) {
+        base_segment_ids[i++] = k++;
+      }
+      return base_segment_ids;
+    }
+  }
+  return base_segment_ids;
+}
 
+void Path::InitPoints(const Path* base,
+                      const std::vector<int>& base_segment_ids) {
   accumulated_s_.clear();
   accumulated_s_.reserve(num_points_);
   segments_.clear();
@@ -151,6 +209,14 @@ void Path::InitPoints() {
     Vec2d heading;
     if (i + 1 >= num_points_) {
       heading = path_points_[i] - path_points_[i - 1];
+    } else if (base_segment_ids[i] >= 0) {
+      // The segment and the direction only depend on the two points, so they
+      // are the same as in base.
+      const int base_id = base_segment_ids[i];
+      segments_.push_back(base->segments_[base_id]);
+      s += segments_.back().length();
+      unit_directions_.push_back(base->unit_directions_[base_id]);
+      continue;
     } else {
       segments_.emplace_back(path_points_[i], path_points_[i + 1]);
       heading = path_points_[i + 1] - path_points_[i];
@@ -171,30 +237,32 @@ void Path::InitPoints() {
   CHECK_EQ(segments_.size(), num_segments_);
 }
 
-void Path::InitLaneSegments() {
-  if (lane_segments_.empty()) {
-    lane_segments_.reserve(num_points_);
-    for (int i = 0; i + 1 < num_points_; ++i) {
-      LaneSegment lane_segment;
-      if (find_lane_segment(path_points_[i], path_points_[i + 1],
-                            &lane_segment)) {
-        lane_segments_.push_back(lane_segment);
-      }
-    }
-  }
-
+void Path::InitLaneSegments(const Path* base,
+                            const std::vector<int>& base_segment_ids) {
   lane_segments_to_next_point_.clear();
   lane_segments_to_next_point_.reserve(num_points_);
   for (int i = 0; i + 1 < num_points_; ++i) {
     LaneSegment lane_segment;
-    if (find_lane_segment(path_points_[i], path_points_[i + 1],
-                          &lane_segment)) {
+    if (base_segment_ids[i] >= 0) {
+      lane_segments_to_next_point_.push_back(
+          base->lane_segments_to_next_point_[base_segment_ids[i]]);
+    } else if (find_lane_segment(path_points_[i], path_points_[i + 1],
+                                 &lane_segment)) {
       lane_segments_to_next_point_.push_back(lane_segment);
     } else {
       lane_segments_to_next_point_.push_back(LaneSegment());
     }
   }
   CHECK_EQ(lane_segments_to_next_point_.size(), num_segments_);
+
+  if (lane_segments_.empty()) {
+    lane_segments_.reserve(num_points_);
+    for (const auto& lane_segment : lane_segments_to_next_point_) {
+      if (lane_segment.lane != nullptr) {
+        lane_segments_.push_back(lane_segment);
+      }
+    }
+  }
 }
 
 void Path::InitWidth() {
@@ -205,14 +273,25 @@ void Path::InitWidth() {
 
   double s = 0;
   for (int i = 0; i < num_sample_points_; ++i) {
-    const MapPathPoint point = GetSmoothPoint(s);
-    if (point.lane_waypoints().empty()) {
+    // The first lane waypoint of GetSmoothPoint(s), without building the
+    // point.
+    const InterpolatedIndex index = GetIndexFromS(s);
+    const MapPathPoint& ref_point = path_points_[index.id];
+    LaneWaypoint waypoint;
+    if (std::abs(index.offset) > kMathEpsilon && index.id < num_segments_ &&
+        lane_segments_to_next_point_[index.id].lane != nullptr) {
+      const LaneSegment& lane_segment = lane_segments_to_next_point_[index.id];
+      waypoint = LaneWaypoint(lane_segment.lane,
+                              lane_segment.start_s + index.offset);
+    } else if (!ref_point.lane_waypoints().empty()) {
+      waypoint = ref_point.lane_waypoints()[0];
+    }
+    if (waypoint.lane == nullptr) {
       left_width_.push_back(0.0);
       right_width_.push_back(0.0);
-      AERROR << "path point:" << point.DebugString() << " has invalid width.";
+      AERROR << "path point:" << GetSmoothPoint(index).DebugString()
+             << " has invalid width.";
     } else {
-      const LaneWaypoint waypoint = point.lane_waypoints()[0];
-      CHECK_NOTNULL(waypoint.lane);
       double left_width = 0.0;
       double right_width = 0.0;
       waypoint.lane->GetWidth(waypoint.s, &left_width, &right_width);
@@ -429,34 +508,141 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
   *min_distance = std::numeric_limits<double>::infinity();
 
   for (int i = 0; i < num_segments_; ++i) {
-    const auto& segment = segments_[i];
-    const double distance = segment.DistanceTo(point);
-    if (distance < *min_distance) {
-      const double proj = segment.ProjectOntoUnit(point);
-      if (proj < 0.0 && i > 0) {
-        continue;
+    const double distance = segments_[i].DistanceTo(point);
+    if (distance < *min_distance &&
+        ProjectOntoSegment(i, point, distance, accumulate_s, lateral)) {
+      *min_distance = distance;
+    }
+  }
+  return true;
+}
+
+bool Path::ProjectOntoSegment(const int i, const Vec2d& point,
+                              const double distance, double* accumulate_s,
+                              double* lateral) const {
+  const auto& segment = segments_[i];
+  const double proj = segment.ProjectOntoUnit(point);
+  if (proj < 0.0 && i > 0) {
+    return false;
+  }
+  if (proj > segment.length() && i + 1 < num_segments_) {
+    const auto& next_segment = segments_[i + 1];
+    if ((point - next_segment.start())
+            .InnerProd(next_segment.unit_direction()) >= 0.0) {
+      return false;
+    }
+  }
+  if (i + 1 >= num_segments_) {
+    *accumulate_s = accumulated_s_[i] + proj;
+  } else {
+    *accumulate_s = accumulated_s_[i] + std::min(proj, segment.length());
+  }
+  const double prod = segment.ProductOntoUnit(point);
+  if ((i == 0 && proj < 0.0) ||
+      (i + 1 == num_segments_ && proj > segment.length())) {
+    *lateral = prod;
+  } else {
+    *lateral = (prod > 0.0 ? distance : -distance);
+  }
+  return true;
+}
+
+void Path::InitProjectionBlocks() {
+  const int num_blocks =
+      (num_segments_ + kProjectionBlockSize - 1) / kProjectionBlockSize;
+  block_min_x_.resize(num_blocks);
+  block_max_x_.resize(num_blocks);
+  block_min_y_.resize(num_blocks);
+  block_max_y_.resize(num_blocks);
+  for (int block = 0; block < num_blocks; ++block) {
+    const int begin = block * kProjectionBlockSize;
+    const int end = std::min(begin + kProjectionBlockSize, num_segments_);
+    block_min_x_[block] = block_max_x_[block] = path_points_[begin].x();
+    block_min_y_[block] = block_max_y_[block] = path_points_[begin].y();
+    for (int i = begin + 1; i <= end; ++i) {
+      block_min_x_[block] = std::min(block_min_x_[block], path_points_[i].x());
+      block_max_x_[block] = std::max(block_max_x_[block], path_points_[i].x());
+      block_min_y_[block] = std::min(block_min_y_[block], path_points_[i].y());
+      block_max_y_[block] = std::max(block_max_y_[block], path_points_[i].y());
+    }
+  }
+}
+
+bool Path::GetProjections(const std::vector<Vec2d>& points,
+                          std::vector<double>* accumulate_s,
+                          std::vector<double>* lateral) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (accumulate_s == nullptr || lateral == nullptr) {
+    return false;
+  }
+  accumulate_s->resize(points.size());
+  lateral->resize(points.size());
+  if (use_path_approximation_) {
+    for (size_t k = 0; k < points.size(); ++k) {
+      if (!GetProjection(points[k], &(*accumulate_s)[k], &(*lateral)[k])) {
+        return false;
       }
-      if (proj > segment.length() && i + 1 < num_segments_) {
-        const auto& next_segment = segments_[i + 1];
-        if ((point - next_segment.start())
-                .InnerProd(next_segment.unit_direction()) >= 0.0) {
-          continue;
+    }
+    return true;
+  }
+
+  const int num_blocks = static_cast<int>(block_min_x_.size());
+  const Eigen::Map<const Eigen::ArrayXd> block_min_x(block_min_x_.data(),
+                                                     num_blocks);
+  const Eigen::Map<const Eigen::ArrayXd> block_max_x(block_max_x_.data(),
+                                                     num_blocks);
+  const Eigen::Map<const Eigen::ArrayXd> block_min_y(block_min_y_.data(),
+                                                     num_blocks);
+  const Eigen::Map<const Eigen::ArrayXd> block_max_y(block_max_y_.data(),
+                                                     num_blocks);
+  int cursor_block = 0;
+  for (size_t k = 0; k < points.size(); ++k) {
+    const Vec2d& point = points[k];
+    double min_distance = std::numeric_limits<double>::infinity();
+    int min_segment = -1;
+    const auto search_block = [&](const int block) {
+      const int begin = block * kProjectionBlockSize;
+      const int end = std::min(begin + kProjectionBlockSize, num_segments_);
+      for (int i = begin; i < end; ++i) {
+        const double distance = segments_[i].DistanceTo(point);
+        // The first of the nearest segments, as GetProjection() finds it.
+        if ((distance < min_distance ||
+             (distance == min_distance && i < min_segment)) &&
+            ProjectOntoSegment(i, point, distance, &(*accumulate_s)[k],
+                               &(*lateral)[k])) {
+          min_distance = distance;
+          min_segment = i;
         }
       }
-      *min_distance = distance;
-      if (i + 1 >= num_segments_) {
-        *accumulate_s = accumulated_s_[i] + proj;
-      } else {
-        *accumulate_s = accumulated_s_[i] + std::min(proj, segment.length());
+    };
+    // Lower bounds of the distances to the blocks.
+    const Eigen::ArrayXd dx = (block_min_x - point.x())
+                                  .max(point.x() - block_max_x)
+                                  .max(0.0);
+    const Eigen::ArrayXd dy = (block_min_y - point.y())
+                                  .max(point.y() - block_max_y)
+                                  .max(0.0);
+    const Eigen::ArrayXd block_distance = (dx.square() + dy.square()).sqrt();
+    if (k == 0) {
+      block_distance.minCoeff(&cursor_block);
+    }
+    search_block(cursor_block);
+    for (int block = 0; block < num_blocks; ++block) {
+      if (block != cursor_block &&
+          block_distance[block] <= min_distance + kProjectionBuffer) {
+        search_block(block);
       }
-      const double prod = segment.ProductOntoUnit(point);
-      if ((i == 0 && proj < 0.0) ||
-          (i + 1 == num_segments_ && proj > segment.length())) {
-        *lateral = prod;
-      } else {
-        *lateral = (prod > 0.0 ? distance : -distance);
+    }
+    if (min_segment < 0) {
+      // No segment takes the point, as GetProjection() would leave it.
+      if (!GetProjection(point, &(*accumulate_s)[k], &(*lateral)[k])) {
+        return false;
       }
+      continue;
     }
+    cursor_block = min_segment / kProjectionBlockSize;
   }
   return true;
 }
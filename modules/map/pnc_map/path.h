@@ -187,6 +187,14 @@ class Path {
        std::vector<LaneSegment> lane_segments,
        const double max_approximation_error);
 
+  // Creates the same path as the constructor above, reusing the segments of
+  // base between the points the two paths share. When a path moves forward
+  // along its lanes, only the points passed at the start and the new points
+  // at the end are different.
+  Path(std::vector<MapPathPoint> path_points,
+       std::vector<LaneSegment> lane_segments,
+       const double max_approximation_error, const Path& base);
+
   // Return smooth coordinate by interpolated index or accumulate_s.
   MapPathPoint GetSmoothPoint(const InterpolatedIndex& index) const;
   MapPathPoint GetSmoothPoint(double s) const;
@@ -204,6 +212,14 @@ class Path {
                      double* lateral) const;
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral, double* distance) const;
+  // Projects the points with the same results as GetProjection() point by
+  // point. The search of a point starts around the projection of the previous
+  // point, and skips the blocks of segments which are farther than the best
+  // projection found so far, so points ordered along the path, like the
+  // points of a trajectory or the corners of a box, are the fastest.
+  bool GetProjections(const std::vector<common::math::Vec2d>& points,
+                      std::vector<double>* accumulate_s,
+                      std::vector<double>* lateral) const;
 
   bool GetHeadingAlongPath(const common::math::Vec2d& point,
                            double* heading) const;
@@ -265,15 +281,27 @@ class Path {
   std::string DebugString() const;
 
  protected:
-  void Init();
-  void InitPoints();
-  void InitLaneSegments();
+  void Init(const Path* base);
+  // The index of every segment of this path in base, or -1 if base does not
+  // have it.
+  std::vector<int> MatchSegments(const Path& base) const;
+  void InitPoints(const Path* base, const std::vector<int>& base_segment_ids);
+  void InitLaneSegments(const Path* base,
+                        const std::vector<int>& base_segment_ids);
   void InitWidth();
   void InitPointIndex();
   void InitOverlaps();
+  void InitProjectionBlocks();
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
+  // Projects point onto segment i, where its distance to the segment is
+  // distance. Returns false if the point projects beyond the segment onto the
+  // segment before or after, which GetProjection() skips.
+  bool ProjectOntoSegment(const int i, const common::math::Vec2d& point,
+                          const double distance, double* accumulate_s,
+                          double* lateral) const;
+
   using GetOverlapFromLaneFunc =
       std::function<const std::vector<OverlapInfoConstPtr>&(const LaneInfo&)>;
   void GetAllOverlaps(GetOverlapFromLaneFunc get_overlaps_from_lane,
@@ -292,6 +320,13 @@ class Path {
   bool use_path_approximation_ = false;
   PathApproximation approximation_;
 
+  // The bounding boxes of the blocks of consecutive segments searched by
+  // GetProjections().
+  std::vector<double> block_min_x_;
+  std::vector<double> block_max_x_;
+  std::vector<double> block_min_y_;
+  std::vector<double> block_max_y_;
+
   // Sampled every fixed length.
   int num_sample_points_ = 0;
   std::vector<double> left_width_;
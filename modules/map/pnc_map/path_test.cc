@@ -745,6 +745,76 @@ TEST(TestSuite, compute_lane_segments_from_points) {
   EXPECT_NEAR(path.lane_segments()[1].end_s, 0.4, 1e-6);
 }
 
+TEST(TestSuite, path_from_base) {
+  Lane lane;
+  lane.mutable_id()->set_id("id");
+  auto* segment =
+      lane.mutable_central_curve()->add_segment()->mutable_line_segment();
+  const int kNumLanePoints = 20;
+  for (int i = 0; i < kNumLanePoints; ++i) {
+    *segment->add_point() = MakePoint(i, 0.01 * i * i, 0);
+  }
+  *lane.add_left_sample() = MakeSample(0.0, 1.5);
+  *lane.add_left_sample() = MakeSample(30.0, 2.0);
+  *lane.add_right_sample() = MakeSample(0.0, 2.0);
+  *lane.add_right_sample() = MakeSample(30.0, 1.5);
+  LaneInfoConstPtr lane_info(new LaneInfo(lane));
+
+  const auto points_of = [&lane_info](const int begin, const int end) {
+    std::vector<MapPathPoint> points;
+    for (int i = begin; i < end; ++i) {
+      points.emplace_back(
+          lane_info->points()[i], lane_info->headings()[i],
+          LaneWaypoint(lane_info, lane_info->accumulate_s()[i]));
+    }
+    return points;
+  };
+  const auto segments_of = [&lane_info](const int begin, const int end) {
+    return std::vector<LaneSegment>{
+        LaneSegment(lane_info, lane_info->accumulate_s()[begin],
+                    lane_info->accumulate_s()[end - 1])};
+  };
+
+  const Path base(points_of(0, 12), segments_of(0, 12), 2.0);
+  const Path expected(points_of(5, 18), segments_of(5, 18), 2.0);
+  const Path path(points_of(5, 18), segments_of(5, 18), 2.0, base);
+  ASSERT_EQ(expected.num_points(), path.num_points());
+  ASSERT_EQ(expected.num_segments(), path.num_segments());
+  EXPECT_DOUBLE_EQ(expected.length(), path.length());
+  for (int i = 0; i < path.num_points(); ++i) {
+    EXPECT_EQ(expected.accumulated_s()[i], path.accumulated_s()[i]);
+    EXPECT_EQ(expected.unit_directions()[i].x(),
+              path.unit_directions()[i].x());
+    EXPECT_EQ(expected.unit_directions()[i].y(),
+              path.unit_directions()[i].y());
+  }
+  for (int i = 0; i < path.num_segments(); ++i) {
+    EXPECT_EQ(expected.segments()[i].length(), path.segments()[i].length());
+    EXPECT_EQ(expected.lane_segments_to_next_point()[i].lane,
+              path.lane_segments_to_next_point()[i].lane);
+    EXPECT_EQ(expected.lane_segments_to_next_point()[i].start_s,
+              path.lane_segments_to_next_point()[i].start_s);
+  }
+  ASSERT_EQ(expected.lane_segments().size(), path.lane_segments().size());
+  for (double s = 0.0; s < path.length(); s += 0.5) {
+    double expected_left_width = 0.0;
+    double expected_right_width = 0.0;
+    double left_width = 0.0;
+    double right_width = 0.0;
+    EXPECT_TRUE(
+        expected.GetWidth(s, &expected_left_width, &expected_right_width));
+    EXPECT_TRUE(path.GetWidth(s, &left_width, &right_width));
+    EXPECT_DOUBLE_EQ(expected_left_width, left_width);
+    EXPECT_DOUBLE_EQ(expected_right_width, right_width);
+  }
+
+  // No shared points.
+  const Path other(points_of(14, 20), segments_of(14, 20), 2.0, base);
+  const Path expected_other(points_of(14, 20), segments_of(14, 20), 2.0);
+  ASSERT_EQ(expected_other.num_points(), other.num_points());
+  EXPECT_DOUBLE_EQ(expected_other.length(), other.length());
+}
+
 TEST(TestSuite, lane_info) {
   Lane lane;
   lane.mutable_id()->set_id("test-id");
@@ -52,6 +52,10 @@ const double kDuplicatedPointsEpsilon = 1e-7;
 // Maximum lateral error used in trajectory approximation.
 const double kTrajectoryApproximationMaxError = 2.0;
 
+// Maximum number of paths cached by PncMap::CreatePath(), which covers the
+// passages of a lane change.
+const size_t kPathCacheSize = 4;
+
 void RemoveDuplicates(std::vector<common::math::Vec2d> *points) {
   CHECK_NOTNULL(points);
   int count = 0;
@@ -95,6 +99,35 @@ void RemoveDuplicates(std::vector<MapPathPoint> *points) {
   points->resize(count);
 }
 
+bool SameLaneSegments(const std::vector<LaneSegment> &segments1,
+                      const std::vector<LaneSegment> &segments2) {
+  if (segments1.size() != segments2.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < segments1.size(); ++i) {
+    if (segments1[i].lane != segments2[i].lane ||
+        segments1[i].start_s != segments2[i].start_s ||
+        segments1[i].end_s != segments2[i].end_s) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int NumSharedLanes(const std::vector<LaneSegment> &segments1,
+                   const std::vector<LaneSegment> &segments2) {
+  int num_shared_lanes = 0;
+  for (const auto &segment1 : segments1) {
+    for (const auto &segment2 : segments2) {
+      if (segment1.lane == segment2.lane) {
+        ++num_shared_lanes;
+        break;
+      }
+    }
+  }
+  return num_shared_lanes;
+}
+
 }  // namespace
 
 bool RouteSegments::GetProjection(const common::PointENU &point_enu, double *s,
@@ -567,23 +600,70 @@ void PncMap::AppendLaneToPoints(LaneInfoConstPtr lane, const double start_s,
   }
 }
 
-bool PncMap::CreatePathFromLaneSegments(const RouteSegments &segments,
-                                        Path *const path) {
-  std::vector<MapPathPoint> points;
+bool PncMap::CreatePathPoints(const RouteSegments &segments,
+                              std::vector<MapPathPoint> *const points) {
+  CHECK_NOTNULL(points);
+  points->clear();
   for (const auto &segment : segments) {
-    AppendLaneToPoints(segment.lane, segment.start_s, segment.end_s, &points);
+    AppendLaneToPoints(segment.lane, segment.start_s, segment.end_s, points);
   }
-  RemoveDuplicates(&points);
+  RemoveDuplicates(points);
 
-  if (points.size() < 2) {
-    AWARN << "Cannot create path from " << points.size()
+  if (points->size() < 2) {
+    AWARN << "Cannot create path from " << points->size()
           << " points. Expecting more than 2.";
     return false;
   }
+  return true;
+}
 
+bool PncMap::CreatePathFromLaneSegments(const RouteSegments &segments,
+                                        Path *const path) {
+  std::vector<MapPathPoint> points;
+  if (!CreatePathPoints(segments, &points)) {
+    return false;
+  }
   *path = Path(points, segments, kTrajectoryApproximationMaxError);
   return true;
 }
 
+bool PncMap::CreatePath(const RouteSegments &segments,
+                        std::shared_ptr<const Path> *const path) {
+  CHECK_NOTNULL(path);
+  std::lock_guard<std::mutex> lock(path_cache_mutex_);
+  const Path *base = nullptr;
+  int base_num_shared_lanes = 0;
+  for (auto iter = path_cache_.begin(); iter != path_cache_.end(); ++iter) {
+    if (SameLaneSegments((*iter)->lane_segments(), segments)) {
+      path_cache_.splice(path_cache_.begin(), path_cache_, iter);
+      *path = path_cache_.front();
+      return true;
+    }
+    const int num_shared_lanes =
+        NumSharedLanes((*iter)->lane_segments(), segments);
+    if (num_shared_lanes > base_num_shared_lanes) {
+      base = iter->get();
+      base_num_shared_lanes = num_shared_lanes;
+    }
+  }
+
+  std::vector<MapPathPoint> points;
+  if (!CreatePathPoints(segments, &points)) {
+    return false;
+  }
+  if (base == nullptr) {
+    path->reset(new Path(std::move(points), segments,
+                         kTrajectoryApproximationMaxError));
+  } else {
+    path->reset(new Path(std::move(points), segments,
+                         kTrajectoryApproximationMaxError, *base));
+  }
+  path_cache_.push_front(*path);
+  if (path_cache_.size() > kPathCacheSize) {
+    path_cache_.pop_back();
+  }
+  return true;
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -21,7 +21,9 @@
 #ifndef MODULES_MAP_PNC_MAP_PNC_MAP_H_
 #define MODULES_MAP_PNC_MAP_PNC_MAP_H_
 
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -77,6 +79,16 @@ class PncMap {
   static bool CreatePathFromLaneSegments(const RouteSegments &segments,
                                          Path *const path);
 
+  /**
+   * Create the same path as CreatePathFromLaneSegments(), from the paths
+   * created by the previous calls: the path of the same lane segments is
+   * shared from the cache, and the cached path sharing the most lanes with
+   * the segments is the base of the new path, which only computes the points
+   * the base does not have.
+   */
+  bool CreatePath(const RouteSegments &segments,
+                  std::shared_ptr<const Path> *const path);
+
   bool GetRouteSegments(const common::PointENU &point,
                         const double backward_length,
                         const double forward_length,
@@ -107,6 +119,9 @@ class PncMap {
 
   static bool ValidateRouting(const routing::RoutingResponse &routing);
 
+  static bool CreatePathPoints(const RouteSegments &segments,
+                               std::vector<MapPathPoint> *const points);
+
   static void AppendLaneToPoints(LaneInfoConstPtr lane, const double start_s,
                                  const double end_s,
                                  std::vector<MapPathPoint> *const points);
@@ -122,6 +137,10 @@ class PncMap {
   std::unordered_set<std::string> routing_lane_ids_;
   std::unique_ptr<LaneWaypoint> last_waypoint_;
   const hdmap::HDMap *hdmap_ = nullptr;
+
+  // The paths created by CreatePath(), the most recently used first.
+  std::list<std::shared_ptr<const Path>> path_cache_;
+  std::mutex path_cache_mutex_;
 };
 
 }  // namespace hdmap
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the path creation of a planning cycle, from scratch and
+ * from the paths of the previous cycles.
+ **/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/pnc_map/pnc_map.h"
+
+namespace apollo {
+namespace hdmap {
+
+namespace {
+
+const char kMapFile[] = "modules/map/data/demo/base_map.txt";
+
+// The look backward and look forward distances of planning.
+const double kLookBackwardDistance = 30.0;
+const double kLookForwardDistance = 100.0;
+
+const HDMap& GetMap() {
+  static const HDMap* hdmap = [] {
+    auto* map = new HDMap();
+    CHECK_EQ(0, map->LoadMapFromFile(kMapFile));
+    return map;
+  }();
+  return *hdmap;
+}
+
+// The route segments of the planning cycles of a vehicle driving along the
+// longest lane of the map, moving forward by the given distance per cycle, or
+// standing still if the distance is 0.
+std::vector<RouteSegments> CycleSegments(const double distance_per_cycle) {
+  Map map;
+  CHECK(common::util::GetProtoFromFile(kMapFile, &map));
+  LaneInfoConstPtr lane;
+  for (const auto& map_lane : map.lane()) {
+    auto candidate = GetMap().GetLaneById(map_lane.id());
+    if (lane == nullptr || candidate->total_length() > lane->total_length()) {
+      lane = candidate;
+    }
+  }
+  CHECK(lane != nullptr);
+  std::vector<RouteSegments> cycle_segments;
+  for (double s = 0.0; s + kLookForwardDistance <= lane->total_length();
+       s += distance_per_cycle) {
+    RouteSegments segments;
+    segments.emplace_back(lane, std::max(0.0, s - kLookBackwardDistance),
+                          s + kLookForwardDistance);
+    cycle_segments.push_back(segments);
+    if (distance_per_cycle <= 0.0) {
+      break;
+    }
+  }
+  return cycle_segments;
+}
+
+}  // namespace
+
+// Arg: the distance per cycle in centimeters.
+void BM_CreatePathFromLaneSegments(benchmark::State& state) {
+  const auto cycle_segments = CycleSegments(state.range(0) / 100.0);
+  size_t cycle = 0;
+  while (state.KeepRunning()) {
+    Path path;
+    CHECK(PncMap::CreatePathFromLaneSegments(cycle_segments[cycle], &path));
+    benchmark::DoNotOptimize(path);
+    cycle = (cycle + 1) % cycle_segments.size();
+  }
+}
+BENCHMARK(BM_CreatePathFromLaneSegments)->Arg(0)->Arg(20)->Arg(100);
+
+// Arg: the distance per cycle in centimeters.
+void BM_CreatePath(benchmark::State& state) {
+  const auto cycle_segments = CycleSegments(state.range(0) / 100.0);
+  PncMap pnc_map(&GetMap());
+  size_t cycle = 0;
+  while (state.KeepRunning()) {
+    std::shared_ptr<const Path> path;
+    CHECK(pnc_map.CreatePath(cycle_segments[cycle], &path));
+    benchmark::DoNotOptimize(path);
+    cycle = (cycle + 1) % cycle_segments.size();
+  }
+}
+BENCHMARK(BM_CreatePath)->Arg(0)->Arg(20)->Arg(100);
+
+}  // namespace hdmap
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -145,6 +145,27 @@ TEST_F(PncMapTest, GetRouteSegments) {
   EXPECT_EQ(routing::RIGHT, segments[1].change_lane_type());
 }
 
+TEST_F(PncMapTest, CreatePath) {
+  auto lane = hdmap_.GetLaneById(hdmap::MakeMapId("9_1_-1"));
+  ASSERT_TRUE(lane);
+  PncMap pnc_map(&hdmap_);
+  for (const double start_s : {0.0, 0.0, 5.0, 10.0}) {
+    RouteSegments segments;
+    segments.emplace_back(lane, start_s, start_s + 30.0);
+    Path expected;
+    ASSERT_TRUE(PncMap::CreatePathFromLaneSegments(segments, &expected));
+    std::shared_ptr<const Path> path;
+    ASSERT_TRUE(pnc_map.CreatePath(segments, &path));
+    ASSERT_EQ(expected.num_points(), path->num_points());
+    EXPECT_DOUBLE_EQ(expected.length(), path->length());
+    for (int i = 0; i < path->num_points(); ++i) {
+      EXPECT_DOUBLE_EQ(expected.accumulated_s()[i], path->accumulated_s()[i]);
+      EXPECT_EQ(expected.lane_segments_to_next_point()[i].lane,
+                path->lane_segments_to_next_point()[i].lane);
+    }
+  }
+}
+
 TEST_F(PncMapTest, GetNeighborPassages) {
   const auto& road0 = routing_.road(0);
   {
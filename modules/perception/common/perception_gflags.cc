@@ -50,3 +50,16 @@ DEFINE_string(lidar_tf2_child_frame_id, "velodyne64",
 DEFINE_string(obstacle_module_name, "perception_obstacle",
               "perception obstacle module name");
 DEFINE_bool(enable_visualization, false, "enable visualization for debug");
+DEFINE_bool(enable_lidar_pipeline, false,
+            "process the point clouds in a pipeline of stages on their own "
+            "threads, rather than in the point cloud callback");
+DEFINE_int32(lidar_pipeline_queue_size, 1,
+             "the frames waiting for each stage of the lidar pipeline, the "
+             "oldest one is dropped when a new one comes");
+
+/// obstacle/lidar/roi_filter/hdmap_roi_filter/hdmap_roi_filter.cc
+DEFINE_bool(enable_hdmap_roi_tiles, false,
+            "filter the points with world-frame ROI tiles, drawn once from "
+            "the hdmap and kept around the car, rather than drawing the ROI "
+            "polygons of each frame");
+DEFINE_double(hdmap_roi_tile_size, 32.0, "the size of a ROI tile in meters");
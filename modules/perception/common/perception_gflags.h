@@ -43,5 +43,11 @@ DECLARE_string(lidar_tf2_frame_id);
 DECLARE_string(lidar_tf2_child_frame_id);
 DECLARE_string(obstacle_module_name);
 DECLARE_bool(enable_visualization);
+DECLARE_bool(enable_lidar_pipeline);
+DECLARE_int32(lidar_pipeline_queue_size);
+
+/// obstacle/lidar/roi_filter/hdmap_roi_filter/hdmap_roi_filter.cc
+DECLARE_bool(enable_hdmap_roi_tiles);
+DECLARE_double(hdmap_roi_tile_size);
 
 #endif /* MODULES_PERCEPTION_COMMON_PERCEPTION_GFLAGS_H_ */
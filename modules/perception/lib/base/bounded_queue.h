@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_LIB_BASE_BOUNDED_QUEUE_H_
+#define MODULES_PERCEPTION_LIB_BASE_BOUNDED_QUEUE_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "modules/common/macro.h"
+
+namespace apollo {
+namespace perception {
+
+// A queue between a producer thread and a consumer thread, which keeps at
+// most `capacity` elements: when it is full, Push() drops the oldest element,
+// so the consumer always gets the latest ones. Pop() blocks until an element
+// is available or the queue is closed.
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity)
+      : capacity_(std::max(capacity, static_cast<size_t>(1))) {}
+
+  // return false if the oldest element was dropped to make room.
+  bool Push(T element) {
+    T dropped;
+    bool is_dropped = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.size() >= capacity_) {
+        dropped = std::move(queue_.front());
+        queue_.pop_front();
+        is_dropped = true;
+        ++num_dropped_;
+      }
+      queue_.push_back(std::move(element));
+    }
+    condition_.notify_one();
+    // the dropped element is destroyed out of the lock.
+    return !is_dropped;
+  }
+
+  // return false if the queue is closed and all its elements are popped.
+  bool Pop(T* element) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return false;
+    }
+    *element = std::move(queue_.front());
+    queue_.pop_front();
+    return true;
+  }
+
+  // wake up the consumer, which pops the remaining elements, then stops.
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    condition_.notify_all();
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  uint64_t num_dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_dropped_;
+  }
+
+ private:
+  const size_t capacity_;
+  std::deque<T> queue_;
+  bool closed_ = false;
+  uint64_t num_dropped_ = 0;
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+
+  DISALLOW_COPY_AND_ASSIGN(BoundedQueue);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_LIB_BASE_BOUNDED_QUEUE_H_
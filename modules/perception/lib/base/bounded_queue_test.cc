@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/base/bounded_queue.h"
+
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+
+TEST(BoundedQueueTest, test_drop_oldest) {
+  BoundedQueue<int> queue(2);
+  EXPECT_EQ(queue.capacity(), 2u);
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_FALSE(queue.Push(3));
+  EXPECT_EQ(queue.size(), 2u);
+  EXPECT_EQ(queue.num_dropped(), 1u);
+
+  int value = 0;
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 3);
+  EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(BoundedQueueTest, test_close) {
+  BoundedQueue<std::unique_ptr<int>> queue(4);
+  queue.Push(std::unique_ptr<int>(new int(1)));
+  queue.Close();
+  // the elements pushed before Close() are still popped.
+  std::unique_ptr<int> value;
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(*value, 1);
+  EXPECT_FALSE(queue.Pop(&value));
+}
+
+TEST(BoundedQueueTest, test_producer_consumer) {
+  BoundedQueue<int> queue(1000);
+  std::thread producer([&queue] {
+    for (int i = 0; i < 1000; ++i) {
+      queue.Push(i);
+    }
+    queue.Close();
+  });
+  int expected = 0;
+  int value = 0;
+  while (queue.Pop(&value)) {
+    EXPECT_EQ(value, expected++);
+  }
+  producer.join();
+  EXPECT_EQ(expected, 1000);
+}
+
+}  // namespace perception
+}  // namespace apollo
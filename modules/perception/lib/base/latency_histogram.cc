@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/base/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+const double kMinLatencyMs = 0.01;
+const double kBucketsPerOctave = 4.0;
+// the last bucket holds the latencies above 0.01 * 2^23.75 ms, about 2 min.
+const size_t kNumBuckets = 96;
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() : counts_(kNumBuckets, 0) {}
+
+size_t LatencyHistogram::Bucket(double latency_ms) {
+  if (!(latency_ms > kMinLatencyMs)) {
+    return 0;
+  }
+  const double bucket =
+      std::ceil(std::log2(latency_ms / kMinLatencyMs) * kBucketsPerOctave);
+  return std::min(static_cast<size_t>(bucket), kNumBuckets - 1);
+}
+
+double LatencyHistogram::BucketUpperBound(size_t bucket) {
+  return kMinLatencyMs * std::exp2(bucket / kBucketsPerOctave);
+}
+
+void LatencyHistogram::Add(double latency_ms) {
+  const size_t bucket = Bucket(latency_ms);
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++counts_[bucket];
+  ++count_;
+  sum_ms_ += latency_ms;
+  max_ms_ = std::max(max_ms_, latency_ms);
+}
+
+uint64_t LatencyHistogram::count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return count_;
+}
+
+double LatencyHistogram::Percentile(double percentile) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (count_ == 0) {
+    return 0.0;
+  }
+  const double rank = std::max(1.0, std::ceil(percentile / 100.0 * count_));
+  uint64_t num_below = 0;
+  for (size_t bucket = 0; bucket < counts_.size(); ++bucket) {
+    num_below += counts_[bucket];
+    if (num_below >= rank) {
+      // the last bucket has no upper bound, and no bound is above the
+      // largest latency.
+      return bucket + 1 == counts_.size()
+                 ? max_ms_
+                 : std::min(BucketUpperBound(bucket), max_ms_);
+    }
+  }
+  return max_ms_;
+}
+
+std::string LatencyHistogram::ToString() const {
+  const double p50 = Percentile(50.0);
+  const double p95 = Percentile(95.0);
+  const double p99 = Percentile(99.0);
+  std::lock_guard<std::mutex> lock(mutex_);
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer),
+           "n=%lu mean=%.2f p50=%.2f p95=%.2f p99=%.2f max=%.2f ms",
+           static_cast<unsigned long>(count_),  // NOLINT
+           count_ == 0 ? 0.0 : sum_ms_ / count_, p50, p95, p99, max_ms_);
+  return buffer;
+}
+
+}  // namespace perception
+}  // namespace apollo
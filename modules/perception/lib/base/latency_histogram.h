@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_LIB_BASE_LATENCY_HISTOGRAM_H_
+#define MODULES_PERCEPTION_LIB_BASE_LATENCY_HISTOGRAM_H_
+
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "modules/common/macro.h"
+
+namespace apollo {
+namespace perception {
+
+// A histogram of latencies in ms, with buckets growing by 2^(1/4) from
+// 0.01 ms, so a percentile is known within 19%, whatever the latency.
+// thread safe.
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  void Add(double latency_ms);
+
+  uint64_t count() const;
+
+  // return the upper bound of the bucket of the percentile (in [0, 100]),
+  // or 0 if the histogram is empty.
+  double Percentile(double percentile) const;
+
+  // e.g. "n=100 mean=1.20 p50=1.19 p95=1.68 p99=2.00 max=2.10 ms".
+  std::string ToString() const;
+
+ private:
+  static size_t Bucket(double latency_ms);
+  static double BucketUpperBound(size_t bucket);
+
+  mutable std::mutex mutex_;
+  std::vector<uint64_t> counts_;
+  uint64_t count_ = 0;
+  double sum_ms_ = 0.0;
+  double max_ms_ = 0.0;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_LIB_BASE_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/base/latency_histogram.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+
+TEST(LatencyHistogramTest, test_percentile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_DOUBLE_EQ(histogram.Percentile(50.0), 0.0);
+
+  for (int i = 1; i <= 100; ++i) {
+    histogram.Add(i);
+  }
+  EXPECT_EQ(histogram.count(), 100u);
+  // a percentile is the upper bound of its bucket, within 2^(1/4).
+  EXPECT_GE(histogram.Percentile(50.0), 50.0);
+  EXPECT_LE(histogram.Percentile(50.0), 50.0 * 1.19);
+  EXPECT_GE(histogram.Percentile(95.0), 95.0);
+  EXPECT_LE(histogram.Percentile(95.0), 100.0);
+  EXPECT_DOUBLE_EQ(histogram.Percentile(100.0), 100.0);
+  EXPECT_LE(histogram.Percentile(0.0), 1.19);
+}
+
+TEST(LatencyHistogramTest, test_out_of_range) {
+  LatencyHistogram histogram;
+  histogram.Add(0.0);
+  histogram.Add(-1.0);
+  histogram.Add(1e9);
+  EXPECT_EQ(histogram.count(), 3u);
+  EXPECT_LE(histogram.Percentile(50.0), 0.01);
+  EXPECT_DOUBLE_EQ(histogram.Percentile(99.0), 1e9);
+  EXPECT_NE(histogram.ToString().find("n=3"), std::string::npos);
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_LIB_BASE_PIPELINE_H_
+#define MODULES_PERCEPTION_LIB_BASE_PIPELINE_H_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "modules/common/log.h"
+#include "modules/common/macro.h"
+#include "modules/perception/lib/base/bounded_queue.h"
+#include "modules/perception/lib/base/latency_histogram.h"
+
+namespace apollo {
+namespace perception {
+
+// A pipeline of stages, each running on its own thread, which process the
+// pushed elements in order. Each stage reads a BoundedQueue filled by the
+// previous one, so a slow stage drops the oldest elements waiting for it
+// rather than delaying the following ones. Example:
+//
+//     Pipeline<Frame> pipeline(2);
+//     pipeline.AddStage("segmentation", [](Frame* frame) { ... });
+//     pipeline.AddStage("tracker", [](Frame* frame) { ... });
+//     pipeline.Start();
+//     pipeline.Push(std::move(frame));
+//     ...
+//     pipeline.Stop();
+//
+// The queue-wait and service time of each stage are kept in histograms.
+template <typename T>
+class Pipeline {
+ public:
+  using StageFunction = std::function<void(T*)>;
+
+  explicit Pipeline(size_t queue_size) : queue_size_(queue_size) {}
+
+  ~Pipeline() { Stop(); }
+
+  // no-thread safe, and before Start().
+  void AddStage(const std::string& name, StageFunction function) {
+    CHECK(!started_) << "cannot add stage " << name << " to a started pipeline";
+    std::unique_ptr<Stage> stage(new Stage(queue_size_));
+    stage->name = name;
+    stage->function = std::move(function);
+    stages_.push_back(std::move(stage));
+  }
+
+  void Start() {
+    CHECK(!started_);
+    started_ = true;
+    for (size_t i = 0; i < stages_.size(); ++i) {
+      stages_[i]->thread = std::thread(&Pipeline::Run, this, i);
+    }
+  }
+
+  // return false if the oldest element waiting for the first stage was
+  // dropped to make room.
+  bool Push(std::unique_ptr<T> value) {
+    DCHECK(started_);
+    return stages_.front()->input.Push(
+        Element(std::move(value), std::chrono::steady_clock::now()));
+  }
+
+  // let the stages process the elements already pushed, then join them.
+  void Stop() {
+    if (!started_ || stages_.empty()) {
+      return;
+    }
+    stages_.front()->input.Close();
+    for (auto& stage : stages_) {
+      if (stage->thread.joinable()) {
+        stage->thread.join();
+      }
+    }
+  }
+
+  size_t num_stages() const { return stages_.size(); }
+
+  const LatencyHistogram& queue_wait_ms(size_t stage) const {
+    return stages_[stage]->queue_wait_ms;
+  }
+
+  const LatencyHistogram& service_ms(size_t stage) const {
+    return stages_[stage]->service_ms;
+  }
+
+  uint64_t num_dropped(size_t stage) const {
+    return stages_[stage]->input.num_dropped();
+  }
+
+  // one line per stage, with its histograms and dropped elements.
+  std::string StatsString() const {
+    std::ostringstream stats;
+    for (const auto& stage : stages_) {
+      stats << stage->name << ": queue_wait " << stage->queue_wait_ms.ToString()
+            << ", service " << stage->service_ms.ToString() << ", dropped "
+            << stage->input.num_dropped() << "\n";
+    }
+    return stats.str();
+  }
+
+ private:
+  using Element =
+      std::pair<std::unique_ptr<T>, std::chrono::steady_clock::time_point>;
+
+  struct Stage {
+    explicit Stage(size_t queue_size) : input(queue_size) {}
+
+    std::string name;
+    StageFunction function;
+    BoundedQueue<Element> input;
+    LatencyHistogram queue_wait_ms;
+    LatencyHistogram service_ms;
+    std::thread thread;
+  };
+
+  static double ElapsedMs(std::chrono::steady_clock::time_point start,
+                          std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  }
+
+  void Run(size_t index) {
+    Stage* stage = stages_[index].get();
+    Stage* next =
+        index + 1 < stages_.size() ? stages_[index + 1].get() : nullptr;
+    Element element;
+    while (stage->input.Pop(&element)) {
+      const auto start = std::chrono::steady_clock::now();
+      stage->queue_wait_ms.Add(ElapsedMs(element.second, start));
+      stage->function(element.first.get());
+      const auto end = std::chrono::steady_clock::now();
+      stage->service_ms.Add(ElapsedMs(start, end));
+      if (next != nullptr) {
+        element.second = end;
+        next->input.Push(std::move(element));
+      }
+      element.first.reset();
+    }
+    // the input is closed and empty: so is the next input, once closed.
+    if (next != nullptr) {
+      next->input.Close();
+    }
+  }
+
+  const size_t queue_size_;
+  bool started_ = false;
+  std::vector<std::unique_ptr<Stage>> stages_;
+
+  DISALLOW_COPY_AND_ASSIGN(Pipeline);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_LIB_BASE_PIPELINE_H_
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/base/pipeline.h"
+
+#include <unistd.h>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+
+TEST(PipelineTest, test_in_order) {
+  std::vector<int> output;
+  Pipeline<std::vector<int>> pipeline(100);
+  pipeline.AddStage("first", [](std::vector<int>* value) {
+    value->push_back(1);
+  });
+  pipeline.AddStage("second", [&output](std::vector<int>* value) {
+    value->push_back(2);
+    output.push_back(value->front());
+  });
+  pipeline.Start();
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_TRUE(pipeline.Push(
+        std::unique_ptr<std::vector<int>>(new std::vector<int>(1, i))));
+  }
+  pipeline.Stop();
+
+  ASSERT_EQ(output.size(), 50u);
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(output[i], i);
+  }
+  EXPECT_EQ(pipeline.num_stages(), 2u);
+  EXPECT_EQ(pipeline.service_ms(0).count(), 50u);
+  EXPECT_EQ(pipeline.queue_wait_ms(1).count(), 50u);
+  EXPECT_EQ(pipeline.num_dropped(0), 0u);
+  EXPECT_NE(pipeline.StatsString().find("second: queue_wait n=50"),
+            std::string::npos);
+}
+
+TEST(PipelineTest, test_drop_oldest) {
+  std::vector<int> output;
+  Pipeline<int> pipeline(1);
+  pipeline.AddStage("slow", [&output](int* value) {
+    usleep(20000);
+    output.push_back(*value);
+  });
+  pipeline.Start();
+  for (int i = 0; i < 10; ++i) {
+    pipeline.Push(std::unique_ptr<int>(new int(i)));
+  }
+  pipeline.Stop();
+
+  // the slow stage skips frames, but keeps their order and gets the last.
+  ASSERT_FALSE(output.empty());
+  EXPECT_LT(output.size(), 10u);
+  EXPECT_EQ(output.back(), 9);
+  for (size_t i = 1; i < output.size(); ++i) {
+    EXPECT_LT(output[i - 1], output[i]);
+  }
+  EXPECT_EQ(pipeline.num_dropped(0), 10u - output.size());
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_LIB_PCL_UTIL_POINT_CLOUD_CONVERTER_H_
+#define MODULES_PERCEPTION_LIB_PCL_UTIL_POINT_CLOUD_CONVERTER_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pcl/PCLPointField.h"
+
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+
+namespace apollo {
+namespace perception {
+namespace pcl_util {
+
+// The offsets of the fields of a point cloud message read by
+// ConvertPointCloud(), -1 for a missing field.
+struct PointCloudLayout {
+  int x_offset = -1;
+  int y_offset = -1;
+  int z_offset = -1;
+  int intensity_offset = -1;
+  bool is_float_intensity = false;
+  int timestamp_offset = -1;
+};
+
+// Finds the fields of a sensor_msgs::PointCloud2 or a pcl::PCLPointCloud2:
+// float x, y and z, and optionally an uint8 or float intensity and a double
+// timestamp. return false if the message has no such x, y and z.
+template <typename CloudMessage>
+bool GetPointCloudLayout(const CloudMessage& message,
+                         PointCloudLayout* layout) {
+  *layout = PointCloudLayout();
+  if (message.is_bigendian) {
+    return false;
+  }
+  for (const auto& field : message.fields) {
+    if (field.count != 1) {
+      continue;
+    }
+    const int offset = static_cast<int>(field.offset);
+    if (field.datatype == pcl::PCLPointField::FLOAT32) {
+      if (field.name == "x") {
+        layout->x_offset = offset;
+      } else if (field.name == "y") {
+        layout->y_offset = offset;
+      } else if (field.name == "z") {
+        layout->z_offset = offset;
+      } else if (field.name == "intensity") {
+        layout->intensity_offset = offset;
+        layout->is_float_intensity = true;
+      }
+    } else if (field.datatype == pcl::PCLPointField::UINT8 &&
+               field.name == "intensity") {
+      layout->intensity_offset = offset;
+      layout->is_float_intensity = false;
+    } else if (field.datatype == pcl::PCLPointField::FLOAT64 &&
+               field.name == "timestamp") {
+      layout->timestamp_offset = offset;
+    }
+  }
+  const int point_step = static_cast<int>(message.point_step);
+  for (const int offset :
+       {layout->x_offset, layout->y_offset, layout->z_offset}) {
+    if (offset < 0 || offset + 4 > point_step) {
+      return false;
+    }
+  }
+  if (layout->intensity_offset + (layout->is_float_intensity ? 4 : 1) >
+      point_step) {
+    layout->intensity_offset = -1;
+  }
+  if (layout->timestamp_offset + 8 > point_step) {
+    layout->timestamp_offset = -1;
+  }
+  return true;
+}
+
+template <typename T>
+inline T ReadField(const uint8_t* point, const int offset) {
+  T value;
+  memcpy(&value, point + offset, sizeof(T));
+  return value;
+}
+
+// only the point types with a timestamp get it.
+template <typename PointT>
+inline void SetTimestamp(const uint8_t*, const int, PointT*) {}
+
+inline void SetTimestamp(const uint8_t* point, const int offset,
+                         PointXYZIT* pt) {
+  pt->timestamp = offset < 0 ? 0.0 : ReadField<double>(point, offset);
+}
+
+inline void SetTimestamp(const uint8_t* point, const int offset,
+                         PointXYZIRT* pt) {
+  pt->timestamp = offset < 0 ? 0.0 : ReadField<double>(point, offset);
+}
+
+// Converts a sensor_msgs::PointCloud2 or a pcl::PCLPointCloud2 into `cloud`
+// in one pass over its data, and without the points with a NaN coordinate or
+// intensity. The points of `cloud` are overwritten, so a reused cloud does not
+// allocate again. Its header is left to the caller, which knows the type of
+// the header of the message. return false if the message has no float x, y
+// and z.
+template <typename CloudMessage, typename PointT>
+bool ConvertPointCloud(const CloudMessage& message,
+                       pcl::PointCloud<PointT>* cloud) {
+  PointCloudLayout layout;
+  if (!GetPointCloudLayout(message, &layout)) {
+    return false;
+  }
+  using Intensity = decltype(PointT().intensity);
+  const size_t num_points =
+      static_cast<size_t>(message.width) * message.height;
+  const size_t point_step = message.point_step;
+  const size_t row_step = message.row_step;
+  if (message.height > 0 &&
+      (row_step < message.width * point_step ||
+       message.data.size() < (message.height - 1) * row_step +
+                                 message.width * point_step)) {
+    return false;
+  }
+
+  cloud->points.resize(num_points);
+  PointT* points = cloud->points.data();
+  size_t num_valid = 0;
+  for (size_t row = 0; row < message.height; ++row) {
+    const uint8_t* point = message.data.data() + row * row_step;
+    for (size_t col = 0; col < message.width; ++col, point += point_step) {
+      const float x = ReadField<float>(point, layout.x_offset);
+      const float y = ReadField<float>(point, layout.y_offset);
+      const float z = ReadField<float>(point, layout.z_offset);
+      float intensity = 0.0f;
+      if (layout.intensity_offset >= 0) {
+        intensity = layout.is_float_intensity
+                        ? ReadField<float>(point, layout.intensity_offset)
+                        : point[layout.intensity_offset];
+      }
+      // the point is always written, and kept only if valid: without a
+      // branch to mispredict on the NaNs of the missed returns.
+      PointT& pt = points[num_valid];
+      pt.x = x;
+      pt.y = y;
+      pt.z = z;
+      const bool is_nan = std::isnan(x) | std::isnan(y) | std::isnan(z) |
+                          std::isnan(intensity);
+      pt.intensity = static_cast<Intensity>(is_nan ? 0.0f : intensity);
+      SetTimestamp(point, layout.timestamp_offset, &pt);
+      num_valid += !is_nan;
+    }
+  }
+  cloud->points.resize(num_valid);
+  cloud->width = static_cast<uint32_t>(num_valid);
+  cloud->height = 1;
+  cloud->is_dense = true;
+  return true;
+}
+
+// A pool of point clouds, which reuses a cloud, and the points allocated
+// in it, once its last holder releases it: the deleter of the clouds it gives
+// returns them to the pool. thread safe, and the clouds may outlive the pool.
+class PointCloudPool {
+ public:
+  // max_size: the number of released clouds kept for reuse.
+  explicit PointCloudPool(const size_t max_size)
+      : free_clouds_(std::make_shared<FreeClouds>(max_size)) {}
+
+  // return a released cloud, or a new one if there is none.
+  PointCloudPtr Get() {
+    PointCloud* cloud = free_clouds_->Pop();
+    if (cloud == nullptr) {
+      cloud = new PointCloud;
+    }
+    return PointCloudPtr(cloud, Release(free_clouds_));
+  }
+
+ private:
+  class FreeClouds {
+   public:
+    explicit FreeClouds(const size_t max_size) : max_size_(max_size) {}
+
+    ~FreeClouds() {
+      for (PointCloud* cloud : clouds_) {
+        delete cloud;
+      }
+    }
+
+    PointCloud* Pop() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (clouds_.empty()) {
+        return nullptr;
+      }
+      PointCloud* cloud = clouds_.back();
+      clouds_.pop_back();
+      return cloud;
+    }
+
+    void Push(PointCloud* cloud) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (clouds_.size() < max_size_) {
+          clouds_.push_back(cloud);
+          return;
+        }
+      }
+      delete cloud;
+    }
+
+   private:
+    const size_t max_size_;
+    std::mutex mutex_;
+    std::vector<PointCloud*> clouds_;
+  };
+
+  // the deleter of the clouds, which keeps the free clouds alive.
+  class Release {
+   public:
+    explicit Release(std::shared_ptr<FreeClouds> free_clouds)
+        : free_clouds_(std::move(free_clouds)) {}
+
+    void operator()(PointCloud* cloud) const {
+      free_clouds_->Push(cloud);
+    }
+
+   private:
+    std::shared_ptr<FreeClouds> free_clouds_;
+  };
+
+  std::shared_ptr<FreeClouds> free_clouds_;
+};
+
+}  // namespace pcl_util
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_LIB_PCL_UTIL_POINT_CLOUD_CONVERTER_H_
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the conversion of a velodyne PointCloud2 message into a
+ * pcl_util::PointCloud: through pcl::fromROSMsg() and a copy without nan as
+ * LidarProcess did, or with ConvertPointCloud() into a pooled cloud.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "benchmark/benchmark.h"
+#include "pcl_conversions/pcl_conversions.h"
+#include "sensor_msgs/PointCloud2.h"
+
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/lib/pcl_util/point_cloud_converter.h"
+
+namespace apollo {
+namespace perception {
+namespace pcl_util {
+
+namespace {
+
+void AddField(const std::string& name, const uint32_t offset,
+              const uint8_t datatype, sensor_msgs::PointCloud2* message) {
+  sensor_msgs::PointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = datatype;
+  field.count = 1;
+  message->fields.push_back(field);
+}
+
+// An organized cloud in the layout of the velodyne driver, with 5% of nan
+// for the missed returns.
+void MakeMessage(const int num_points, sensor_msgs::PointCloud2* message) {
+  AddField("x", 0, sensor_msgs::PointField::FLOAT32, message);
+  AddField("y", 4, sensor_msgs::PointField::FLOAT32, message);
+  AddField("z", 8, sensor_msgs::PointField::FLOAT32, message);
+  AddField("intensity", 16, sensor_msgs::PointField::UINT8, message);
+  AddField("timestamp", 24, sensor_msgs::PointField::FLOAT64, message);
+  message->point_step = 32;
+  message->height = 64;
+  message->width = num_points / message->height;
+  message->row_step = message->point_step * message->width;
+  message->data.assign(message->row_step * message->height, 0);
+  for (uint32_t i = 0; i < message->width * message->height; ++i) {
+    uint8_t* point = &message->data[i * message->point_step];
+    const float range = 5.0f + (i % 97);
+    const float x = i % 20 == 7 ? std::numeric_limits<float>::quiet_NaN()
+                                : range * std::cos(i * 0.001f);
+    const float y = range * std::sin(i * 0.001f);
+    const float z = -1.5f + (i % 64) * 0.05f;
+    const double timestamp = 1500000000.0 + i * 1e-6;
+    memcpy(point, &x, sizeof(float));
+    memcpy(point + 4, &y, sizeof(float));
+    memcpy(point + 8, &z, sizeof(float));
+    point[16] = static_cast<uint8_t>(i % 256);
+    memcpy(point + 24, &timestamp, sizeof(double));
+  }
+}
+
+}  // namespace
+
+// the conversion of LidarProcess before ConvertPointCloud().
+void BM_FromROSMsg(benchmark::State& state) {
+  sensor_msgs::PointCloud2 message;
+  MakeMessage(state.range(0), &message);
+  while (state.KeepRunning()) {
+    pcl::PointCloud<PointXYZIT> in_cloud;
+    pcl::fromROSMsg(message, in_cloud);
+    PointCloudPtr cloud(new PointCloud);
+    cloud->header = in_cloud.header;
+    cloud->points.resize(in_cloud.points.size());
+    size_t points_num = 0;
+    for (size_t idx = 0; idx < in_cloud.size(); ++idx) {
+      const PointXYZIT& pt = in_cloud.points[idx];
+      if (!std::isnan(pt.x) && !std::isnan(pt.y) && !std::isnan(pt.z) &&
+          !std::isnan(pt.intensity)) {
+        cloud->points[points_num].x = pt.x;
+        cloud->points[points_num].y = pt.y;
+        cloud->points[points_num].z = pt.z;
+        cloud->points[points_num].intensity = pt.intensity;
+        points_num++;
+      }
+    }
+    cloud->points.resize(points_num);
+    benchmark::DoNotOptimize(cloud->points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FromROSMsg)->Arg(120000);
+
+void BM_ConvertPointCloud(benchmark::State& state) {
+  sensor_msgs::PointCloud2 message;
+  MakeMessage(state.range(0), &message);
+  PointCloudPool pool(4);
+  while (state.KeepRunning()) {
+    PointCloudPtr cloud = pool.Get();
+    pcl_conversions::toPCL(message.header, cloud->header);
+    ConvertPointCloud(message, cloud.get());
+    benchmark::DoNotOptimize(cloud->points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertPointCloud)->Arg(120000);
+
+}  // namespace pcl_util
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/pcl_util/point_cloud_converter.h"
+
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pcl/PCLPointCloud2.h"
+
+namespace apollo {
+namespace perception {
+namespace pcl_util {
+
+namespace {
+
+// the layout of the velodyne point clouds: x, y, z, intensity, timestamp.
+void AddField(const std::string& name, const uint32_t offset,
+              const uint8_t datatype, pcl::PCLPointCloud2* message) {
+  pcl::PCLPointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = datatype;
+  field.count = 1;
+  message->fields.push_back(field);
+}
+
+void MakeMessage(const std::vector<float>& xs, pcl::PCLPointCloud2* message) {
+  AddField("x", 0, pcl::PCLPointField::FLOAT32, message);
+  AddField("y", 4, pcl::PCLPointField::FLOAT32, message);
+  AddField("z", 8, pcl::PCLPointField::FLOAT32, message);
+  AddField("intensity", 16, pcl::PCLPointField::UINT8, message);
+  AddField("timestamp", 24, pcl::PCLPointField::FLOAT64, message);
+  message->point_step = 32;
+  message->width = static_cast<uint32_t>(xs.size());
+  message->height = 1;
+  message->row_step = message->point_step * message->width;
+  message->data.assign(message->row_step, 0);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    uint8_t* point = &message->data[i * message->point_step];
+    const float y = 2.0f * i;
+    const float z = -1.0f;
+    const double timestamp = 100.0 + i;
+    memcpy(point, &xs[i], sizeof(float));
+    memcpy(point + 4, &y, sizeof(float));
+    memcpy(point + 8, &z, sizeof(float));
+    point[16] = static_cast<uint8_t>(i);
+    memcpy(point + 24, &timestamp, sizeof(double));
+  }
+}
+
+}  // namespace
+
+TEST(PointCloudConverterTest, test_ConvertPointCloud) {
+  const float kNan = std::numeric_limits<float>::quiet_NaN();
+  pcl::PCLPointCloud2 message;
+  MakeMessage({0.5f, kNan, 1.5f, kNan, 2.5f}, &message);
+
+  PointCloud cloud;
+  EXPECT_TRUE(ConvertPointCloud(message, &cloud));
+  ASSERT_EQ(cloud.points.size(), 3u);
+  EXPECT_EQ(cloud.width, 3u);
+  EXPECT_EQ(cloud.height, 1u);
+  const int kIndices[] = {0, 2, 4};
+  for (size_t i = 0; i < cloud.points.size(); ++i) {
+    EXPECT_FLOAT_EQ(cloud.points[i].x, 0.5f + i);
+    EXPECT_FLOAT_EQ(cloud.points[i].y, 2.0f * kIndices[i]);
+    EXPECT_FLOAT_EQ(cloud.points[i].z, -1.0f);
+    EXPECT_FLOAT_EQ(cloud.points[i].intensity, kIndices[i]);
+  }
+
+  pcl::PointCloud<PointXYZIT> xyzit_cloud;
+  EXPECT_TRUE(ConvertPointCloud(message, &xyzit_cloud));
+  ASSERT_EQ(xyzit_cloud.points.size(), 3u);
+  EXPECT_EQ(xyzit_cloud.points[1].intensity, 2);
+  EXPECT_DOUBLE_EQ(xyzit_cloud.points[2].timestamp, 104.0);
+}
+
+TEST(PointCloudConverterTest, test_missing_field) {
+  pcl::PCLPointCloud2 message;
+  MakeMessage({0.5f}, &message);
+  message.fields[2].datatype = pcl::PCLPointField::FLOAT64;
+  PointCloud cloud;
+  EXPECT_FALSE(ConvertPointCloud(message, &cloud));
+
+  message.fields[2].datatype = pcl::PCLPointField::FLOAT32;
+  message.data.resize(16);
+  EXPECT_FALSE(ConvertPointCloud(message, &cloud));
+}
+
+TEST(PointCloudConverterTest, test_PointCloudPool) {
+  PointCloudPool pool(1);
+  PointCloudPtr cloud = pool.Get();
+  cloud->points.resize(10);
+  const Point* points = cloud->points.data();
+  // held by the caller, so not reused.
+  PointCloudPtr other_cloud = pool.Get();
+  EXPECT_NE(cloud.get(), other_cloud.get());
+  cloud.reset();
+  other_cloud.reset();
+  cloud = pool.Get();
+  EXPECT_EQ(cloud->points.data(), points);
+}
+
+TEST(PointCloudConverterTest, test_PointCloudPool_threads) {
+  PointCloudPool pool(4);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&pool]() {
+      for (int j = 0; j < 1000; ++j) {
+        PointCloudPtr cloud = pool.Get();
+        // a cloud is only held by one thread at a time.
+        EXPECT_TRUE(cloud->points.empty());
+        cloud->points.resize(1);
+        cloud->points.clear();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(PointCloudConverterTest, test_PointCloudPool_outlive) {
+  PointCloudPtr cloud;
+  {
+    PointCloudPool pool(1);
+    cloud = pool.Get();
+  }
+  cloud->points.resize(10);
+  EXPECT_EQ(10, cloud->points.size());
+  cloud.reset();
+}
+
+}  // namespace pcl_util
+}  // namespace perception
+}  // namespace apollo
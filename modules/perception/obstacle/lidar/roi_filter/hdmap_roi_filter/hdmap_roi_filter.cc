@@ -16,6 +16,15 @@
 namespace apollo {
 namespace perception {
 
+namespace {
+
+// The road polygons around a tile are the ones of the lanes within this
+// distance more than the tile: their boundaries may be farther from the lane
+// center lines than the lanes are from the tile.
+const double kTileMapRadiusMargin = 10.0;
+
+}  // namespace
+
 bool HdmapROIFilter::Filter(const pcl_util::PointCloudPtr& cloud,
                             const ROIFilterOptions &roi_filter_options,
                             pcl_util::PointIndices* roi_indices) {
@@ -26,6 +35,14 @@ bool HdmapROIFilter::Filter(const pcl_util::PointCloudPtr& cloud,
 
   Eigen::Affine3d temp_trans(*(roi_filter_options.velodyne_trans));
 
+  if (tile_map_ != nullptr) {
+    if (roi_filter_options.hdmap->road_boundary.empty() &&
+        roi_filter_options.hdmap->junction.empty()) {
+      return false;
+    }
+    return FilterWithTileMap(cloud, temp_trans, roi_indices);
+  }
+
   std::vector<PolygonDType> polygons;
   MergeHdmapStructToPolygons(roi_filter_options.hdmap, &polygons);
 
@@ -64,6 +81,52 @@ bool HdmapROIFilter::FilterWithPolygonMask(
   return Bitmap2dFilter(cloud, bitmap, roi_indices);
 }
 
+bool HdmapROIFilter::FilterWithTileMap(const pcl_util::PointCloudPtr& cloud,
+                                       const Eigen::Affine3d& vel_pose,
+                                       pcl_util::PointIndices* roi_indices) {
+  const Eigen::Vector3d vel_location = vel_pose.translation();
+  const Eigen::Matrix3d vel_rot = vel_pose.linear();
+  const Eigen::Vector3d x_axis = vel_rot.row(0);
+  const Eigen::Vector3d y_axis = vel_rot.row(1);
+  const uint64_t map_version = HDMapInput::instance()->MapVersion();
+  if (map_version != map_version_) {
+    tile_map_->Clear();
+    map_version_ = map_version;
+  }
+  if (!tile_map_->Update(vel_location.head<2>(), range_)) {
+    AERROR << "Failed to draw the ROI tiles around "
+           << vel_location.head<2>().transpose();
+    return false;
+  }
+
+  // The points are in ROI as in FilterWithPolygonMask(), with their local
+  // coordinates in float as TransformFrame() gives them, but checked in the
+  // world frame. Each index is written, and kept only if in ROI: without a
+  // branch to mispredict at each ROI boundary.
+  const ROITileMap& tile_map = *tile_map_;
+  const double range = range_;
+  std::vector<int>& indices = roi_indices->indices;
+  const size_t offset = indices.size();
+  indices.resize(offset + cloud->size());
+  size_t num_roi = offset;
+  for (size_t i = 0; i < cloud->size(); ++i) {
+    const auto& pt = cloud->points[i];
+    const Eigen::Vector3d e_pt(pt.x, pt.y, pt.z);
+    const float local_x = x_axis.dot(e_pt);
+    const float local_y = y_axis.dot(e_pt);
+    if (local_x < -range || local_x >= range || local_y < -range ||
+        local_y >= range) {
+      continue;
+    }
+    const Eigen::Vector2d p(local_x + vel_location.x(),
+                            local_y + vel_location.y());
+    indices[num_roi] = static_cast<int>(i);
+    num_roi += tile_map.Check(p);
+  }
+  indices.resize(num_roi);
+  return true;
+}
+
 MajorDirection HdmapROIFilter::GetMajorDirection(
     const std::vector<PolygonType>& map_polygons,
     std::vector<PolygonScanConverter::Polygon>* polygons) {
@@ -174,6 +237,27 @@ bool HdmapROIFilter::Init() {
       return false;
     }
   }
+
+  if (FLAGS_enable_hdmap_roi_tiles) {
+    tile_map_.reset(new ROITileMap(
+        FLAGS_hdmap_roi_tile_size, cell_size_, extend_dist_,
+        [this](const Eigen::Vector2d& center, const double radius,
+               std::vector<PolygonDType>* polygons) {
+          pcl_util::PointD point;
+          point.x = center.x();
+          point.y = center.y();
+          point.z = 0.0;
+          HdmapStructPtr hdmap;
+          if (!HDMapInput::instance()->GetROI(
+                  point, radius + kTileMapRadiusMargin, &hdmap)) {
+            AERROR << "Failed to get the ROI of the tile at "
+                   << center.transpose();
+            return false;
+          }
+          MergeHdmapStructToPolygons(hdmap, polygons);
+          return true;
+        }));
+  }
   return true;
 }
 
@@ -19,6 +19,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <memory>
 
 #include "Eigen/Core"
 #include "gflags/gflags.h"
@@ -31,6 +32,7 @@
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/bitmap2d.h"
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/polygon_mask.h"
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/polygon_scan_converter.h"
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/roi_tile_map.h"
 #include "modules/perception/obstacle/onboard/hdmap_input.h"
 
 namespace apollo {
@@ -77,6 +79,16 @@ class HdmapROIFilter : public BaseROIFilter {
                              const std::vector<PolygonType>& map_polygons,
                              pcl_util::PointIndices* roi_indices);
 
+  /**
+   * @brief: Check each point against the tiles of the ROI around the car, in
+   * the world frame, drawing only the tiles the car just reached.
+   * @return false if a tile could not be drawn: it is drawn again by the next
+   * frame.
+   */
+  bool FilterWithTileMap(const pcl_util::PointCloudPtr& cloud,
+                         const Eigen::Affine3d& vel_pose,
+                         pcl_util::PointIndices* roi_indices);
+
   /**
    * @brief: Transform polygon points and cloud points from world coordinates
    * system to local.
@@ -125,6 +137,13 @@ class HdmapROIFilter : public BaseROIFilter {
 
   // The distance extended away from the ROI boundary
   double extend_dist_;
+
+  // The ROI tiles drawn from the hdmap, with FLAGS_enable_hdmap_roi_tiles
+  std::unique_ptr<ROITileMap> tile_map_;
+
+  // The version of the map the tiles are drawn from, see
+  // HDMapInput::MapVersion()
+  uint64_t map_version_ = 0;
 };
 
 REGISTER_ROIFILTER(HdmapROIFilter);
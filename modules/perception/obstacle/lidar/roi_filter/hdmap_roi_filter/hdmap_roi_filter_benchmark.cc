@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the ROI filter on the hdmap_roi_filter_test data, with the
+ * car driving over it: drawing the ROI polygons of each frame, or checking the
+ * points against the ROI tiles drawn as the car reaches them.
+ */
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Eigen/Geometry"
+#include "benchmark/benchmark.h"
+#include "pcl/io/pcd_io.h"
+
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/hdmap_roi_filter.h"
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+const char kPolygonFileName[] =
+    "/apollo/modules/perception/data/hdmap_roi_filter_test/poly_mask_ut.poly";
+const char kPcdFileName[] =
+    "/apollo/modules/perception/data/hdmap_roi_filter_test/poly_mask_ut.pcd";
+
+// the parameters of the HdmapROIFilter model of the perception config.
+const double kRange = 70.0;
+const double kCellSize = 0.25;
+const double kExtendDist = 0.0;
+
+// 10 m/s at 10 Hz, back and forth over the test polygons.
+const double kFrameDistance = 1.0;
+const int kFramesPerWay = 60;
+
+void LoadPolygons(std::vector<PolygonDType>* polygons) {
+  std::ifstream polygon_data(kPolygonFileName, std::ifstream::in);
+  CHECK(polygon_data) << "Can not open file: " << kPolygonFileName;
+  size_t polygons_num = 0;
+  polygon_data >> polygons_num;
+  polygons->resize(polygons_num);
+  for (auto& polygon : *polygons) {
+    size_t points_num = 0;
+    polygon_data >> points_num;
+    polygon.resize(points_num);
+    for (auto& vertex : polygon.points) {
+      double z = 0.0;
+      polygon_data >> vertex.x >> vertex.y >> z;
+      vertex.z = 0.0;
+    }
+  }
+}
+
+// The test cloud, repeated with small offsets for the larger clouds.
+pcl_util::PointCloudPtr LoadCloud(const int copies_num) {
+  pcl_util::PointCloud test_cloud;
+  CHECK_EQ(0, pcl::io::loadPCDFile(kPcdFileName, test_cloud));
+  pcl_util::PointCloudPtr cloud(new pcl_util::PointCloud);
+  for (int i = 0; i < copies_num; ++i) {
+    for (pcl_util::Point pt : test_cloud.points) {
+      pt.x += 0.01f * i;
+      pt.y -= 0.01f * i;
+      cloud->push_back(pt);
+    }
+  }
+  return cloud;
+}
+
+// The position of the car at the frame.
+Eigen::Vector2d Location(const int frame) {
+  const int step = frame % (2 * kFramesPerWay);
+  const int distance = step < kFramesPerWay ? step : 2 * kFramesPerWay - step;
+  return Eigen::Vector2d(-30.0 + kFrameDistance * distance, 0.0);
+}
+
+class HdmapROIFilterBenchmark : public HdmapROIFilter {
+ public:
+  explicit HdmapROIFilterBenchmark(const bool use_tile_map) {
+    range_ = kRange;
+    cell_size_ = kCellSize;
+    extend_dist_ = kExtendDist;
+    LoadPolygons(&polygons_);
+    if (use_tile_map) {
+      tile_map_.reset(new ROITileMap(
+          FLAGS_hdmap_roi_tile_size, cell_size_, extend_dist_,
+          [this](const Eigen::Vector2d& center, const double radius,
+                 std::vector<PolygonDType>* polygons) {
+            *polygons = polygons_;
+            return true;
+          }));
+    }
+    HdmapStructPtr hdmap(new HdmapStruct);
+    hdmap->junction = polygons_;
+    options_.hdmap = hdmap;
+  }
+
+  void FilterFrame(const pcl_util::PointCloudPtr& cloud, const int frame,
+                   pcl_util::PointIndices* roi_indices) {
+    Eigen::Matrix4d velodyne_trans = Eigen::Matrix4d::Identity();
+    // the car heads along x, slightly turned.
+    velodyne_trans.topLeftCorner<2, 2>() =
+        Eigen::Rotation2Dd(0.1).toRotationMatrix();
+    velodyne_trans.topRightCorner<2, 1>() = Location(frame);
+    options_.velodyne_trans.reset(new Eigen::Matrix4d(velodyne_trans));
+    roi_indices->indices.clear();
+    CHECK(Filter(cloud, options_, roi_indices));
+  }
+
+  size_t drawn_tiles_num() const {
+    return tile_map_ == nullptr ? 0 : tile_map_->drawn_tiles_num();
+  }
+
+ private:
+  std::vector<PolygonDType> polygons_;
+  ROIFilterOptions options_;
+};
+
+void FilterFrames(const bool use_tile_map, benchmark::State* state) {
+  const pcl_util::PointCloudPtr cloud = LoadCloud(state->range(0));
+  HdmapROIFilterBenchmark filter(use_tile_map);
+  pcl_util::PointIndices roi_indices;
+  int frame = 0;
+  size_t roi_points_num = 0;
+  while (state->KeepRunning()) {
+    filter.FilterFrame(cloud, frame++, &roi_indices);
+    roi_points_num += roi_indices.indices.size();
+  }
+  state->SetItemsProcessed(state->iterations() * cloud->size());
+  state->SetLabel(
+      std::to_string(roi_points_num / std::max(frame, 1)) + " points in ROI, " +
+      std::to_string(filter.drawn_tiles_num()) + " tiles drawn");
+}
+
+}  // namespace
+
+// Arg: the copies of the 10000 test points in the cloud.
+void BM_FilterWithPolygonMask(benchmark::State& state) {
+  FilterFrames(false, &state);
+}
+BENCHMARK(BM_FilterWithPolygonMask)
+    ->Arg(1)
+    ->Arg(12)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_FilterWithTileMap(benchmark::State& state) {
+  FilterFrames(true, &state);
+}
+BENCHMARK(BM_FilterWithTileMap)
+    ->Arg(1)
+    ->Arg(12)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
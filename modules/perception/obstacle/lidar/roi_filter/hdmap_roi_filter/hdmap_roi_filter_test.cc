@@ -16,6 +16,7 @@
 
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/hdmap_roi_filter.h"
 
+#include <cmath>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -79,6 +80,10 @@ class HdmapROIFilterTest : public testing::Test, HdmapROIFilter {
  protected:
   void init();
   void filter();
+  void filter_with_tile_map();
+  void filter_with_tile_map_failure();
+  void check(const pcl_util::PointIndices& indices,
+             const Eigen::Vector2d& location, const size_t max_errors_num);
 
   std::unique_ptr<HdmapROIFilter> _hdmap_roi_filter_ptr;
   std::vector<PolygonType> _polygons;
@@ -95,7 +100,107 @@ void HdmapROIFilterTest::filter() {
   pcl_util::PointIndices indices;
 
   ASSERT_TRUE(FilterWithPolygonMask(_pts_cloud_ptr, _polygons, &indices));
+  check(indices, Eigen::Vector2d::Zero(), 0);
+}
+
+void HdmapROIFilterTest::filter_with_tile_map() {
+  // The test polygons, as the ones of the map in the world frame.
+  std::vector<PolygonDType> map_polygons(_polygons.size());
+  for (size_t i = 0; i < _polygons.size(); ++i) {
+    map_polygons[i].resize(_polygons[i].size());
+    for (size_t j = 0; j < _polygons[i].size(); ++j) {
+      map_polygons[i][j].x = _polygons[i][j].x;
+      map_polygons[i][j].y = _polygons[i][j].y;
+    }
+  }
+  tile_map_.reset(new ROITileMap(
+      FLAGS_hdmap_roi_tile_size, cell_size_, extend_dist_,
+      [&map_polygons](const Eigen::Vector2d& center, const double radius,
+                      std::vector<PolygonDType>* polygons) {
+        *polygons = map_polygons;
+        return true;
+      }));
+  HdmapStructPtr hdmap(new HdmapStruct);
+  hdmap->junction = map_polygons;
+  ROIFilterOptions options;
+  options.hdmap = hdmap;
+
+  // The car moves along the test points, which stay at the same place in the
+  // world: the tiles are drawn as the car reaches them.
+  for (const Eigen::Vector2d location :
+       {Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(10.0, -5.0),
+        Eigen::Vector2d(40.0, 20.0), Eigen::Vector2d(-30.0, 60.0)}) {
+    Eigen::Matrix4d velodyne_trans = Eigen::Matrix4d::Identity();
+    velodyne_trans.topRightCorner<2, 1>() = location;
+    options.velodyne_trans.reset(new Eigen::Matrix4d(velodyne_trans));
+    pcl_util::PointCloudPtr cloud(new pcl_util::PointCloud(*_pts_cloud_ptr));
+    for (auto& pt : cloud->points) {
+      pt.x -= location.x();
+      pt.y -= location.y();
+    }
+    pcl_util::PointIndices indices;
+    ASSERT_TRUE(Filter(cloud, options, &indices));
+    // The grids of the tiles are aligned on the world frame, and drawn along
+    // the major direction of each tile: a few points next to the ROI boundary
+    // may be on the other side of it.
+    check(indices, location, _pts_cloud_ptr->size() / 1000);
+  }
+  EXPECT_GT(tile_map_->drawn_tiles_num(), 0);
+}
+
+void HdmapROIFilterTest::filter_with_tile_map_failure() {
+  std::vector<PolygonDType> map_polygons(_polygons.size());
+  for (size_t i = 0; i < _polygons.size(); ++i) {
+    map_polygons[i].resize(_polygons[i].size());
+    for (size_t j = 0; j < _polygons[i].size(); ++j) {
+      map_polygons[i][j].x = _polygons[i][j].x;
+      map_polygons[i][j].y = _polygons[i][j].y;
+    }
+  }
+  // The polygons of the first tile fail to be got.
+  int sources_num = 0;
+  tile_map_.reset(new ROITileMap(
+      FLAGS_hdmap_roi_tile_size, cell_size_, extend_dist_,
+      [&map_polygons, &sources_num](const Eigen::Vector2d& center,
+                                    const double radius,
+                                    std::vector<PolygonDType>* polygons) {
+        if (sources_num++ == 0) {
+          return false;
+        }
+        *polygons = map_polygons;
+        return true;
+      }));
+  HdmapStructPtr hdmap(new HdmapStruct);
+  hdmap->junction = map_polygons;
+  ROIFilterOptions options;
+  options.hdmap = hdmap;
+  options.velodyne_trans.reset(
+      new Eigen::Matrix4d(Eigen::Matrix4d::Identity()));
 
+  pcl_util::PointIndices indices;
+  EXPECT_FALSE(Filter(_pts_cloud_ptr, options, &indices));
+  const size_t drawn_tiles_num = tile_map_->drawn_tiles_num();
+  EXPECT_EQ(drawn_tiles_num + 1, static_cast<size_t>(sources_num));
+
+  // The tile which failed is drawn by the next frame, and only this one.
+  indices.indices.clear();
+  ASSERT_TRUE(Filter(_pts_cloud_ptr, options, &indices));
+  EXPECT_EQ(drawn_tiles_num + 1, tile_map_->drawn_tiles_num());
+  check(indices, Eigen::Vector2d::Zero(), _pts_cloud_ptr->size() / 1000);
+
+  // All the tiles are drawn again once cleared.
+  tile_map_->Clear();
+  indices.indices.clear();
+  ASSERT_TRUE(Filter(_pts_cloud_ptr, options, &indices));
+  EXPECT_EQ(2 * (drawn_tiles_num + 1), tile_map_->drawn_tiles_num());
+  check(indices, Eigen::Vector2d::Zero(), _pts_cloud_ptr->size() / 1000);
+}
+
+// The points in ROI are the ones above zero within the range of the car. They
+// are only labeled within the range of the origin.
+void HdmapROIFilterTest::check(const pcl_util::PointIndices& indices,
+                               const Eigen::Vector2d& location,
+                               const size_t max_errors_num) {
   size_t points_num = _pts_cloud_ptr->size();
   std::vector<bool> is_in_roi(points_num, false);
 
@@ -110,15 +215,19 @@ void HdmapROIFilterTest::filter() {
 
   for (size_t i = 0; i < points_num; ++i) {
     const auto& pt = _pts_cloud_ptr->points[i];
+    const bool is_labeled = std::abs(pt.x) < range_ && std::abs(pt.y) < range_;
+    const bool is_in_range = std::abs(pt.x - location.x()) < range_ &&
+                             std::abs(pt.y - location.y()) < range_;
+    if (is_in_range && !is_labeled) {
+      continue;
+    }
 
-    if (pt.z > 0) {
-      EXPECT_TRUE(is_in_roi[i]);
+    if (pt.z > 0 && is_in_range) {
       if (is_in_roi[i])
         ++true_positive;
       else
         ++false_negitive;
     } else {
-      EXPECT_FALSE(is_in_roi[i]);
       if (is_in_roi[i])
         ++false_positive;
       else
@@ -130,6 +239,7 @@ void HdmapROIFilterTest::filter() {
          << ", False positive: " << false_positive
          << ", True negitive: " << true_negitive
          << ", False negative: " << false_negitive;
+  EXPECT_LE(false_positive + false_negitive, max_errors_num);
 }
 
 TEST_F(HdmapROIFilterTest, test_filter) {
@@ -137,5 +247,15 @@ TEST_F(HdmapROIFilterTest, test_filter) {
   filter();
 }
 
+TEST_F(HdmapROIFilterTest, test_filter_with_tile_map) {
+  init();
+  filter_with_tile_map();
+}
+
+TEST_F(HdmapROIFilterTest, test_filter_with_tile_map_failure) {
+  init();
+  filter_with_tile_map_failure();
+}
+
 }  // namespace perception
 }  // namespace apollo
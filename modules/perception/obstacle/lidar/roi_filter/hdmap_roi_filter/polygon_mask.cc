@@ -64,6 +64,12 @@ void DrawPolygonInBitmap(const typename PolygonScanConverter::Polygon& polygon,
   GetValidXRange(polygon, *bitmap, major_dir,
                  major_dir_grid_size, &valid_x_range);
 
+  // The polygon covers no scan line of the bitmap: the scan converter needs
+  // at least one.
+  if (valid_x_range.second - valid_x_range.first < major_dir_grid_size) {
+    return;
+  }
+
   // 2. Convert polygon to scan intervals(Most important)
   std::vector<std::vector<Interval>> scans_intervals;
 
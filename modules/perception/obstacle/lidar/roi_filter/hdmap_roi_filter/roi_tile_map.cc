@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/roi_tile_map.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/bitmap2d.h"
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/polygon_mask.h"
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+// The grids drawn around a tile: the scan conversion may miss the last scan
+// line of a bitmap, which is then in the padding, so the grids of the tile are
+// drawn as they would be on a bitmap covering the whole map.
+const int kPaddingGrids = 2;
+
+int RoundUpToPowerOf2(const int x) {
+  int power = 1;
+  while (power < x) {
+    power <<= 1;
+  }
+  return power;
+}
+
+}  // namespace
+
+ROITileMap::ROITileMap(const double tile_size, const double cell_size,
+                       const double extend_dist,
+                       PolygonSource polygon_source)
+    : cell_size_(cell_size),
+      inv_cell_size_(1.0 / cell_size),
+      extend_dist_(extend_dist),
+      polygon_source_(std::move(polygon_source)) {
+  CHECK_GT(cell_size_, 0.0);
+  const double tile_grids = std::max(1.0, tile_size / cell_size_);
+  tile_grids_ = 1 << static_cast<int>(std::round(std::log2(tile_grids)));
+}
+
+bool ROITileMap::Update(const Eigen::Vector2d& position, const double range) {
+  const int window_tiles = RoundUpToPowerOf2(
+      static_cast<int>(std::ceil(2.0 * range / tile_size())) + 1);
+  if (window_tiles != window_tiles_) {
+    window_tiles_ = window_tiles;
+    window_tiles_mask_ = window_tiles_ - 1;
+    const int window_grids = window_tiles_ * tile_grids_;
+    window_grids_mask_ = window_grids - 1;
+    blocks_per_row_ = (window_grids + 63) / 64;
+    tiles_.assign(window_tiles_ * window_tiles_, Tile());
+    bitmap_.assign(window_grids * blocks_per_row_, 0);
+  }
+
+  const int min_x_id = TileId(GridId(position.x() - range));
+  const int max_x_id = TileId(GridId(position.x() + range));
+  const int min_y_id = TileId(GridId(position.y() - range));
+  const int max_y_id = TileId(GridId(position.y() + range));
+  bool drawn = true;
+  for (int x_id = min_x_id; x_id <= max_x_id; ++x_id) {
+    for (int y_id = min_y_id; y_id <= max_y_id; ++y_id) {
+      Tile* tile = GetTile(x_id, y_id);
+      if (!tile->is_drawn || tile->x_id != x_id || tile->y_id != y_id) {
+        drawn = DrawTile(x_id, y_id, tile) && drawn;
+      }
+    }
+  }
+  return drawn;
+}
+
+void ROITileMap::Clear() {
+  tiles_.assign(tiles_.size(), Tile());
+}
+
+bool ROITileMap::IsTileDrawn(const int x_grid_id, const int y_grid_id) const {
+  if (tiles_.empty()) {
+    return false;
+  }
+  const int x_id = TileId(x_grid_id);
+  const int y_id = TileId(y_grid_id);
+  const Tile& tile = tiles_[(x_id & window_tiles_mask_) * window_tiles_ +
+                            (y_id & window_tiles_mask_)];
+  return tile.is_drawn && tile.x_id == x_id && tile.y_id == y_id;
+}
+
+bool ROITileMap::DrawTile(const int x_id, const int y_id, Tile* tile) {
+  const Eigen::Vector2d padding(kPaddingGrids * cell_size_,
+                                kPaddingGrids * cell_size_);
+  const Eigen::Vector2d tile_min_p(x_id * tile_size(), y_id * tile_size());
+  const Eigen::Vector2d min_p = tile_min_p - padding;
+  const Eigen::Vector2d max_p =
+      tile_min_p + Eigen::Vector2d(tile_size(), tile_size()) + padding;
+
+  std::vector<PolygonDType> polygons_world;
+  if (!polygon_source_(0.5 * (min_p + max_p), 0.5 * (max_p - min_p).norm(),
+                       &polygons_world)) {
+    return false;
+  }
+
+  // Only the polygons over the tile are drawn. As in
+  // HdmapROIFilter::GetMajorDirection(), the major direction is the one where
+  // they cover the least of the tile.
+  Eigen::Vector2d polygons_min_p = max_p;
+  Eigen::Vector2d polygons_max_p = min_p;
+  std::vector<PolygonScanConverter::Polygon> raw_polygons;
+  raw_polygons.reserve(polygons_world.size());
+  for (const auto& polygon_world : polygons_world) {
+    Eigen::Vector2d polygon_min_p(std::numeric_limits<double>::max(),
+                                  std::numeric_limits<double>::max());
+    Eigen::Vector2d polygon_max_p = -polygon_min_p;
+    PolygonScanConverter::Polygon raw_polygon(polygon_world.size());
+    for (size_t i = 0; i < polygon_world.size(); ++i) {
+      raw_polygon[i].x() = polygon_world[i].x;
+      raw_polygon[i].y() = polygon_world[i].y;
+      polygon_min_p = polygon_min_p.cwiseMin(raw_polygon[i]);
+      polygon_max_p = polygon_max_p.cwiseMax(raw_polygon[i]);
+    }
+    if ((polygon_max_p.array() >= min_p.array()).all() &&
+        (polygon_min_p.array() <= max_p.array()).all()) {
+      raw_polygons.push_back(std::move(raw_polygon));
+      polygons_min_p = polygons_min_p.cwiseMin(polygon_min_p);
+      polygons_max_p = polygons_max_p.cwiseMax(polygon_max_p);
+    }
+  }
+  polygons_min_p = polygons_min_p.cwiseMax(min_p);
+  polygons_max_p = polygons_max_p.cwiseMin(max_p);
+  const Eigen::Vector2d polygons_size = polygons_max_p - polygons_min_p;
+
+  Bitmap2D bitmap(min_p, max_p, Eigen::Vector2d(cell_size_, cell_size_),
+                  polygons_size.x() < polygons_size.y() ? Bitmap2D::XMAJOR
+                                                        : Bitmap2D::YMAJOR);
+  bitmap.BuildMap();
+  DrawPolygonInBitmap(raw_polygons, extend_dist_, &bitmap);
+
+  // Copy the grids of the tile, checked at their centers, into the window.
+  for (int i = 0; i < tile_grids_; ++i) {
+    const int x = (x_id * tile_grids_ + i) & window_grids_mask_;
+    uint64_t* row = &bitmap_[x * blocks_per_row_];
+    for (int j = 0; j < tile_grids_; ++j) {
+      const int y = (y_id * tile_grids_ + j) & window_grids_mask_;
+      const Eigen::Vector2d center =
+          tile_min_p + Eigen::Vector2d(i + 0.5, j + 0.5) * cell_size_;
+      const uint64_t bit = static_cast<uint64_t>(1) << (y & 63);
+      if (bitmap.Check(center)) {
+        row[y >> 6] |= bit;
+      } else {
+        row[y >> 6] &= ~bit;
+      }
+    }
+  }
+  tile->is_drawn = true;
+  tile->x_id = x_id;
+  tile->y_id = y_id;
+  ++drawn_tiles_num_;
+  return true;
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_ROI_FILTER_HDMAP_ROI_FILTER_TM_H_
+#define MODULES_PERCEPTION_OBSTACLE_LIDAR_ROI_FILTER_HDMAP_ROI_FILTER_TM_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/common/log.h"
+#include "modules/perception/obstacle/base/types.h"
+
+namespace apollo {
+namespace perception {
+
+/**
+ * @class ROITileMap
+ * @brief The ROI around the car in the world frame, as square tiles of grids
+ * drawn from the map polygons. A tile is drawn once, when the window of tiles
+ * around the car reaches it, and kept until the window leaves it: so the
+ * polygons are only drawn when the car reaches new tiles, and the grids are
+ * aligned on the world frame rather than on the car.
+ *
+ * @Note: The window is stored as one bitmap, where the grid (x, y) of the
+ * world is at (x, y) modulo the size of the window: the window slides over the
+ * world without moving the grids it keeps, and a point is checked with a few
+ * bit operations.
+ */
+class ROITileMap {
+ public:
+  /**
+   * @brief: Get the ROI polygons within radius of center, all in the world
+   * frame.
+   * @return false if the polygons could not be got.
+   */
+  typedef std::function<bool(const Eigen::Vector2d& center,
+                             const double radius,
+                             std::vector<PolygonDType>* polygons)>
+      PolygonSource;
+
+  /**
+   * @params[In] tile_size: rounded so that a tile has a power of 2 of grids on
+   * each side.
+   * @params[In] extend_dist: The distance extended away from the ROI
+   * boundary.
+   */
+  ROITileMap(const double tile_size, const double cell_size,
+             const double extend_dist, PolygonSource polygon_source);
+
+  /**
+   * @brief: Make the tiles over [-range, range] * [-range, range] around the
+   * position available, drawing the ones the window just reached.
+   * @return false if the polygons of a tile could not be got: the tile is
+   * left undrawn, to be drawn again by the next Update().
+   */
+  bool Update(const Eigen::Vector2d& position, const double range);
+
+  /**
+   * @brief: Forget all the drawn tiles, e.g. when the map changes: they are
+   * drawn again by the next Update().
+   */
+  void Clear();
+
+  /**
+   * @brief: Check whether a point, within the range of the last Update(), is
+   * in the ROI.
+   */
+  bool Check(const Eigen::Vector2d& point) const {
+    const int x_id = GridId(point.x());
+    const int y_id = GridId(point.y());
+    DCHECK(IsTileDrawn(x_id, y_id));
+    // the ids modulo the window size, as it is a power of 2.
+    const int x = x_id & window_grids_mask_;
+    const int y = y_id & window_grids_mask_;
+    return (bitmap_[x * blocks_per_row_ + (y >> 6)] >> (y & 63)) & 1;
+  }
+
+  double tile_size() const {
+    return tile_grids_ * cell_size_;
+  }
+
+  // The number of tiles drawn since the construction.
+  size_t drawn_tiles_num() const {
+    return drawn_tiles_num_;
+  }
+
+ private:
+  struct Tile {
+    bool is_drawn = false;
+    int x_id = 0;
+    int y_id = 0;
+  };
+
+  // floor(x / cell_size_), without the call to std::floor.
+  inline int GridId(const double x) const {
+    const double grid = x * inv_cell_size_;
+    const int grid_id = static_cast<int>(grid);
+    return grid_id - (grid < grid_id);
+  }
+
+  inline int TileId(const int grid_id) const {
+    return grid_id >= 0 ? grid_id / tile_grids_
+                        : -((-grid_id - 1) / tile_grids_) - 1;
+  }
+
+  Tile* GetTile(const int x_id, const int y_id) {
+    return &tiles_[(x_id & window_tiles_mask_) * window_tiles_ +
+                   (y_id & window_tiles_mask_)];
+  }
+
+  bool IsTileDrawn(const int x_grid_id, const int y_grid_id) const;
+
+  bool DrawTile(const int x_id, const int y_id, Tile* tile);
+
+  double cell_size_;
+  double inv_cell_size_;
+  double extend_dist_;
+  PolygonSource polygon_source_;
+  int tile_grids_ = 1;
+
+  // The window has window_tiles_ * window_tiles_ tiles, a power of 2.
+  int window_tiles_ = 0;
+  int window_tiles_mask_ = 0;
+  int window_grids_mask_ = 0;
+  std::vector<Tile> tiles_;
+
+  // Each row of the bitmap has a bit by grid, in blocks of 64 grids.
+  int blocks_per_row_ = 0;
+  std::vector<uint64_t> bitmap_;
+
+  size_t drawn_tiles_num_ = 0;
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_LIDAR_ROI_FILTER_HDMAP_ROI_FILTER_TM_H_
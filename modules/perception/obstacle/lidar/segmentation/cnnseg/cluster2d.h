@@ -19,6 +19,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <cmath>
 #include "caffe/caffe.hpp"
 #include "modules/common/log.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
@@ -31,19 +32,25 @@ namespace perception {
 namespace cnnseg {
 
 struct Obstacle {
-  std::vector<int> grids;
+  int grid_num;
+  // the points of the obstacle, set by Cluster2D::GetObjects() if it has
+  // enough of them.
   apollo::perception::pcl_util::PointCloudPtr cloud;
   float score;
   float height;
 
   Obstacle() {
-    grids.clear();
-    cloud.reset(new apollo::perception::pcl_util::PointCloud);
+    grid_num = 0;
     score = 0.0;
     height = -5.0;
   }
 };
 
+// Clusters the grids of the objects predicted by the cnnseg network into
+// obstacles. Each grid points to the grid of the center of its object: the
+// grids reaching the same center, and the centers next to each other, are an
+// obstacle. All the per-grid state lives in flat arrays allocated by Init()
+// and reused from frame to frame.
 class Cluster2D {
  public:
   Cluster2D() {}
@@ -60,6 +67,13 @@ class Cluster2D {
     point2grid_.clear();
     obstacles_.clear();
     id_img_.assign(grids_, -1);
+    point_num_.assign(grids_, 0);
+    object_grids_.assign(grids_, 0);
+    object_grid_num_ = 0;
+    center_.assign(grids_, 0);
+    walk_.assign(grids_, 0);
+    is_center_.assign(grids_, 0);
+    nodes_.assign(grids_, Node());
     pc_ptr_.reset();
     valid_indices_in_pc_ = nullptr;
     return true;
@@ -77,14 +91,16 @@ class Cluster2D {
         instance_pt_blob.cpu_data() + instance_pt_blob.offset(0, 1);
 
     pc_ptr_ = pc_ptr;
-    std::vector<std::vector<Node>> nodes(rows_,
-                                         std::vector<Node>(cols_, Node()));
 
     // map points into grids
     size_t tot_point_num = pc_ptr_->size();
     valid_indices_in_pc_ = &(valid_indices.indices);
     CHECK_LE(valid_indices_in_pc_->size(), tot_point_num);
     point2grid_.assign(valid_indices_in_pc_->size(), -1);
+    // the point numbers matter only if the empty grids are not clustered.
+    if (!use_all_grids_for_clustering) {
+      std::fill(point_num_.begin(), point_num_.end(), 0);
+    }
 
     for (size_t i = 0; i < valid_indices_in_pc_->size(); ++i) {
       int point_id = valid_indices_in_pc_->at(i);
@@ -97,98 +113,113 @@ class Cluster2D {
       int pos_x = F2I(point.y, range_, inv_res_x_);  // col
       int pos_y = F2I(point.x, range_, inv_res_y_);  // row
       if (IsValidRowCol(pos_y, pos_x)) {
-        // get grid index and count point number for corresponding node
+        // get grid index and count point number for corresponding grid
         point2grid_[i] = RowCol2Grid(pos_y, pos_x);
-        nodes[pos_y][pos_x].point_num++;
+        if (!use_all_grids_for_clustering) {
+          point_num_[point2grid_[i]]++;
+        }
       }
     }
 
-    // construct graph with center offset prediction and objectness
-    for (int row = 0; row < rows_; row++) {
-      for (int col = 0; col < cols_; col++) {
-        int grid = RowCol2Grid(row, col);
-        Node* node = &nodes[row][col];
-        apollo::perception::DisjointSetMakeSet(node);
-        node->is_object =
-            (use_all_grids_for_clustering || nodes[row][col].point_num > 0) &&
-            (*(category_pt_data + grid) >= objectness_thresh);
-        int center_row = std::round(row + instance_pt_x_data[grid] * scale_);
-        int center_col = std::round(col + instance_pt_y_data[grid] * scale_);
-        center_row = std::min(std::max(center_row, 0), rows_ - 1);
-        center_col = std::min(std::max(center_col, 0), cols_ - 1);
-        node->center_node = &nodes[center_row][center_col];
-      }
+    // collect the object grids in row-major order, without a branch on the
+    // objectness.
+    object_grid_num_ = 0;
+    for (int grid = 0; grid < grids_; ++grid) {
+      object_grids_[object_grid_num_] = grid;
+      object_grid_num_ +=
+          (use_all_grids_for_clustering || point_num_[grid] > 0) &&
+          (category_pt_data[grid] >= objectness_thresh);
     }
 
-    // traverse nodes
-    for (int row = 0; row < rows_; row++) {
-      for (int col = 0; col < cols_; col++) {
-        Node* node = &nodes[row][col];
-        if (node->is_object && node->traversed == 0) {
-          Traverse(node);
-        }
+    // follow the center pointers from each object grid, until a grid
+    // already visited. A grid visited by the same walk closes a new cycle:
+    // its grids are centers, and its entry grid is the root of all the grids
+    // leading to it. Otherwise the grids of the walk join the root of the
+    // grid they reached. So each grid is visited by a single walk, and all the
+    // trees are flat before the union of the centers.
+    std::fill(walk_.begin(), walk_.end(), 0);
+    center_grids_.clear();
+    for (int i = 0; i < object_grid_num_; ++i) {
+      const int start = object_grids_[i];
+      if (walk_[start] != 0) {
+        continue;
+      }
+      const int walk = i + 1;
+      int grid = start;
+      while (walk_[grid] == 0) {
+        walk_[grid] = walk;
+        apollo::perception::DisjointSetMakeSet(&nodes_[grid]);
+        nodes_[grid].obstacle_id = -1;
+        center_[grid] = CenterGrid(grid, instance_pt_x_data[grid],
+                                   instance_pt_y_data[grid]);
+        grid = center_[grid];
+      }
+      Node* root = nodes_[grid].parent;
+      if (walk_[grid] == walk) {
+        int cycle_grid = grid;
+        do {
+          is_center_[cycle_grid] = 1;
+          center_grids_.push_back(cycle_grid);
+          nodes_[cycle_grid].parent = root;
+          cycle_grid = center_[cycle_grid];
+        } while (cycle_grid != grid);
+      }
+      for (int path_grid = start; path_grid != grid;
+           path_grid = center_[path_grid]) {
+        nodes_[path_grid].parent = root;
       }
     }
-    for (int row = 0; row < rows_; row++) {
-      for (int col = 0; col < cols_; col++) {
-        Node* node = &nodes[row][col];
-        if (!node->is_center) {
-          continue;
-        }
-        for (int row2 = row - 1; row2 <= row + 1; row2++) {
-          for (int col2 = col - 1; col2 <= col + 1; col2++) {
-            if ((row2 == row || col2 == col) && IsValidRowCol(row2, col2)) {
-              Node* node2 = &nodes[row2][col2];
-              if (node2->is_center) {
-                apollo::perception::DisjointSetUnion(node, node2);
-              }
-            }
-          }
-        }
+
+    // unite the centers with their right and bottom neighbor centers, then
+    // clear the center flags for the next frame.
+    for (const int grid : center_grids_) {
+      const int col = grid % cols_;
+      if (col + 1 < cols_ && is_center_[grid + 1]) {
+        apollo::perception::DisjointSetUnion(&nodes_[grid], &nodes_[grid + 1]);
+      }
+      if (grid + cols_ < grids_ && is_center_[grid + cols_]) {
+        apollo::perception::DisjointSetUnion(&nodes_[grid],
+                                             &nodes_[grid + cols_]);
       }
     }
+    for (const int grid : center_grids_) {
+      is_center_[grid] = 0;
+    }
 
-    int count_obstacles = 0;
+    // number the obstacles in the row-major order of their first grid.
     obstacles_.clear();
-    id_img_.assign(grids_, -1);
-    for (int row = 0; row < rows_; row++) {
-      for (int col = 0; col < cols_; col++) {
-        Node* node = &nodes[row][col];
-        if (!node->is_object) {
-          continue;
-        }
-        Node* root = apollo::perception::DisjointSetFind(node);
-        if (root->obstacle_id < 0) {
-          root->obstacle_id = count_obstacles++;
-          CHECK_EQ(static_cast<int>(obstacles_.size()), count_obstacles - 1);
-          obstacles_.push_back(Obstacle());
-        }
-        int grid = RowCol2Grid(row, col);
-        CHECK_GE(root->obstacle_id, 0);
-        id_img_[grid] = root->obstacle_id;
-        obstacles_[root->obstacle_id].grids.push_back(grid);
+    std::fill(id_img_.begin(), id_img_.end(), -1);
+    for (int i = 0; i < object_grid_num_; ++i) {
+      const int grid = object_grids_[i];
+      Node* root = apollo::perception::DisjointSetFind(&nodes_[grid]);
+      if (root->obstacle_id < 0) {
+        root->obstacle_id = static_cast<int>(obstacles_.size());
+        obstacles_.push_back(Obstacle());
       }
+      id_img_[grid] = root->obstacle_id;
+      obstacles_[root->obstacle_id].grid_num++;
     }
-    CHECK_EQ(static_cast<int>(count_obstacles), obstacles_.size());
   }
 
   void Filter(const caffe::Blob<float>& confidence_pt_blob,
               const caffe::Blob<float>& height_pt_blob) {
     const float* confidence_pt_data = confidence_pt_blob.cpu_data();
     const float* height_pt_data = height_pt_blob.cpu_data();
+    score_sum_.assign(obstacles_.size(), 0.0);
+    height_sum_.assign(obstacles_.size(), 0.0);
+    for (int i = 0; i < object_grid_num_; ++i) {
+      const int grid = object_grids_[i];
+      const int obstacle_id = id_img_[grid];
+      score_sum_[obstacle_id] += static_cast<double>(confidence_pt_data[grid]);
+      height_sum_[obstacle_id] += static_cast<double>(height_pt_data[grid]);
+    }
     for (size_t obstacle_id = 0; obstacle_id < obstacles_.size();
          obstacle_id++) {
       Obstacle* obs = &obstacles_[obstacle_id];
-      CHECK_GT(obs->grids.size(), 0);
-      double score = 0.0;
-      double height = 0.0;
-      for (int grid : obs->grids) {
-        score += static_cast<double>(confidence_pt_data[grid]);
-        height += static_cast<double>(height_pt_data[grid]);
-      }
-      obs->score = score / static_cast<double>(obs->grids.size());
-      obs->height = height / static_cast<double>(obs->grids.size());
-      obs->cloud.reset(new apollo::perception::pcl_util::PointCloud);
+      CHECK_GT(obs->grid_num, 0);
+      obs->score = score_sum_[obstacle_id] / static_cast<double>(obs->grid_num);
+      obs->height =
+          height_sum_[obstacle_id] / static_cast<double>(obs->grid_num);
     }
   }
 
@@ -198,13 +229,16 @@ class Cluster2D {
                   std::vector<ObjectPtr>* objects) {
     CHECK(valid_indices_in_pc_ != nullptr);
 
+    // a counting sort of the points by obstacle: count the points kept by
+    // each obstacle, size its cloud, then scatter the points in order.
+    point_obstacle_ids_.assign(point2grid_.size(), -1);
+    obstacle_point_num_.assign(obstacles_.size(), 0);
     for (size_t i = 0; i < point2grid_.size(); ++i) {
       int grid = point2grid_[i];
       if (grid < 0) {
         continue;
       }
 
-      CHECK_GE(grid, 0);
       CHECK_LT(grid, grids_);
       int obstacle_id = id_img_[grid];
 
@@ -217,15 +251,42 @@ class Cluster2D {
         if (height_thresh < 0 ||
             pc_ptr_->points[point_id].z <=
                 obstacles_[obstacle_id].height + height_thresh) {
-          obstacles_[obstacle_id].cloud->push_back(pc_ptr_->points[point_id]);
+          point_obstacle_ids_[i] = obstacle_id;
+          obstacle_point_num_[obstacle_id]++;
         }
       }
     }
 
+    obstacle_cursors_.assign(obstacles_.size(), nullptr);
+    obstacle_has_cloud_.assign(obstacles_.size(), 0);
+    for (size_t obstacle_id = 0; obstacle_id < obstacles_.size();
+         obstacle_id++) {
+      const int point_num = obstacle_point_num_[obstacle_id];
+      if (point_num < min_pts_num) {
+        continue;
+      }
+      Obstacle* obs = &obstacles_[obstacle_id];
+      obs->cloud.reset(new apollo::perception::pcl_util::PointCloud);
+      obs->cloud->points.resize(point_num);
+      obs->cloud->width = static_cast<uint32_t>(point_num);
+      obs->cloud->height = 1;
+      // the data of an empty cloud may be null: the flag tells it is kept.
+      obstacle_cursors_[obstacle_id] = obs->cloud->points.data();
+      obstacle_has_cloud_[obstacle_id] = 1;
+    }
+
+    for (size_t i = 0; i < point2grid_.size(); ++i) {
+      const int obstacle_id = point_obstacle_ids_[i];
+      if (obstacle_id >= 0 && obstacle_has_cloud_[obstacle_id]) {
+        *obstacle_cursors_[obstacle_id]++ =
+            pc_ptr_->points[valid_indices_in_pc_->at(i)];
+      }
+    }
+
     for (size_t obstacle_id = 0; obstacle_id < obstacles_.size();
          obstacle_id++) {
       Obstacle* obs = &obstacles_[obstacle_id];
-      if (static_cast<int>(obs->cloud->size()) < min_pts_num) {
+      if (!obstacle_has_cloud_[obstacle_id]) {
         continue;
       }
       apollo::perception::ObjectPtr out_obj(new apollo::perception::Object);
@@ -236,24 +297,15 @@ class Cluster2D {
   }
 
  private:
+  // a grid in the disjoint sets of grids.
   struct Node {
-    Node* center_node;
     Node* parent;
     char node_rank;
-    char traversed;
-    bool is_center;
-    bool is_object;
-    int point_num;
     int obstacle_id;
 
     Node() {
-      center_node = nullptr;
       parent = nullptr;
       node_rank = 0;
-      traversed = 0;
-      is_center = false;
-      is_object = false;
-      point_num = 0;
       obstacle_id = -1;
     }
   };
@@ -274,25 +326,17 @@ class Cluster2D {
     return row * cols_ + col;
   }
 
-  void Traverse(Node* x) {
-    std::vector<Node*> p;
-    p.clear();
-    while (x->traversed == 0) {
-      p.push_back(x);
-      x->traversed = 2;
-      x = x->center_node;
-    }
-    if (x->traversed == 2) {
-      for (int i = static_cast<int>(p.size()) - 1; i >= 0 && p[i] != x; i--) {
-        p[i]->is_center = true;
-      }
-      x->is_center = true;
-    }
-    for (size_t i = 0; i < p.size(); i++) {
-      Node* y = p[i];
-      y->traversed = 1;
-      y->parent = x->parent;
-    }
+  // the grid of the object center predicted for the grid, clamped to the
+  // grid map.
+  inline int CenterGrid(int grid, float instance_pt_x,
+                        float instance_pt_y) const {
+    const int row = grid / cols_;
+    const int col = grid - row * cols_;
+    int center_row = std::round(row + instance_pt_x * scale_);
+    int center_col = std::round(col + instance_pt_y * scale_);
+    center_row = std::min(std::max(center_row, 0), rows_ - 1);
+    center_col = std::min(std::max(center_col, 0), cols_ - 1);
+    return RowCol2Grid(center_row, center_col);
   }
 
   int rows_;
@@ -309,6 +353,31 @@ class Cluster2D {
   std::vector<int> point2grid_;
   std::vector<int> id_img_;
   std::vector<Obstacle> obstacles_;
+
+  // per grid
+  std::vector<int> point_num_;
+  std::vector<int> center_;
+  // the 1-based index of the walk which visited the grid, 0 if none did.
+  std::vector<int> walk_;
+  std::vector<char> is_center_;
+  std::vector<Node> nodes_;
+
+  // the first object_grid_num_ grids are the object grids.
+  std::vector<int> object_grids_;
+  int object_grid_num_ = 0;
+  std::vector<int> center_grids_;
+
+  // per obstacle
+  std::vector<double> score_sum_;
+  std::vector<double> height_sum_;
+  std::vector<int> obstacle_point_num_;
+  // where the next point of the obstacle goes, if it has a cloud.
+  std::vector<apollo::perception::pcl_util::Point*> obstacle_cursors_;
+  // whether the obstacle has enough points to get a cloud.
+  std::vector<char> obstacle_has_cloud_;
+
+  // per valid point, the obstacle which keeps it, or -1.
+  std::vector<int> point_obstacle_ids_;
 };
 
 }  // namespace cnnseg
@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the clustering of the cnnseg network outputs into
+ * objects, by number of obstacles, on the grid and about the number of points
+ * of the cnnseg test data.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/cluster2d.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+namespace {
+
+// the grid of cnnseg.conf.
+const int kRows = 512;
+const int kCols = 512;
+const float kRange = 60.0f;
+// the test cloud has 195626 points.
+const int kBackgroundPoints = 150000;
+const int kObstaclePoints = 150;
+
+// The outputs of the network for a scene of boxes, whose grids point to their
+// centers, with some noise, among background grids.
+struct Scene {
+  caffe::Blob<float> category_blob;
+  caffe::Blob<float> instance_blob;
+  caffe::Blob<float> confidence_blob;
+  caffe::Blob<float> height_blob;
+  pcl_util::PointCloudPtr cloud;
+  pcl_util::PointIndices indices;
+};
+
+void MakeScene(const int num_obstacles, Scene* scene) {
+  std::mt19937 random_engine(num_obstacles);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  std::normal_distribution<float> noise(0.0f, 0.3f);
+  const float scale = 0.5f * kRows / kRange;
+
+  for (caffe::Blob<float>* blob :
+       {&scene->category_blob, &scene->confidence_blob, &scene->height_blob}) {
+    blob->Reshape(1, 1, kRows, kCols);
+  }
+  scene->instance_blob.Reshape(1, 2, kRows, kCols);
+  float* category = scene->category_blob.mutable_cpu_data();
+  float* instance_x = scene->instance_blob.mutable_cpu_data();
+  float* instance_y = instance_x + scene->instance_blob.offset(0, 1);
+  float* confidence = scene->confidence_blob.mutable_cpu_data();
+  float* height = scene->height_blob.mutable_cpu_data();
+  for (int grid = 0; grid < kRows * kCols; ++grid) {
+    category[grid] = 0.4f * unit(random_engine);
+    instance_x[grid] = noise(random_engine) / scale;
+    instance_y[grid] = noise(random_engine) / scale;
+    confidence[grid] = 0.05f;
+    height[grid] = 0.0f;
+  }
+
+  scene->cloud.reset(new pcl_util::PointCloud);
+  auto add_point = [&scene](float row, float col, float z) {
+    pcl_util::Point point;
+    point.x = kRange - row / (0.5f * kRows / kRange);
+    point.y = kRange - col / (0.5f * kCols / kRange);
+    point.z = z;
+    scene->cloud->push_back(point);
+  };
+  std::normal_distribution<float> background(0.5f * kRows, 0.2f * kRows);
+  for (int i = 0; i < kBackgroundPoints; ++i) {
+    add_point(background(random_engine), background(random_engine),
+              -1.5f + 0.2f * unit(random_engine));
+  }
+
+  // boxes of 2 to 8 m, so the larger ones may overlap.
+  std::uniform_int_distribution<int> size(8, 34);
+  std::uniform_int_distribution<int> position(0, kRows - 35);
+  for (int i = 0; i < num_obstacles; ++i) {
+    const int rows = size(random_engine);
+    const int cols = size(random_engine);
+    const int top = position(random_engine);
+    const int left = position(random_engine);
+    const float center_row = top + 0.5f * rows;
+    const float center_col = left + 0.5f * cols;
+    const float object_height = 1.0f + unit(random_engine);
+    for (int row = top; row < top + rows; ++row) {
+      for (int col = left; col < left + cols; ++col) {
+        const int grid = row * kCols + col;
+        category[grid] = 0.6f + 0.4f * unit(random_engine);
+        instance_x[grid] = (center_row - row + noise(random_engine)) / scale;
+        instance_y[grid] = (center_col - col + noise(random_engine)) / scale;
+        confidence[grid] = 0.5f + 0.5f * unit(random_engine);
+        height[grid] = object_height;
+      }
+    }
+    for (int j = 0; j < kObstaclePoints; ++j) {
+      add_point(top + rows * unit(random_engine),
+                left + cols * unit(random_engine),
+                -1.5f + 2.5f * object_height * unit(random_engine));
+    }
+  }
+  scene->indices.indices.resize(scene->cloud->size());
+  std::iota(scene->indices.indices.begin(), scene->indices.indices.end(), 0);
+}
+
+}  // namespace
+
+// Arg: the number of obstacles of the scene. Clusters with the parameters
+// of cnnseg.conf.
+void BM_Cluster(benchmark::State& state) {
+  Scene scene;
+  MakeScene(state.range(0), &scene);
+  Cluster2D cluster2d;
+  CHECK(cluster2d.Init(kRows, kCols, kRange));
+  std::vector<ObjectPtr> objects;
+  while (state.KeepRunning()) {
+    objects.clear();
+    cluster2d.Cluster(scene.category_blob, scene.instance_blob, scene.cloud,
+                      scene.indices, 0.5f, true);
+    cluster2d.Filter(scene.confidence_blob, scene.height_blob);
+    cluster2d.GetObjects(0.1f, 0.5f, 3, &objects);
+  }
+  state.SetLabel(std::to_string(objects.size()) + " objects");
+}
+BENCHMARK(BM_Cluster)
+    ->Arg(0)
+    ->Arg(20)
+    ->Arg(50)
+    ->Arg(100)
+    ->Arg(200)
+    ->Arg(400)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
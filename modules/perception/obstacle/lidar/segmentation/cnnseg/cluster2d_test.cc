@@ -0,0 +1,306 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/cluster2d.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+namespace {
+
+using apollo::perception::pcl_util::Point;
+using apollo::perception::pcl_util::PointCloud;
+using apollo::perception::pcl_util::PointCloudPtr;
+using apollo::perception::pcl_util::PointIndices;
+
+// a 32 x 32 grid of 1 m cells, so the instance offsets are in cells.
+const int kRows = 32;
+const int kCols = 32;
+const float kRange = 16.0f;
+
+class Cluster2DTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    category_blob_.Reshape(1, 1, kRows, kCols);
+    instance_blob_.Reshape(1, 2, kRows, kCols);
+    confidence_blob_.Reshape(1, 1, kRows, kCols);
+    height_blob_.Reshape(1, 1, kRows, kCols);
+    for (caffe::Blob<float>* blob : {&category_blob_, &instance_blob_,
+                                     &confidence_blob_, &height_blob_}) {
+      std::fill(blob->mutable_cpu_data(),
+                blob->mutable_cpu_data() + blob->count(), 0.0f);
+    }
+    cloud_.reset(new PointCloud);
+    ASSERT_TRUE(cluster2d_.Init(kRows, kCols, kRange));
+  }
+
+  // an object grid of the given score and height, pointing to the center.
+  void SetObjectGrid(int row, int col, int center_row, int center_col,
+                     float score, float height) {
+    const int grid = row * kCols + col;
+    category_blob_.mutable_cpu_data()[grid] = 1.0f;
+    instance_blob_.mutable_cpu_data()[grid] =
+        static_cast<float>(center_row - row);
+    instance_blob_.mutable_cpu_data()[instance_blob_.offset(0, 1) + grid] =
+        static_cast<float>(center_col - col);
+    confidence_blob_.mutable_cpu_data()[grid] = score;
+    height_blob_.mutable_cpu_data()[grid] = height;
+  }
+
+  // a point in the middle of the grid: the rows go along -x, the columns
+  // along -y.
+  void AddPoint(int row, int col, float z) {
+    Point point;
+    point.x = kRange - row - 0.5f;
+    point.y = kRange - col - 0.5f;
+    point.z = z;
+    point.intensity = static_cast<float>(cloud_->size());
+    cloud_->push_back(point);
+  }
+
+  std::vector<ObjectPtr> GetObjects(float confidence_thresh,
+                                    float height_thresh, int min_pts_num) {
+    indices_.indices.resize(cloud_->size());
+    std::iota(indices_.indices.begin(), indices_.indices.end(), 0);
+    cluster2d_.Cluster(category_blob_, instance_blob_, cloud_, indices_, 0.5f,
+                       true);
+    cluster2d_.Filter(confidence_blob_, height_blob_);
+    std::vector<ObjectPtr> objects;
+    cluster2d_.GetObjects(confidence_thresh, height_thresh, min_pts_num,
+                          &objects);
+    return objects;
+  }
+
+  // the indices of the points of the object.
+  static std::vector<int> PointIds(const ObjectPtr& object) {
+    std::vector<int> ids;
+    for (const Point& point : object->cloud->points) {
+      ids.push_back(static_cast<int>(point.intensity));
+    }
+    return ids;
+  }
+
+  caffe::Blob<float> category_blob_;
+  caffe::Blob<float> instance_blob_;
+  caffe::Blob<float> confidence_blob_;
+  caffe::Blob<float> height_blob_;
+  PointCloudPtr cloud_;
+  PointIndices indices_;
+  Cluster2D cluster2d_;
+};
+
+// The obstacle of each object grid, as the first one of its grids in
+// row-major order: by following the center pointers of each object grid to
+// its cycle, then merging the cycles next to each other.
+std::vector<int> ReferenceObstacles(const std::vector<int>& centers,
+                                    const std::vector<bool>& is_object) {
+  const int grids = kRows * kCols;
+  std::vector<int> cycle(grids, -1);
+  std::vector<bool> is_center(grids, false);
+  for (int grid = 0; grid < grids; ++grid) {
+    if (!is_object[grid]) {
+      continue;
+    }
+    std::set<int> visited;
+    int x = grid;
+    while (visited.insert(x).second) {
+      x = centers[x];
+    }
+    // x is on the cycle: name it by its smallest grid.
+    int first = x;
+    for (int y = centers[x]; y != x; y = centers[y]) {
+      first = std::min(first, y);
+    }
+    for (int y = centers[x];; y = centers[y]) {
+      is_center[y] = true;
+      cycle[y] = first;
+      if (y == x) {
+        break;
+      }
+    }
+    cycle[grid] = first;
+  }
+  std::vector<int> parent(grids);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](int x) {
+    while (parent[x] != x) {
+      x = parent[x];
+    }
+    return x;
+  };
+  for (int grid = 0; grid < grids; ++grid) {
+    if (!is_center[grid]) {
+      continue;
+    }
+    if (grid % kCols + 1 < kCols && is_center[grid + 1]) {
+      parent[find(cycle[grid])] = find(cycle[grid + 1]);
+    }
+    if (grid + kCols < grids && is_center[grid + kCols]) {
+      parent[find(cycle[grid])] = find(cycle[grid + kCols]);
+    }
+  }
+  std::vector<int> obstacles(grids, -1);
+  std::vector<int> first_grid(grids, -1);
+  for (int grid = 0; grid < grids; ++grid) {
+    if (is_object[grid]) {
+      const int root = find(cycle[grid]);
+      if (first_grid[root] < 0) {
+        first_grid[root] = grid;
+      }
+      obstacles[grid] = first_grid[root];
+    }
+  }
+  return obstacles;
+}
+
+}  // namespace
+
+TEST_F(Cluster2DTest, test_cluster_objects) {
+  // a 3 x 3 object centered on (3, 3), and a 3 x 4 one with two centers
+  // next to each other.
+  for (int row = 2; row <= 4; ++row) {
+    for (int col = 2; col <= 4; ++col) {
+      SetObjectGrid(row, col, 3, 3, 0.8f, 1.0f);
+    }
+  }
+  for (int row = 10; row <= 12; ++row) {
+    for (int col = 20; col <= 23; ++col) {
+      SetObjectGrid(row, col, 11, col < 22 ? 21 : 22, 0.6f, 2.0f);
+    }
+  }
+  AddPoint(11, 23, 0.0f);
+  AddPoint(3, 3, 0.0f);
+  AddPoint(2, 4, 1.5f);
+  AddPoint(20, 5, 0.0f);  // background
+  AddPoint(12, 20, 2.4f);
+  AddPoint(4, 2, 1.6f);  // above the height of the object
+  AddPoint(3, 3, 0.5f);
+
+  std::vector<ObjectPtr> objects = GetObjects(0.1f, 0.5f, 1);
+  ASSERT_EQ(2, objects.size());
+  EXPECT_FLOAT_EQ(0.8f, objects[0]->score);
+  EXPECT_EQ(std::vector<int>({1, 2, 6}), PointIds(objects[0]));
+  EXPECT_EQ(3, objects[0]->cloud->width);
+  EXPECT_EQ(1, objects[0]->cloud->height);
+  EXPECT_FLOAT_EQ(0.6f, objects[1]->score);
+  EXPECT_EQ(std::vector<int>({0, 4}), PointIds(objects[1]));
+
+  // no height threshold.
+  objects = GetObjects(0.1f, -1.0f, 1);
+  ASSERT_EQ(2, objects.size());
+  EXPECT_EQ(std::vector<int>({1, 2, 5, 6}), PointIds(objects[0]));
+
+  // the second object has too few points, or a too low score.
+  objects = GetObjects(0.1f, 0.5f, 3);
+  ASSERT_EQ(1, objects.size());
+  EXPECT_EQ(std::vector<int>({1, 2, 6}), PointIds(objects[0]));
+  objects = GetObjects(0.7f, 0.5f, 1);
+  ASSERT_EQ(1, objects.size());
+  EXPECT_FLOAT_EQ(0.8f, objects[0]->score);
+}
+
+TEST_F(Cluster2DTest, test_empty_objects) {
+  // without a minimum of points, an object keeping no point is output with an
+  // empty cloud.
+  SetObjectGrid(5, 5, 5, 5, 1.0f, 0.0f);
+  SetObjectGrid(9, 9, 9, 9, 1.0f, 0.0f);
+  AddPoint(5, 5, 0.0f);
+  AddPoint(9, 9, 2.0f);  // above the height of the object
+  std::vector<ObjectPtr> objects = GetObjects(0.1f, 0.5f, 0);
+  ASSERT_EQ(2, objects.size());
+  EXPECT_EQ(std::vector<int>({0}), PointIds(objects[0]));
+  ASSERT_TRUE(objects[1]->cloud != nullptr);
+  EXPECT_TRUE(objects[1]->cloud->points.empty());
+
+  objects = GetObjects(0.1f, 0.5f, 1);
+  ASSERT_EQ(1, objects.size());
+}
+
+TEST_F(Cluster2DTest, test_diagonal_centers) {
+  // the centers are merged only with their 4 neighbors.
+  SetObjectGrid(5, 5, 5, 5, 1.0f, 0.0f);
+  SetObjectGrid(6, 6, 6, 6, 1.0f, 0.0f);
+  SetObjectGrid(6, 7, 6, 6, 1.0f, 0.0f);
+  AddPoint(5, 5, 0.0f);
+  AddPoint(6, 7, 0.0f);
+  std::vector<ObjectPtr> objects = GetObjects(0.1f, 0.5f, 1);
+  ASSERT_EQ(2, objects.size());
+  EXPECT_EQ(std::vector<int>({0}), PointIds(objects[0]));
+  EXPECT_EQ(std::vector<int>({1}), PointIds(objects[1]));
+}
+
+TEST_F(Cluster2DTest, test_same_obstacles_as_reference) {
+  // random center pointers, with cycles and paths through the grids which
+  // are not objects, over several frames.
+  std::mt19937 random_engine(7);
+  std::uniform_int_distribution<int> offset(-3, 3);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  for (int frame = 0; frame < 5; ++frame) {
+    std::vector<int> centers(kRows * kCols);
+    std::vector<bool> is_object(kRows * kCols);
+    cloud_->clear();
+    for (int row = 0; row < kRows; ++row) {
+      for (int col = 0; col < kCols; ++col) {
+        const int grid = row * kCols + col;
+        const bool still = unit(random_engine) < 0.2f;
+        const int center_row =
+            std::min(std::max(row + (still ? 0 : offset(random_engine)), 0),
+                     kRows - 1);
+        const int center_col =
+            std::min(std::max(col + (still ? 0 : offset(random_engine)), 0),
+                     kCols - 1);
+        SetObjectGrid(row, col, center_row, center_col, 1.0f, 0.0f);
+        centers[grid] = center_row * kCols + center_col;
+        is_object[grid] = unit(random_engine) < 0.6f;
+        category_blob_.mutable_cpu_data()[grid] = is_object[grid] ? 1.0f : 0.0f;
+        AddPoint(row, col, 0.0f);
+      }
+    }
+
+    // all the obstacles, with a point in each of their grids.
+    std::vector<ObjectPtr> objects = GetObjects(0.0f, -1.0f, 0);
+    const std::vector<int> obstacles = ReferenceObstacles(centers, is_object);
+    std::vector<int> first_grids;
+    for (int grid = 0; grid < kRows * kCols; ++grid) {
+      if (obstacles[grid] == grid) {
+        first_grids.push_back(grid);
+      }
+    }
+    ASSERT_EQ(first_grids.size(), objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+      std::vector<int> grids;
+      for (int grid = 0; grid < kRows * kCols; ++grid) {
+        if (obstacles[grid] == first_grids[i]) {
+          grids.push_back(grid);
+        }
+      }
+      EXPECT_EQ(grids, PointIds(objects[i]));
+    }
+  }
+}
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
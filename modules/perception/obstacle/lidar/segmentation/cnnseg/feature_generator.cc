@@ -90,34 +90,58 @@ bool FeatureGenerator<Dtype>::Init(const FeatureParam& feature_param,
   caffe::caffe_copy(siz, direction_data.data(), direction_data_);
   caffe::caffe_copy(siz, distance_data.data(), distance_data_);
 
+  thread_pool_.reset();
+  if (feature_param.num_threads() > 0) {
+    thread_pool_.reset(
+        new common::util::ThreadPool(feature_param.num_threads()));
+  }
   return true;
 }
 
 template <typename Dtype>
 void FeatureGenerator<Dtype>::Generate(
     const apollo::perception::pcl_util::PointCloudConstPtr& pc_ptr) {
-  const auto& points = pc_ptr->points;
+  const auto& cloud = *pc_ptr;
 
   // DO NOT remove this line!!!
   // Otherwise, the gpu_data will not be updated for the later frames.
   // It marks the head at cpu for blob.
   out_blob_->mutable_cpu_data();
 
-  int siz = height_ * width_;
-  caffe::caffe_set(siz, Dtype(-5), max_height_data_);
-  caffe::caffe_set(siz, Dtype(0), mean_height_data_);
-  caffe::caffe_set(siz, Dtype(0), count_data_);
-  caffe::caffe_set(siz, Dtype(0), top_intensity_data_);
-  caffe::caffe_set(siz, Dtype(0), mean_intensity_data_);
-  caffe::caffe_set(siz, Dtype(0), nonempty_data_);
-
-  map_idx_.resize(points.size());
+  map_idx_.resize(cloud.points.size());
+  const size_t num_tasks =
+      thread_pool_ == nullptr ? 1 : thread_pool_->size() + 1;
+
+  // the points are mapped in chunks.
+  common::util::ParallelFor(
+      thread_pool_.get(), 0, num_tasks, [this, &cloud, num_tasks](size_t i) {
+        const size_t num_points = cloud.points.size();
+        MapPoints(cloud, num_points * i / num_tasks,
+                  num_points * (i + 1) / num_tasks);
+      });
+
+  // the cells are generated in bands of rows: each cell gets its points in
+  // the same order, so the same sums, whatever the number of bands.
+  common::util::ParallelFor(
+      thread_pool_.get(), 0, num_tasks, [this, &cloud, num_tasks](size_t i) {
+        const int begin = static_cast<int>(height_ * i / num_tasks) * width_;
+        const int end =
+            static_cast<int>(height_ * (i + 1) / num_tasks) * width_;
+        GenerateCells(cloud, begin, end);
+      });
+}
+
+template <typename Dtype>
+void FeatureGenerator<Dtype>::MapPoints(
+    const apollo::perception::pcl_util::PointCloud& cloud, size_t begin,
+    size_t end) {
+  const auto& points = cloud.points;
   float inv_res_x =
       0.5 * static_cast<float>(width_) / static_cast<float>(range_);
   float inv_res_y =
       0.5 * static_cast<float>(height_) / static_cast<float>(range_);
 
-  for (size_t i = 0; i < points.size(); ++i) {
+  for (size_t i = begin; i < end; ++i) {
     if (points[i].z <= min_height_ || points[i].z >= max_height_) {
       map_idx_[i] = -1;
       continue;
@@ -131,8 +155,27 @@ void FeatureGenerator<Dtype>::Generate(
       continue;
     }
     map_idx_[i] = pos_y * width_ + pos_x;
+  }
+}
 
-    int idx = map_idx_[i];
+template <typename Dtype>
+void FeatureGenerator<Dtype>::GenerateCells(
+    const apollo::perception::pcl_util::PointCloud& cloud, int begin,
+    int end) {
+  const auto& points = cloud.points;
+  const int siz = end - begin;
+  caffe::caffe_set(siz, Dtype(-5), max_height_data_ + begin);
+  caffe::caffe_set(siz, Dtype(0), mean_height_data_ + begin);
+  caffe::caffe_set(siz, Dtype(0), count_data_ + begin);
+  caffe::caffe_set(siz, Dtype(0), top_intensity_data_ + begin);
+  caffe::caffe_set(siz, Dtype(0), mean_intensity_data_ + begin);
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    const int idx = map_idx_[i];
+    // the points out of the grid, at -1, are out of every band.
+    if (idx < begin || idx >= end) {
+      continue;
+    }
     float pz = points[i].z;
     float pi = points[i].intensity / 255.0;
     if (max_height_data_[idx] < pz) {
@@ -144,14 +187,18 @@ void FeatureGenerator<Dtype>::Generate(
     count_data_[idx] += Dtype(1);
   }
 
-  for (int i = 0; i < siz; ++i) {
-    if (count_data_[i] < EPS) {
-      max_height_data_[i] = Dtype(0);
-    } else {
-      mean_height_data_[i] /= count_data_[i];
-      mean_intensity_data_[i] /= count_data_[i];
-      nonempty_data_[i] = Dtype(1);
-    }
+  // without branches, so vectorized: a count is an integer, so it is at
+  // least 1 in a nonempty cell, and the sums of an empty cell are 0.
+  for (int i = begin; i < end; ++i) {
+    const Dtype count = count_data_[i];
+    const bool is_empty = count < EPS;
+    const Dtype divisor = is_empty ? Dtype(1) : count;
+    max_height_data_[i] = is_empty ? Dtype(0) : max_height_data_[i];
+    mean_height_data_[i] /= divisor;
+    mean_intensity_data_[i] /= divisor;
+    nonempty_data_[i] = is_empty ? Dtype(0) : Dtype(1);
+  }
+  for (int i = begin; i < end; ++i) {
     count_data_[i] = LogCount(static_cast<int>(count_data_[i]));
   }
 }
@@ -18,10 +18,12 @@
 #define MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_FEATURE_GENERATOR_H_  // NOLINT
 
 #include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 #include "caffe/caffe.hpp"
 #include "modules/common/log.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
 #include "modules/perception/obstacle/lidar/segmentation/cnnseg/proto/cnnseg.pb.h"
 
@@ -38,6 +40,9 @@ class FeatureGenerator {
 
   bool Init(const FeatureParam& feature_param, caffe::Blob<Dtype>* out_blob);
 
+  // Generates the features of the points on FeatureParam::num_threads
+  // workers and the calling thread, with the same result whatever the number
+  // of threads.
   void Generate(const apollo::perception::pcl_util::PointCloudConstPtr& pc_ptr);
 
   inline std::string name() const { return "FeatureGenerator"; }
@@ -50,6 +55,15 @@ class FeatureGenerator {
     return std::log(static_cast<Dtype>(1 + count));
   }
 
+  // set the cells of the points in [begin, end) into map_idx_.
+  void MapPoints(const apollo::perception::pcl_util::PointCloud& cloud,
+                 size_t begin, size_t end);
+
+  // generate the features of the cells in [begin, end), from the points in
+  // them in the order of the cloud.
+  void GenerateCells(const apollo::perception::pcl_util::PointCloud& cloud,
+                     int begin, int end);
+
   std::vector<Dtype> log_table_;
 
   int width_ = 0;
@@ -74,6 +88,9 @@ class FeatureGenerator {
 
   // output Caffe blob
   caffe::Blob<Dtype>* out_blob_ = nullptr;
+
+  // null without worker threads.
+  std::unique_ptr<common::util::ThreadPool> thread_pool_;
 };
 
 typedef FeatureGenerator<float> FP32FeatureGenerator;
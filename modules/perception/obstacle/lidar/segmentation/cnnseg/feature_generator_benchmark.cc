@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the generation of the cnnseg features, by grid size,
+ * number of points and number of worker threads.
+ */
+
+#include <random>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/feature_generator.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+namespace {
+
+// points denser near the vehicle, as in a scan.
+pcl_util::PointCloudPtr MakeCloud(const int num_points) {
+  std::mt19937 random_engine(num_points);
+  std::normal_distribution<float> xy(0.0f, 25.0f);
+  std::uniform_real_distribution<float> z(-3.0f, 4.0f);
+  std::uniform_int_distribution<int> intensity(0, 255);
+  pcl_util::PointCloudPtr cloud(new pcl_util::PointCloud);
+  cloud->points.reserve(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    pcl_util::Point point;
+    point.x = xy(random_engine);
+    point.y = xy(random_engine);
+    point.z = z(random_engine);
+    point.intensity = intensity(random_engine);
+    cloud->push_back(point);
+  }
+  return cloud;
+}
+
+}  // namespace
+
+// Args: the width and height of the grid, the number of points, and the
+// number of worker threads.
+void BM_Generate(benchmark::State& state) {
+  FeatureParam feature_param;
+  feature_param.set_width(state.range(0));
+  feature_param.set_height(state.range(0));
+  feature_param.set_num_threads(state.range(2));
+  caffe::Blob<float> blob;
+  FP32FeatureGenerator feature_generator;
+  CHECK(feature_generator.Init(feature_param, &blob));
+  const pcl_util::PointCloudPtr cloud = MakeCloud(state.range(1));
+  while (state.KeepRunning()) {
+    feature_generator.Generate(cloud);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_Generate)
+    ->Args({512, 100000, 0})
+    ->Args({512, 100000, 3})
+    ->Args({512, 250000, 0})
+    ->Args({512, 250000, 3})
+    ->Args({640, 100000, 0})
+    ->Args({640, 100000, 3})
+    ->Args({640, 250000, 0})
+    ->Args({640, 250000, 3})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/feature_generator.h"
+
+#include <cstring>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+namespace {
+
+using apollo::perception::pcl_util::Point;
+using apollo::perception::pcl_util::PointCloud;
+using apollo::perception::pcl_util::PointCloudPtr;
+
+// points in and around the range of the grid, many in the same cells.
+PointCloudPtr MakeCloud(const int num_points) {
+  std::mt19937 random_engine(42);
+  std::uniform_real_distribution<float> xy(-70.0f, 70.0f);
+  std::uniform_real_distribution<float> z(-6.0f, 6.0f);
+  std::uniform_int_distribution<int> intensity(0, 255);
+  PointCloudPtr cloud(new PointCloud);
+  for (int i = 0; i < num_points; ++i) {
+    Point point;
+    point.x = i % 4 == 0 ? 10.0f : xy(random_engine);
+    point.y = i % 4 == 0 ? -10.0f : xy(random_engine);
+    point.z = z(random_engine);
+    point.intensity = intensity(random_engine);
+    cloud->push_back(point);
+  }
+  return cloud;
+}
+
+}  // namespace
+
+TEST(FeatureGeneratorTest, test_same_features_with_threads) {
+  PointCloudPtr cloud = MakeCloud(50000);
+  FeatureParam feature_param;
+  feature_param.set_width(256);
+  feature_param.set_height(256);
+
+  caffe::Blob<float> blob;
+  FP32FeatureGenerator feature_generator;
+  ASSERT_TRUE(feature_generator.Init(feature_param, &blob));
+  feature_generator.Generate(cloud);
+  const std::vector<float> features(blob.cpu_data(),
+                                    blob.cpu_data() + blob.count());
+
+  for (const int num_threads : {1, 3, 7}) {
+    feature_param.set_num_threads(num_threads);
+    caffe::Blob<float> parallel_blob;
+    FP32FeatureGenerator parallel_feature_generator;
+    ASSERT_TRUE(parallel_feature_generator.Init(feature_param, &parallel_blob));
+    // twice, to generate over the features of the previous frame.
+    parallel_feature_generator.Generate(MakeCloud(1000));
+    parallel_feature_generator.Generate(cloud);
+    ASSERT_EQ(parallel_blob.count(), blob.count());
+    EXPECT_EQ(0, memcmp(features.data(), parallel_blob.cpu_data(),
+                        features.size() * sizeof(float)))
+        << "num_threads: " << num_threads;
+  }
+
+  // the cell of (10, -10), with a quarter of the points, minus the ones out
+  // of the height range.
+  const int row = 256 / 2 - 10 * 256 / 120 - 1;
+  const int col = 256 / 2 + 10 * 256 / 120;
+  const int count_channel = 2;
+  const int nonempty_channel = 7;
+  EXPECT_GT(features[blob.offset(0, count_channel, row, col)],
+            std::log(1.0f + 9000));
+  EXPECT_FLOAT_EQ(features[blob.offset(0, nonempty_channel, row, col)], 1.0f);
+}
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
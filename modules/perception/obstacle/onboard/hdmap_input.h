@@ -42,6 +42,15 @@ class HDMapInput {
   //         all points are in the world frame
   bool GetROI(const pcl_util::PointD& pointd, HdmapStructPtr* mapptr);
 
+  // @brief: get roi polygon within map_radius of the point
+  //         all points are in the world frame
+  bool GetROI(const pcl_util::PointD& pointd, const double map_radius,
+              HdmapStructPtr* mapptr);
+
+  // @brief: the version of the map the roi comes from, changed each time
+  //         the map is loaded
+  uint64_t MapVersion() const;
+
   // @brief: get nearest lane direction
   bool GetNearestLaneDirection(const pcl_util::PointD& pointd,
                                Eigen::Vector3d* lane_direction);
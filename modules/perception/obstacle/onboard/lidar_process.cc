@@ -16,6 +16,7 @@
 
 #include "modules/perception/obstacle/onboard/lidar_process.h"
 
+#include <algorithm>
 #include <string>
 
 #include "Eigen/Core"
@@ -81,22 +82,21 @@ bool LidarProcess::Process(const sensor_msgs::PointCloud2& message) {
 
   PERF_BLOCK_START();
   /// get velodyne2world transfrom
-  std::shared_ptr<Matrix4d> velodyne_trans = std::make_shared<Matrix4d>();
-  if (!GetVelodyneTrans(kTimeStamp, velodyne_trans.get())) {
-    AERROR << "failed to get trans at timestamp: " << kTimeStamp;
-    error_code_ = common::PERCEPTION_ERROR_TF;
+  LidarFrame frame;
+  frame.timestamp = kTimeStamp;
+  if (!TransformFrame(&frame)) {
+    error_code_ = frame.error_code;
     return false;
   }
-  ADEBUG << "get trans pose succ.";
   PERF_BLOCK_END("lidar_get_velodyne2world_transfrom");
 
-  PointCloudPtr point_cloud(new PointCloud);
+  PointCloudPtr point_cloud = cloud_pool_.Get();
   TransPointCloudToPCL(message, &point_cloud);
   ADEBUG << "transform pointcloud success. points num is: "
          << point_cloud->points.size();
   PERF_BLOCK_END("lidar_transform_poindcloud");
 
-  if (!Process(timestamp_, point_cloud, velodyne_trans)) {
+  if (!Process(timestamp_, point_cloud, frame.velodyne_trans)) {
     AERROR << "faile to process msg at timestamp: " << kTimeStamp;
     return false;
   }
@@ -106,88 +106,222 @@ bool LidarProcess::Process(const sensor_msgs::PointCloud2& message) {
 
 bool LidarProcess::Process(const double timestamp, PointCloudPtr point_cloud,
                            std::shared_ptr<Matrix4d> velodyne_trans) {
+  LidarFrame frame;
+  frame.timestamp = timestamp;
+  frame.cloud = point_cloud;
+  frame.velodyne_trans = velodyne_trans;
+
   PERF_BLOCK_START();
+  if (!FilterROI(&frame)) {
+    error_code_ = frame.error_code;
+    return false;
+  }
+  if (frame.roi_indices != nullptr) {
+    roi_indices_ = frame.roi_indices;
+  }
+  PERF_BLOCK_END("lidar_roi_filter");
+
+  if (!Segment(&frame)) {
+    error_code_ = frame.error_code;
+    return false;
+  }
+  PERF_BLOCK_END("lidar_segmentation");
+
+  if (!BuildObjects(&frame)) {
+    error_code_ = frame.error_code;
+    return false;
+  }
+  PERF_BLOCK_END("lidar_object_builder");
+
+  const bool tracked = Track(&frame);
+  objects_ = frame.tracked_objects;
+  if (!tracked) {
+    error_code_ = frame.error_code;
+    return false;
+  }
+  PERF_BLOCK_END("lidar_tracker");
+  ADEBUG << "lidar process succ, there are " << objects_.size()
+         << " tracked objects.";
+  return true;
+}
+
+bool LidarProcess::StartPipeline(const ObstaclesCallback& callback) {
+  if (pipeline_ != nullptr) {
+    AERROR << "the lidar pipeline is already started.";
+    return false;
+  }
+  obstacles_callback_ = callback;
+  pipeline_.reset(new Pipeline<LidarFrame>(
+      static_cast<size_t>(std::max(1, FLAGS_lidar_pipeline_queue_size))));
+  // a stage skips the frames failed in the previous ones, which go on to the
+  // tracker stage to be published with their error code, in order.
+  pipeline_->AddStage("transform", [this](LidarFrame* frame) {
+    if (frame->velodyne_trans == nullptr) {
+      TransformFrame(frame);
+    }
+  });
+  pipeline_->AddStage("roi_filter", [this](LidarFrame* frame) {
+    if (frame->error_code == common::OK) {
+      FilterROI(frame);
+    }
+  });
+  pipeline_->AddStage("segmentation", [this](LidarFrame* frame) {
+    if (frame->error_code == common::OK) {
+      Segment(frame);
+    }
+  });
+  pipeline_->AddStage("object_builder", [this](LidarFrame* frame) {
+    if (frame->error_code == common::OK) {
+      BuildObjects(frame);
+    }
+  });
+  pipeline_->AddStage("tracker", [this](LidarFrame* frame) {
+    if (frame->error_code == common::OK) {
+      Track(frame);
+    }
+    PerceptionObstacles obstacles;
+    if (GeneratePbMsg(frame->timestamp, frame->error_code,
+                      frame->tracked_objects, &obstacles) &&
+        obstacles_callback_) {
+      obstacles_callback_(obstacles);
+    }
+    AINFO_EVERY(100) << "lidar pipeline stats:\n" << pipeline_->StatsString();
+  });
+  pipeline_->Start();
+  AINFO << "start lidar pipeline, queue size: "
+        << FLAGS_lidar_pipeline_queue_size;
+  return true;
+}
+
+void LidarProcess::StopPipeline() {
+  if (pipeline_ != nullptr) {
+    pipeline_->Stop();
+    AINFO << "stop lidar pipeline, stats:\n" << pipeline_->StatsString();
+    pipeline_.reset();
+  }
+}
+
+bool LidarProcess::Enqueue(const sensor_msgs::PointCloud2& message) {
+  // the message is only valid in the callback, so it is converted here.
+  PointCloudPtr point_cloud = cloud_pool_.Get();
+  TransPointCloudToPCL(message, &point_cloud);
+  return Enqueue(message.header.stamp.toSec(), point_cloud, nullptr);
+}
+
+bool LidarProcess::Enqueue(const double timestamp, PointCloudPtr point_cloud,
+                           std::shared_ptr<Matrix4d> velodyne_trans) {
+  CHECK(pipeline_ != nullptr) << "the lidar pipeline is not started.";
+  std::unique_ptr<LidarFrame> frame(new LidarFrame);
+  frame->timestamp = timestamp;
+  frame->cloud = point_cloud;
+  frame->velodyne_trans = velodyne_trans;
+  if (!pipeline_->Push(std::move(frame))) {
+    AWARN_EVERY(10) << "lidar pipeline is full, drop the oldest frame before "
+                    << "timestamp: " << std::fixed << timestamp;
+    return false;
+  }
+  return true;
+}
+
+bool LidarProcess::TransformFrame(LidarFrame* frame) {
+  std::shared_ptr<Matrix4d> velodyne_trans = std::make_shared<Matrix4d>();
+  if (!GetVelodyneTrans(frame->timestamp, velodyne_trans.get())) {
+    AERROR << "failed to get trans at timestamp: " << frame->timestamp;
+    frame->error_code = common::PERCEPTION_ERROR_TF;
+    return false;
+  }
+  frame->velodyne_trans = velodyne_trans;
+  ADEBUG << "get trans pose succ.";
+  return true;
+}
+
+bool LidarProcess::FilterROI(LidarFrame* frame) {
   /// call hdmap to get ROI
-  HdmapStructPtr hdmap = nullptr;
   if (hdmap_input_) {
+    PERF_BLOCK_START();
     PointD velodyne_pose = {0.0, 0.0, 0.0, 0};  // (0,0,0)
-    Affine3d temp_trans(*velodyne_trans);
+    Affine3d temp_trans(*frame->velodyne_trans);
     PointD velodyne_pose_world = pcl::transformPoint(velodyne_pose, temp_trans);
-    hdmap.reset(new HdmapStruct);
-    hdmap_input_->GetROI(velodyne_pose_world, &hdmap);
+    frame->hdmap.reset(new HdmapStruct);
+    hdmap_input_->GetROI(velodyne_pose_world, &frame->hdmap);
     PERF_BLOCK_END("lidar_get_roi_from_hdmap");
   }
 
   /// call roi_filter
-  PointCloudPtr roi_cloud(new PointCloud);
+  frame->roi_cloud.reset(new PointCloud);
   if (roi_filter_ != nullptr) {
     PointIndicesPtr roi_indices(new PointIndices);
     ROIFilterOptions roi_filter_options;
-    roi_filter_options.velodyne_trans = velodyne_trans;
-    roi_filter_options.hdmap = hdmap;
-    if (roi_filter_->Filter(point_cloud, roi_filter_options,
+    roi_filter_options.velodyne_trans = frame->velodyne_trans;
+    roi_filter_options.hdmap = frame->hdmap;
+    if (roi_filter_->Filter(frame->cloud, roi_filter_options,
                             roi_indices.get())) {
-      pcl::copyPointCloud(*point_cloud, *roi_indices, *roi_cloud);
-      roi_indices_ = roi_indices;
+      pcl::copyPointCloud(*frame->cloud, *roi_indices, *frame->roi_cloud);
+      frame->roi_indices = roi_indices;
     } else {
       AERROR << "failed to call roi filter.";
-      error_code_ = common::PERCEPTION_ERROR_PROCESS;
+      frame->error_code = common::PERCEPTION_ERROR_PROCESS;
       return false;
     }
   }
   ADEBUG << "call roi_filter succ. The num of roi_cloud is: "
-         << roi_cloud->points.size();
-  PERF_BLOCK_END("lidar_roi_filter");
+         << frame->roi_cloud->points.size();
+  return true;
+}
 
+bool LidarProcess::Segment(LidarFrame* frame) {
   /// call segmentor
-  std::vector<ObjectPtr> objects;
   if (segmentor_ != nullptr) {
     SegmentationOptions segmentation_options;
-    segmentation_options.origin_cloud = point_cloud;
+    segmentation_options.origin_cloud = frame->cloud;
     PointIndices non_ground_indices;
-    non_ground_indices.indices.resize(roi_cloud->points.size());
+    non_ground_indices.indices.resize(frame->roi_cloud->points.size());
     // non_ground_indices.indices.resize(point_cloud->points.size());
 
     std::iota(non_ground_indices.indices.begin(),
               non_ground_indices.indices.end(), 0);
-    if (!segmentor_->Segment(roi_cloud, non_ground_indices,
-                             segmentation_options, &objects)) {
+    if (!segmentor_->Segment(frame->roi_cloud, non_ground_indices,
+                             segmentation_options,
+                             &frame->segmented_objects)) {
       AERROR << "failed to call segmention.";
-      error_code_ = common::PERCEPTION_ERROR_PROCESS;
+      frame->error_code = common::PERCEPTION_ERROR_PROCESS;
       return false;
     }
   }
-  ADEBUG << "call segmentation succ. The num of objects is: " << objects.size();
-  PERF_BLOCK_END("lidar_segmentation");
+  ADEBUG << "call segmentation succ. The num of objects is: "
+         << frame->segmented_objects.size();
+  return true;
+}
 
+bool LidarProcess::BuildObjects(LidarFrame* frame) {
   /// call object builder
   if (object_builder_ != nullptr) {
     ObjectBuilderOptions object_builder_options;
-    if (!object_builder_->Build(object_builder_options, &objects)) {
+    if (!object_builder_->Build(object_builder_options,
+                                &frame->segmented_objects)) {
       AERROR << "failed to call object builder.";
-      error_code_ = common::PERCEPTION_ERROR_PROCESS;
+      frame->error_code = common::PERCEPTION_ERROR_PROCESS;
       return false;
     }
   }
   ADEBUG << "call object_builder succ.";
-  PERF_BLOCK_END("lidar_object_builder");
+  return true;
+}
 
+bool LidarProcess::Track(LidarFrame* frame) {
   /// call tracker
   if (tracker_ != nullptr) {
     TrackerOptions tracker_options;
-    tracker_options.velodyne_trans = velodyne_trans;
-    tracker_options.hdmap = hdmap;
+    tracker_options.velodyne_trans = frame->velodyne_trans;
+    tracker_options.hdmap = frame->hdmap;
     tracker_options.hdmap_input = hdmap_input_;
-    if (!tracker_->Track(objects, timestamp, tracker_options, &objects_)) {
+    if (!tracker_->Track(frame->segmented_objects, frame->timestamp,
+                         tracker_options, &frame->tracked_objects)) {
       AERROR << "failed to call tracker.";
-      error_code_ = common::PERCEPTION_ERROR_PROCESS;
+      frame->error_code = common::PERCEPTION_ERROR_PROCESS;
       return false;
     }
   }
-
-  PERF_BLOCK_END("lidar_tracker");
-  ADEBUG << "lidar process succ, there are " << objects_.size()
-         << " tracked objects.";
   return true;
 }
 
@@ -291,30 +425,13 @@ bool LidarProcess::InitAlgorithmPlugin() {
 
 void LidarProcess::TransPointCloudToPCL(const sensor_msgs::PointCloud2& in_msg,
                                         PointCloudPtr* out_cloud) {
-  // transform from ros to pcl
-  pcl::PointCloud<pcl_util::PointXYZIT> in_cloud;
-  pcl::fromROSMsg(in_msg, in_cloud);
-  // transform from xyzit to xyzi
+  // read the xyzi of the message straight into the cloud, without nan.
   PointCloudPtr& cloud = *out_cloud;
-  cloud->header = in_cloud.header;
-  cloud->width = in_cloud.width;
-  cloud->height = in_cloud.height;
-  cloud->is_dense = in_cloud.is_dense;
-  cloud->sensor_origin_ = in_cloud.sensor_origin_;
-  cloud->sensor_orientation_ = in_cloud.sensor_orientation_;
-  cloud->points.resize(in_cloud.points.size());
-  size_t points_num = 0;
-  for (size_t idx = 0; idx < in_cloud.size(); ++idx) {
-    pcl_util::PointXYZIT& pt = in_cloud.points[idx];
-    if (!isnan(pt.x) && !isnan(pt.y) && !isnan(pt.z) && !isnan(pt.intensity)) {
-      cloud->points[points_num].x = pt.x;
-      cloud->points[points_num].y = pt.y;
-      cloud->points[points_num].z = pt.z;
-      cloud->points[points_num].intensity = pt.intensity;
-      points_num++;
-    }
+  pcl_conversions::toPCL(in_msg.header, cloud->header);
+  if (!pcl_util::ConvertPointCloud(in_msg, cloud.get())) {
+    AERROR << "failed to convert the point cloud, it has no float x, y, z.";
+    cloud->clear();
   }
-  cloud->points.resize(points_num);
 }
 
 bool LidarProcess::GetVelodyneTrans(const double query_time, Matrix4d* trans) {
@@ -357,16 +474,23 @@ bool LidarProcess::GetVelodyneTrans(const double query_time, Matrix4d* trans) {
 }
 
 bool LidarProcess::GeneratePbMsg(PerceptionObstacles* obstacles) {
+  return GeneratePbMsg(timestamp_, error_code_, objects_, obstacles);
+}
+
+bool LidarProcess::GeneratePbMsg(const double timestamp,
+                                 const common::ErrorCode error_code,
+                                 const std::vector<ObjectPtr>& objects,
+                                 PerceptionObstacles* obstacles) {
   AdapterManager::FillPerceptionObstaclesHeader(FLAGS_obstacle_module_name,
                                                 obstacles);
   common::Header* header = obstacles->mutable_header();
-  header->set_lidar_timestamp(timestamp_ * 1e9);  // in ns
+  header->set_lidar_timestamp(timestamp * 1e9);  // in ns
   header->set_camera_timestamp(0);
   header->set_radar_timestamp(0);
 
-  obstacles->set_error_code(error_code_);
+  obstacles->set_error_code(error_code);
 
-  for (const auto& obj : objects_) {
+  for (const auto& obj : objects) {
     PerceptionObstacle* obstacle = obstacles->add_perception_obstacle();
     if (!obj->Serialize(obstacle)) {
       AERROR << "Failed gen PerceptionObstacle. Object:" << obj->ToString();
@@ -17,6 +17,7 @@
 #ifndef MODEULES_PERCEPTION_OBSTACLE_ONBOARD_LIDAR_PROCESS_H_
 #define MODEULES_PERCEPTION_OBSTACLE_ONBOARD_LIDAR_PROCESS_H_
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -25,7 +26,9 @@
 #include "sensor_msgs/PointCloud2.h"
 
 #include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/perception/lib/base/pipeline.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/lib/pcl_util/point_cloud_converter.h"
 #include "modules/perception/obstacle/base/object.h"
 #include "modules/perception/obstacle/lidar/interface/base_object_builder.h"
 #include "modules/perception/obstacle/lidar/interface/base_roi_filter.h"
@@ -38,8 +41,24 @@
 namespace apollo {
 namespace perception {
 
+// The data of a point cloud, filled by the stages of LidarProcess.
+struct LidarFrame {
+  double timestamp = 0.0;
+  pcl_util::PointCloudPtr cloud;
+  std::shared_ptr<Eigen::Matrix4d> velodyne_trans;
+  HdmapStructPtr hdmap;
+  pcl_util::PointCloudPtr roi_cloud;
+  pcl_util::PointIndicesPtr roi_indices;
+  std::vector<ObjectPtr> segmented_objects;
+  std::vector<ObjectPtr> tracked_objects;
+  // the stages after a failed one skip the frame.
+  common::ErrorCode error_code = common::OK;
+};
+
 class LidarProcess {
  public:
+  using ObstaclesCallback = std::function<void(const PerceptionObstacles&)>;
+
   LidarProcess() = default;
   ~LidarProcess() = default;
 
@@ -52,6 +71,21 @@ class LidarProcess {
 
   bool GeneratePbMsg(PerceptionObstacles* obstacles);
 
+  // Runs the stages on their own threads: transform, roi filter,
+  // segmentation, object builder and tracker, linked by queues of
+  // FLAGS_lidar_pipeline_queue_size frames which drop the oldest one when
+  // full. The callback gets the obstacles of each frame out of the tracker,
+  // in order, on the tracker thread.
+  bool StartPipeline(const ObstaclesCallback& callback);
+  // process the frames already enqueued, then stop the threads.
+  void StopPipeline();
+
+  // Converts the point cloud, and enqueues it into the started pipeline.
+  // return false if the oldest frame in the queue was dropped.
+  bool Enqueue(const sensor_msgs::PointCloud2& message);
+  bool Enqueue(const double timestamp, pcl_util::PointCloudPtr cloud,
+               std::shared_ptr<Eigen::Matrix4d> velodyne_trans);
+
   std::vector<ObjectPtr> GetObjects() { return objects_; }
 
   pcl_util::PointIndicesPtr GetROIIndices() { return roi_indices_; }
@@ -65,6 +99,19 @@ class LidarProcess {
                             pcl_util::PointCloudPtr* out_cloud);
   bool GetVelodyneTrans(const double query_time, Eigen::Matrix4d* trans);
 
+  // the stages, each returns false and sets the error code of the frame if
+  // it fails.
+  bool TransformFrame(LidarFrame* frame);
+  bool FilterROI(LidarFrame* frame);
+  bool Segment(LidarFrame* frame);
+  bool BuildObjects(LidarFrame* frame);
+  bool Track(LidarFrame* frame);
+
+  bool GeneratePbMsg(const double timestamp,
+                     const common::ErrorCode error_code,
+                     const std::vector<ObjectPtr>& objects,
+                     PerceptionObstacles* obstacles);
+
   bool inited_ = false;
   double timestamp_;
   common::ErrorCode error_code_ = common::OK;
@@ -78,6 +125,14 @@ class LidarProcess {
 
   std::unique_ptr<OpenglVisualizer> visualizer_ = nullptr;
 
+  // the converted point clouds, reused once the frames holding them are
+  // done: enough for the frames in the stages and queues of the pipeline.
+  pcl_util::PointCloudPool cloud_pool_{16};
+
+  ObstaclesCallback obstacles_callback_;
+  // last, to stop its threads before the algorithms they call are destroyed.
+  std::unique_ptr<Pipeline<LidarFrame>> pipeline_;
+
   FRIEND_TEST(LidarProcessTest, test_Init);
   FRIEND_TEST(LidarProcessTest, test_Process);
   FRIEND_TEST(LidarProcessTest, test_GeneratePbMsg);
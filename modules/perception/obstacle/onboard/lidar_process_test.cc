@@ -137,5 +137,29 @@ TEST_F(LidarProcessTest, test_GeneratePbMsg) {
             PerceptionObstacle::PEDESTRIAN);
 }
 
+TEST_F(LidarProcessTest, test_Pipeline) {
+  FLAGS_lidar_pipeline_queue_size = 10;
+  vector<double> timestamps;
+  EXPECT_TRUE(lidar_process_.StartPipeline(
+      [&timestamps](const PerceptionObstacles &obstacles) {
+        EXPECT_EQ(obstacles.error_code(), common::OK);
+        timestamps.push_back(obstacles.header().lidar_timestamp() / 1e9);
+      }));
+  EXPECT_FALSE(lidar_process_.StartPipeline(nullptr));
+
+  std::shared_ptr<Matrix4d> velodyne_trans = std::make_shared<Matrix4d>();
+  velodyne_trans->setIdentity();
+  for (int i = 0; i < 5; ++i) {
+    PointCloudPtr point_cloud(new PointCloud);
+    EXPECT_TRUE(lidar_process_.Enqueue(100.0 + i, point_cloud, velodyne_trans));
+  }
+  lidar_process_.StopPipeline();
+
+  ASSERT_EQ(timestamps.size(), 5u);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_NEAR(timestamps[i], 100.0 + i, 1e-6);
+  }
+}
+
 }  // namespace perception
 }  // namespace apollo
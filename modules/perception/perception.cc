@@ -42,6 +42,14 @@ Status Perception::Init() {
     AERROR << "failed to init lidar_process.";
     return Status(ErrorCode::PERCEPTION_ERROR, "failed to init lidar_process.");
   }
+  if (lidar_process_ != nullptr && FLAGS_enable_lidar_pipeline &&
+      !lidar_process_->StartPipeline([](const PerceptionObstacles& obstacles) {
+        AdapterManager::PublishPerceptionObstacles(obstacles);
+      })) {
+    AERROR << "failed to start lidar pipeline.";
+    return Status(ErrorCode::PERCEPTION_ERROR,
+                  "failed to start lidar pipeline.");
+  }
 
   CHECK(AdapterManager::GetPointCloud()) << "PointCloud is not initialized.";
   AdapterManager::AddPointCloudCallback(&Perception::OnPointCloud, this);
@@ -52,6 +60,11 @@ void Perception::OnPointCloud(const sensor_msgs::PointCloud2& message) {
   ADEBUG << "get point cloud callback";
 
   if (lidar_process_ != nullptr && lidar_process_->IsInit()) {
+    if (FLAGS_enable_lidar_pipeline) {
+      // the obstacles are published by the pipeline.
+      lidar_process_->Enqueue(message);
+      return;
+    }
     lidar_process_->Process(message);
 
     /// public obstacle message
@@ -66,7 +79,11 @@ Status Perception::Start() {
   return Status::OK();
 }
 
-void Perception::Stop() {}
+void Perception::Stop() {
+  if (lidar_process_ != nullptr) {
+    lidar_process_->StopPipeline();
+  }
+}
 
 }  // namespace perception
 }  // namespace apollo
@@ -56,7 +56,10 @@ void Frame::SetMap(const hdmap::HDMap *hdmap) {
 FrameHistory::FrameHistory()
     : IndexedQueue<uint32_t, Frame>(FLAGS_max_history_frame_num) {}
 
-Frame::Frame(const uint32_t sequence_num) : sequence_num_(sequence_num) {}
+Frame::Frame(const uint32_t sequence_num)
+    : prediction_(google::protobuf::Arena::CreateMessage<
+                  prediction::PredictionObstacles>(&arena_)),
+      sequence_num_(sequence_num) {}
 
 void Frame::SetVehicleInitPose(const localization::Pose &pose) {
   init_pose_ = pose;
@@ -71,7 +74,7 @@ const common::TrajectoryPoint &Frame::PlanningStartPoint() const {
 }
 
 void Frame::SetPrediction(const prediction::PredictionObstacles &prediction) {
-  prediction_ = prediction;
+  prediction_->CopyFrom(prediction);
 }
 
 void Frame::CreatePredictionObstacles(
@@ -125,6 +128,11 @@ const Obstacle *Frame::AddStaticVirtualObstacle(
   }
   auto *ptr =
       obstacles_.Add(id, *Obstacle::CreateStaticVirtualObstacles(id, box));
+  if (!ptr) {
+    // It may have been added concurrently while planning another reference
+    // line.
+    ptr = obstacles_.Find(id);
+  }
   if (!ptr) {
     AERROR << "Failed to create virtual obstacle " << id;
   }
@@ -192,7 +200,7 @@ Status Frame::Init(const PlanningConfig &config,
     AlignPredictionTime(current_time_stamp);
   }
   if (FLAGS_enable_prediction) {
-    CreatePredictionObstacles(prediction_);
+    CreatePredictionObstacles(*prediction_);
   }
 
   if (!CreateDestinationObstacle()) {
@@ -253,13 +261,16 @@ std::vector<ReferenceLine> Frame::CreateReferenceLineFromRouting(
   smoother.Init(smoother_config_);
 
   for (const auto &segments : route_segments) {
-    hdmap::Path hdmap_path;
-    hdmap::PncMap::CreatePathFromLaneSegments(segments, &hdmap_path);
+    std::shared_ptr<const hdmap::Path> hdmap_path;
+    if (!pnc_map_->CreatePath(segments, &hdmap_path)) {
+      AERROR << "Failed to create path from lane segments";
+      continue;
+    }
     if (FLAGS_enable_smooth_reference_line) {
       ReferenceLine reference_line;
       std::vector<double> init_t_knots;
       Spline2dSolver spline_solver(init_t_knots, 5);
-      if (!smoother.Smooth(ReferenceLine(hdmap_path), &reference_line,
+      if (!smoother.Smooth(ReferenceLine(*hdmap_path), &reference_line,
                            &spline_solver)) {
         AERROR << "Failed to smooth reference line";
         continue;
@@ -267,7 +278,7 @@ std::vector<ReferenceLine> Frame::CreateReferenceLineFromRouting(
       reference_lines.push_back(std::move(reference_line));
       reference_lines.back().set_change_lane_type(segments.change_lane_type());
     } else {
-      reference_lines.emplace_back(hdmap_path);
+      reference_lines.emplace_back(*hdmap_path);
       reference_lines.back().set_change_lane_type(segments.change_lane_type());
     }
   }
@@ -298,15 +309,15 @@ void Frame::RecordInputDebug(planning_internal::Debug *debug) {
   auto debug_routing = planning_data->mutable_routing();
   debug_routing->CopyFrom(routing_response());
 
-  planning_data->mutable_prediction_header()->CopyFrom(prediction_.header());
+  planning_data->mutable_prediction_header()->CopyFrom(prediction_->header());
 }
 
 void Frame::AlignPredictionTime(const double trajectory_header_time) {
   ADEBUG << "planning header: " << std::to_string(trajectory_header_time);
-  double prediction_header_time = prediction_.header().timestamp_sec();
+  double prediction_header_time = prediction_->header().timestamp_sec();
   ADEBUG << "prediction header: " << std::to_string(prediction_header_time);
 
-  for (auto &obstacle : *prediction_.mutable_prediction_obstacle()) {
+  for (auto &obstacle : *prediction_->mutable_prediction_obstacle()) {
     for (auto &trajectory : *obstacle.mutable_trajectory()) {
       for (auto &point : *trajectory.mutable_trajectory_point()) {
         point.set_relative_time(prediction_header_time + point.relative_time() -
@@ -27,6 +27,8 @@
 #include <string>
 #include <vector>
 
+#include "google/protobuf/arena.h"
+
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/localization/proto/pose.pb.h"
 #include "modules/planning/proto/planning.pb.h"
@@ -124,7 +126,10 @@ class Frame {
    **/
   const ReferenceLineInfo *drive_reference_line_info_ = nullptr;
 
-  prediction::PredictionObstacles prediction_;
+  /// the protobuf messages owned by the frame, freed at once with it.
+  google::protobuf::Arena arena_;
+
+  prediction::PredictionObstacles *prediction_ = nullptr;
 
   ThreadSafeIndexedObstacles obstacles_;
 
@@ -151,18 +151,26 @@ std::string PathData::DebugString() const {
 bool PathData::SLToXY(const FrenetFramePath &frenet_path,
                       DiscretizedPath *const discretized_path) {
   DCHECK_NOTNULL(discretized_path);
+  const auto &frenet_points = frenet_path.points();
+  std::vector<SLPoint> sl_points;
+  std::vector<double> s;
+  for (const common::FrenetFramePoint &frenet_point : frenet_points) {
+    sl_points.push_back(
+        common::util::MakeSLPoint(frenet_point.s(), frenet_point.l()));
+    s.push_back(frenet_point.s());
+  }
+  std::vector<Vec2d> cartesian_points;
+  if (!reference_line_->SLToXY(sl_points, &cartesian_points)) {
+    AERROR << "Fail to convert sl points to xy points";
+    return false;
+  }
+  const auto ref_points = reference_line_->GetReferencePoints(s);
+
   std::vector<common::PathPoint> path_points;
-  for (const common::FrenetFramePoint &frenet_point : frenet_path.points()) {
-    common::SLPoint sl_point;
-    common::math::Vec2d cartesian_point;
-    sl_point.set_s(frenet_point.s());
-    sl_point.set_l(frenet_point.l());
-    if (!reference_line_->SLToXY(sl_point, &cartesian_point)) {
-      AERROR << "Fail to convert sl point to xy point";
-      return false;
-    }
-    ReferencePoint ref_point =
-        reference_line_->GetReferencePoint(frenet_point.s());
+  for (size_t i = 0; i < frenet_points.size(); ++i) {
+    const common::FrenetFramePoint &frenet_point = frenet_points[i];
+    const Vec2d &cartesian_point = cartesian_points[i];
+    const ReferencePoint &ref_point = ref_points[i];
     double theta = CartesianFrenetConverter::CalculateTheta(
         ref_point.heading(), ref_point.kappa(), frenet_point.l(),
         frenet_point.dl());
@@ -191,14 +199,18 @@ bool PathData::SLToXY(const FrenetFramePath &frenet_path,
 bool PathData::XYToSL(const DiscretizedPath &discretized_path,
                       FrenetFramePath *const frenet_path) {
   DCHECK_NOTNULL(frenet_path);
-  std::vector<common::FrenetFramePoint> frenet_frame_points;
-
+  std::vector<Vec2d> xy_points;
   for (const auto &path_point : discretized_path.path_points()) {
-    SLPoint sl_point;
-    if (!reference_line_->XYToSL({path_point.x(), path_point.y()}, &sl_point)) {
-      AERROR << "Fail to transfer cartesian point to frenet point.";
-      return false;
-    }
+    xy_points.emplace_back(path_point.x(), path_point.y());
+  }
+  std::vector<SLPoint> sl_points;
+  if (!reference_line_->XYToSL(xy_points, &sl_points)) {
+    AERROR << "Fail to transfer cartesian points to frenet points.";
+    return false;
+  }
+
+  std::vector<common::FrenetFramePoint> frenet_frame_points;
+  for (const auto &sl_point : sl_points) {
     common::FrenetFramePoint frenet_point;
     // NOTICE: does not set dl and ddl here. Add if needed.
     frenet_point.set_s(sl_point.s());
@@ -63,6 +63,11 @@ DEFINE_double(replan_distance_threshold, 5.0,
 
 DEFINE_bool(enable_reference_line_provider_thread, false,
             "Enable reference line provider thread.");
+DEFINE_bool(enable_parallel_reference_line_planning, false,
+            "Plan each reference line in its own thread.");
+DEFINE_int32(reference_line_planning_threads, 2,
+             "Number of worker threads, besides the planning thread, used "
+             "to plan reference lines in parallel.");
 
 DEFINE_double(default_reference_line_width, 4.0,
               "Default reference line width");
@@ -202,3 +207,28 @@ DEFINE_bool(enable_follow_accel_constraint, true,
 
 // SQP solver
 DEFINE_bool(enable_sqp_solver, true, "True to enable SQP solver.");
+DEFINE_bool(enable_sparse_spline_qp, false,
+            "True to hand the spline QP matrices to qpOASES in the compressed "
+            "sparse column format instead of dense arrays.");
+
+// DP poly path
+DEFINE_bool(enable_parallel_dp_poly_path, false,
+            "Evaluate the nodes of each level of the DP path graph in "
+            "parallel.");
+DEFINE_int32(dp_poly_path_threads, 2,
+             "Number of worker threads, besides the planning thread, used "
+             "by the DP path graph.");
+
+// DP ST speed
+DEFINE_bool(enable_parallel_dp_st_graph, false,
+            "Evaluate the rows of each column of the DP ST graph in "
+            "parallel.");
+DEFINE_int32(dp_st_graph_threads, 2,
+             "Number of worker threads, besides the planning thread, used "
+             "by the DP ST graph.");
+
+// Protobuf arena
+DEFINE_int32(planning_arena_block_size, 1 << 20,
+             "The size in bytes of the memory block reused by the protobuf "
+             "arena of the messages of each planning cycle. The arena "
+             "allocates more blocks when it is full.");
@@ -42,6 +42,8 @@ DECLARE_double(replan_distance_threshold);
 
 // parameter for reference line
 DECLARE_bool(enable_reference_line_provider_thread);
+DECLARE_bool(enable_parallel_reference_line_planning);
+DECLARE_int32(reference_line_planning_threads);
 DECLARE_double(default_reference_line_width);
 DECLARE_double(smoothed_reference_line_max_diff);
 
@@ -121,5 +123,14 @@ DECLARE_double(crosswalk_strick_l_distance);
 DECLARE_double(crosswalk_loose_l_distance);
 
 DECLARE_bool(enable_sqp_solver);
+DECLARE_bool(enable_sparse_spline_qp);
+
+DECLARE_bool(enable_parallel_dp_poly_path);
+DECLARE_int32(dp_poly_path_threads);
+
+DECLARE_bool(enable_parallel_dp_st_graph);
+DECLARE_int32(dp_st_graph_threads);
+
+DECLARE_int32(planning_arena_block_size);
 
 #endif  // MODULES_PLANNING_COMMON_PLANNING_GFLAGS_H
@@ -304,6 +304,16 @@ bool StBoundary::GetUnblockSRange(const double curr_time, double* s_upper,
 
 bool StBoundary::GetBoundarySRange(const double curr_time, double* s_upper,
                                    double* s_lower) const {
+  if (!GetPolygonSRange(curr_time, s_upper, s_lower)) {
+    return false;
+  }
+  *s_upper = std::fmin(*s_upper, s_high_limit_);
+  *s_lower = std::fmax(*s_lower, 0.0);
+  return true;
+}
+
+bool StBoundary::GetPolygonSRange(const double curr_time, double* s_upper,
+                                  double* s_lower) const {
   CHECK_NOTNULL(s_upper);
   CHECK_NOTNULL(s_lower);
   if (curr_time < min_t_ || curr_time > max_t_) {
@@ -316,22 +326,21 @@ bool StBoundary::GetBoundarySRange(const double curr_time, double* s_upper,
     AERROR << "Fail to get index range.";
     return false;
   }
-  const double r = (curr_time - upper_points_[left].t()) /
-                   (upper_points_[right].t() - upper_points_[left].t());
+  const double r =
+      (left == right ? 0.0 : (curr_time - upper_points_[left].t()) /
+                                 (upper_points_[right].t() -
+                                  upper_points_[left].t()));
 
   *s_upper = upper_points_[left].s() +
              r * (upper_points_[right].s() - upper_points_[left].s());
   *s_lower = lower_points_[left].s() +
              r * (lower_points_[right].s() - lower_points_[left].s());
-
-  *s_upper = std::fmin(*s_upper, s_high_limit_);
-  *s_lower = std::fmax(*s_lower, 0.0);
   return true;
 }
 
 double StBoundary::DistanceS(const STPoint& st_point) const {
-  double s_upper;
-  double s_lower;
+  double s_upper = 0.0;
+  double s_lower = 0.0;
   if (GetBoundarySRange(st_point.t(), &s_upper, &s_lower)) {
     constexpr double kMaxDistance = 1.0e10;
     return kMaxDistance;
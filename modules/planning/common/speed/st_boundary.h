@@ -85,6 +85,12 @@ class StBoundary : public common::math::Polygon2d {
   bool GetBoundarySRange(const double curr_time, double* s_upper,
                          double* s_lower) const;
 
+  // The s range of the boundary polygon at curr_time, which contains the
+  // points at curr_time IsPointInBoundary() accepts. Unlike
+  // GetBoundarySRange(), the range is not limited to [0, s_high_limit].
+  bool GetPolygonSRange(const double curr_time, double* s_upper,
+                        double* s_lower) const;
+
   double min_s() const;
   double min_t() const;
   double max_s() const;
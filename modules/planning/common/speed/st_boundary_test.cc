@@ -94,6 +94,22 @@ TEST(StBoundaryTest, boundary_range) {
   }
 }
 
+TEST(StBoundaryTest, distance_s) {
+  std::vector<std::pair<STPoint, STPoint>> point_pairs;
+  point_pairs.emplace_back(STPoint(1.0, 0.0), STPoint(5.0, 0.0));
+  point_pairs.emplace_back(STPoint(3.0, 10.0), STPoint(7.0, 10.0));
+  StBoundary boundary(point_pairs);
+
+  // Within the time range of the boundary, the distance is the largest.
+  EXPECT_DOUBLE_EQ(1.0e10, boundary.DistanceS(STPoint(0.0, 0.0)));
+  EXPECT_DOUBLE_EQ(1.0e10, boundary.DistanceS(STPoint(0.5, 5.0)));
+  EXPECT_DOUBLE_EQ(1.0e10, boundary.DistanceS(STPoint(8.0, 5.0)));
+  EXPECT_DOUBLE_EQ(1.0e10, boundary.DistanceS(STPoint(10.0, 10.0)));
+  // Out of it, the distance is to s = 0.
+  EXPECT_DOUBLE_EQ(2.0, boundary.DistanceS(STPoint(2.0, -1.0)));
+  EXPECT_DOUBLE_EQ(2.0, boundary.DistanceS(STPoint(2.0, 11.0)));
+}
+
 TEST(StBoundaryTest, get_index_range) {
   std::vector<STPoint> upper_points;
   std::vector<STPoint> lower_points;
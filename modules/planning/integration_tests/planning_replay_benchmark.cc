@@ -0,0 +1,322 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Replays the recorded inputs of a directory through
+ * Planning::RunOnce(), and reports the latency of each task and of the
+ * cycle, and the heap allocations of the cycle, as JSON.
+ *
+ * A scenario of the directory is a prefix of the files
+ * <prefix>_localization.pb.txt, <prefix>_chassis.pb.txt, and optionally
+ * <prefix>_routing.pb.txt and <prefix>_prediction.pb.txt, the layout of the
+ * integration tests. For example:
+ *
+ *   planning_replay_benchmark \
+ *       --map_dir=modules/map/data/sunnyvale_loop \
+ *       --replay_data_dir=modules/planning/testdata/sunnyvale_loop_test \
+ *       --replay_output_file=/tmp/planning_replay.json
+ */
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "third_party/json/json.hpp"
+
+#include "modules/planning/proto/planning.pb.h"
+
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_tokenizer.h"
+#include "modules/common/util/string_util.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/planning.h"
+
+DEFINE_string(replay_data_dir, "modules/planning/testdata/sunnyvale_loop_test",
+              "The directory of the recorded inputs to replay.");
+DEFINE_string(replay_scenarios, "",
+              "Comma separated prefixes of the scenarios to replay, all the "
+              "scenarios of the directory if empty.");
+DEFINE_string(replay_routing_file, "",
+              "The routing file of the directory used by the scenarios "
+              "without their own routing file.");
+DEFINE_int32(replay_warm_up_cycles, 2,
+             "Number of planning cycles of each scenario run before the "
+             "measured ones.");
+DEFINE_int32(replay_cycles, 20,
+             "Number of measured planning cycles of each scenario.");
+DEFINE_string(replay_output_file, "",
+              "The JSON file of the results, the standard output if empty.");
+
+namespace {
+
+std::atomic<uint64_t> num_allocations(0);
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++num_allocations;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::adapter::AdapterManager;
+using apollo::common::util::EndWith;
+using apollo::common::util::StrCat;
+
+namespace {
+
+const char kLocalizationSuffix[] = "_localization.pb.txt";
+
+// The samples of each measured quantity: the tasks by name, and the cycle.
+using Samples = std::map<std::string, std::vector<double>>;
+
+struct Scenario {
+  std::string name;
+  Samples latency_ms;
+  std::vector<double> allocations;
+  // the sequence number of the last trajectory published by the scenario.
+  uint32_t sequence_num = 0;
+};
+
+std::string ScenarioFile(const std::string& name, const std::string& kind) {
+  return StrCat(FLAGS_replay_data_dir, "/", name, "_", kind, ".pb.txt");
+}
+
+std::vector<std::string> ListScenarios() {
+  std::vector<std::string> names;
+  if (!FLAGS_replay_scenarios.empty()) {
+    return common::util::StringTokenizer::Split(FLAGS_replay_scenarios, ",");
+  }
+  DIR* directory = opendir(FLAGS_replay_data_dir.c_str());
+  CHECK(directory != nullptr) << "Cannot open " << FLAGS_replay_data_dir;
+  const std::string suffix = kLocalizationSuffix;
+  while (const struct dirent* entry = readdir(directory)) {
+    const std::string file_name = entry->d_name;
+    if (EndWith(file_name, suffix) &&
+        common::util::PathExists(ScenarioFile(
+            file_name.substr(0, file_name.size() - suffix.size()),
+            "chassis"))) {
+      names.push_back(file_name.substr(0, file_name.size() - suffix.size()));
+    }
+  }
+  closedir(directory);
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+// Feeds the recorded inputs of the scenario, and initializes the planning
+// on them, as PlanningTestBase does.
+bool SetUpScenario(const std::string& name, Planning* planning) {
+  planning->Stop();
+  AdapterManager::GetRoutingResponse()->ClearData();
+  AdapterManager::GetLocalization()->ClearData();
+  AdapterManager::GetChassis()->ClearData();
+  AdapterManager::GetPrediction()->ClearData();
+
+  std::string routing_file = ScenarioFile(name, "routing");
+  if (!common::util::PathExists(routing_file)) {
+    routing_file =
+        StrCat(FLAGS_replay_data_dir, "/", FLAGS_replay_routing_file);
+  }
+  if (!AdapterManager::FeedRoutingResponseFile(routing_file) ||
+      !AdapterManager::FeedLocalizationFile(
+          ScenarioFile(name, "localization")) ||
+      !AdapterManager::FeedChassisFile(ScenarioFile(name, "chassis"))) {
+    AERROR << "Failed to feed the inputs of scenario " << name;
+    return false;
+  }
+  const std::string prediction_file = ScenarioFile(name, "prediction");
+  FLAGS_enable_prediction = common::util::PathExists(prediction_file);
+  if (FLAGS_enable_prediction &&
+      !AdapterManager::FeedPredictionFile(prediction_file)) {
+    AERROR << "Failed to feed " << prediction_file;
+    return false;
+  }
+  if (!planning->Init().ok()) {
+    AERROR << "Failed to init planning for scenario " << name;
+    return false;
+  }
+  return true;
+}
+
+void RunCycle(Planning* planning, Scenario* scenario) {
+  const uint64_t start_allocations = num_allocations;
+  const auto start_time = std::chrono::steady_clock::now();
+  planning->RunOnce();
+  const auto end_time = std::chrono::steady_clock::now();
+  scenario->allocations.push_back(num_allocations - start_allocations);
+  scenario->latency_ms["Cycle"].push_back(
+      std::chrono::duration<double, std::milli>(end_time - start_time)
+          .count());
+
+  const ADCTrajectory* trajectory =
+      AdapterManager::GetPlanning()->GetLatestPublished();
+  // a cycle which published nothing leaves the trajectory of the previous
+  // one.
+  if (trajectory == nullptr ||
+      trajectory->header().sequence_num() == scenario->sequence_num) {
+    return;
+  }
+  scenario->sequence_num = trajectory->header().sequence_num();
+  const LatencyStats& latency_stats = trajectory->latency_stats();
+  if (latency_stats.has_init_frame_time_ms()) {
+    scenario->latency_ms["InitFrame"].push_back(
+        latency_stats.init_frame_time_ms());
+  }
+  for (const TaskStats& task_stats : latency_stats.task_stats()) {
+    scenario->latency_ms[task_stats.name()].push_back(task_stats.time_ms());
+  }
+}
+
+// The nearest rank percentile of the sorted values.
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percentile) {
+  const double rank = std::ceil(percentile / 100.0 * sorted_values.size());
+  const size_t index = static_cast<size_t>(std::max(1.0, rank)) - 1;
+  return sorted_values[std::min(index, sorted_values.size() - 1)];
+}
+
+nlohmann::json Summary(std::vector<double> values) {
+  nlohmann::json summary;
+  summary["samples"] = values.size();
+  if (values.empty()) {
+    return summary;
+  }
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  summary["mean"] = sum / values.size();
+  summary["p50"] = Percentile(values, 50.0);
+  summary["p95"] = Percentile(values, 95.0);
+  summary["p99"] = Percentile(values, 99.0);
+  summary["max"] = values.back();
+  return summary;
+}
+
+nlohmann::json Summary(const Samples& latency_ms,
+                       const std::vector<double>& allocations) {
+  nlohmann::json summary;
+  for (const auto& samples : latency_ms) {
+    summary["latency_ms"][samples.first] = Summary(samples.second);
+  }
+  summary["allocations_per_cycle"] = Summary(allocations);
+  return summary;
+}
+
+}  // namespace
+
+int RunReplay() {
+  FLAGS_planning_config_file = "modules/planning/conf/planning_config.pb.txt";
+  FLAGS_planning_adapter_config_filename =
+      "modules/planning/testdata/conf/adapter.conf";
+  FLAGS_align_prediction_time = false;
+  FLAGS_enable_reference_line_provider_thread = false;
+  AdapterManager::Init(FLAGS_planning_adapter_config_filename);
+
+  const std::vector<std::string> names = ListScenarios();
+  if (names.empty()) {
+    AERROR << "No scenario in " << FLAGS_replay_data_dir;
+    return EXIT_FAILURE;
+  }
+
+  Planning planning;
+  std::vector<Scenario> scenarios;
+  for (const std::string& name : names) {
+    Scenario scenario;
+    scenario.name = name;
+    if (!SetUpScenario(name, &planning)) {
+      return EXIT_FAILURE;
+    }
+    for (int i = 0; i < FLAGS_replay_warm_up_cycles; ++i) {
+      planning.RunOnce();
+    }
+    for (int i = 0; i < FLAGS_replay_cycles; ++i) {
+      RunCycle(&planning, &scenario);
+    }
+    scenarios.push_back(std::move(scenario));
+  }
+  planning.Stop();
+
+  nlohmann::json result;
+  result["data_dir"] = FLAGS_replay_data_dir;
+  result["cycles_per_scenario"] = FLAGS_replay_cycles;
+  Samples all_latency_ms;
+  std::vector<double> all_allocations;
+  for (const Scenario& scenario : scenarios) {
+    nlohmann::json summary = Summary(scenario.latency_ms,
+                                     scenario.allocations);
+    summary["name"] = scenario.name;
+    result["scenarios"].push_back(summary);
+    for (const auto& samples : scenario.latency_ms) {
+      auto* all_samples = &all_latency_ms[samples.first];
+      all_samples->insert(all_samples->end(), samples.second.begin(),
+                          samples.second.end());
+    }
+    all_allocations.insert(all_allocations.end(),
+                           scenario.allocations.begin(),
+                           scenario.allocations.end());
+  }
+  result["all"] = Summary(all_latency_ms, all_allocations);
+
+  if (FLAGS_replay_output_file.empty()) {
+    std::cout << result.dump(2) << std::endl;
+  } else {
+    std::ofstream output(FLAGS_replay_output_file);
+    output << result.dump(2) << std::endl;
+    if (!output) {
+      AERROR << "Failed to write " << FLAGS_replay_output_file;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::planning::RunReplay();
+}
@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 
 #include "modules/common/configs/config_gflags.h"
+#include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/integration_tests/planning_test_base.h"
 #include "modules/planning/planning.h"
@@ -166,5 +167,55 @@ TEST_F(SunnyvaleLoopTest, change_lane) {
   RUN_GOLDEN_TEST;
 }
 
+/*
+ * test change lane, planning the reference lines in parallel
+ * The trajectory and the latency stats of each reference line are the same as
+ * when they are planned one after the other.
+ */
+TEST_F(SunnyvaleLoopTest, change_lane_parallel) {
+  std::string seq_num = "9";
+  FLAGS_test_routing_response_file = seq_num + "_routing.pb.txt";
+  FLAGS_enable_prediction = false;
+  FLAGS_test_localization_file = seq_num + "_localization.pb.txt";
+  FLAGS_test_chassis_file = seq_num + "_chassis.pb.txt";
+
+  FLAGS_enable_parallel_reference_line_planning = false;
+  PlanningTestBase::SetUp();
+  planning_.RunOnce();
+  const ADCTrajectory* sequential_pointer =
+      AdapterManager::GetPlanning()->GetLatestPublished();
+  ASSERT_TRUE(sequential_pointer != nullptr);
+  ADCTrajectory sequential_trajectory = *sequential_pointer;
+
+  FLAGS_enable_parallel_reference_line_planning = true;
+  PlanningTestBase::SetUp();
+  planning_.RunOnce();
+  const ADCTrajectory* parallel_pointer =
+      AdapterManager::GetPlanning()->GetLatestPublished();
+  ASSERT_TRUE(parallel_pointer != nullptr);
+  ADCTrajectory parallel_trajectory = *parallel_pointer;
+  FLAGS_enable_parallel_reference_line_planning = false;
+
+  const auto& sequential_stats = sequential_trajectory.latency_stats();
+  const auto& parallel_stats = parallel_trajectory.latency_stats();
+  // the change lane case has a reference line for each lane.
+  EXPECT_GT(sequential_stats.reference_line_time_ms_size(), 1);
+  EXPECT_EQ(sequential_stats.reference_line_time_ms_size(),
+            parallel_stats.reference_line_time_ms_size());
+  EXPECT_TRUE(parallel_stats.has_plan_reference_lines_time_ms());
+  ASSERT_EQ(sequential_stats.task_stats_size(),
+            parallel_stats.task_stats_size());
+  for (int i = 0; i < sequential_stats.task_stats_size(); ++i) {
+    EXPECT_EQ(sequential_stats.task_stats(i).name(),
+              parallel_stats.task_stats(i).name());
+  }
+
+  // the times differ from run to run.
+  TrimPlanning(&sequential_trajectory);
+  TrimPlanning(&parallel_trajectory);
+  EXPECT_TRUE(
+      common::util::IsProtoEqual(sequential_trajectory, parallel_trajectory));
+}
+
 }  // namespace planning
 }  // namespace apollo
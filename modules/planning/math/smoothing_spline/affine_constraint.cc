@@ -31,7 +31,7 @@ AffineConstraint::AffineConstraint(const bool is_equality)
 AffineConstraint::AffineConstraint(const Eigen::MatrixXd& constraint_matrix,
                                    const Eigen::MatrixXd& constraint_boundary,
                                    const bool is_equality)
-    : constraint_matrix_(constraint_matrix),
+    : constraint_matrix_(constraint_matrix.sparseView()),
       constraint_boundary_(constraint_boundary),
       is_equality_(is_equality) {
   CHECK_EQ(constraint_boundary.rows(), constraint_matrix.rows());
@@ -41,7 +41,12 @@ void AffineConstraint::SetIsEquality(const double is_equality) {
   is_equality_ = is_equality;
 }
 
-const Eigen::MatrixXd& AffineConstraint::constraint_matrix() const {
+Eigen::MatrixXd AffineConstraint::constraint_matrix() const {
+  return Eigen::MatrixXd(constraint_matrix_);
+}
+
+const AffineConstraint::SparseMatrix&
+AffineConstraint::sparse_constraint_matrix() const {
   return constraint_matrix_;
 }
 
@@ -52,6 +57,13 @@ const Eigen::MatrixXd& AffineConstraint::constraint_boundary() const {
 bool AffineConstraint::AddConstraint(
     const Eigen::MatrixXd& constraint_matrix,
     const Eigen::MatrixXd& constraint_boundary) {
+  return AddConstraint(SparseMatrix(constraint_matrix.sparseView()),
+                       constraint_boundary);
+}
+
+bool AffineConstraint::AddConstraint(
+    const SparseMatrix& constraint_matrix,
+    const Eigen::MatrixXd& constraint_boundary) {
   if (constraint_matrix.rows() != constraint_boundary.rows()) {
     AERROR << "Fail to add constraint because constraint matrix rows != "
               "constraint boundary rows.";
@@ -61,9 +73,8 @@ bool AffineConstraint::AddConstraint(
   }
 
   if (constraint_matrix_.rows() == 0) {
-    constraint_matrix_ = constraint_matrix;
-    constraint_boundary_ = constraint_boundary;
-    return true;
+    constraint_matrix_.resize(0, constraint_matrix.cols());
+    constraint_boundary_.resize(0, 1);
   }
   if (constraint_matrix_.cols() != constraint_matrix.cols()) {
     AERROR
@@ -77,15 +88,34 @@ bool AffineConstraint::AddConstraint(
     return false;
   }
 
-  Eigen::MatrixXd n_matrix(constraint_matrix_.rows() + constraint_matrix.rows(),
-                           constraint_matrix_.cols());
-  Eigen::MatrixXd n_boundary(
-      constraint_boundary_.rows() + constraint_boundary.rows(), 1);
+  // The new rows are appended to the compressed storage in place; only their
+  // non zeros are kept, the generators also write e.g. the powers of a zero
+  // relative x.
+  const int num_rows = constraint_matrix_.rows();
+  int num_non_zeros = constraint_matrix_.nonZeros();
+  constraint_matrix_.conservativeResize(num_rows + constraint_matrix.rows(),
+                                        constraint_matrix_.cols());
+  constraint_matrix_.resizeNonZeros(num_non_zeros +
+                                    constraint_matrix.nonZeros());
+  double* values = constraint_matrix_.valuePtr();
+  int* columns = constraint_matrix_.innerIndexPtr();
+  int* row_starts = constraint_matrix_.outerIndexPtr();
+  for (int i = 0; i < constraint_matrix.outerSize(); ++i) {
+    for (SparseMatrix::InnerIterator it(constraint_matrix, i); it; ++it) {
+      if (it.value() != 0.0) {
+        values[num_non_zeros] = it.value();
+        columns[num_non_zeros] = it.col();
+        ++num_non_zeros;
+      }
+    }
+    row_starts[num_rows + i + 1] = num_non_zeros;
+  }
+  constraint_matrix_.resizeNonZeros(num_non_zeros);
 
-  n_matrix << constraint_matrix_, constraint_matrix;
-  n_boundary << constraint_boundary_, constraint_boundary;
-  constraint_matrix_ = n_matrix;
-  constraint_boundary_ = n_boundary;
+  constraint_boundary_.conservativeResize(
+      num_rows + constraint_boundary.rows(), 1);
+  constraint_boundary_.bottomRows(constraint_boundary.rows()) =
+      constraint_boundary;
   return true;
 }
 
@@ -22,13 +22,20 @@
 #define MODULES_PLANNING_MATH_SMOOTHING_SPLINE_AFFINE_CONSTRAINT_H_
 
 #include "Eigen/Core"
+#include "Eigen/SparseCore"
+
 #include "modules/planning/math/polynomial_xd.h"
 
 namespace apollo {
 namespace planning {
 
+// The rows of constraint_matrix * x (==|>=) constraint_boundary. The matrix
+// is kept sparse: a spline constraint only touches the coefficients of the
+// one or two segments it is evaluated on.
 class AffineConstraint {
  public:
+  using SparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
   AffineConstraint() = default;
   explicit AffineConstraint(const bool is_equality);
   explicit AffineConstraint(const Eigen::MatrixXd& constraint_matrix,
@@ -37,13 +44,18 @@ class AffineConstraint {
 
   void SetIsEquality(const double is_equality);
 
-  const Eigen::MatrixXd& constraint_matrix() const;
+  // a dense copy of the constraint matrix.
+  Eigen::MatrixXd constraint_matrix() const;
+  const SparseMatrix& sparse_constraint_matrix() const;
   const Eigen::MatrixXd& constraint_boundary() const;
   bool AddConstraint(const Eigen::MatrixXd& constraint_matrix,
                      const Eigen::MatrixXd& constraint_boundary);
+  // appends the rows in time linear in their non zeros.
+  bool AddConstraint(const SparseMatrix& constraint_matrix,
+                     const Eigen::MatrixXd& constraint_boundary);
 
  private:
-  Eigen::MatrixXd constraint_matrix_;
+  SparseMatrix constraint_matrix_;
   Eigen::MatrixXd constraint_boundary_;
   bool is_equality_ = true;
 };
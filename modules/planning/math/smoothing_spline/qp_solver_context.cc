@@ -0,0 +1,240 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file : qp_solver_context.cc
+ **/
+
+#include "modules/planning/math/smoothing_spline/qp_solver_context.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/common/log.h"
+#include "modules/common/math/qp_solver/qp_solver_gflags.h"
+#include "modules/common/time/time.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::time::Clock;
+using Eigen::MatrixXd;
+using RowMajorMatrixXd =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+QpSolverContext::QpSolverContext(const std::string& name,
+                                 const ::qpOASES::HessianType hessian_type,
+                                 const int cholesky_refactorisation_freq)
+    : name_(name),
+      hessian_type_(hessian_type),
+      cholesky_refactorisation_freq_(cholesky_refactorisation_freq) {}
+
+bool QpSolverContext::Solve(const MatrixXd& kernel_matrix,
+                            const MatrixXd& offset,
+                            const AffineConstraint& equality_constraint,
+                            const AffineConstraint& inequality_constraint,
+                            MatrixXd* params) {
+  CHECK_NOTNULL(params);
+  const AffineConstraint::SparseMatrix& equality_constraint_matrix =
+      equality_constraint.sparse_constraint_matrix();
+  const MatrixXd& equality_constraint_boundary =
+      equality_constraint.constraint_boundary();
+  const AffineConstraint::SparseMatrix& inequality_constraint_matrix =
+      inequality_constraint.sparse_constraint_matrix();
+  const MatrixXd& inequality_constraint_boundary =
+      inequality_constraint.constraint_boundary();
+
+  if (kernel_matrix.rows() != kernel_matrix.cols()) {
+    AERROR << "kernel_matrix.rows() [" << kernel_matrix.rows()
+           << "] and kernel_matrix.cols() [" << kernel_matrix.cols()
+           << "] should be identical.";
+    return false;
+  }
+
+  const int num_param = kernel_matrix.rows();
+  const int num_constraint =
+      equality_constraint_matrix.rows() + inequality_constraint_matrix.rows();
+  const bool sparse = FLAGS_enable_sparse_spline_qp;
+  ADEBUG << name_ << " num_param: " << num_param
+         << ", last_num_param_: " << last_num_param_
+         << ", num_constraint: " << num_constraint
+         << ", last_num_constraint_: " << last_num_constraint_;
+
+  hotstart_ = FLAGS_enable_sqp_solver && sqp_solver_ != nullptr &&
+              num_param == last_num_param_ &&
+              num_constraint == last_num_constraint_ && sparse == last_sparse_;
+  hotstart_failed_ = false;
+
+  // definition of qpOASESproblem
+  std::vector<double> g_matrix(offset.data(), offset.data() + offset.rows());
+
+  // search space lower bound and uppper bound
+  const double l_lower_bound_ = -1e10;
+  const double l_upper_bound_ = 1e10;
+  std::vector<double> lower_bound(num_param, l_lower_bound_);
+  std::vector<double> upper_bound(num_param, l_upper_bound_);
+
+  // constraint bounds, equality rows first
+  std::vector<double> constraint_lower_bound(num_constraint);
+  std::vector<double> constraint_upper_bound(num_constraint);
+  for (int r = 0; r < equality_constraint_matrix.rows(); ++r) {
+    constraint_lower_bound[r] = equality_constraint_boundary(r, 0);
+    constraint_upper_bound[r] = equality_constraint_boundary(r, 0);
+  }
+
+  const double constraint_upper_bound_ = 1e10;
+  for (int r = 0; r < inequality_constraint_matrix.rows(); ++r) {
+    constraint_lower_bound[r + equality_constraint_boundary.rows()] =
+        inequality_constraint_boundary(r, 0);
+    constraint_upper_bound[r + equality_constraint_boundary.rows()] =
+        constraint_upper_bound_;
+  }
+
+  // qpOASES still refers to the matrices of the last solve until hotstart()
+  // returns, so they are only replaced afterwards.
+  std::unique_ptr<SparseQpMatrices> sparse_matrices;
+  std::vector<double> h_matrix;
+  std::vector<double> affine_constraint_matrix;
+  if (sparse) {
+    sparse_matrices.reset(new SparseQpMatrices(
+        kernel_matrix, equality_constraint, inequality_constraint));
+  } else {
+    h_matrix.resize(num_param * num_param);
+    Eigen::Map<RowMajorMatrixXd>(h_matrix.data(), num_param, num_param) =
+        kernel_matrix;
+
+    affine_constraint_matrix.resize(num_param * num_constraint);
+    Eigen::Map<RowMajorMatrixXd> affine_constraint(
+        affine_constraint_matrix.data(), num_constraint, num_param);
+    affine_constraint.topRows(equality_constraint_matrix.rows()) =
+        equality_constraint_matrix;
+    affine_constraint.bottomRows(inequality_constraint_matrix.rows()) =
+        inequality_constraint_matrix;
+  }
+
+  const int max_iteration_ = 1000;
+  auto solve = [&](const bool hotstart, int* num_working_set_recalculations)
+      -> ::qpOASES::returnValue {
+    // in: the max number of working set recalculations, out: the number used.
+    *num_working_set_recalculations = std::max(max_iteration_, num_constraint);
+    if (!hotstart) {
+      sqp_solver_.reset(
+          new ::qpOASES::SQProblem(num_param, num_constraint, hessian_type_));
+      ::qpOASES::Options my_options;
+      my_options.enableCholeskyRefactorisation =
+          cholesky_refactorisation_freq_;
+      my_options.enableRegularisation = ::qpOASES::BT_TRUE;
+      my_options.epsNum = FLAGS_default_active_set_eps_num;
+      my_options.epsDen = FLAGS_default_active_set_eps_den;
+      my_options.epsIterRef = FLAGS_default_active_set_eps_iter_ref;
+      sqp_solver_->setOptions(my_options);
+      if (!FLAGS_default_enable_active_set_debug_info) {
+        sqp_solver_->setPrintLevel(qpOASES::PL_NONE);
+      }
+    }
+    if (sparse && hotstart) {
+      return sqp_solver_->hotstart(
+          sparse_matrices->hessian(), g_matrix.data(),
+          sparse_matrices->constraint_matrix(), lower_bound.data(),
+          upper_bound.data(), constraint_lower_bound.data(),
+          constraint_upper_bound.data(), *num_working_set_recalculations);
+    } else if (sparse) {
+      return sqp_solver_->init(
+          sparse_matrices->hessian(), g_matrix.data(),
+          sparse_matrices->constraint_matrix(), lower_bound.data(),
+          upper_bound.data(), constraint_lower_bound.data(),
+          constraint_upper_bound.data(), *num_working_set_recalculations);
+    } else if (hotstart) {
+      return sqp_solver_->hotstart(
+          h_matrix.data(), g_matrix.data(), affine_constraint_matrix.data(),
+          lower_bound.data(), upper_bound.data(), constraint_lower_bound.data(),
+          constraint_upper_bound.data(), *num_working_set_recalculations);
+    }
+    return sqp_solver_->init(
+        h_matrix.data(), g_matrix.data(), affine_constraint_matrix.data(),
+        lower_bound.data(), upper_bound.data(), constraint_lower_bound.data(),
+        constraint_upper_bound.data(), *num_working_set_recalculations);
+  };
+
+  const double start_timestamp = Clock::NowInSecond();
+  ADEBUG << name_ << (hotstart_ ? " is" : " is NOT") << " using SQP hotstart.";
+  int num_working_set_recalculations = 0;
+  ::qpOASES::returnValue ret =
+      solve(hotstart_, &num_working_set_recalculations);
+  num_working_set_recalculations_ = num_working_set_recalculations;
+  if (hotstart_ && ret != qpOASES::SUCCESSFUL_RETURN) {
+    // the working set of the last solve may not suit the new problem at all.
+    AWARN << name_ << " SQP hotstart failed: " << ret
+          << ", solving from scratch.";
+    hotstart_failed_ = true;
+    ret = solve(false, &num_working_set_recalculations);
+    num_working_set_recalculations_ += num_working_set_recalculations;
+  }
+  sparse_matrices_ = std::move(sparse_matrices);
+  h_matrix_.swap(h_matrix);
+  affine_constraint_matrix_.swap(affine_constraint_matrix);
+  last_num_param_ = num_param;
+  last_num_constraint_ = num_constraint;
+  last_sparse_ = sparse;
+
+  const double end_timestamp = Clock::NowInSecond();
+  solve_time_ms_ = (end_timestamp - start_timestamp) * 1000;
+  ++num_solves_;
+  if (hotstart_ && !hotstart_failed_) {
+    ++num_hotstarts_;
+  }
+  ADEBUG << name_ << " QP solve time: " << solve_time_ms_ << " ms, "
+         << num_working_set_recalculations_ << " working set recalculations.";
+
+  if (ret != qpOASES::SUCCESSFUL_RETURN) {
+    if (ret == qpOASES::RET_MAX_NWSR_REACHED) {
+      AERROR << "qpOASES solver failed due to reached max iteration";
+    } else {
+      AERROR << "qpOASES solver failed due to infeasibility or other internal "
+                "reasons:"
+             << ret;
+    }
+    Reset();
+    return false;
+  }
+
+  *params = MatrixXd::Zero(num_param, 1);
+  sqp_solver_->getPrimalSolution(params->data());
+  return true;
+}
+
+void QpSolverContext::Reset() {
+  sqp_solver_.reset();
+  sparse_matrices_.reset();
+  h_matrix_.clear();
+  affine_constraint_matrix_.clear();
+}
+
+void QpSolverContext::GetStats(planning_internal::QpSolverDebug* debug) const {
+  CHECK_NOTNULL(debug);
+  debug->set_hotstart(hotstart_);
+  debug->set_hotstart_failed(hotstart_failed_);
+  debug->set_num_working_set_recalculations(num_working_set_recalculations_);
+  debug->set_solve_time_ms(solve_time_ms_);
+  debug->set_num_param(last_num_param_);
+  debug->set_num_constraint(last_num_constraint_);
+  debug->set_num_solves(num_solves_);
+  debug->set_num_hotstarts(num_hotstarts_);
+}
+
+}  // namespace planning
+}  // namespace apollo
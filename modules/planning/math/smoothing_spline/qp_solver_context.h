@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file : qp_solver_context.h
+ * @brief: the qpOASES problem of a spline solver, kept across planning cycles
+ *         to warm start the next solve
+ **/
+
+#ifndef MODULES_PLANNING_MATH_SMOOTHING_SPLINE_QP_SOLVER_CONTEXT_H_
+#define MODULES_PLANNING_MATH_SMOOTHING_SPLINE_QP_SOLVER_CONTEXT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Eigen/Core"
+#include "qpOASES/include/qpOASES.hpp"
+
+#include "modules/planning/proto/planning_internal.pb.h"
+
+#include "modules/planning/math/smoothing_spline/affine_constraint.h"
+#include "modules/planning/math/smoothing_spline/sparse_qp_matrices.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class QpSolverContext
+ * @brief solves the QP of a spline solver, and keeps the qpOASES problem for
+ * the next solve.
+ *
+ * \par
+ * When the next QP has the same number of parameters and constraints, and
+ * --enable_sqp_solver is set, qpOASES hotstarts from the primal and dual
+ * solution and the working set of the previous one. The spline tasks own their
+ * spline solver, so consecutive planning cycles share a context. A failed
+ * hotstart is retried from scratch, and a failed solve drops the context.
+ */
+class QpSolverContext {
+ public:
+  /**
+   * @param name the name of the solver in logs.
+   * @param hessian_type the qpOASES hessian type of the problems.
+   * @param cholesky_refactorisation_freq see
+   * qpOASES::Options::enableCholeskyRefactorisation.
+   */
+  QpSolverContext(const std::string& name,
+                  const ::qpOASES::HessianType hessian_type,
+                  const int cholesky_refactorisation_freq);
+
+  /**
+   * @brief solves min 0.5 * x' * kernel_matrix * x + offset' * x such that
+   * the equality rows equal and the inequality rows are not below their
+   * boundaries.
+   * @param params the solution x, as a column.
+   */
+  bool Solve(const Eigen::MatrixXd& kernel_matrix,
+             const Eigen::MatrixXd& offset,
+             const AffineConstraint& equality_constraint,
+             const AffineConstraint& inequality_constraint,
+             Eigen::MatrixXd* params);
+
+  /**
+   * @brief drops the problem of the last solve, the next one starts from
+   * scratch.
+   */
+  void Reset();
+
+  /**
+   * @brief fills the statistics of the last solve and the solve counters.
+   */
+  void GetStats(planning_internal::QpSolverDebug* debug) const;
+
+ private:
+  const std::string name_;
+  const ::qpOASES::HessianType hessian_type_;
+  const int cholesky_refactorisation_freq_;
+
+  std::unique_ptr<::qpOASES::SQProblem> sqp_solver_;
+  // qpOASES keeps pointers to the matrices of the problem: the compressed
+  // matrices when FLAGS_enable_sparse_spline_qp, the row major arrays
+  // otherwise.
+  std::unique_ptr<SparseQpMatrices> sparse_matrices_;
+  std::vector<double> h_matrix_;
+  std::vector<double> affine_constraint_matrix_;
+
+  int last_num_constraint_ = 0;
+  int last_num_param_ = 0;
+  bool last_sparse_ = false;
+
+  // statistics of the last solve.
+  bool hotstart_ = false;
+  bool hotstart_failed_ = false;
+  int num_working_set_recalculations_ = 0;
+  double solve_time_ms_ = 0.0;
+
+  uint32_t num_solves_ = 0;
+  uint32_t num_hotstarts_ = 0;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_MATH_SMOOTHING_SPLINE_QP_SOLVER_CONTEXT_H_
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+#include "modules/planning/math/smoothing_spline/qp_solver_context.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/math/smoothing_spline/spline_1d_constraint.h"
+#include "modules/planning/math/smoothing_spline/spline_1d_kernel.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+bool Solve(const std::vector<double>& x_knots, const double end_l,
+           QpSolverContext* context, Eigen::MatrixXd* params) {
+  const uint32_t spline_order = 6;
+  Spline1dConstraint constraint(x_knots, spline_order);
+  Spline1dKernel kernel(x_knots, spline_order);
+
+  std::vector<double> x_coord;
+  for (double x = x_knots.front(); x <= x_knots.back(); x += 0.5) {
+    x_coord.push_back(x);
+  }
+  std::vector<double> lower_bound(x_coord.size(), -1.0);
+  std::vector<double> upper_bound(x_coord.size(), 1.0);
+  EXPECT_TRUE(constraint.AddPointConstraint(x_knots.front(), 0.5));
+  EXPECT_TRUE(constraint.AddPointConstraint(x_knots.back(), end_l));
+  EXPECT_TRUE(constraint.AddThirdDerivativeSmoothConstraint());
+  EXPECT_TRUE(constraint.AddBoundary(x_coord, lower_bound, upper_bound));
+  kernel.AddRegularization(0.1);
+  kernel.AddSecondOrderDerivativeMatrix(1000.0);
+  kernel.AddThirdOrderDerivativeMatrix(10.0);
+
+  return context->Solve(kernel.kernel_matrix(), kernel.offset(),
+                        constraint.equality_constraint(),
+                        constraint.inequality_constraint(), params);
+}
+
+}  // namespace
+
+TEST(QpSolverContext, hotstart) {
+  FLAGS_enable_sqp_solver = true;
+  const std::vector<double> x_knots = {0.0, 1.0, 2.0, 3.0};
+  QpSolverContext context("test", ::qpOASES::HST_POSDEF, 1);
+  planning_internal::QpSolverDebug debug;
+
+  Eigen::MatrixXd params;
+  ASSERT_TRUE(Solve(x_knots, 0.0, &context, &params));
+  context.GetStats(&debug);
+  EXPECT_FALSE(debug.hotstart());
+  EXPECT_EQ(1, debug.num_solves());
+  EXPECT_EQ(0, debug.num_hotstarts());
+  EXPECT_EQ(params.rows(), debug.num_param());
+  const int num_working_set_recalculations =
+      debug.num_working_set_recalculations();
+
+  // the same problem again, from the solution of the first one.
+  Eigen::MatrixXd hotstart_params;
+  ASSERT_TRUE(Solve(x_knots, 0.0, &context, &hotstart_params));
+  context.GetStats(&debug);
+  EXPECT_TRUE(debug.hotstart());
+  EXPECT_FALSE(debug.hotstart_failed());
+  EXPECT_EQ(2, debug.num_solves());
+  EXPECT_EQ(1, debug.num_hotstarts());
+  EXPECT_LE(debug.num_working_set_recalculations(),
+            num_working_set_recalculations);
+  ASSERT_EQ(params.rows(), hotstart_params.rows());
+  for (int i = 0; i < params.rows(); ++i) {
+    EXPECT_NEAR(params(i, 0), hotstart_params(i, 0), 1e-6);
+  }
+
+  // a different problem of the same size.
+  ASSERT_TRUE(Solve(x_knots, 0.2, &context, &params));
+  context.GetStats(&debug);
+  EXPECT_TRUE(debug.hotstart());
+  EXPECT_EQ(3, debug.num_solves());
+
+  // a problem with more parameters starts from scratch.
+  ASSERT_TRUE(Solve({0.0, 1.0, 2.0, 3.0, 4.0}, 0.0, &context, &params));
+  context.GetStats(&debug);
+  EXPECT_FALSE(debug.hotstart());
+  EXPECT_EQ(params.rows(), debug.num_param());
+
+  context.Reset();
+  ASSERT_TRUE(Solve({0.0, 1.0, 2.0, 3.0, 4.0}, 0.0, &context, &params));
+  context.GetStats(&debug);
+  EXPECT_FALSE(debug.hotstart());
+  EXPECT_EQ(5, debug.num_solves());
+}
+
+TEST(QpSolverContext, no_hotstart_without_sqp_solver) {
+  FLAGS_enable_sqp_solver = false;
+  const std::vector<double> x_knots = {0.0, 1.0, 2.0, 3.0};
+  QpSolverContext context("test", ::qpOASES::HST_POSDEF, 1);
+  planning_internal::QpSolverDebug debug;
+
+  Eigen::MatrixXd params;
+  ASSERT_TRUE(Solve(x_knots, 0.0, &context, &params));
+  ASSERT_TRUE(Solve(x_knots, 0.0, &context, &params));
+  context.GetStats(&debug);
+  EXPECT_FALSE(debug.hotstart());
+  EXPECT_EQ(2, debug.num_solves());
+  EXPECT_EQ(0, debug.num_hotstarts());
+  FLAGS_enable_sqp_solver = true;
+}
+
+}  // namespace planning
+}  // namespace apollo
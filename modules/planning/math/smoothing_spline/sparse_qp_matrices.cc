@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file : sparse_qp_matrices.cc
+ **/
+
+#include "modules/planning/math/smoothing_spline/sparse_qp_matrices.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+SparseQpMatrices::SparseQpMatrices(
+    const Eigen::MatrixXd& kernel_matrix,
+    const AffineConstraint& equality_constraint,
+    const AffineConstraint& inequality_constraint) {
+  CHECK_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  const int num_param = kernel_matrix.rows();
+
+  // qpOASES wants both triangles of the symmetric Hessian.
+  hessian_column_start_.reserve(num_param + 1);
+  for (int c = 0; c < num_param; ++c) {
+    hessian_column_start_.push_back(hessian_value_.size());
+    for (int r = 0; r < num_param; ++r) {
+      if (kernel_matrix(r, c) != 0.0) {
+        hessian_row_.push_back(r);
+        hessian_value_.push_back(kernel_matrix(r, c));
+      }
+    }
+  }
+  hessian_column_start_.push_back(hessian_value_.size());
+  hessian_.reset(new ::qpOASES::SymSparseMat(
+      num_param, num_param, hessian_row_.data(),
+      hessian_column_start_.data(), hessian_value_.data()));
+  hessian_->createDiagInfo();
+
+  // The row major constraints are transposed by counting the non zeros of
+  // each column first; rows are then visited in order, so the row indices of
+  // every column come out sorted.
+  const AffineConstraint::SparseMatrix* const blocks[] = {
+      &equality_constraint.sparse_constraint_matrix(),
+      &inequality_constraint.sparse_constraint_matrix()};
+  int num_constraint = 0;
+  constraint_column_start_.assign(num_param + 1, 0);
+  for (const auto* block : blocks) {
+    if (block->rows() == 0) {
+      continue;
+    }
+    CHECK_EQ(block->cols(), num_param);
+    num_constraint += block->rows();
+    for (int r = 0; r < block->outerSize(); ++r) {
+      for (AffineConstraint::SparseMatrix::InnerIterator it(*block, r); it;
+           ++it) {
+        ++constraint_column_start_[it.col() + 1];
+      }
+    }
+  }
+  for (int c = 0; c < num_param; ++c) {
+    constraint_column_start_[c + 1] += constraint_column_start_[c];
+  }
+  constraint_row_.resize(constraint_column_start_.back());
+  constraint_value_.resize(constraint_column_start_.back());
+  std::vector<::qpOASES::sparse_int_t> next(constraint_column_start_.begin(),
+                                            constraint_column_start_.end() - 1);
+  int row_offset = 0;
+  for (const auto* block : blocks) {
+    for (int r = 0; r < block->outerSize(); ++r) {
+      for (AffineConstraint::SparseMatrix::InnerIterator it(*block, r); it;
+           ++it) {
+        const int index = next[it.col()]++;
+        constraint_row_[index] = row_offset + r;
+        constraint_value_[index] = it.value();
+      }
+    }
+    row_offset += block->rows();
+  }
+  constraint_matrix_.reset(new ::qpOASES::SparseMatrix(
+      num_constraint, num_param, constraint_row_.data(),
+      constraint_column_start_.data(), constraint_value_.data()));
+}
+
+::qpOASES::SymSparseMat* SparseQpMatrices::hessian() { return hessian_.get(); }
+
+::qpOASES::SparseMatrix* SparseQpMatrices::constraint_matrix() {
+  return constraint_matrix_.get();
+}
+
+size_t SparseQpMatrices::ByteSize() const {
+  return sizeof(::qpOASES::sparse_int_t) *
+             (hessian_row_.size() + hessian_column_start_.size() +
+              constraint_row_.size() + constraint_column_start_.size()) +
+         sizeof(::qpOASES::real_t) *
+             (hessian_value_.size() + constraint_value_.size());
+}
+
+}  // namespace planning
+}  // namespace apollo
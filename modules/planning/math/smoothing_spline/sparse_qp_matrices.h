@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file : sparse_qp_matrices.h
+ * @brief: the spline QP matrices in the compressed sparse column format of
+ *         qpOASES
+ **/
+
+#ifndef MODULES_PLANNING_MATH_SMOOTHING_SPLINE_SPARSE_QP_MATRICES_H_
+#define MODULES_PLANNING_MATH_SMOOTHING_SPLINE_SPARSE_QP_MATRICES_H_
+
+#include <memory>
+#include <vector>
+
+#include "Eigen/Core"
+#include "qpOASES/include/qpOASES.hpp"
+
+#include "modules/planning/math/smoothing_spline/affine_constraint.h"
+
+namespace apollo {
+namespace planning {
+
+// The Hessian and the constraint matrix of a spline QP, stored as the
+// compressed sparse columns qpOASES reads without densifying. The equality
+// rows are stacked over the inequality rows, the order of the dense arrays
+// in Spline1dGenerator and Spline2dSolver. qpOASES keeps pointers to the
+// matrices, so they must outlive the init() or hotstart() that uses them.
+class SparseQpMatrices {
+ public:
+  SparseQpMatrices(const Eigen::MatrixXd& kernel_matrix,
+                   const AffineConstraint& equality_constraint,
+                   const AffineConstraint& inequality_constraint);
+
+  ::qpOASES::SymSparseMat* hessian();
+  ::qpOASES::SparseMatrix* constraint_matrix();
+
+  // the bytes of the compressed arrays.
+  size_t ByteSize() const;
+
+ private:
+  std::vector<::qpOASES::sparse_int_t> hessian_row_;
+  std::vector<::qpOASES::sparse_int_t> hessian_column_start_;
+  std::vector<::qpOASES::real_t> hessian_value_;
+  std::unique_ptr<::qpOASES::SymSparseMat> hessian_;
+
+  std::vector<::qpOASES::sparse_int_t> constraint_row_;
+  std::vector<::qpOASES::sparse_int_t> constraint_column_start_;
+  std::vector<::qpOASES::real_t> constraint_value_;
+  std::unique_ptr<::qpOASES::SparseMatrix> constraint_matrix_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_MATH_SMOOTHING_SPLINE_SPARSE_QP_MATRICES_H_
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+#include "modules/planning/math/smoothing_spline/sparse_qp_matrices.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/math/smoothing_spline/spline_1d_constraint.h"
+#include "modules/planning/math/smoothing_spline/spline_1d_kernel.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(SparseQpMatrices, same_as_dense_matrices) {
+  std::vector<double> x_knots = {0.0, 1.0, 2.0, 3.0};
+  const uint32_t spline_order = 6;
+  Spline1dConstraint constraint(x_knots, spline_order);
+  Spline1dKernel kernel(x_knots, spline_order);
+
+  std::vector<double> x_coord = {0.0, 0.5, 1.0, 1.5, 2.0, 2.5, 3.0};
+  std::vector<double> lower_bound(x_coord.size(), -1.0);
+  std::vector<double> upper_bound(x_coord.size(), 1.0);
+  EXPECT_TRUE(constraint.AddPointConstraint(0.0, 0.5));
+  EXPECT_TRUE(constraint.AddPointDerivativeConstraint(3.0, 0.0));
+  EXPECT_TRUE(constraint.AddThirdDerivativeSmoothConstraint());
+  EXPECT_TRUE(constraint.AddBoundary(x_coord, lower_bound, upper_bound));
+  EXPECT_TRUE(
+      constraint.AddDerivativeBoundary(x_coord, lower_bound, upper_bound));
+  kernel.AddRegularization(0.1);
+  kernel.AddSecondOrderDerivativeMatrix(1000.0);
+  kernel.AddThirdOrderDerivativeMatrix(10.0);
+
+  SparseQpMatrices matrices(kernel.kernel_matrix(),
+                            constraint.equality_constraint(),
+                            constraint.inequality_constraint());
+
+  const Eigen::MatrixXd& kernel_matrix = kernel.kernel_matrix();
+  const int num_param = kernel_matrix.rows();
+  std::unique_ptr<double[]> hessian(matrices.hessian()->full());
+  for (int r = 0; r < num_param; ++r) {
+    for (int c = 0; c < num_param; ++c) {
+      EXPECT_DOUBLE_EQ(hessian[r * num_param + c], kernel_matrix(r, c));
+    }
+  }
+
+  const Eigen::MatrixXd equality_matrix =
+      constraint.equality_constraint().constraint_matrix();
+  const Eigen::MatrixXd inequality_matrix =
+      constraint.inequality_constraint().constraint_matrix();
+  const int num_constraint = equality_matrix.rows() + inequality_matrix.rows();
+  Eigen::MatrixXd affine_matrix(num_constraint, num_param);
+  affine_matrix << equality_matrix, inequality_matrix;
+  std::unique_ptr<double[]> constraint_matrix(
+      matrices.constraint_matrix()->full());
+  for (int r = 0; r < num_constraint; ++r) {
+    for (int c = 0; c < num_param; ++c) {
+      EXPECT_DOUBLE_EQ(constraint_matrix[r * num_param + c],
+                       affine_matrix(r, c));
+    }
+  }
+  EXPECT_LT(matrices.ByteSize(),
+            sizeof(double) * (num_param + num_constraint) * num_param);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -74,9 +74,11 @@ bool Spline1dConstraint::AddBoundary(const std::vector<double>& x_coord,
     return false;
   }
   // emplace affine constraints
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix inequality_constraint(
       filtered_upper_bound.size() + filtered_lower_bound.size(),
       (x_knots_.size() - 1) * spline_order_);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), spline_order_));
   Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(
       filtered_upper_bound.size() + filtered_lower_bound.size(), 1);
 
@@ -86,7 +88,7 @@ bool Spline1dConstraint::AddBoundary(const std::vector<double>& x_coord,
     const double corrected_x = filtered_lower_bound_x[i] - x_knots_[index];
     double coef = 1.0;
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      inequality_constraint(i, j + index * spline_order_) = coef;
+      inequality_constraint.coeffRef(i, j + index * spline_order_) = coef;
       coef *= corrected_x;
     }
     inequality_boundary(i, 0) = filtered_lower_bound[i];
@@ -97,8 +99,8 @@ bool Spline1dConstraint::AddBoundary(const std::vector<double>& x_coord,
     const double corrected_x = filtered_upper_bound_x[i] - x_knots_[index];
     double coef = -1.0;
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      inequality_constraint(i + filtered_lower_bound.size(),
-                            j + index * spline_order_) = coef;
+      inequality_constraint.coeffRef(i + filtered_lower_bound.size(),
+                                     j + index * spline_order_) = coef;
       coef *= corrected_x;
     }
     inequality_boundary(i + filtered_lower_bound.size(), 0) =
@@ -128,9 +130,11 @@ bool Spline1dConstraint::AddDerivativeBoundary(
   }
 
   // emplace affine constraints
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix inequality_constraint(
       filtered_upper_bound.size() + filtered_lower_bound.size(),
       (x_knots_.size() - 1) * spline_order_);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), spline_order_));
   Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(
       filtered_upper_bound.size() + filtered_lower_bound.size(), 1);
 
@@ -139,7 +143,7 @@ bool Spline1dConstraint::AddDerivativeBoundary(
     const double corrected_x = filtered_lower_bound_x[i] - x_knots_[index];
     double coef = 1.0;
     for (uint32_t j = 1; j < spline_order_; ++j) {
-      inequality_constraint(i, j + index * spline_order_) = coef * j;
+      inequality_constraint.coeffRef(i, j + index * spline_order_) = coef * j;
       coef *= corrected_x;
     }
     inequality_boundary(i, 0) = filtered_lower_bound[i];
@@ -150,8 +154,8 @@ bool Spline1dConstraint::AddDerivativeBoundary(
     const double corrected_x = filtered_upper_bound_x[i] - x_knots_[index];
     double coef = -1.0;
     for (uint32_t j = 1; j < spline_order_; ++j) {
-      inequality_constraint(i + filtered_lower_bound.size(),
-                            j + index * spline_order_) = coef * j;
+      inequality_constraint.coeffRef(i + filtered_lower_bound.size(),
+                                     j + index * spline_order_) = coef * j;
       coef *= corrected_x;
     }
     inequality_boundary(i + filtered_lower_bound.size(), 0) =
@@ -180,9 +184,11 @@ bool Spline1dConstraint::AddSecondDerivativeBoundary(
   }
 
   // emplace affine constraints
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix inequality_constraint(
       filtered_upper_bound.size() + filtered_lower_bound.size(),
       (x_knots_.size() - 1) * spline_order_);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), spline_order_));
   Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(
       filtered_upper_bound.size() + filtered_lower_bound.size(), 1);
 
@@ -191,7 +197,8 @@ bool Spline1dConstraint::AddSecondDerivativeBoundary(
     const double corrected_x = filtered_lower_bound_x[i] - x_knots_[index];
     double coef = 1.0;
     for (uint32_t j = 2; j < spline_order_; ++j) {
-      inequality_constraint(i, j + index * spline_order_) = coef * j * (j - 1);
+      inequality_constraint.coeffRef(i, j + index * spline_order_) =
+          coef * j * (j - 1);
       coef *= corrected_x;
     }
     inequality_boundary(i, 0) = filtered_lower_bound[i];
@@ -202,8 +209,9 @@ bool Spline1dConstraint::AddSecondDerivativeBoundary(
     const double corrected_x = filtered_upper_bound_x[i] - x_knots_[index];
     double coef = -1.0;
     for (uint32_t j = 2; j < spline_order_; ++j) {
-      inequality_constraint(i + filtered_lower_bound.size(),
-                            j + index * spline_order_) = coef * j * (j - 1);
+      inequality_constraint.coeffRef(i + filtered_lower_bound.size(),
+                                     j + index * spline_order_) =
+          coef * j * (j - 1);
       coef *= corrected_x;
     }
     inequality_boundary(i + filtered_lower_bound.size(), 0) =
@@ -234,9 +242,11 @@ bool Spline1dConstraint::AddThirdDerivativeBoundary(
   }
 
   // emplace affine constraints
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix inequality_constraint(
       filtered_upper_bound.size() + filtered_lower_bound.size(),
       (x_knots_.size() - 1) * spline_order_);
+  inequality_constraint.reserve(
+      Eigen::VectorXi::Constant(inequality_constraint.rows(), spline_order_));
   Eigen::MatrixXd inequality_boundary = Eigen::MatrixXd::Zero(
       filtered_upper_bound.size() + filtered_lower_bound.size(), 1);
 
@@ -245,7 +255,7 @@ bool Spline1dConstraint::AddThirdDerivativeBoundary(
     const double corrected_x = filtered_lower_bound_x[i] - x_knots_[index];
     double coef = 1.0;
     for (uint32_t j = 3; j < spline_order_; ++j) {
-      inequality_constraint(i, j + index * spline_order_) =
+      inequality_constraint.coeffRef(i, j + index * spline_order_) =
           coef * j * (j - 1) * (j - 2);
       coef *= corrected_x;
     }
@@ -257,8 +267,8 @@ bool Spline1dConstraint::AddThirdDerivativeBoundary(
     const double corrected_x = filtered_upper_bound_x[i] - x_knots_[index];
     double coef = -1.0;
     for (uint32_t j = 3; j < spline_order_; ++j) {
-      inequality_constraint(i + filtered_lower_bound.size(),
-                            j + index * spline_order_) =
+      inequality_constraint.coeffRef(i + filtered_lower_bound.size(),
+                                     j + index * spline_order_) =
           coef * j * (j - 1) * (j - 2);
       coef *= corrected_x;
     }
@@ -273,15 +283,17 @@ bool Spline1dConstraint::AddPointConstraint(const double x, const double fx) {
   uint32_t index = FindIndex(x);
   std::vector<double> power_x;
   GeneratePowerX(x - x_knots_[index], spline_order_, &power_x);
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(1, (x_knots_.size() - 1) * spline_order_);
+  AffineConstraint::SparseMatrix equality_constraint(
+      1, (x_knots_.size() - 1) * spline_order_);
+  equality_constraint.reserve(Eigen::VectorXi::Constant(1, spline_order_));
   uint32_t index_offset = index * spline_order_;
   for (uint32_t i = 0; i < spline_order_; ++i) {
-    equality_constraint(0, index_offset + i) = power_x[i];
+    equality_constraint.coeffRef(0, index_offset + i) = power_x[i];
   }
   Eigen::MatrixXd equality_boundary(1, 1);
   equality_boundary(0, 0) = fx;
-  return AddEqualityConstraint(equality_constraint, equality_boundary);
+  return equality_constraint_.AddConstraint(equality_constraint,
+                                            equality_boundary);
 }
 
 bool Spline1dConstraint::AddPointDerivativeConstraint(const double x,
@@ -289,15 +301,17 @@ bool Spline1dConstraint::AddPointDerivativeConstraint(const double x,
   uint32_t index = FindIndex(x);
   std::vector<double> power_x;
   GeneratePowerX(x - x_knots_[index], spline_order_, &power_x);
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(1, (x_knots_.size() - 1) * spline_order_);
+  AffineConstraint::SparseMatrix equality_constraint(
+      1, (x_knots_.size() - 1) * spline_order_);
+  equality_constraint.reserve(Eigen::VectorXi::Constant(1, spline_order_));
   uint32_t index_offset = index * spline_order_;
   for (uint32_t i = 1; i < spline_order_; ++i) {
-    equality_constraint(0, index_offset + i) = power_x[i - 1] * i;
+    equality_constraint.coeffRef(0, index_offset + i) = power_x[i - 1] * i;
   }
   Eigen::MatrixXd equality_boundary(1, 1);
   equality_boundary(0, 0) = dfx;
-  return AddEqualityConstraint(equality_constraint, equality_boundary);
+  return equality_constraint_.AddConstraint(equality_constraint,
+                                            equality_boundary);
 }
 
 bool Spline1dConstraint::AddPointSecondDerivativeConstraint(const double x,
@@ -305,15 +319,18 @@ bool Spline1dConstraint::AddPointSecondDerivativeConstraint(const double x,
   uint32_t index = FindIndex(x);
   std::vector<double> power_x;
   GeneratePowerX(x - x_knots_[index], spline_order_, &power_x);
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(1, (x_knots_.size() - 1) * spline_order_);
+  AffineConstraint::SparseMatrix equality_constraint(
+      1, (x_knots_.size() - 1) * spline_order_);
+  equality_constraint.reserve(Eigen::VectorXi::Constant(1, spline_order_));
   uint32_t index_offset = index * spline_order_;
   for (uint32_t i = 2; i < spline_order_; ++i) {
-    equality_constraint(0, index_offset + i) = power_x[i - 2] * i * (i - 1);
+    equality_constraint.coeffRef(0, index_offset + i) =
+        power_x[i - 2] * i * (i - 1);
   }
   Eigen::MatrixXd equality_boundary(1, 1);
   equality_boundary(0, 0) = ddfx;
-  return AddEqualityConstraint(equality_constraint, equality_boundary);
+  return equality_constraint_.AddConstraint(equality_constraint,
+                                            equality_boundary);
 }
 
 bool Spline1dConstraint::AddPointThirdDerivativeConstraint(const double x,
@@ -321,24 +338,28 @@ bool Spline1dConstraint::AddPointThirdDerivativeConstraint(const double x,
   uint32_t index = FindIndex(x);
   std::vector<double> power_x;
   GeneratePowerX(x - x_knots_[index], spline_order_, &power_x);
-  Eigen::MatrixXd equality_constraint =
-      Eigen::MatrixXd::Zero(1, (x_knots_.size() - 1) * spline_order_);
+  AffineConstraint::SparseMatrix equality_constraint(
+      1, (x_knots_.size() - 1) * spline_order_);
+  equality_constraint.reserve(Eigen::VectorXi::Constant(1, spline_order_));
   uint32_t index_offset = index * spline_order_;
   for (uint32_t i = 3; i < spline_order_; ++i) {
-    equality_constraint(0, index_offset + i) =
+    equality_constraint.coeffRef(0, index_offset + i) =
         power_x[i - 3] * i * (i - 1) * (i - 2);
   }
   Eigen::MatrixXd equality_boundary(1, 1);
   equality_boundary(0, 0) = dddfx;
-  return AddEqualityConstraint(equality_constraint, equality_boundary);
+  return equality_constraint_.AddConstraint(equality_constraint,
+                                            equality_boundary);
 }
 
 bool Spline1dConstraint::AddSmoothConstraint() {
   if (x_knots_.size() < 3) {
     return false;
   }
-  Eigen::MatrixXd equality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix equality_constraint(
       x_knots_.size() - 2, (x_knots_.size() - 1) * spline_order_);
+  equality_constraint.reserve(Eigen::VectorXi::Constant(
+      equality_constraint.rows(), 2 * spline_order_));
   Eigen::MatrixXd equality_boundary =
       Eigen::MatrixXd::Zero(x_knots_.size() - 2, 1);
 
@@ -348,8 +369,8 @@ bool Spline1dConstraint::AddSmoothConstraint() {
     const double x_left = x_knots_[i + 1] - x_knots_[i];
     const double x_right = 0.0;
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      equality_constraint(i, spline_order_ * i + j) = left_coef;
-      equality_constraint(i, spline_order_ * (i + 1) + j) = right_coef;
+      equality_constraint.coeffRef(i, spline_order_ * i + j) = left_coef;
+      equality_constraint.coeffRef(i, spline_order_ * (i + 1) + j) = right_coef;
       left_coef *= x_left;
       right_coef *= x_right;
     }
@@ -364,8 +385,10 @@ bool Spline1dConstraint::AddDerivativeSmoothConstraint() {
   }
 
   const uint32_t n_constraint = (x_knots_.size() - 2) * 2;
-  Eigen::MatrixXd equality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix equality_constraint(
       n_constraint, (x_knots_.size() - 1) * spline_order_);
+  equality_constraint.reserve(Eigen::VectorXi::Constant(
+      equality_constraint.rows(), 2 * spline_order_));
   Eigen::MatrixXd equality_boundary = Eigen::MatrixXd::Zero(n_constraint, 1);
 
   for (uint32_t i = 0; i < n_constraint; i += 2) {
@@ -376,12 +399,13 @@ bool Spline1dConstraint::AddDerivativeSmoothConstraint() {
     const double x_left = x_knots_[i / 2 + 1] - x_knots_[i / 2];
     const double x_right = 0.0;
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      equality_constraint(i, spline_order_ * (i / 2) + j) = left_coef;
-      equality_constraint(i, spline_order_ * ((i / 2) + 1) + j) = right_coef;
+      equality_constraint.coeffRef(i, spline_order_ * (i / 2) + j) = left_coef;
+      equality_constraint.coeffRef(i, spline_order_ * ((i / 2) + 1) + j) =
+          right_coef;
       if (j >= 1) {
-        equality_constraint(i + 1, spline_order_ * (i / 2) + j) =
+        equality_constraint.coeffRef(i + 1, spline_order_ * (i / 2) + j) =
             left_dcoef * j;
-        equality_constraint(i + 1, spline_order_ * ((i / 2) + 1) + j) =
+        equality_constraint.coeffRef(i + 1, spline_order_ * ((i / 2) + 1) + j) =
             right_dcoef * j;
         left_dcoef = left_coef;
         right_dcoef = right_coef;
@@ -400,8 +424,10 @@ bool Spline1dConstraint::AddSecondDerivativeSmoothConstraint() {
   }
 
   const uint32_t n_constraint = (x_knots_.size() - 2) * 3;
-  Eigen::MatrixXd equality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix equality_constraint(
       n_constraint, (x_knots_.size() - 1) * spline_order_);
+  equality_constraint.reserve(Eigen::VectorXi::Constant(
+      equality_constraint.rows(), 2 * spline_order_));
   Eigen::MatrixXd equality_boundary = Eigen::MatrixXd::Zero(n_constraint, 1);
 
   for (uint32_t i = 0; i < n_constraint; i += 3) {
@@ -415,22 +441,23 @@ bool Spline1dConstraint::AddSecondDerivativeSmoothConstraint() {
     const double x_left = x_knots_[i / 3 + 1] - x_knots_[i / 3];
     const double x_right = 0.0;
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      equality_constraint(i, spline_order_ * (i / 3) + j) = left_coef;
-      equality_constraint(i, spline_order_ * (i / 3 + 1) + j) = right_coef;
+      equality_constraint.coeffRef(i, spline_order_ * (i / 3) + j) = left_coef;
+      equality_constraint.coeffRef(i, spline_order_ * (i / 3 + 1) + j) =
+          right_coef;
 
       if (j >= 2) {
-        equality_constraint(i + 2, spline_order_ * i / 3 + j) =
+        equality_constraint.coeffRef(i + 2, spline_order_ * i / 3 + j) =
             left_ddcoef * j * (j - 1);
-        equality_constraint(i + 2, spline_order_ * (i / 3 + 1) + j) =
+        equality_constraint.coeffRef(i + 2, spline_order_ * (i / 3 + 1) + j) =
             right_ddcoef * j * (j - 1);
         left_ddcoef = left_dcoef;
         right_ddcoef = right_dcoef;
       }
 
       if (j >= 1) {
-        equality_constraint(i + 1, spline_order_ * (i / 3) + j) =
+        equality_constraint.coeffRef(i + 1, spline_order_ * (i / 3) + j) =
             left_dcoef * j;
-        equality_constraint(i + 1, spline_order_ * (i / 3 + 1) + j) =
+        equality_constraint.coeffRef(i + 1, spline_order_ * (i / 3 + 1) + j) =
             right_dcoef * j;
         left_dcoef = left_coef;
         right_dcoef = right_coef;
@@ -449,8 +476,10 @@ bool Spline1dConstraint::AddThirdDerivativeSmoothConstraint() {
   }
 
   const uint32_t n_constraint = (x_knots_.size() - 2) * 4;
-  Eigen::MatrixXd equality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix equality_constraint(
       n_constraint, (x_knots_.size() - 1) * spline_order_);
+  equality_constraint.reserve(Eigen::VectorXi::Constant(
+      equality_constraint.rows(), 2 * spline_order_));
   Eigen::MatrixXd equality_boundary = Eigen::MatrixXd::Zero(n_constraint, 1);
 
   for (uint32_t i = 0; i < n_constraint; i += 4) {
@@ -466,30 +495,32 @@ bool Spline1dConstraint::AddThirdDerivativeSmoothConstraint() {
     const double x_left = x_knots_[i / 4 + 1] - x_knots_[i / 4];
     const double x_right = 0.0;
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      equality_constraint(i, spline_order_ * i / 4 + j) = left_coef;
-      equality_constraint(i, spline_order_ * (i / 4 + 1) + j) = right_coef;
+      equality_constraint.coeffRef(i, spline_order_ * i / 4 + j) = left_coef;
+      equality_constraint.coeffRef(i, spline_order_ * (i / 4 + 1) + j) =
+          right_coef;
 
       if (j >= 3) {
-        equality_constraint(i + 3, spline_order_ * i / 4 + j) =
+        equality_constraint.coeffRef(i + 3, spline_order_ * i / 4 + j) =
             left_dddcoef * j * (j - 1) * (j - 2);
-        equality_constraint(i + 3, spline_order_ * (i / 4 + 1) + j) =
+        equality_constraint.coeffRef(i + 3, spline_order_ * (i / 4 + 1) + j) =
             right_dddcoef * j * (j - 1) * (j - 2);
         left_dddcoef = left_ddcoef;
         right_dddcoef = right_ddcoef;
       }
 
       if (j >= 2) {
-        equality_constraint(i + 2, spline_order_ * i / 4 + j) =
+        equality_constraint.coeffRef(i + 2, spline_order_ * i / 4 + j) =
             left_ddcoef * j * (j - 1);
-        equality_constraint(i + 2, spline_order_ * (i / 4 + 1) + j) =
+        equality_constraint.coeffRef(i + 2, spline_order_ * (i / 4 + 1) + j) =
             right_ddcoef * j * (j - 1);
         left_ddcoef = left_dcoef;
         right_ddcoef = right_dcoef;
       }
 
       if (j >= 1) {
-        equality_constraint(i + 1, spline_order_ * i / 4 + j) = left_dcoef * j;
-        equality_constraint(i + 1, spline_order_ * (i / 4 + 1) + j) =
+        equality_constraint.coeffRef(i + 1, spline_order_ * i / 4 + j) =
+            left_dcoef * j;
+        equality_constraint.coeffRef(i + 1, spline_order_ * (i / 4 + 1) + j) =
             right_dcoef * j;
         left_dcoef = left_coef;
         right_dcoef = right_coef;
@@ -510,8 +541,10 @@ bool Spline1dConstraint::AddMonotoneInequalityConstraint(
     return false;
   }
 
-  Eigen::MatrixXd inequality_constraint = Eigen::MatrixXd::Zero(
+  AffineConstraint::SparseMatrix inequality_constraint(
       x_coord.size() - 1, (x_knots_.size() - 1) * spline_order_);
+  inequality_constraint.reserve(Eigen::VectorXi::Constant(
+      inequality_constraint.rows(), 2 * spline_order_));
   Eigen::MatrixXd inequality_boundary =
       Eigen::MatrixXd::Zero(x_coord.size() - 1, 1);
 
@@ -528,15 +561,18 @@ bool Spline1dConstraint::AddMonotoneInequalityConstraint(
     // if constraint on the same spline
     if (cur_spline_index == prev_spline_index) {
       for (uint32_t j = 0; j < cur_coef.size(); ++j) {
-        inequality_constraint(i - 1, cur_spline_index * spline_order_ + j) =
+        inequality_constraint.coeffRef(
+            i - 1, cur_spline_index * spline_order_ + j) =
             cur_coef[j] - prev_coef[j];
       }
     } else {
       // if not on the same spline
       for (uint32_t j = 0; j < cur_coef.size(); ++j) {
-        inequality_constraint(i - 1, prev_spline_index * spline_order_ + j) =
+        inequality_constraint.coeffRef(
+            i - 1, prev_spline_index * spline_order_ + j) =
             -prev_coef[j];
-        inequality_constraint(i - 1, cur_spline_index * spline_order_ + j) =
+        inequality_constraint.coeffRef(
+            i - 1, cur_spline_index * spline_order_ + j) =
             cur_coef[j];
       }
     }
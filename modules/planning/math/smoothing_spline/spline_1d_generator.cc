@@ -23,28 +23,19 @@
 
 #include "modules/planning/math/smoothing_spline/spline_1d_generator.h"
 
-#include <algorithm>
-
 #include "Eigen/Core"
-#include "Eigen/Eigenvalues"
-
-#include "modules/common/log.h"
-#include "modules/common/math/qp_solver/active_set_qp_solver.h"
-#include "modules/common/math/qp_solver/qp_solver_gflags.h"
-#include "modules/common/time/time.h"
-#include "modules/planning/common/planning_gflags.h"
 
 namespace apollo {
 namespace planning {
 
-using apollo::common::time::Clock;
 using Eigen::MatrixXd;
 
 Spline1dGenerator::Spline1dGenerator(const std::vector<double>& x_knots,
                                      const uint32_t spline_order)
     : spline_(x_knots, spline_order),
       spline_constraint_(x_knots, spline_order),
-      spline_kernel_(x_knots, spline_order) {}
+      spline_kernel_(x_knots, spline_order),
+      qp_solver_context_("Spline1dGenerator", ::qpOASES::HST_POSDEF, 1) {}
 
 void Spline1dGenerator::Reset(const std::vector<double>& x_knots,
                               const uint32_t spline_order) {
@@ -62,153 +53,21 @@ Spline1dKernel* Spline1dGenerator::mutable_spline_kernel() {
 }
 
 bool Spline1dGenerator::Solve() {
-  const MatrixXd& kernel_matrix = spline_kernel_.kernel_matrix();
-  const MatrixXd& offset = spline_kernel_.offset();
-  const MatrixXd& inequality_constraint_matrix =
-      spline_constraint_.inequality_constraint().constraint_matrix();
-  const MatrixXd& inequality_constraint_boundary =
-      spline_constraint_.inequality_constraint().constraint_boundary();
-  const MatrixXd& equality_constraint_matrix =
-      spline_constraint_.equality_constraint().constraint_matrix();
-  const MatrixXd& equality_constraint_boundary =
-      spline_constraint_.equality_constraint().constraint_boundary();
-
-  if (kernel_matrix.rows() != kernel_matrix.cols()) {
-    AERROR << "kernel_matrix.rows() [" << kernel_matrix.rows()
-           << "] and kernel_matrix.cols() [" << kernel_matrix.cols()
-           << "] should be identical.";
+  MatrixXd solved_params;
+  if (!qp_solver_context_.Solve(
+          spline_kernel_.kernel_matrix(), spline_kernel_.offset(),
+          spline_constraint_.equality_constraint(),
+          spline_constraint_.inequality_constraint(), &solved_params)) {
     return false;
   }
-
-  int num_param = kernel_matrix.rows();
-  int num_constraint =
-      equality_constraint_matrix.rows() + inequality_constraint_matrix.rows();
-
-  bool use_hotstart =
-      (FLAGS_enable_sqp_solver && sqp_solver_ != nullptr &&
-       num_param == last_num_param_ && num_constraint == last_num_constraint_);
-
-  if (!use_hotstart) {
-    sqp_solver_.reset(new ::qpOASES::SQProblem(num_param, num_constraint,
-                                               ::qpOASES::HST_POSDEF));
-    ::qpOASES::Options my_options;
-    my_options.enableCholeskyRefactorisation = 1;
-    my_options.enableRegularisation = ::qpOASES::BT_TRUE;
-    my_options.epsNum = FLAGS_default_active_set_eps_num;
-    my_options.epsDen = FLAGS_default_active_set_eps_den;
-    my_options.epsIterRef = FLAGS_default_active_set_eps_iter_ref;
-    sqp_solver_->setOptions(my_options);
-    if (!FLAGS_default_enable_active_set_debug_info) {
-      sqp_solver_->setPrintLevel(qpOASES::PL_NONE);
-    }
-  }
-
-  // definition of qpOASESproblem
-  const int kNumOfMatrixElements = kernel_matrix.rows() * kernel_matrix.cols();
-  double h_matrix[kNumOfMatrixElements];  // NOLINT
-
-  const int kNumOfOffsetRows = offset.rows();
-  double g_matrix[kNumOfOffsetRows];  // NOLINT
-  int index = 0;
-
-  for (int r = 0; r < kernel_matrix.rows(); ++r) {
-    g_matrix[r] = offset(r, 0);
-    for (int c = 0; c < kernel_matrix.cols(); ++c) {
-      h_matrix[index++] = kernel_matrix(r, c);
-    }
-  }
-  DCHECK_EQ(index, kernel_matrix.rows() * kernel_matrix.cols());
-
-  // search space lower bound and uppper bound
-  double lower_bound[num_param];  // NOLINT
-  double upper_bound[num_param];  // NOLINT
-
-  const double l_lower_bound_ = -1e10;
-  const double l_upper_bound_ = 1e10;
-  for (int i = 0; i < num_param; ++i) {
-    lower_bound[i] = l_lower_bound_;
-    upper_bound[i] = l_upper_bound_;
-  }
-
-  // constraint matrix construction
-  double affine_constraint_matrix[num_param * num_constraint];  // NOLINT
-  double constraint_lower_bound[num_constraint];                // NOLINT
-  double constraint_upper_bound[num_constraint];                // NOLINT
-  index = 0;
-
-  for (int r = 0; r < equality_constraint_matrix.rows(); ++r) {
-    constraint_lower_bound[r] = equality_constraint_boundary(r, 0);
-    constraint_upper_bound[r] = equality_constraint_boundary(r, 0);
-
-    for (int c = 0; c < num_param; ++c) {
-      affine_constraint_matrix[index++] = equality_constraint_matrix(r, c);
-    }
-  }
-
-  DCHECK_EQ(index, equality_constraint_matrix.rows() * num_param);
-
-  const double constraint_upper_bound_ = 1e10;
-  for (int r = 0; r < inequality_constraint_matrix.rows(); ++r) {
-    constraint_lower_bound[r + equality_constraint_boundary.rows()] =
-        inequality_constraint_boundary(r, 0);
-    constraint_upper_bound[r + equality_constraint_boundary.rows()] =
-        constraint_upper_bound_;
-
-    for (int c = 0; c < num_param; ++c) {
-      affine_constraint_matrix[index++] = inequality_constraint_matrix(r, c);
-    }
-  }
-  DCHECK_EQ(index, equality_constraint_matrix.rows() * num_param +
-                       inequality_constraint_boundary.rows() * num_param);
-
-  // initialize problem
-  int max_iteration_ = 1000;
-  int max_iter = std::max(max_iteration_, num_constraint);
-
-  ::qpOASES::returnValue ret;
-  const double start_timestamp = Clock::NowInSecond();
-  if (use_hotstart) {
-    ADEBUG << "using SQP hotstart.";
-    ret = sqp_solver_->hotstart(
-        h_matrix, g_matrix, affine_constraint_matrix, lower_bound, upper_bound,
-        constraint_lower_bound, constraint_upper_bound, max_iter);
-  } else {
-    ADEBUG << "no using SQP hotstart.";
-    ret = sqp_solver_->init(h_matrix, g_matrix, affine_constraint_matrix,
-                            lower_bound, upper_bound, constraint_lower_bound,
-                            constraint_upper_bound, max_iter);
-  }
-  const double end_timestamp = Clock::NowInSecond();
-  ADEBUG << "Spline1dGenerator QP solve time: "
-         << (end_timestamp - start_timestamp) * 1000 << " ms.";
-
-  if (ret != qpOASES::SUCCESSFUL_RETURN) {
-    if (ret == qpOASES::RET_MAX_NWSR_REACHED) {
-      AERROR << "qpOASES solver failed due to reached max iteration";
-    } else {
-      AERROR << "qpOASES solver failed due to infeasibility or other internal "
-                "reasons:"
-             << ret;
-    }
-    return false;
-  }
-
-  double result[num_param];  // NOLINT
-  sqp_solver_->getPrimalSolution(result);
-
-  MatrixXd solved_params = MatrixXd::Zero(num_param, 1);
-  for (int i = 0; i < num_param; ++i) {
-    solved_params(i, 0) = result[i];
-  }
-
-  const uint32_t spline_order = spline_.spline_order();
-
-  last_num_param_ = num_param;
-  last_num_constraint_ = num_constraint;
-  return spline_.SetSplineSegs(solved_params, spline_order);
+  return spline_.SetSplineSegs(solved_params, spline_.spline_order());
 }
 
 const Spline1d& Spline1dGenerator::spline() const { return spline_; }
 
+const QpSolverContext& Spline1dGenerator::qp_solver_context() const {
+  return qp_solver_context_;
+}
+
 }  // namespace planning
 }  // namespace apollo
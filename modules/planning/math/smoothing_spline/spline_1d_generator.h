@@ -51,9 +51,8 @@
 #include <memory>
 #include <vector>
 
-#include "qpOASES/include/qpOASES.hpp"
-
 #include "modules/common/math/qp_solver/qp_solver.h"
+#include "modules/planning/math/smoothing_spline/qp_solver_context.h"
 #include "modules/planning/math/smoothing_spline/spline_1d.h"
 #include "modules/planning/math/smoothing_spline/spline_1d_constraint.h"
 #include "modules/planning/math/smoothing_spline/spline_1d_kernel.h"
@@ -79,15 +78,15 @@ class Spline1dGenerator {
   // output
   const Spline1d& spline() const;
 
+  // the qpOASES problem kept across solves, and its statistics
+  const QpSolverContext& qp_solver_context() const;
+
  private:
   Spline1d spline_;
   Spline1dConstraint spline_constraint_;
   Spline1dKernel spline_kernel_;
 
-  std::unique_ptr<::qpOASES::SQProblem> sqp_solver_;
-
-  int last_num_constraint_ = 0;
-  int last_num_param_ = 0;
+  QpSolverContext qp_solver_context_;
 };
 
 }  // namespace planning
@@ -47,9 +47,7 @@ Spline1dKernel::Spline1dKernel(const std::vector<double>& x_knots,
 }
 
 void Spline1dKernel::AddRegularization(const double regularized_param) {
-  Eigen::MatrixXd id_matrix =
-      Eigen::MatrixXd::Identity(kernel_matrix_.rows(), kernel_matrix_.cols());
-  kernel_matrix_ += 2.0 * id_matrix * regularized_param;
+  kernel_matrix_.diagonal().array() += 2.0 * regularized_param;
 }
 
 bool Spline1dKernel::AddKernel(const Eigen::MatrixXd& kernel,
@@ -66,8 +66,10 @@ bool Spline2dConstraint::Add2dBoundary(
       longitidinal_bound.size() != lateral_bound.size()) {
     return false;
   }
-  Eigen::MatrixXd affine_inequality =
-      Eigen::MatrixXd::Zero(4 * t_coord.size(), total_param_);
+  AffineConstraint::SparseMatrix affine_inequality(
+      4 * t_coord.size(), total_param_);
+  affine_inequality.reserve(
+      Eigen::VectorXi::Constant(affine_inequality.rows(), 2 * spline_order_));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * t_coord.size(), 1);
   for (uint32_t i = 0; i < t_coord.size(); ++i) {
@@ -80,13 +82,14 @@ bool Spline2dConstraint::Add2dBoundary(
     std::vector<double> lateral_coef = AffineCoef(angle[i] - M_PI / 2, rel_t);
     for (uint32_t j = 0; j < 2 * spline_order_; ++j) {
       // upper longi
-      affine_inequality(4 * i, index_offset + j) = longi_coef[j];
+      affine_inequality.coeffRef(4 * i, index_offset + j) = longi_coef[j];
       // lower longi
-      affine_inequality(4 * i + 1, index_offset + j) = -longi_coef[j];
+      affine_inequality.coeffRef(4 * i + 1, index_offset + j) = -longi_coef[j];
       // upper lateral
-      affine_inequality(4 * i + 2, index_offset + j) = lateral_coef[j];
+      affine_inequality.coeffRef(4 * i + 2, index_offset + j) = lateral_coef[j];
       // lower lateral
-      affine_inequality(4 * i + 3, index_offset + j) = -lateral_coef[j];
+      affine_inequality.coeffRef(4 * i + 3, index_offset + j) =
+          -lateral_coef[j];
     }
 
     affine_boundary(4 * i, 0) = d_longitudinal - longitidinal_bound[i];
@@ -94,7 +97,8 @@ bool Spline2dConstraint::Add2dBoundary(
     affine_boundary(4 * i + 2, 0) = d_lateral - lateral_bound[i];
     affine_boundary(4 * i + 3, 0) = -d_lateral - lateral_bound[i];
   }
-  return AddInequalityConstraint(affine_inequality, affine_boundary);
+  return inequality_constraint_.AddConstraint(affine_inequality,
+                                              affine_boundary);
 }
 
 bool Spline2dConstraint::Add2dDerivativeBoundary(
@@ -107,8 +111,10 @@ bool Spline2dConstraint::Add2dDerivativeBoundary(
       longitidinal_bound.size() != lateral_bound.size()) {
     return false;
   }
-  Eigen::MatrixXd affine_inequality =
-      Eigen::MatrixXd::Zero(4 * t_coord.size(), total_param_);
+  AffineConstraint::SparseMatrix affine_inequality(
+      4 * t_coord.size(), total_param_);
+  affine_inequality.reserve(
+      Eigen::VectorXi::Constant(affine_inequality.rows(), 2 * spline_order_));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * t_coord.size(), 1);
   for (uint32_t i = 0; i < t_coord.size(); ++i) {
@@ -122,13 +128,14 @@ bool Spline2dConstraint::Add2dDerivativeBoundary(
         AffineDerivativeCoef(angle[i] - M_PI / 2, rel_t);
     for (uint32_t j = 0; j < 2 * spline_order_; ++j) {
       // upper longi
-      affine_inequality(4 * i, index_offset + j) = longi_coef[j];
+      affine_inequality.coeffRef(4 * i, index_offset + j) = longi_coef[j];
       // lower longi
-      affine_inequality(4 * i + 1, index_offset + j) = -longi_coef[j];
+      affine_inequality.coeffRef(4 * i + 1, index_offset + j) = -longi_coef[j];
       // upper lateral
-      affine_inequality(4 * i + 2, index_offset + j) = lateral_coef[j];
+      affine_inequality.coeffRef(4 * i + 2, index_offset + j) = lateral_coef[j];
       // lower lateral
-      affine_inequality(4 * i + 3, index_offset + j) = -lateral_coef[j];
+      affine_inequality.coeffRef(4 * i + 3, index_offset + j) =
+          -lateral_coef[j];
     }
 
     affine_boundary(4 * i, 0) = d_longitudinal - longitidinal_bound[i];
@@ -136,7 +143,8 @@ bool Spline2dConstraint::Add2dDerivativeBoundary(
     affine_boundary(4 * i + 2, 0) = d_lateral - lateral_bound[i];
     affine_boundary(4 * i + 3, 0) = -d_lateral - lateral_bound[i];
   }
-  return AddInequalityConstraint(affine_inequality, affine_boundary);
+  return inequality_constraint_.AddConstraint(affine_inequality,
+                                              affine_boundary);
 }
 
 bool Spline2dConstraint::Add2dSecondDerivativeBoundary(
@@ -149,8 +157,10 @@ bool Spline2dConstraint::Add2dSecondDerivativeBoundary(
       longitidinal_bound.size() != lateral_bound.size()) {
     return false;
   }
-  Eigen::MatrixXd affine_inequality =
-      Eigen::MatrixXd::Zero(4 * t_coord.size(), total_param_);
+  AffineConstraint::SparseMatrix affine_inequality(
+      4 * t_coord.size(), total_param_);
+  affine_inequality.reserve(
+      Eigen::VectorXi::Constant(affine_inequality.rows(), 2 * spline_order_));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * t_coord.size(), 1);
   for (uint32_t i = 0; i < t_coord.size(); ++i) {
@@ -165,13 +175,14 @@ bool Spline2dConstraint::Add2dSecondDerivativeBoundary(
         AffineSecondDerivativeCoef(angle[i] - M_PI / 2, rel_t);
     for (uint32_t j = 0; j < 2 * spline_order_; ++j) {
       // upper longi
-      affine_inequality(4 * i, index_offset + j) = longi_coef[j];
+      affine_inequality.coeffRef(4 * i, index_offset + j) = longi_coef[j];
       // lower longi
-      affine_inequality(4 * i + 1, index_offset + j) = -longi_coef[j];
+      affine_inequality.coeffRef(4 * i + 1, index_offset + j) = -longi_coef[j];
       // upper lateral
-      affine_inequality(4 * i + 2, index_offset + j) = lateral_coef[j];
+      affine_inequality.coeffRef(4 * i + 2, index_offset + j) = lateral_coef[j];
       // lower lateral
-      affine_inequality(4 * i + 3, index_offset + j) = -lateral_coef[j];
+      affine_inequality.coeffRef(4 * i + 3, index_offset + j) =
+          -lateral_coef[j];
     }
 
     affine_boundary(4 * i, 0) = d_longitudinal - longitidinal_bound[i];
@@ -179,7 +190,8 @@ bool Spline2dConstraint::Add2dSecondDerivativeBoundary(
     affine_boundary(4 * i + 2, 0) = d_lateral - lateral_bound[i];
     affine_boundary(4 * i + 3, 0) = -d_lateral - lateral_bound[i];
   }
-  return AddInequalityConstraint(affine_inequality, affine_boundary);
+  return inequality_constraint_.AddConstraint(affine_inequality,
+                                              affine_boundary);
 }
 
 bool Spline2dConstraint::Add2dThirdDerivativeBoundary(
@@ -192,8 +204,10 @@ bool Spline2dConstraint::Add2dThirdDerivativeBoundary(
       longitidinal_bound.size() != lateral_bound.size()) {
     return false;
   }
-  Eigen::MatrixXd affine_inequality =
-      Eigen::MatrixXd::Zero(4 * t_coord.size(), total_param_);
+  AffineConstraint::SparseMatrix affine_inequality(
+      4 * t_coord.size(), total_param_);
+  affine_inequality.reserve(
+      Eigen::VectorXi::Constant(affine_inequality.rows(), 2 * spline_order_));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * t_coord.size(), 1);
   for (uint32_t i = 0; i < t_coord.size(); ++i) {
@@ -207,13 +221,14 @@ bool Spline2dConstraint::Add2dThirdDerivativeBoundary(
         AffineThirdDerivativeCoef(angle[i] - M_PI / 2, rel_t);
     for (uint32_t j = 0; j < 2 * spline_order_; ++j) {
       // upper longi
-      affine_inequality(4 * i, index_offset + j) = longi_coef[j];
+      affine_inequality.coeffRef(4 * i, index_offset + j) = longi_coef[j];
       // lower longi
-      affine_inequality(4 * i + 1, index_offset + j) = -longi_coef[j];
+      affine_inequality.coeffRef(4 * i + 1, index_offset + j) = -longi_coef[j];
       // upper lateral
-      affine_inequality(4 * i + 2, index_offset + j) = lateral_coef[j];
+      affine_inequality.coeffRef(4 * i + 2, index_offset + j) = lateral_coef[j];
       // lower lateral
-      affine_inequality(4 * i + 3, index_offset + j) = -lateral_coef[j];
+      affine_inequality.coeffRef(4 * i + 3, index_offset + j) =
+          -lateral_coef[j];
     }
 
     affine_boundary(4 * i, 0) = d_longitudinal - longitidinal_bound[i];
@@ -221,7 +236,8 @@ bool Spline2dConstraint::Add2dThirdDerivativeBoundary(
     affine_boundary(4 * i + 2, 0) = d_lateral - lateral_bound[i];
     affine_boundary(4 * i + 3, 0) = -d_lateral - lateral_bound[i];
   }
-  return AddInequalityConstraint(affine_inequality, affine_boundary);
+  return inequality_constraint_.AddConstraint(affine_inequality,
+                                              affine_boundary);
 }
 
 bool Spline2dConstraint::AddPointConstraint(const double t, const double x,
@@ -230,15 +246,17 @@ bool Spline2dConstraint::AddPointConstraint(const double t, const double x,
   const uint32_t index_offset = index * 2 * spline_order_;
   const double rel_t = t - t_knots_[index];
 
-  Eigen::MatrixXd affine_equality = Eigen::MatrixXd::Zero(2, total_param_);
+  AffineConstraint::SparseMatrix affine_equality(2, total_param_);
+  affine_equality.reserve(Eigen::VectorXi::Constant(2, spline_order_));
   Eigen::MatrixXd affine_boundary = Eigen::MatrixXd::Zero(2, 1);
   affine_boundary << x, y;
   std::vector<double> power_t = PolyCoef(rel_t);
   for (uint32_t i = 0; i < spline_order_; ++i) {
-    affine_equality(0, i + index_offset) = power_t[i];
-    affine_equality(1, i + spline_order_ + index_offset) = power_t[i];
+    affine_equality.coeffRef(0, i + index_offset) = power_t[i];
+    affine_equality.coeffRef(1, i + spline_order_ + index_offset) = power_t[i];
   }
-  return AddEqualityConstraint(affine_equality, affine_boundary);
+  return equality_constraint_.AddConstraint(affine_equality,
+                                            affine_boundary);
 }
 
 bool Spline2dConstraint::AddPointAngleConstraint(const double t,
@@ -248,15 +266,17 @@ bool Spline2dConstraint::AddPointAngleConstraint(const double t,
   const double rel_t = t - t_knots_[index];
 
   // add equality constraint
-  Eigen::MatrixXd affine_equality = Eigen::MatrixXd::Zero(1, total_param_);
+  AffineConstraint::SparseMatrix affine_equality(1, total_param_);
+  affine_equality.reserve(Eigen::VectorXi::Constant(1, 2 * spline_order_));
   Eigen::MatrixXd affine_boundary = Eigen::MatrixXd::Zero(1, 1);
   std::vector<double> line_derivative_coef = AffineDerivativeCoef(angle, rel_t);
   for (uint32_t i = 0; i < line_derivative_coef.size(); ++i) {
-    affine_equality(0, i + index_offset) = line_derivative_coef[i];
+    affine_equality.coeffRef(0, i + index_offset) = line_derivative_coef[i];
   }
 
   // add inequality constraint
-  Eigen::MatrixXd affine_inequality = Eigen::MatrixXd::Zero(2, total_param_);
+  AffineConstraint::SparseMatrix affine_inequality(2, total_param_);
+  affine_inequality.reserve(Eigen::VectorXi::Constant(2, spline_order_));
   Eigen::MatrixXd affine_inequality_boundary = Eigen::MatrixXd::Zero(2, 1);
   std::vector<double> t_coef = DerivativeCoef(rel_t);
   int x_sign = 1;
@@ -276,13 +296,15 @@ bool Spline2dConstraint::AddPointAngleConstraint(const double t,
   }
 
   for (uint32_t i = 0; i < t_coef.size(); ++i) {
-    affine_inequality(0, i + index_offset) = t_coef[i] * x_sign;
-    affine_inequality(1, i + index_offset + spline_order_) = t_coef[i] * y_sign;
+    affine_inequality.coeffRef(0, i + index_offset) = t_coef[i] * x_sign;
+    affine_inequality.coeffRef(1, i + index_offset + spline_order_) =
+        t_coef[i] * y_sign;
   }
-  if (!AddEqualityConstraint(affine_equality, affine_boundary)) {
+  if (!equality_constraint_.AddConstraint(affine_equality, affine_boundary)) {
     return false;
   }
-  return AddInequalityConstraint(affine_inequality, affine_inequality_boundary);
+  return inequality_constraint_.AddConstraint(affine_inequality,
+                                              affine_inequality_boundary);
 }
 
 // guarantee upto values are joint
@@ -290,8 +312,10 @@ bool Spline2dConstraint::AddSmoothConstraint() {
   if (t_knots_.size() < 3) {
     return false;
   }
-  Eigen::MatrixXd affine_equality =
-      Eigen::MatrixXd::Zero(2 * (t_knots_.size() - 2), total_param_);
+  AffineConstraint::SparseMatrix affine_equality(
+      2 * (t_knots_.size() - 2), total_param_);
+  affine_equality.reserve(
+      Eigen::VectorXi::Constant(affine_equality.rows(), spline_order_ + 1));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(2 * (t_knots_.size() - 2), 1);
   for (uint32_t i = 0; i + 2 < t_knots_.size(); ++i) {
@@ -300,13 +324,16 @@ bool Spline2dConstraint::AddSmoothConstraint() {
     std::vector<double> power_t = PolyCoef(rel_t);
 
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      affine_equality(2 * i, j + index_offset) = power_t[j];
-      affine_equality(2 * i + 1, j + index_offset + spline_order_) = power_t[j];
+      affine_equality.coeffRef(2 * i, j + index_offset) = power_t[j];
+      affine_equality.coeffRef(2 * i + 1, j + index_offset + spline_order_) =
+          power_t[j];
     }
-    affine_equality(2 * i, index_offset + 2 * spline_order_) = -1.0;
-    affine_equality(2 * i + 1, index_offset + 3 * spline_order_) = -1.0;
+    affine_equality.coeffRef(2 * i, index_offset + 2 * spline_order_) = -1.0;
+    affine_equality.coeffRef(2 * i + 1, index_offset + 3 * spline_order_) =
+        -1.0;
   }
-  return AddEqualityConstraint(affine_equality, affine_boundary);
+  return equality_constraint_.AddConstraint(affine_equality,
+                                            affine_boundary);
 }
 
 // guarantee upto derivative are joint
@@ -314,8 +341,10 @@ bool Spline2dConstraint::AddDerivativeSmoothConstraint() {
   if (t_knots_.size() < 3) {
     return false;
   }
-  Eigen::MatrixXd affine_equality =
-      Eigen::MatrixXd::Zero(4 * (t_knots_.size() - 2), total_param_);
+  AffineConstraint::SparseMatrix affine_equality(
+      4 * (t_knots_.size() - 2), total_param_);
+  affine_equality.reserve(
+      Eigen::VectorXi::Constant(affine_equality.rows(), spline_order_ + 1));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(4 * (t_knots_.size() - 2), 1);
 
@@ -325,18 +354,23 @@ bool Spline2dConstraint::AddDerivativeSmoothConstraint() {
     std::vector<double> power_t = PolyCoef(rel_t);
     std::vector<double> derivative_t = DerivativeCoef(rel_t);
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      affine_equality(4 * i, j + index_offset) = power_t[j];
-      affine_equality(4 * i + 1, j + index_offset) = derivative_t[j];
-      affine_equality(4 * i + 2, j + index_offset + spline_order_) = power_t[j];
-      affine_equality(4 * i + 3, j + index_offset + spline_order_) =
+      affine_equality.coeffRef(4 * i, j + index_offset) = power_t[j];
+      affine_equality.coeffRef(4 * i + 1, j + index_offset) = derivative_t[j];
+      affine_equality.coeffRef(4 * i + 2, j + index_offset + spline_order_) =
+          power_t[j];
+      affine_equality.coeffRef(4 * i + 3, j + index_offset + spline_order_) =
           derivative_t[j];
     }
-    affine_equality(4 * i, index_offset + 2 * spline_order_) = -1.0;
-    affine_equality(4 * i + 1, index_offset + 2 * spline_order_ + 1) = -1.0;
-    affine_equality(4 * i + 2, index_offset + 3 * spline_order_) = -1.0;
-    affine_equality(4 * i + 3, index_offset + 3 * spline_order_ + 1) = -1.0;
+    affine_equality.coeffRef(4 * i, index_offset + 2 * spline_order_) = -1.0;
+    affine_equality.coeffRef(4 * i + 1, index_offset + 2 * spline_order_ + 1) =
+        -1.0;
+    affine_equality.coeffRef(4 * i + 2, index_offset + 3 * spline_order_) =
+        -1.0;
+    affine_equality.coeffRef(4 * i + 3, index_offset + 3 * spline_order_ + 1) =
+        -1.0;
   }
-  return AddEqualityConstraint(affine_equality, affine_boundary);
+  return equality_constraint_.AddConstraint(affine_equality,
+                                            affine_boundary);
 }
 
 // guarantee upto second order derivative are joint
@@ -344,8 +378,10 @@ bool Spline2dConstraint::AddSecondDerivativeSmoothConstraint() {
   if (t_knots_.size() < 3) {
     return false;
   }
-  Eigen::MatrixXd affine_equality =
-      Eigen::MatrixXd::Zero(6 * (t_knots_.size() - 2), total_param_);
+  AffineConstraint::SparseMatrix affine_equality(
+      6 * (t_knots_.size() - 2), total_param_);
+  affine_equality.reserve(
+      Eigen::VectorXi::Constant(affine_equality.rows(), spline_order_ + 1));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(6 * (t_knots_.size() - 2), 1);
 
@@ -356,23 +392,31 @@ bool Spline2dConstraint::AddSecondDerivativeSmoothConstraint() {
     std::vector<double> derivative_t = DerivativeCoef(rel_t);
     std::vector<double> second_derivative_t = SecondDerivativeCoef(rel_t);
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      affine_equality(6 * i, j + index_offset) = power_t[j];
-      affine_equality(6 * i + 1, j + index_offset) = derivative_t[j];
-      affine_equality(6 * i + 2, j + index_offset) = second_derivative_t[j];
-      affine_equality(6 * i + 3, j + index_offset + spline_order_) = power_t[j];
-      affine_equality(6 * i + 4, j + index_offset + spline_order_) =
+      affine_equality.coeffRef(6 * i, j + index_offset) = power_t[j];
+      affine_equality.coeffRef(6 * i + 1, j + index_offset) = derivative_t[j];
+      affine_equality.coeffRef(6 * i + 2, j + index_offset) =
+          second_derivative_t[j];
+      affine_equality.coeffRef(6 * i + 3, j + index_offset + spline_order_) =
+          power_t[j];
+      affine_equality.coeffRef(6 * i + 4, j + index_offset + spline_order_) =
           derivative_t[j];
-      affine_equality(6 * i + 5, j + index_offset + spline_order_) =
+      affine_equality.coeffRef(6 * i + 5, j + index_offset + spline_order_) =
           second_derivative_t[j];
     }
-    affine_equality(6 * i, index_offset + 2 * spline_order_) = -1.0;
-    affine_equality(6 * i + 1, index_offset + 2 * spline_order_ + 1) = -1.0;
-    affine_equality(6 * i + 2, index_offset + 2 * spline_order_ + 2) = -2.0;
-    affine_equality(6 * i + 3, index_offset + 3 * spline_order_) = -1.0;
-    affine_equality(6 * i + 4, index_offset + 3 * spline_order_ + 1) = -1.0;
-    affine_equality(6 * i + 5, index_offset + 3 * spline_order_ + 2) = -2.0;
+    affine_equality.coeffRef(6 * i, index_offset + 2 * spline_order_) = -1.0;
+    affine_equality.coeffRef(6 * i + 1, index_offset + 2 * spline_order_ + 1) =
+        -1.0;
+    affine_equality.coeffRef(6 * i + 2, index_offset + 2 * spline_order_ + 2) =
+        -2.0;
+    affine_equality.coeffRef(6 * i + 3, index_offset + 3 * spline_order_) =
+        -1.0;
+    affine_equality.coeffRef(6 * i + 4, index_offset + 3 * spline_order_ + 1) =
+        -1.0;
+    affine_equality.coeffRef(6 * i + 5, index_offset + 3 * spline_order_ + 2) =
+        -2.0;
   }
-  return AddEqualityConstraint(affine_equality, affine_boundary);
+  return equality_constraint_.AddConstraint(affine_equality,
+                                            affine_boundary);
 }
 
 // guarantee upto third order derivative are joint
@@ -380,8 +424,10 @@ bool Spline2dConstraint::AddThirdDerivativeSmoothConstraint() {
   if (t_knots_.size() < 3) {
     return false;
   }
-  Eigen::MatrixXd affine_equality =
-      Eigen::MatrixXd::Zero(8 * (t_knots_.size() - 2), total_param_);
+  AffineConstraint::SparseMatrix affine_equality(
+      8 * (t_knots_.size() - 2), total_param_);
+  affine_equality.reserve(
+      Eigen::VectorXi::Constant(affine_equality.rows(), spline_order_ + 1));
   Eigen::MatrixXd affine_boundary =
       Eigen::MatrixXd::Zero(8 * (t_knots_.size() - 2), 1);
 
@@ -393,28 +439,39 @@ bool Spline2dConstraint::AddThirdDerivativeSmoothConstraint() {
     std::vector<double> second_derivative_t = SecondDerivativeCoef(rel_t);
     std::vector<double> third_derivative_t = ThirdDerivativeCoef(rel_t);
     for (uint32_t j = 0; j < spline_order_; ++j) {
-      affine_equality(8 * i, j + index_offset) = power_t[j];
-      affine_equality(8 * i + 1, j + index_offset) = derivative_t[j];
-      affine_equality(8 * i + 2, j + index_offset) = second_derivative_t[j];
-      affine_equality(8 * i + 3, j + index_offset) = third_derivative_t[j];
-      affine_equality(8 * i + 4, j + index_offset + spline_order_) = power_t[j];
-      affine_equality(8 * i + 5, j + index_offset + spline_order_) =
+      affine_equality.coeffRef(8 * i, j + index_offset) = power_t[j];
+      affine_equality.coeffRef(8 * i + 1, j + index_offset) = derivative_t[j];
+      affine_equality.coeffRef(8 * i + 2, j + index_offset) =
+          second_derivative_t[j];
+      affine_equality.coeffRef(8 * i + 3, j + index_offset) =
+          third_derivative_t[j];
+      affine_equality.coeffRef(8 * i + 4, j + index_offset + spline_order_) =
+          power_t[j];
+      affine_equality.coeffRef(8 * i + 5, j + index_offset + spline_order_) =
           derivative_t[j];
-      affine_equality(8 * i + 6, j + index_offset + spline_order_) =
+      affine_equality.coeffRef(8 * i + 6, j + index_offset + spline_order_) =
           second_derivative_t[j];
-      affine_equality(8 * i + 7, j + index_offset + spline_order_) =
+      affine_equality.coeffRef(8 * i + 7, j + index_offset + spline_order_) =
           third_derivative_t[j];
     }
-    affine_equality(8 * i, index_offset + 2 * spline_order_) = -1.0;
-    affine_equality(8 * i + 1, index_offset + 2 * spline_order_ + 1) = -1.0;
-    affine_equality(8 * i + 2, index_offset + 2 * spline_order_ + 2) = -2.0;
-    affine_equality(8 * i + 3, index_offset + 2 * spline_order_ + 3) = -6.0;
-    affine_equality(8 * i + 4, index_offset + 3 * spline_order_) = -1.0;
-    affine_equality(8 * i + 5, index_offset + 3 * spline_order_ + 1) = -1.0;
-    affine_equality(8 * i + 6, index_offset + 3 * spline_order_ + 2) = -2.0;
-    affine_equality(8 * i + 7, index_offset + 3 * spline_order_ + 3) = -6.0;
+    affine_equality.coeffRef(8 * i, index_offset + 2 * spline_order_) = -1.0;
+    affine_equality.coeffRef(8 * i + 1, index_offset + 2 * spline_order_ + 1) =
+        -1.0;
+    affine_equality.coeffRef(8 * i + 2, index_offset + 2 * spline_order_ + 2) =
+        -2.0;
+    affine_equality.coeffRef(8 * i + 3, index_offset + 2 * spline_order_ + 3) =
+        -6.0;
+    affine_equality.coeffRef(8 * i + 4, index_offset + 3 * spline_order_) =
+        -1.0;
+    affine_equality.coeffRef(8 * i + 5, index_offset + 3 * spline_order_ + 1) =
+        -1.0;
+    affine_equality.coeffRef(8 * i + 6, index_offset + 3 * spline_order_ + 2) =
+        -2.0;
+    affine_equality.coeffRef(8 * i + 7, index_offset + 3 * spline_order_ + 3) =
+        -6.0;
   }
-  return AddEqualityConstraint(affine_equality, affine_boundary);
+  return equality_constraint_.AddConstraint(affine_equality,
+                                            affine_boundary);
 }
 
 /**
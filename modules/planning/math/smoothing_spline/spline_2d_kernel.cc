@@ -40,9 +40,7 @@ Spline2dKernel::Spline2dKernel(const std::vector<double>& t_knots,
 
 // customized input output
 void Spline2dKernel::AddRegularization(const double regularization_param) {
-  Eigen::MatrixXd id_matrix =
-      Eigen::MatrixXd::Identity(kernel_matrix_.rows(), kernel_matrix_.cols());
-  kernel_matrix_ += id_matrix * regularization_param;
+  kernel_matrix_.diagonal().array() += regularization_param;
 }
 
 bool Spline2dKernel::AddKernel(const Eigen::MatrixXd& kernel,
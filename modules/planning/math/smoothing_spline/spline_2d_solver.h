@@ -24,9 +24,8 @@
 #include <memory>
 #include <vector>
 
-#include "qpOASES/include/qpOASES.hpp"
-
 #include "modules/common/math/qp_solver/qp_solver.h"
+#include "modules/planning/math/smoothing_spline/qp_solver_context.h"
 #include "modules/planning/math/smoothing_spline/spline_2d.h"
 #include "modules/planning/math/smoothing_spline/spline_2d_constraint.h"
 #include "modules/planning/math/smoothing_spline/spline_2d_kernel.h"
@@ -51,14 +50,14 @@ class Spline2dSolver {
   // extract
   const Spline2d& spline() const;
 
+  // the qpOASES problem kept across solves, and its statistics
+  const QpSolverContext& qp_solver_context() const;
+
  private:
   Spline2d spline_;
   Spline2dKernel kernel_;
   Spline2dConstraint constraint_;
-  std::unique_ptr<::qpOASES::SQProblem> sqp_solver_;
-
-  int last_num_constraint_ = 0;
-  int last_num_param_ = 0;
+  QpSolverContext qp_solver_context_;
 };
 
 }  // namespace planning
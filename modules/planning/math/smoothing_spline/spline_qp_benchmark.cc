@@ -0,0 +1,353 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks assembling and solving the spline QPs of the reference
+ * line smoother, QpSplinePathGenerator and QpSplineStGraph, with the dense
+ * and the sparse qpOASES matrices, and hotstarting them across cycles.
+ **/
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/planning/proto/planning_internal.pb.h"
+
+#include "modules/common/log.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/math/smoothing_spline/sparse_qp_matrices.h"
+#include "modules/planning/math/smoothing_spline/spline_1d_generator.h"
+#include "modules/planning/math/smoothing_spline/spline_2d_solver.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+using apollo::common::math::Vec2d;
+
+// The spline order of the three tasks in planning_config.pb.txt.
+constexpr uint32_t kSplineOrder = 6;
+
+std::vector<double> UniformSlice(const double start, const double end,
+                                 const uint32_t num) {
+  std::vector<double> points;
+  for (uint32_t i = 0; i <= num; ++i) {
+    points.push_back(start + (end - start) * i / num);
+  }
+  return points;
+}
+
+// The knots of ReferenceLineSmoother, one per max_spline_length (25 m).
+std::vector<double> SmootherKnots(const uint32_t num_splines) {
+  return UniformSlice(0.0, num_splines, num_splines);
+}
+
+// The constraints and kernel of ReferenceLineSmoother on a gentle curve.
+void SetUpSmoother(const std::vector<double>& t_knots,
+                   Spline2dConstraint* constraint, Spline2dKernel* kernel) {
+  const uint32_t num_splines = t_knots.size() - 1;
+  // constraint_to_knots_ratio: 5
+  const auto evaluated_t = UniformSlice(t_knots.front(), t_knots.back(),
+                                        5 * num_splines);
+  std::vector<double> headings;
+  std::vector<Vec2d> xy_points;
+  std::vector<double> longitudinal_bound(evaluated_t.size(), 0.1);
+  std::vector<double> lateral_bound(evaluated_t.size(), 2.0);
+  const double kRadius = 500.0;
+  for (const double t : evaluated_t) {
+    const double theta = t * 25.0 / kRadius;
+    headings.push_back(theta + M_PI / 2.0);
+    xy_points.emplace_back(kRadius * std::cos(theta),
+                           kRadius * std::sin(theta));
+  }
+  longitudinal_bound.front() = longitudinal_bound.back() = 0.01;
+  lateral_bound.front() = lateral_bound.back() = 0.01;
+  CHECK(constraint->Add2dBoundary(evaluated_t, headings, xy_points,
+                                  longitudinal_bound, lateral_bound));
+  CHECK(constraint->AddSecondDerivativeSmoothConstraint());
+
+  kernel->AddSecondOrderDerivativeMatrix(200.0);
+  kernel->AddThirdOrderDerivativeMatrix(1000.0);
+  kernel->AddRegularization(0.2);
+}
+
+// The knots of QpSplinePathGenerator, one per max_spline_length (20 m).
+std::vector<double> PathKnots(const uint32_t num_splines) {
+  return UniformSlice(0.0, 20.0 * num_splines, num_splines);
+}
+
+// The constraints and kernel of QpSplinePathGenerator in a 4 m wide lane.
+void SetUpPath(const std::vector<double>& knots,
+               Spline1dConstraint* constraint, Spline1dKernel* kernel) {
+  const uint32_t num_splines = knots.size() - 1;
+  const auto evaluated_s =
+      UniformSlice(knots.front(), knots.back(), 3 * num_splines);
+  CHECK(constraint->AddPointConstraint(knots.front(), 0.5));
+  CHECK(constraint->AddPointDerivativeConstraint(knots.front(), 0.0));
+  CHECK(constraint->AddPointSecondDerivativeConstraint(knots.front(), 0.0));
+  CHECK(constraint->AddPointConstraint(knots.back(), 0.0));
+  CHECK(constraint->AddPointDerivativeConstraint(knots.back(), 0.0));
+  CHECK(constraint->AddPointSecondDerivativeConstraint(knots.back(), 0.0));
+  const std::vector<double> kappa_lower(evaluated_s.size(), -0.2);
+  const std::vector<double> kappa_upper(evaluated_s.size(), 0.2);
+  CHECK(constraint->AddSecondDerivativeBoundary(evaluated_s, kappa_lower,
+                                                kappa_upper));
+  const std::vector<double> dkappa_lower(evaluated_s.size(), -0.02);
+  const std::vector<double> dkappa_upper(evaluated_s.size(), 0.02);
+  CHECK(constraint->AddThirdDerivativeBoundary(evaluated_s, dkappa_lower,
+                                               dkappa_upper));
+  const std::vector<double> l_lower(evaluated_s.size(), -2.0);
+  const std::vector<double> l_upper(evaluated_s.size(), 2.0);
+  CHECK(constraint->AddBoundary(evaluated_s, l_lower, l_upper));
+  if (knots.size() >= 3) {
+    CHECK(constraint->AddThirdDerivativeSmoothConstraint());
+  }
+
+  kernel->AddRegularization(0.1);
+  kernel->AddSecondOrderDerivativeMatrix(1000.0);
+  kernel->AddThirdOrderDerivativeMatrix(10.0);
+}
+
+// The distance to the stop of the QpSplineStGraph problems.
+constexpr double kStopS = 70.0;
+
+// The knots of QpSplineStGraph, number_of_discrete_graph_t - 1 splines over
+// the 8 s of total_time.
+std::vector<double> StKnots(const uint32_t num_splines) {
+  return UniformSlice(0.0, 8.0, num_splines);
+}
+
+// The constraints and kernel of QpSplineStGraph cruising at 10 m/s behind a
+// stop stop_s ahead.
+void SetUpSt(const std::vector<double>& t_knots, const double stop_s,
+             Spline1dConstraint* constraint, Spline1dKernel* kernel) {
+  const uint32_t num_splines = t_knots.size() - 1;
+  const auto evaluated_t =
+      UniformSlice(t_knots.front(), t_knots.back(), 10 * num_splines);
+  CHECK(constraint->AddPointConstraint(0.0, 0.0));
+  CHECK(constraint->AddPointDerivativeConstraint(0.0, 10.0));
+  CHECK(constraint->AddMonotoneInequalityConstraint(evaluated_t));
+  CHECK(constraint->AddThirdDerivativeSmoothConstraint());
+  const std::vector<double> s_lower(evaluated_t.size(), 0.0);
+  const std::vector<double> s_upper(evaluated_t.size(), stop_s);
+  CHECK(constraint->AddBoundary(evaluated_t, s_lower, s_upper));
+  const std::vector<double> v_lower(evaluated_t.size(), 0.0);
+  const std::vector<double> v_upper(evaluated_t.size(), 15.0);
+  CHECK(constraint->AddDerivativeBoundary(evaluated_t, v_lower, v_upper));
+  const std::vector<double> a_lower(evaluated_t.size(), -4.5);
+  const std::vector<double> a_upper(evaluated_t.size(), 2.0);
+  CHECK(constraint->AddSecondDerivativeBoundary(evaluated_t, a_lower,
+                                                a_upper));
+
+  kernel->AddSecondOrderDerivativeMatrix(1000.0);
+  kernel->AddThirdOrderDerivativeMatrix(1000.0);
+  std::vector<double> cruise;
+  for (const double t : evaluated_t) {
+    cruise.push_back(std::fmin(10.0 * t, stop_s));
+  }
+  CHECK(kernel->AddReferenceLineKernelMatrix(evaluated_t, cruise, 0.5));
+  kernel->AddRegularization(0.1);
+}
+
+// The bytes of the matrices handed to qpOASES: row major arrays of the
+// Hessian and the constraints, or their compressed sparse columns.
+std::string QpMatricesLabel(const Eigen::MatrixXd& kernel_matrix,
+                            const AffineConstraint& equality_constraint,
+                            const AffineConstraint& inequality_constraint) {
+  const size_t num_param = kernel_matrix.rows();
+  const size_t num_constraint =
+      equality_constraint.sparse_constraint_matrix().rows() +
+      inequality_constraint.sparse_constraint_matrix().rows();
+  const size_t dense_bytes =
+      sizeof(double) * (num_param + num_constraint) * num_param;
+  const SparseQpMatrices sparse_matrices(kernel_matrix, equality_constraint,
+                                         inequality_constraint);
+  return std::to_string(num_param) + "x" + std::to_string(num_constraint) +
+         " dense:" + std::to_string(dense_bytes / 1024) +
+         "KiB sparse:" + std::to_string(sparse_matrices.ByteSize() / 1024) +
+         "KiB";
+}
+
+}  // namespace
+
+// Arg: number of splines.
+void BM_SmootherAssembly(benchmark::State& state) {
+  const auto t_knots = SmootherKnots(state.range(0));
+  while (state.KeepRunning()) {
+    Spline2dConstraint constraint(t_knots, kSplineOrder);
+    Spline2dKernel kernel(t_knots, kSplineOrder);
+    SetUpSmoother(t_knots, &constraint, &kernel);
+    benchmark::DoNotOptimize(constraint);
+  }
+  Spline2dConstraint constraint(t_knots, kSplineOrder);
+  Spline2dKernel kernel(t_knots, kSplineOrder);
+  SetUpSmoother(t_knots, &constraint, &kernel);
+  state.SetLabel(QpMatricesLabel(kernel.kernel_matrix(),
+                                 constraint.equality_constraint(),
+                                 constraint.inequality_constraint()));
+}
+BENCHMARK(BM_SmootherAssembly)->Arg(10)->Arg(20)->Arg(40);
+
+// Arg: number of splines.
+void BM_PathAssembly(benchmark::State& state) {
+  const auto knots = PathKnots(state.range(0));
+  while (state.KeepRunning()) {
+    Spline1dConstraint constraint(knots, kSplineOrder);
+    Spline1dKernel kernel(knots, kSplineOrder);
+    SetUpPath(knots, &constraint, &kernel);
+    benchmark::DoNotOptimize(constraint);
+  }
+  Spline1dConstraint constraint(knots, kSplineOrder);
+  Spline1dKernel kernel(knots, kSplineOrder);
+  SetUpPath(knots, &constraint, &kernel);
+  state.SetLabel(QpMatricesLabel(kernel.kernel_matrix(),
+                                 constraint.equality_constraint(),
+                                 constraint.inequality_constraint()));
+}
+BENCHMARK(BM_PathAssembly)->Arg(5)->Arg(10)->Arg(20);
+
+// Arg: number of splines.
+void BM_StAssembly(benchmark::State& state) {
+  const auto t_knots = StKnots(state.range(0));
+  while (state.KeepRunning()) {
+    Spline1dConstraint constraint(t_knots, kSplineOrder);
+    Spline1dKernel kernel(t_knots, kSplineOrder);
+    SetUpSt(t_knots, kStopS, &constraint, &kernel);
+    benchmark::DoNotOptimize(constraint);
+  }
+  Spline1dConstraint constraint(t_knots, kSplineOrder);
+  Spline1dKernel kernel(t_knots, kSplineOrder);
+  SetUpSt(t_knots, kStopS, &constraint, &kernel);
+  state.SetLabel(QpMatricesLabel(kernel.kernel_matrix(),
+                                 constraint.equality_constraint(),
+                                 constraint.inequality_constraint()));
+}
+BENCHMARK(BM_StAssembly)->Arg(3)->Arg(6)->Arg(12);
+
+// Solving includes the assembly, as each planning cycle does it again.
+// Args: {number of splines, 1 for the sparse matrices}.
+void BM_SmootherSolve(benchmark::State& state) {
+  FLAGS_enable_sparse_spline_qp = state.range(1);
+  const auto t_knots = SmootherKnots(state.range(0));
+  Spline2dSolver solver(t_knots, kSplineOrder);
+  while (state.KeepRunning()) {
+    solver.Reset(t_knots, kSplineOrder);
+    SetUpSmoother(t_knots, solver.mutable_constraint(),
+                  solver.mutable_kernel());
+    CHECK(solver.Solve());
+  }
+}
+BENCHMARK(BM_SmootherSolve)
+    ->Args({10, 0})
+    ->Args({10, 1})
+    ->Args({20, 0})
+    ->Args({20, 1})
+    ->Args({40, 0})
+    ->Args({40, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+// Args: {number of splines, 1 for the sparse matrices}.
+void BM_PathSolve(benchmark::State& state) {
+  FLAGS_enable_sparse_spline_qp = state.range(1);
+  const auto knots = PathKnots(state.range(0));
+  Spline1dGenerator generator(knots, kSplineOrder);
+  while (state.KeepRunning()) {
+    generator.Reset(knots, kSplineOrder);
+    SetUpPath(knots, generator.mutable_spline_constraint(),
+              generator.mutable_spline_kernel());
+    CHECK(generator.Solve());
+  }
+}
+BENCHMARK(BM_PathSolve)
+    ->Args({5, 0})
+    ->Args({5, 1})
+    ->Args({10, 0})
+    ->Args({10, 1})
+    ->Args({20, 0})
+    ->Args({20, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+// Args: {number of splines, 1 for the sparse matrices}.
+void BM_StSolve(benchmark::State& state) {
+  FLAGS_enable_sparse_spline_qp = state.range(1);
+  const auto t_knots = StKnots(state.range(0));
+  Spline1dGenerator generator(t_knots, kSplineOrder);
+  while (state.KeepRunning()) {
+    generator.Reset(t_knots, kSplineOrder);
+    SetUpSt(t_knots, kStopS, generator.mutable_spline_constraint(),
+            generator.mutable_spline_kernel());
+    CHECK(generator.Solve());
+  }
+}
+BENCHMARK(BM_StSolve)
+    ->Args({3, 0})
+    ->Args({3, 1})
+    ->Args({6, 0})
+    ->Args({6, 1})
+    ->Args({12, 0})
+    ->Args({12, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+// Consecutive planning cycles, 1 m closer to the stop each time, solved from
+// scratch or hotstarted from the previous cycle.
+// Args: {number of splines, 1 for the hotstart}.
+void BM_StCycles(benchmark::State& state) {
+  FLAGS_enable_sparse_spline_qp = false;
+  FLAGS_enable_sqp_solver = state.range(1);
+  const auto t_knots = StKnots(state.range(0));
+  Spline1dGenerator generator(t_knots, kSplineOrder);
+  const int kNumCycles = 20;
+  int64_t num_working_set_recalculations = 0;
+  int64_t num_hotstarts = 0;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < kNumCycles; ++i) {
+      generator.Reset(t_knots, kSplineOrder);
+      SetUpSt(t_knots, kStopS - i, generator.mutable_spline_constraint(),
+              generator.mutable_spline_kernel());
+      CHECK(generator.Solve());
+      planning_internal::QpSolverDebug debug;
+      generator.qp_solver_context().GetStats(&debug);
+      num_working_set_recalculations += debug.num_working_set_recalculations();
+      num_hotstarts += debug.hotstart() && !debug.hotstart_failed();
+    }
+  }
+  const int64_t num_solves = state.iterations() * kNumCycles;
+  state.SetItemsProcessed(num_solves);
+  state.SetLabel(
+      "nWSR/solve:" +
+      std::to_string(num_working_set_recalculations / num_solves) +
+      " hotstarts:" + std::to_string(100 * num_hotstarts / num_solves) + "%");
+  FLAGS_enable_sqp_solver = true;
+}
+BENCHMARK(BM_StCycles)
+    ->Args({3, 0})
+    ->Args({3, 1})
+    ->Args({6, 0})
+    ->Args({6, 1})
+    ->Args({12, 0})
+    ->Args({12, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <vector>
 
+#include "google/protobuf/arena.h"
 #include "google/protobuf/repeated_field.h"
 
 #include "modules/common/adapters/adapter_manager.h"
@@ -138,6 +139,11 @@ Status Planning::Init() {
         ErrorCode::PLANNING_ERROR,
         "planning is not initialized with config : " + config_.DebugString());
   }
+  if (FLAGS_enable_parallel_reference_line_planning) {
+    thread_pool_.reset(new common::util::ThreadPool(
+        std::max(0, FLAGS_reference_line_planning_threads)));
+  }
+  arena_block_.resize(std::max(0, FLAGS_planning_arena_block_size));
 
   return planner_->Init(config_);
 }
@@ -178,8 +184,19 @@ void Planning::PublishPlanningPb(ADCTrajectory* trajectory_pb,
 void Planning::RunOnce() {
   const double start_timestamp = Clock::NowInSecond();
   AdapterManager::Observe();
-  ADCTrajectory not_ready_pb;
-  auto* not_ready = not_ready_pb.mutable_decision()
+
+  // All the messages of the cycle are allocated in the arena, and freed at
+  // once with it at the end of the cycle.
+  google::protobuf::ArenaOptions arena_options;
+  if (!arena_block_.empty()) {
+    arena_options.initial_block = arena_block_.data();
+    arena_options.initial_block_size = arena_block_.size();
+  }
+  google::protobuf::Arena arena(arena_options);
+
+  ADCTrajectory* not_ready_pb =
+      google::protobuf::Arena::CreateMessage<ADCTrajectory>(&arena);
+  auto* not_ready = not_ready_pb->mutable_decision()
                         ->mutable_main_decision()
                         ->mutable_not_ready();
   if (AdapterManager::GetLocalization()->Empty()) {
@@ -194,7 +211,7 @@ void Planning::RunOnce() {
   }
   if (not_ready->has_reason()) {
     AERROR << not_ready->reason() << "; skip the planning cycle.";
-    PublishPlanningPb(&not_ready_pb, start_timestamp);
+    PublishPlanningPb(not_ready_pb, start_timestamp);
     return;
   }
 
@@ -214,8 +231,8 @@ void Planning::RunOnce() {
   if (!status.ok()) {
     AERROR << "Update VehicleState failed.";
     not_ready->set_reason("Update VehicleState failed.");
-    status.Save(not_ready_pb.mutable_header()->mutable_status());
-    PublishPlanningPb(&not_ready_pb, start_timestamp);
+    status.Save(not_ready_pb->mutable_header()->mutable_status());
+    PublishPlanningPb(not_ready_pb, start_timestamp);
     return;
   }
   const double planning_cycle_time = 1.0 / FLAGS_planning_loop_rate;
@@ -229,19 +246,21 @@ void Planning::RunOnce() {
 
   const uint32_t frame_num = AdapterManager::GetPlanning()->GetSeqNum() + 1;
   status = InitFrame(frame_num, start_timestamp, stitching_trajectory.back());
-  ADCTrajectory trajectory_pb;
+  ADCTrajectory* trajectory_pb =
+      google::protobuf::Arena::CreateMessage<ADCTrajectory>(&arena);
   if (FLAGS_enable_record_debug) {
-    frame_->RecordInputDebug(trajectory_pb.mutable_debug());
+    frame_->RecordInputDebug(trajectory_pb->mutable_debug());
   }
-  trajectory_pb.mutable_latency_stats()->set_init_frame_time_ms(
-      Clock::NowInSecond() - start_timestamp);
+  trajectory_pb->mutable_latency_stats()->set_init_frame_time_ms(
+      (Clock::NowInSecond() - start_timestamp) * 1000);
   if (!status.ok()) {
     AERROR << "Init frame failed";
     if (FLAGS_publish_estop) {
-      ADCTrajectory estop;
-      estop.mutable_estop();
-      status.Save(estop.mutable_header()->mutable_status());
-      PublishPlanningPb(&estop, start_timestamp);
+      ADCTrajectory* estop =
+          google::protobuf::Arena::CreateMessage<ADCTrajectory>(&arena);
+      estop->mutable_estop();
+      status.Save(estop->mutable_header()->mutable_status());
+      PublishPlanningPb(estop, start_timestamp);
     }
     if (frame_) {
       auto seq_num = frame_->SequenceNum();
@@ -250,22 +269,23 @@ void Planning::RunOnce() {
     return;
   }
 
-  status = Plan(start_timestamp, stitching_trajectory, &trajectory_pb);
+  status = Plan(start_timestamp, stitching_trajectory, trajectory_pb);
 
   const auto time_diff_ms = (Clock::NowInSecond() - start_timestamp) * 1000;
   ADEBUG << "total planning time spend: " << time_diff_ms << " ms.";
 
-  trajectory_pb.mutable_latency_stats()->set_total_time_ms(time_diff_ms);
-  ADEBUG << "Planning latency: " << trajectory_pb.latency_stats().DebugString();
+  trajectory_pb->mutable_latency_stats()->set_total_time_ms(time_diff_ms);
+  ADEBUG << "Planning latency: "
+         << trajectory_pb->latency_stats().DebugString();
 
   if (status.ok()) {
-    trajectory_pb.set_is_replan(is_replan);
-    PublishPlanningPb(&trajectory_pb, start_timestamp);
-    ADEBUG << "Planning succeeded:" << trajectory_pb.header().DebugString();
+    trajectory_pb->set_is_replan(is_replan);
+    PublishPlanningPb(trajectory_pb, start_timestamp);
+    ADEBUG << "Planning succeeded:" << trajectory_pb->header().DebugString();
   } else if (FLAGS_publish_estop) {
-    trajectory_pb.mutable_estop();
-    status.Save(trajectory_pb.mutable_header()->mutable_status());
-    PublishPlanningPb(&trajectory_pb, start_timestamp);
+    trajectory_pb->mutable_estop();
+    status.Save(trajectory_pb->mutable_header()->mutable_status());
+    PublishPlanningPb(trajectory_pb, start_timestamp);
     AERROR << "Planning failed";
   }
   if (frame_) {
@@ -281,6 +301,8 @@ void Planning::Stop() {
   }
   last_publishable_trajectory_.reset(nullptr);
   frame_.reset(nullptr);
+  thread_pool_.reset(nullptr);
+  reference_line_planners_.clear();
   planner_.reset(nullptr);
 }
 
@@ -299,10 +321,26 @@ common::Status Planning::Plan(
         stitching_trajectory.back());
   }
   auto status = Status::OK();
-  for (auto& reference_line_info : frame_->reference_line_info()) {
-    status = planner_->Plan(stitching_trajectory.back(), frame_.get(),
-                            &reference_line_info);
-    AERROR_IF(!status.ok()) << "planner failed to make a driving plan.";
+  std::vector<double> reference_line_time_ms;
+  const double plan_start_timestamp = Clock::NowInSecond();
+  if (thread_pool_ && frame_->reference_line_info().size() > 1) {
+    status = PlanReferenceLinesInParallel(stitching_trajectory.back(),
+                                          &reference_line_time_ms);
+  } else {
+    for (auto& reference_line_info : frame_->reference_line_info()) {
+      const double start_timestamp = Clock::NowInSecond();
+      status = planner_->Plan(stitching_trajectory.back(), frame_.get(),
+                              &reference_line_info);
+      reference_line_time_ms.push_back(
+          (Clock::NowInSecond() - start_timestamp) * 1000);
+      AERROR_IF(!status.ok()) << "planner failed to make a driving plan.";
+    }
+  }
+  auto* latency_stats = trajectory_pb->mutable_latency_stats();
+  latency_stats->set_plan_reference_lines_time_ms(
+      (Clock::NowInSecond() - plan_start_timestamp) * 1000);
+  for (const double time_ms : reference_line_time_ms) {
+    latency_stats->add_reference_line_time_ms(time_ms);
   }
 
   const auto* best_reference_line = frame_->FindDriveReferenceLineInfo();
@@ -348,5 +386,51 @@ common::Status Planning::Plan(
   return status;
 }
 
+Planner* Planning::GetReferenceLinePlanner(const size_t index) {
+  if (index == 0) {
+    return planner_.get();
+  }
+  while (reference_line_planners_.size() < index) {
+    auto planner = planner_factory_.CreateObject(config_.planner_type());
+    if (!planner || !planner->Init(config_).ok()) {
+      AERROR << "Failed to create planner for reference line "
+             << reference_line_planners_.size() + 1;
+      return nullptr;
+    }
+    reference_line_planners_.push_back(std::move(planner));
+  }
+  return reference_line_planners_[index - 1].get();
+}
+
+Status Planning::PlanReferenceLinesInParallel(
+    const TrajectoryPoint& planning_start_point, std::vector<double>* time_ms) {
+  std::vector<ReferenceLineInfo*> reference_line_infos;
+  std::vector<Planner*> planners;
+  for (auto& reference_line_info : frame_->reference_line_info()) {
+    auto* planner = GetReferenceLinePlanner(reference_line_infos.size());
+    if (planner == nullptr) {
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "failed to create reference line planner");
+    }
+    reference_line_infos.push_back(&reference_line_info);
+    planners.push_back(planner);
+  }
+
+  std::vector<Status> statuses(reference_line_infos.size());
+  time_ms->assign(reference_line_infos.size(), 0.0);
+  auto* frame = frame_.get();
+  common::util::ParallelFor(
+      thread_pool_.get(), 0, reference_line_infos.size(), [&](size_t i) {
+        const double start_timestamp = Clock::NowInSecond();
+        statuses[i] = planners[i]->Plan(planning_start_point, frame,
+                                        reference_line_infos[i]);
+        (*time_ms)[i] = (Clock::NowInSecond() - start_timestamp) * 1000;
+      });
+  for (const auto& status : statuses) {
+    AERROR_IF(!status.ok()) << "planner failed to make a driving plan.";
+  }
+  return statuses.back();
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -29,6 +29,7 @@
 #include "modules/common/apollo_app.h"
 #include "modules/common/status/status.h"
 #include "modules/common/util/factory.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/common/vehicle_state/vehicle_state.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
@@ -101,6 +102,22 @@ class Planning : public apollo::common::ApolloApp {
 
   bool HasSignalLight(const PlanningConfig& config);
 
+  /**
+   * @brief returns the planner for the index-th reference line of the
+   * frame in the parallel planning mode. Each reference line gets its own
+   * planner instance so that task states are not shared across threads.
+   */
+  Planner* GetReferenceLinePlanner(const size_t index);
+
+  /**
+   * @brief plans all the reference lines of the frame concurrently.
+   * @param time_ms the planning time of each reference line.
+   * @return the status of the last reference line, as the sequential mode.
+   */
+  common::Status PlanReferenceLinesInParallel(
+      const common::TrajectoryPoint& planning_start_point,
+      std::vector<double>* time_ms);
+
   apollo::common::util::Factory<PlanningConfig::PlannerType, Planner>
       planner_factory_;
 
@@ -112,8 +129,18 @@ class Planning : public apollo::common::ApolloApp {
 
   std::unique_ptr<Planner> planner_;
 
+  /// planners for the reference lines after the first one, only used in
+  /// the parallel planning mode.
+  std::vector<std::unique_ptr<Planner>> reference_line_planners_;
+
+  std::unique_ptr<common::util::ThreadPool> thread_pool_;
+
   std::unique_ptr<PublishableTrajectory> last_publishable_trajectory_;
 
+  /// the first memory block of the protobuf arena of each planning cycle,
+  /// reused across the cycles.
+  std::vector<char> arena_block_;
+
   ros::Timer timer_;
 };
 
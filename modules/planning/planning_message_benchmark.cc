@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the protobuf messages of a planning cycle, allocated on
+ * the heap or in an arena, and counts their heap allocations per cycle.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "google/protobuf/arena.h"
+
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/planning/proto/planning.pb.h"
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+#include "modules/routing/proto/routing.pb.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace {
+
+std::atomic<uint64_t> num_allocations(0);
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++num_allocations;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+const char kTestDataDir[] = "modules/planning/testdata/garage_test/";
+
+// The recorded inputs and result of the garage follow scenario.
+struct RecordedCycle {
+  localization::LocalizationEstimate localization;
+  canbus::Chassis chassis;
+  routing::RoutingResponse routing;
+  prediction::PredictionObstacles prediction;
+  ADCTrajectory trajectory;
+};
+
+void LoadRecordedCycle(RecordedCycle* cycle) {
+  const std::string dir = kTestDataDir;
+  CHECK(common::util::GetProtoFromFile(dir + "follow_localization.pb.txt",
+                                       &cycle->localization));
+  CHECK(common::util::GetProtoFromFile(dir + "follow_chassis.pb.txt",
+                                       &cycle->chassis));
+  CHECK(common::util::GetProtoFromFile(dir + "garage_routing.pb.txt",
+                                       &cycle->routing));
+  CHECK(common::util::GetProtoFromFile(dir + "follow_prediction.pb.txt",
+                                       &cycle->prediction));
+  CHECK(common::util::GetProtoFromFile(dir + "result_follow_0.pb.txt",
+                                       &cycle->trajectory));
+}
+
+// Builds the messages of a cycle the way Frame and Planning::RunOnce() do:
+// the frame copies the prediction, the trajectory records the inputs in its
+// debug, gets its points and decisions, and is serialized to be published.
+void RunCycle(const RecordedCycle& cycle, google::protobuf::Arena* arena,
+              std::string* serialized) {
+  auto* prediction =
+      google::protobuf::Arena::CreateMessage<prediction::PredictionObstacles>(
+          arena);
+  prediction->CopyFrom(cycle.prediction);
+
+  auto* trajectory = google::protobuf::Arena::CreateMessage<ADCTrajectory>(
+      arena);
+  auto* planning_data = trajectory->mutable_debug()->mutable_planning_data();
+  planning_data->mutable_adc_position()->CopyFrom(cycle.localization);
+  planning_data->mutable_chassis()->CopyFrom(cycle.chassis);
+  planning_data->mutable_routing()->CopyFrom(cycle.routing);
+  planning_data->mutable_prediction_header()->CopyFrom(prediction->header());
+  trajectory->MergeFrom(cycle.trajectory);
+  trajectory->mutable_latency_stats()->set_total_time_ms(1.0);
+  trajectory->SerializeToString(serialized);
+
+  if (arena == nullptr) {
+    delete prediction;
+    delete trajectory;
+  }
+}
+
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percentile) {
+  const size_t index = std::min(
+      sorted_values.size() - 1,
+      static_cast<size_t>(percentile / 100.0 * sorted_values.size()));
+  return sorted_values[index];
+}
+
+}  // namespace
+
+// Arg: whether the messages are allocated in an arena which reuses a block.
+void BM_PlanningCycleMessages(benchmark::State& state) {
+  const bool use_arena = state.range(0) != 0;
+  RecordedCycle cycle;
+  LoadRecordedCycle(&cycle);
+  std::vector<char> arena_block(std::max(0, FLAGS_planning_arena_block_size));
+  std::string serialized;
+
+  uint64_t allocations = 0;
+  std::vector<double> cycle_time_us;
+  while (state.KeepRunning()) {
+    const uint64_t start_allocations = num_allocations;
+    const auto start_time = std::chrono::steady_clock::now();
+    if (use_arena) {
+      google::protobuf::ArenaOptions arena_options;
+      arena_options.initial_block = arena_block.data();
+      arena_options.initial_block_size = arena_block.size();
+      google::protobuf::Arena arena(arena_options);
+      RunCycle(cycle, &arena, &serialized);
+    } else {
+      RunCycle(cycle, nullptr, &serialized);
+    }
+    const auto end_time = std::chrono::steady_clock::now();
+    allocations += num_allocations - start_allocations;
+    state.PauseTiming();
+    cycle_time_us.push_back(
+        std::chrono::duration<double, std::micro>(end_time - start_time)
+            .count());
+    state.ResumeTiming();
+  }
+  std::sort(cycle_time_us.begin(), cycle_time_us.end());
+  state.SetLabel(common::util::StrCat(
+      "allocations/cycle ",
+      static_cast<double>(allocations) / state.iterations(), " p50 ",
+      Percentile(cycle_time_us, 50.0), " us p99 ",
+      Percentile(cycle_time_us, 99.0), " us"));
+}
+BENCHMARK(BM_PlanningCycleMessages)->Arg(0)->Arg(1);
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -40,6 +40,7 @@ namespace planning {
 
 using MapPath = hdmap::Path;
 using apollo::common::SLPoint;
+using apollo::common::math::Vec2d;
 
 ReferenceLine::ReferenceLine(
     const std::vector<ReferencePoint>& reference_points)
@@ -80,18 +81,57 @@ ReferencePoint ReferenceLine::GetReferencePoint(const double s) const {
 
   auto it_lower =
       std::lower_bound(accumulated_s.begin(), accumulated_s.end(), s);
-  if (it_lower == accumulated_s.begin()) {
+  return GetReferencePointAtIndex(
+      std::distance(accumulated_s.begin(), it_lower), s);
+}
+
+ReferencePoint ReferenceLine::GetReferencePointAtIndex(const size_t index,
+                                                       const double s) const {
+  if (index == 0) {
     return reference_points_.front();
-  } else {
-    auto index = std::distance(accumulated_s.begin(), it_lower);
-    const auto& p0 = reference_points_[index - 1];
-    const auto& p1 = reference_points_[index];
+  }
+  const auto& accumulated_s = map_path_.accumulated_s();
+  const auto& p0 = reference_points_[index - 1];
+  const auto& p1 = reference_points_[index];
 
-    const double s0 = accumulated_s[index - 1];
-    const double s1 = accumulated_s[index];
+  const double s0 = accumulated_s[index - 1];
+  const double s1 = accumulated_s[index];
 
-    return Interpolate(p0, s0, p1, s1, s);
+  return Interpolate(p0, s0, p1, s1, s);
+}
+
+std::vector<ReferencePoint> ReferenceLine::GetReferencePoints(
+    const std::vector<double>& s) const {
+  const auto& accumulated_s = map_path_.accumulated_s();
+  std::vector<ReferencePoint> reference_points;
+  reference_points.reserve(s.size());
+  // The lower bound of the previous s in accumulated_s.
+  size_t cursor = 0;
+  for (const double point_s : s) {
+    if (point_s < accumulated_s.front()) {
+      AWARN << "The requested s " << point_s << " < 0";
+      reference_points.push_back(reference_points_.front());
+      continue;
+    }
+    if (point_s > accumulated_s.back()) {
+      AWARN << "The requested s " << point_s << " > reference line length "
+            << accumulated_s.back();
+      reference_points.push_back(reference_points_.back());
+      continue;
+    }
+    if (cursor > 0 && accumulated_s[cursor - 1] >= point_s) {
+      cursor = std::distance(
+          accumulated_s.begin(),
+          std::lower_bound(accumulated_s.begin(),
+                           accumulated_s.begin() + cursor, point_s));
+    } else {
+      while (accumulated_s[cursor] < point_s) {
+        ++cursor;
+      }
+    }
+    reference_points.push_back(GetReferencePointAtIndex(cursor, point_s));
   }
+  return reference_points;
 }
 
 double ReferenceLine::FindMinDistancePoint(const ReferencePoint& p0,
@@ -181,6 +221,50 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   return true;
 }
 
+bool ReferenceLine::SLToXY(const std::vector<SLPoint>& sl_points,
+                           std::vector<Vec2d>* const xy_points) const {
+  CHECK_NOTNULL(xy_points);
+  if (map_path_.num_points() < 2) {
+    AERROR << "The reference line has too few points.";
+    return false;
+  }
+
+  std::vector<double> s;
+  s.reserve(sl_points.size());
+  for (const auto& sl_point : sl_points) {
+    s.push_back(sl_point.s());
+  }
+  const auto matched_points = GetReferencePoints(s);
+  xy_points->clear();
+  xy_points->reserve(sl_points.size());
+  for (size_t i = 0; i < sl_points.size(); ++i) {
+    const auto angle =
+        common::math::Angle16::from_rad(matched_points[i].heading());
+    xy_points->emplace_back(
+        matched_points[i].x() - common::math::sin(angle) * sl_points[i].l(),
+        matched_points[i].y() + common::math::cos(angle) * sl_points[i].l());
+  }
+  return true;
+}
+
+bool ReferenceLine::XYToSL(const std::vector<Vec2d>& xy_points,
+                           std::vector<SLPoint>* const sl_points) const {
+  DCHECK_NOTNULL(sl_points);
+  std::vector<double> s;
+  std::vector<double> l;
+  if (!map_path_.GetProjections(xy_points, &s, &l)) {
+    AERROR << "Can't get nearest points from path.";
+    return false;
+  }
+
+  sl_points->resize(xy_points.size());
+  for (size_t i = 0; i < xy_points.size(); ++i) {
+    (*sl_points)[i].set_s(s[i]);
+    (*sl_points)[i].set_l(l[i]);
+  }
+  return true;
+}
+
 ReferencePoint ReferenceLine::Interpolate(const ReferencePoint& p0,
                                           const double s0,
                                           const ReferencePoint& p1,
@@ -259,15 +343,15 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
-  std::vector<common::math::Vec2d> corners;
+  std::vector<Vec2d> corners;
   box.GetAllCorners(&corners);
-  for (const auto& point : corners) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
+  std::vector<SLPoint> sl_corners;
+  if (!XYToSL(corners, &sl_corners)) {
+    AERROR << "failed to get projection for box: " << box.DebugString()
+           << " on reference line.";
+    return false;
+  }
+  for (const auto& sl_point : sl_corners) {
     start_s = std::fmin(start_s, sl_point.s());
     end_s = std::fmax(end_s, sl_point.s());
     start_l = std::fmin(start_l, sl_point.l());
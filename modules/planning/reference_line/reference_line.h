@@ -48,6 +48,14 @@ class ReferenceLine {
   ReferencePoint GetReferencePoint(const double s) const;
   ReferencePoint GetReferencePoint(const double x, const double y) const;
 
+  /**
+   * @brief The reference points at s like GetReferencePoint(s) point by point.
+   * A cursor moves forward along the reference line from the previous s, so
+   * increasing s, like the s of a trajectory, do not search the whole line.
+   */
+  std::vector<ReferencePoint> GetReferencePoints(
+      const std::vector<double>& s) const;
+
   bool GetSLBoundary(const common::math::Box2d& box,
                      SLBoundary* const sl_boundary) const;
 
@@ -56,6 +64,16 @@ class ReferenceLine {
   bool XYToSL(const common::math::Vec2d& xy_point,
               common::SLPoint* const sl_point) const;
 
+  /**
+   * @brief Batch SLToXY() and XYToSL(), with the same results point by point.
+   * Points ordered along the reference line are the fastest, see
+   * GetReferencePoints() and hdmap::Path::GetProjections().
+   */
+  bool SLToXY(const std::vector<common::SLPoint>& sl_points,
+              std::vector<common::math::Vec2d>* const xy_points) const;
+  bool XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+              std::vector<common::SLPoint>* const sl_points) const;
+
   bool GetLaneWidth(const double s, double* const left_width,
                     double* const right_width) const;
   bool IsOnRoad(const common::SLPoint& sl_point) const;
@@ -98,6 +116,14 @@ class ReferenceLine {
                                     const ReferencePoint& p1, const double s1,
                                     const double s);
 
+  /**
+   * @brief The reference point at s, which is within
+   * [accumulated_s[index - 1], accumulated_s[index]] of the map path, where
+   * index is the lower bound of s in accumulated_s.
+   */
+  ReferencePoint GetReferencePointAtIndex(const size_t index,
+                                          const double s) const;
+
   static double FindMinDistancePoint(const ReferencePoint& p0, const double s0,
                                      const ReferencePoint& p1, const double s1,
                                      const double x, const double y);
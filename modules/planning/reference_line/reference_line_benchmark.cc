@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the SL/XY projections of a trajectory and of obstacle
+ * boxes onto a reference line of the garage map, point by point and in
+ * batches.
+ **/
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/log.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/util/util.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/planning/reference_line/reference_line.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::SLPoint;
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+const char kMapFile[] = "modules/planning/testdata/garage_map/base_map.txt";
+const char kLaneId[] = "1_-1";
+const int kNumTrajectoryPoints = 200;
+
+const ReferenceLine& GetReferenceLine() {
+  static const ReferenceLine* reference_line = [] {
+    static hdmap::HDMap hdmap;
+    CHECK_EQ(0, hdmap.LoadMapFromFile(kMapFile));
+    auto lane = hdmap.GetLaneById(hdmap::MakeMapId(kLaneId));
+    CHECK(lane) << "Failed to find lane " << kLaneId;
+    std::vector<ReferencePoint> ref_points;
+    for (size_t i = 0; i < lane->points().size(); ++i) {
+      std::vector<hdmap::LaneWaypoint> waypoint;
+      waypoint.emplace_back(lane, lane->accumulate_s()[i]);
+      hdmap::MapPathPoint map_path_point(lane->points()[i],
+                                         lane->headings()[i], waypoint);
+      ref_points.emplace_back(map_path_point, 0.0, 0.0, -2.0, 2.0);
+    }
+    return new ReferenceLine(ref_points);
+  }();
+  return *reference_line;
+}
+
+// A trajectory of kNumTrajectoryPoints points changing lane along the first
+// 100 meters of the reference line.
+std::vector<SLPoint> TrajectorySLPoints() {
+  std::vector<SLPoint> sl_points;
+  for (int i = 0; i < kNumTrajectoryPoints; ++i) {
+    const double s = 100.0 * i / kNumTrajectoryPoints;
+    sl_points.push_back(common::util::MakeSLPoint(s, 3.5 * s / 100.0));
+  }
+  return sl_points;
+}
+
+std::vector<Vec2d> TrajectoryXYPoints() {
+  std::vector<Vec2d> xy_points;
+  CHECK(GetReferenceLine().SLToXY(TrajectorySLPoints(), &xy_points));
+  return xy_points;
+}
+
+// Obstacle boxes randomly placed around the reference line.
+std::vector<Box2d> ObstacleBoxes(const int num_boxes) {
+  const auto& reference_line = GetReferenceLine();
+  std::mt19937 random_engine(2017);
+  std::uniform_real_distribution<double> s(0.0, reference_line.Length());
+  std::uniform_real_distribution<double> l(-10.0, 10.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < num_boxes; ++i) {
+    Vec2d center;
+    CHECK(reference_line.SLToXY(
+        common::util::MakeSLPoint(s(random_engine), l(random_engine)),
+        &center));
+    boxes.emplace_back(center, heading(random_engine), 4.0, 2.0);
+  }
+  return boxes;
+}
+
+}  // namespace
+
+// Arg: 0 point by point, 1 in a batch.
+void BM_TrajectoryXYToSL(benchmark::State& state) {
+  const auto& reference_line = GetReferenceLine();
+  const auto xy_points = TrajectoryXYPoints();
+  while (state.KeepRunning()) {
+    std::vector<SLPoint> sl_points;
+    if (state.range(0)) {
+      CHECK(reference_line.XYToSL(xy_points, &sl_points));
+    } else {
+      for (const auto& xy_point : xy_points) {
+        sl_points.emplace_back();
+        CHECK(reference_line.XYToSL(xy_point, &sl_points.back()));
+      }
+    }
+    benchmark::DoNotOptimize(sl_points);
+  }
+  state.SetItemsProcessed(state.iterations() * xy_points.size());
+}
+BENCHMARK(BM_TrajectoryXYToSL)->Arg(0)->Arg(1);
+
+// Arg: 0 point by point, 1 in a batch.
+void BM_TrajectorySLToXY(benchmark::State& state) {
+  const auto& reference_line = GetReferenceLine();
+  const auto sl_points = TrajectorySLPoints();
+  while (state.KeepRunning()) {
+    std::vector<Vec2d> xy_points;
+    if (state.range(0)) {
+      CHECK(reference_line.SLToXY(sl_points, &xy_points));
+    } else {
+      for (const auto& sl_point : sl_points) {
+        xy_points.emplace_back();
+        CHECK(reference_line.SLToXY(sl_point, &xy_points.back()));
+      }
+    }
+    benchmark::DoNotOptimize(xy_points);
+  }
+  state.SetItemsProcessed(state.iterations() * sl_points.size());
+}
+BENCHMARK(BM_TrajectorySLToXY)->Arg(0)->Arg(1);
+
+// Args: {number of obstacles, 0 corner by corner, 1 box by box}.
+void BM_ObstacleXYToSL(benchmark::State& state) {
+  const auto& reference_line = GetReferenceLine();
+  std::vector<std::vector<Vec2d>> boxes_corners;
+  for (const auto& box : ObstacleBoxes(state.range(0))) {
+    boxes_corners.emplace_back();
+    box.GetAllCorners(&boxes_corners.back());
+  }
+  while (state.KeepRunning()) {
+    for (const auto& corners : boxes_corners) {
+      std::vector<SLPoint> sl_corners;
+      if (state.range(1)) {
+        CHECK(reference_line.XYToSL(corners, &sl_corners));
+      } else {
+        for (const auto& corner : corners) {
+          sl_corners.emplace_back();
+          CHECK(reference_line.XYToSL(corner, &sl_corners.back()));
+        }
+      }
+      benchmark::DoNotOptimize(sl_corners);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * boxes_corners.size());
+}
+BENCHMARK(BM_ObstacleXYToSL)
+    ->Args({20, 0})
+    ->Args({20, 1})
+    ->Args({80, 0})
+    ->Args({80, 1});
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -139,10 +139,13 @@ bool ReferenceLineProvider::CreateReferenceLineFromRouting(
 
   std::vector<ReferenceLine> reference_lines;
   for (const auto &segments : route_segments) {
-    hdmap::Path hdmap_path;
-    hdmap::PncMap::CreatePathFromLaneSegments(segments, &hdmap_path);
+    std::shared_ptr<const hdmap::Path> hdmap_path;
+    if (!pnc_map_->CreatePath(segments, &hdmap_path)) {
+      AERROR << "Failed to create path from lane segments";
+      continue;
+    }
     if (FLAGS_enable_smooth_reference_line) {
-      ReferenceLine raw_reference_line(hdmap_path);
+      ReferenceLine raw_reference_line(*hdmap_path);
       ReferenceLine reference_line;
       if (!smoother.Smooth(raw_reference_line, &reference_line,
                            spline_solver_.get())) {
@@ -172,7 +175,7 @@ bool ReferenceLineProvider::CreateReferenceLineFromRouting(
             segments.change_lane_type());
       }
     } else {
-      reference_lines.emplace_back(hdmap_path);
+      reference_lines.emplace_back(*hdmap_path);
       reference_lines.back().set_change_lane_type(segments.change_lane_type());
     }
   }
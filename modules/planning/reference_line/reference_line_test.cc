@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file reference_line_test.cc
+ **/
+
+#include "modules/planning/reference_line/reference_line.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/vec2d.h"
+#include "modules/common/util/util.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/planning/reference_line/reference_point.h"
+
+namespace apollo {
+namespace planning {
+
+using common::SLPoint;
+using common::math::Vec2d;
+
+class ReferenceLineTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    ASSERT_EQ(0, hdmap_.LoadMapFromFile(map_file));
+    const std::string lane_id = "1_-1";
+    auto lane = hdmap_.GetLaneById(hdmap::MakeMapId(lane_id));
+    ASSERT_TRUE(lane != nullptr);
+
+    std::vector<ReferencePoint> ref_points;
+    for (size_t i = 0; i < lane->points().size(); ++i) {
+      std::vector<hdmap::LaneWaypoint> waypoint;
+      waypoint.emplace_back(lane, lane->accumulate_s()[i]);
+      hdmap::MapPathPoint map_path_point(lane->points()[i],
+                                         lane->headings()[i], waypoint);
+      ref_points.emplace_back(map_path_point, 0.0, 0.0, -2.0, 2.0);
+    }
+    reference_line_.reset(new ReferenceLine(ref_points));
+
+    // Points along the reference line, and some before and after it.
+    std::mt19937 random_engine(2017);
+    std::uniform_real_distribution<double> l(-5.0, 5.0);
+    for (double s = -10.0; s < reference_line_->Length() + 10.0; s += 0.7) {
+      sl_points_.push_back(common::util::MakeSLPoint(s, l(random_engine)));
+    }
+  }
+
+  const std::string map_file =
+      "modules/planning/testdata/garage_map/base_map.txt";
+
+  hdmap::HDMap hdmap_;
+  std::unique_ptr<ReferenceLine> reference_line_;
+  std::vector<SLPoint> sl_points_;
+};
+
+TEST_F(ReferenceLineTest, GetReferencePoints) {
+  std::vector<double> s;
+  for (const auto& sl_point : sl_points_) {
+    s.push_back(sl_point.s());
+  }
+  // In order, and backward and forward.
+  for (int k = 0; k < 2; ++k) {
+    const auto ref_points = reference_line_->GetReferencePoints(s);
+    ASSERT_EQ(s.size(), ref_points.size());
+    for (size_t i = 0; i < s.size(); ++i) {
+      const auto expected = reference_line_->GetReferencePoint(s[i]);
+      EXPECT_EQ(expected.x(), ref_points[i].x());
+      EXPECT_EQ(expected.y(), ref_points[i].y());
+      EXPECT_EQ(expected.heading(), ref_points[i].heading());
+    }
+    std::shuffle(s.begin(), s.end(), std::mt19937(2017));
+  }
+}
+
+TEST_F(ReferenceLineTest, SLToXY) {
+  std::vector<Vec2d> xy_points;
+  ASSERT_TRUE(reference_line_->SLToXY(sl_points_, &xy_points));
+  ASSERT_EQ(sl_points_.size(), xy_points.size());
+  for (size_t i = 0; i < sl_points_.size(); ++i) {
+    Vec2d expected;
+    ASSERT_TRUE(reference_line_->SLToXY(sl_points_[i], &expected));
+    EXPECT_EQ(expected.x(), xy_points[i].x());
+    EXPECT_EQ(expected.y(), xy_points[i].y());
+  }
+}
+
+TEST_F(ReferenceLineTest, XYToSL) {
+  std::vector<Vec2d> xy_points;
+  ASSERT_TRUE(reference_line_->SLToXY(sl_points_, &xy_points));
+  // In order, and backward and forward.
+  for (int k = 0; k < 2; ++k) {
+    std::vector<SLPoint> sl_points;
+    ASSERT_TRUE(reference_line_->XYToSL(xy_points, &sl_points));
+    ASSERT_EQ(xy_points.size(), sl_points.size());
+    for (size_t i = 0; i < xy_points.size(); ++i) {
+      SLPoint expected;
+      ASSERT_TRUE(reference_line_->XYToSL(xy_points[i], &expected));
+      EXPECT_EQ(expected.s(), sl_points[i].s());
+      EXPECT_EQ(expected.l(), sl_points[i].l());
+    }
+    std::shuffle(xy_points.begin(), xy_points.end(), std::mt19937(2017));
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
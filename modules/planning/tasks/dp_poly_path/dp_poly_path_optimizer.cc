@@ -39,6 +39,15 @@ DpPolyPathOptimizer::DpPolyPathOptimizer()
 
 bool DpPolyPathOptimizer::Init(const PlanningConfig &config) {
   config_ = config.em_planner_config().dp_poly_path_config();
+  if (FLAGS_enable_parallel_dp_poly_path) {
+    thread_pool_.reset(
+        new common::util::ThreadPool(FLAGS_dp_poly_path_threads));
+  }
+  if (config_.enable_edge_cost_cache()) {
+    edge_cost_cache_.reset(
+        new EdgeCostCache(config_.edge_cost_cache_capacity(),
+                          config_.edge_cost_cache_resolution()));
+  }
   is_init_ = true;
   return true;
 }
@@ -52,7 +61,8 @@ Status DpPolyPathOptimizer::Process(const SpeedData &speed_data,
     return Status(ErrorCode::PLANNING_ERROR, "Not inited.");
   }
   CHECK_NOTNULL(path_data);
-  DPRoadGraph dp_road_graph(config_, reference_line, speed_data);
+  DPRoadGraph dp_road_graph(config_, reference_line, speed_data,
+                            thread_pool_.get(), edge_cost_cache_.get());
   if (!dp_road_graph.FindPathTunnel(
           init_point,
           reference_line_info_->path_decision()->path_obstacles().Items(),
@@ -60,6 +70,13 @@ Status DpPolyPathOptimizer::Process(const SpeedData &speed_data,
     AERROR << "Failed to find tunnel in road graph";
     return Status(ErrorCode::PLANNING_ERROR, "dp_road_graph path generation");
   }
+  if (edge_cost_cache_ && FLAGS_enable_record_debug) {
+    auto *dp_poly_path_debug = reference_line_info_->mutable_debug()
+                                   ->mutable_planning_data()
+                                   ->add_dp_poly_path();
+    dp_poly_path_debug->set_name(Name());
+    edge_cost_cache_->GetStats(dp_poly_path_debug);
+  }
 
   return Status::OK();
 }
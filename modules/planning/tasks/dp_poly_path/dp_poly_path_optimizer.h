@@ -21,11 +21,14 @@
 #ifndef MODULES_PLANNING_TASKS_DP_POLY_PATH_OPTIMIZER_H_
 #define MODULES_PLANNING_TASKS_DP_POLY_PATH_OPTIMIZER_H_
 
+#include <memory>
 #include <string>
 
 #include "modules/planning/proto/dp_poly_path_config.pb.h"
 
+#include "modules/common/util/thread_pool.h"
 #include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/tasks/dp_poly_path/edge_cost_cache.h"
 #include "modules/planning/tasks/path_optimizer.h"
 
 namespace apollo {
@@ -45,6 +48,8 @@ class DpPolyPathOptimizer : public PathOptimizer {
 
  private:
   DpPolyPathConfig config_;
+  std::unique_ptr<common::util::ThreadPool> thread_pool_;
+  std::unique_ptr<EdgeCostCache> edge_cost_cache_;
 };
 
 }  // namespace planning
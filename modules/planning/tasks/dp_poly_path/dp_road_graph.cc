@@ -45,10 +45,14 @@ using apollo::common::Status;
 
 DPRoadGraph::DPRoadGraph(const DpPolyPathConfig &config,
                          const ReferenceLine &reference_line,
-                         const SpeedData &speed_data)
+                         const SpeedData &speed_data,
+                         common::util::ThreadPool *thread_pool,
+                         EdgeCostCache *edge_cost_cache)
     : config_(config),
       reference_line_(reference_line),
-      speed_data_(speed_data) {}
+      speed_data_(speed_data),
+      thread_pool_(thread_pool),
+      edge_cost_cache_(edge_cost_cache) {}
 
 bool DPRoadGraph::FindPathTunnel(
     const common::TrajectoryPoint &init_point,
@@ -118,28 +122,45 @@ bool DPRoadGraph::GenerateMinCostPath(
       common::VehicleConfigHelper::instance()->GetConfig();
 
   TrajectoryCost trajectory_cost(config_, reference_line_, obstacles,
-                                 vehicle_config.vehicle_param(), speed_data_);
+                                 vehicle_config.vehicle_param(), speed_data_,
+                                 init_sl_point_);
+  if (edge_cost_cache_ != nullptr) {
+    edge_cost_cache_->Reset();
+  }
 
   std::vector<std::vector<DPRoadGraphNode>> graph_nodes(path_waypoints.size());
   graph_nodes[0].emplace_back(init_sl_point_, nullptr, 0.0);
 
   for (std::size_t level = 1; level < path_waypoints.size(); ++level) {
     const auto &prev_dp_nodes = graph_nodes[level - 1];
-    const auto &level_points = path_waypoints[level];
-    for (const auto &cur_point : level_points) {
-      graph_nodes[level].emplace_back(cur_point, nullptr);
-      auto &cur_node = graph_nodes[level].back();
-      for (const auto &prev_dp_node : prev_dp_nodes) {
-        const auto &prev_sl_point = prev_dp_node.sl_point;
-        QuinticPolynomialCurve1d curve(prev_sl_point.l(), 0.0, 0.0,
-                                       cur_point.l(), 0.0, 0.0,
-                                       cur_point.s() - prev_sl_point.s());
-        const double cost =
-            trajectory_cost.Calculate(curve, prev_sl_point.s(), cur_point.s()) +
-            prev_dp_node.min_cost;
-        cur_node.UpdateCost(&prev_dp_node, curve, cost);
-      }
+    auto &cur_dp_nodes = graph_nodes[level];
+    // All the nodes of a level are created before any of them is updated,
+    // so that each node is only written by the task reducing it.
+    cur_dp_nodes.reserve(path_waypoints[level].size());
+    for (const auto &cur_point : path_waypoints[level]) {
+      cur_dp_nodes.emplace_back(cur_point, nullptr);
     }
+    // The nodes of a level only depend on the previous level. Each node
+    // scans the previous level in order and only keeps a strictly cheaper
+    // candidate, so ties go to the lowest previous node whether or not the
+    // nodes are updated in parallel.
+    common::util::ParallelFor(
+        thread_pool_, 0, cur_dp_nodes.size(),
+        [this, &prev_dp_nodes, &cur_dp_nodes,
+         &trajectory_cost](const size_t i) {
+          auto &cur_node = cur_dp_nodes[i];
+          const auto &cur_point = cur_node.sl_point;
+          for (const auto &prev_dp_node : prev_dp_nodes) {
+            const auto &prev_sl_point = prev_dp_node.sl_point;
+            QuinticPolynomialCurve1d curve(prev_sl_point.l(), 0.0, 0.0,
+                                           cur_point.l(), 0.0, 0.0,
+                                           cur_point.s() - prev_sl_point.s());
+            const double cost = CalculateEdgeCost(trajectory_cost, curve,
+                                                  prev_sl_point, cur_point) +
+                                prev_dp_node.min_cost;
+            cur_node.UpdateCost(&prev_dp_node, curve, cost);
+          }
+        });
   }
 
   // find best path
@@ -158,6 +179,28 @@ bool DPRoadGraph::GenerateMinCostPath(
   return true;
 }
 
+double DPRoadGraph::CalculateEdgeCost(const TrajectoryCost &trajectory_cost,
+                                      const QuinticPolynomialCurve1d &curve,
+                                      const common::SLPoint &start,
+                                      const common::SLPoint &end) const {
+  if (edge_cost_cache_ == nullptr) {
+    return trajectory_cost.Calculate(curve, start.s(), end.s());
+  }
+  // The cache computes the path cost on snapped endpoints, which need their
+  // own curve.
+  const double path_cost = edge_cost_cache_->GetPathCost(
+      start, end, [&trajectory_cost](const common::SLPoint &snapped_start,
+                                     const common::SLPoint &snapped_end) {
+        return trajectory_cost.CalculatePathCost(
+            QuinticPolynomialCurve1d(snapped_start.l(), 0.0, 0.0,
+                                     snapped_end.l(), 0.0, 0.0,
+                                     snapped_end.s() - snapped_start.s()),
+            snapped_start.s(), snapped_end.s());
+      });
+  return path_cost +
+         trajectory_cost.CalculateObstacleCost(curve, start.s(), end.s());
+}
+
 bool DPRoadGraph::SamplePathWaypoints(
     const common::TrajectoryPoint &init_point,
     std::vector<std::vector<common::SLPoint>> *const points) {
@@ -29,6 +29,7 @@
 #include "modules/common/proto/pnc_point.pb.h"
 
 #include "modules/common/status/status.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/path_obstacle.h"
@@ -38,15 +39,26 @@
 #include "modules/planning/proto/dp_poly_path_config.pb.h"
 #include "modules/planning/reference_line/reference_line.h"
 #include "modules/planning/reference_line/reference_point.h"
+#include "modules/planning/tasks/dp_poly_path/edge_cost_cache.h"
+#include "modules/planning/tasks/dp_poly_path/trajectory_cost.h"
 
 namespace apollo {
 namespace planning {
 
 class DPRoadGraph {
  public:
+  /**
+   * @param thread_pool if not null, the nodes of each level of the graph are
+   * evaluated in parallel on this pool. The resulting path is identical to
+   * the one found without a pool.
+   * @param edge_cost_cache if not null, the edge path costs are looked up in
+   * and added to this cache.
+   */
   explicit DPRoadGraph(const DpPolyPathConfig &config,
                        const ReferenceLine &reference_line,
-                       const SpeedData &speed_data);
+                       const SpeedData &speed_data,
+                       common::util::ThreadPool *thread_pool = nullptr,
+                       EdgeCostCache *edge_cost_cache = nullptr);
 
   ~DPRoadGraph() = default;
 
@@ -88,6 +100,11 @@ class DPRoadGraph {
   bool GenerateMinCostPath(const std::vector<const PathObstacle *> &obstacles,
                            std::vector<DPRoadGraphNode> *min_cost_path);
 
+  double CalculateEdgeCost(const TrajectoryCost &trajectory_cost,
+                           const QuinticPolynomialCurve1d &curve,
+                           const common::SLPoint &start,
+                           const common::SLPoint &end) const;
+
   bool SamplePathWaypoints(
       const common::TrajectoryPoint &init_point,
       std::vector<std::vector<common::SLPoint>> *const points);
@@ -98,6 +115,8 @@ class DPRoadGraph {
   const ReferenceLine &reference_line_;
   SpeedData speed_data_;
   common::SLPoint init_sl_point_;
+  common::util::ThreadPool *thread_pool_ = nullptr;
+  EdgeCostCache *edge_cost_cache_ = nullptr;
 };
 
 }  // namespace planning
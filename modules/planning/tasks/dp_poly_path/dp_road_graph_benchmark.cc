@@ -0,0 +1,249 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the DP path against the number of obstacles on the garage
+ * map.
+ **/
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/log.h"
+#include "modules/common/util/thread_pool.h"
+#include "modules/common/util/util.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/path_obstacle.h"
+#include "modules/planning/tasks/dp_poly_path/dp_road_graph.h"
+#include "modules/planning/tasks/dp_poly_path/edge_cost_cache.h"
+#include "modules/planning/tasks/dp_poly_path/trajectory_cost.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+const char kMapFile[] = "modules/planning/testdata/garage_map/base_map.txt";
+const char kLaneId[] = "1_-1";
+
+/**
+ * @class DpPathScene
+ * @brief a reference line along one lane of the garage map, a constant
+ * speed profile, and randomly placed static obstacles around the lane.
+ */
+class DpPathScene {
+ public:
+  static DpPathScene* instance() {
+    static DpPathScene scene;
+    return &scene;
+  }
+
+  const ReferenceLine& reference_line() const { return *reference_line_; }
+  const SpeedData& speed_data() const { return speed_data_; }
+  const common::TrajectoryPoint& init_point() const { return init_point_; }
+
+  common::TrajectoryPoint InitPoint(const double s, const double l) const {
+    Vec2d init_xy;
+    reference_line_->SLToXY(common::util::MakeSLPoint(s, l), &init_xy);
+    common::TrajectoryPoint init_point;
+    init_point.mutable_path_point()->set_x(init_xy.x());
+    init_point.mutable_path_point()->set_y(init_xy.y());
+    init_point.set_v(init_point_.v());
+    return init_point;
+  }
+
+  std::vector<const PathObstacle*> PathObstacles(const size_t num) {
+    while (obstacles_.size() < num) {
+      AddObstacle();
+    }
+    std::vector<const PathObstacle*> path_obstacles;
+    for (size_t i = 0; i < num; ++i) {
+      path_obstacles.push_back(path_obstacles_[i].get());
+    }
+    return path_obstacles;
+  }
+
+ private:
+  DpPathScene() {
+    common::VehicleConfigHelper::Init();
+    CHECK_EQ(0, hdmap_.LoadMapFromFile(kMapFile));
+    auto lane = hdmap_.GetLaneById(hdmap::MakeMapId(kLaneId));
+    CHECK(lane) << "Failed to find lane " << kLaneId;
+    std::vector<ReferencePoint> ref_points;
+    for (size_t i = 0; i < lane->points().size(); ++i) {
+      std::vector<hdmap::LaneWaypoint> waypoint;
+      waypoint.emplace_back(lane, lane->accumulate_s()[i]);
+      hdmap::MapPathPoint map_path_point(lane->points()[i],
+                                         lane->headings()[i], waypoint);
+      ref_points.emplace_back(map_path_point, 0.0, 0.0, -2.0, 2.0);
+    }
+    reference_line_.reset(new ReferenceLine(ref_points));
+
+    const double kSpeed = 10.0;
+    for (double t = 0.0; t <= 8.0; t += 0.1) {
+      speed_data_.AppendSpeedPoint(kSpeed * t, t, kSpeed, 0.0, 0.0);
+    }
+
+    init_point_.set_v(kSpeed);
+    init_point_ = InitPoint(1.0, 0.0);
+  }
+
+  void AddObstacle() {
+    std::uniform_real_distribution<double> s_dist(
+        0.0, reference_line_->map_path().length());
+    std::uniform_real_distribution<double> l_dist(-6.0, 6.0);
+    common::SLPoint sl = common::util::MakeSLPoint(s_dist(random_engine_),
+                                                   l_dist(random_engine_));
+    Vec2d center;
+    reference_line_->SLToXY(sl, &center);
+    const double heading =
+        reference_line_->GetReferencePoint(sl.s()).heading();
+
+    perception::PerceptionObstacle perception_obstacle;
+    perception_obstacle.set_id(static_cast<int>(obstacles_.size()));
+    perception_obstacle.mutable_position()->set_x(center.x());
+    perception_obstacle.mutable_position()->set_y(center.y());
+    perception_obstacle.set_theta(heading);
+    perception_obstacle.set_length(4.0);
+    perception_obstacle.set_width(2.0);
+    perception_obstacle.set_type(
+        perception::PerceptionObstacle::UNKNOWN_UNMOVABLE);
+    std::vector<Vec2d> corners;
+    Box2d(center, heading, 4.0, 2.0).GetAllCorners(&corners);
+    for (const auto& corner : corners) {
+      auto* point = perception_obstacle.add_polygon_point();
+      point->set_x(corner.x());
+      point->set_y(corner.y());
+    }
+    const std::string id = std::to_string(perception_obstacle.id());
+    obstacles_.emplace_back(new Obstacle(id, perception_obstacle));
+    path_obstacles_.emplace_back(new PathObstacle(obstacles_.back().get()));
+  }
+
+  hdmap::HDMap hdmap_;
+  std::unique_ptr<ReferenceLine> reference_line_;
+  SpeedData speed_data_;
+  common::TrajectoryPoint init_point_;
+  std::mt19937 random_engine_{2017};
+  std::vector<std::unique_ptr<Obstacle>> obstacles_;
+  std::vector<std::unique_ptr<PathObstacle>> path_obstacles_;
+};
+
+}  // namespace
+
+// Arg: number of obstacles.
+void BM_DpRoadGraph(benchmark::State& state) {
+  auto* scene = DpPathScene::instance();
+  const auto obstacles = scene->PathObstacles(state.range(0));
+  DpPolyPathConfig config;
+  while (state.KeepRunning()) {
+    DPRoadGraph dp_road_graph(config, scene->reference_line(),
+                              scene->speed_data());
+    PathData path_data;
+    CHECK(dp_road_graph.FindPathTunnel(scene->init_point(), obstacles,
+                                       &path_data));
+    benchmark::DoNotOptimize(path_data);
+  }
+}
+BENCHMARK(BM_DpRoadGraph)->Arg(10)->Arg(50)->Arg(200);
+
+// Args: {number of obstacles, number of worker threads}.
+void BM_DpRoadGraphParallel(benchmark::State& state) {
+  auto* scene = DpPathScene::instance();
+  const auto obstacles = scene->PathObstacles(state.range(0));
+  DpPolyPathConfig config;
+  common::util::ThreadPool thread_pool(state.range(1));
+  while (state.KeepRunning()) {
+    DPRoadGraph dp_road_graph(config, scene->reference_line(),
+                              scene->speed_data(), &thread_pool);
+    PathData path_data;
+    CHECK(dp_road_graph.FindPathTunnel(scene->init_point(), obstacles,
+                                       &path_data));
+    benchmark::DoNotOptimize(path_data);
+  }
+}
+BENCHMARK(BM_DpRoadGraphParallel)
+    ->Args({50, 1})
+    ->Args({50, 3})
+    ->Args({200, 1})
+    ->Args({200, 3})
+    ->UseRealTime();
+
+// Every iteration is a new cycle of the car driving along the lane at 10 m/s
+// and 10 Hz, slightly weaving around its center, with the path costs looked up
+// in the cache. The label has the path cost cache hit rate over all the
+// cycles.
+// Args: {number of obstacles, 1 to use the cache}.
+void BM_DpRoadGraphEdgeCostCache(benchmark::State& state) {
+  auto* scene = DpPathScene::instance();
+  const auto obstacles = scene->PathObstacles(state.range(0));
+  DpPolyPathConfig config;
+  std::unique_ptr<EdgeCostCache> edge_cost_cache;
+  if (state.range(1) != 0) {
+    edge_cost_cache.reset(
+        new EdgeCostCache(config.edge_cost_cache_capacity(),
+                          config.edge_cost_cache_resolution()));
+  }
+  const double kCycleDistance = 1.0;
+  const double max_init_s = scene->reference_line().map_path().length() / 2.0;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  int cycle = 0;
+  while (state.KeepRunning()) {
+    const double init_s = std::fmod(1.0 + kCycleDistance * cycle, max_init_s);
+    const double init_l = 0.3 * std::sin(0.2 * cycle);
+    ++cycle;
+    DPRoadGraph dp_road_graph(config, scene->reference_line(),
+                              scene->speed_data(), nullptr,
+                              edge_cost_cache.get());
+    PathData path_data;
+    CHECK(dp_road_graph.FindPathTunnel(scene->InitPoint(init_s, init_l),
+                                       obstacles, &path_data));
+    benchmark::DoNotOptimize(path_data);
+    if (edge_cost_cache != nullptr) {
+      planning_internal::DpPolyPathDebug stats;
+      edge_cost_cache->GetStats(&stats);
+      hits += stats.path_cost_cache_hits();
+      misses += stats.path_cost_cache_misses();
+    }
+  }
+  if (hits + misses > 0) {
+    state.SetLabel("path cost cache hit rate " +
+                   std::to_string(100.0 * hits / (hits + misses)) + "%");
+  }
+}
+BENCHMARK(BM_DpRoadGraphEdgeCostCache)
+    ->Args({10, 0})
+    ->Args({10, 1})
+    ->Args({200, 0})
+    ->Args({200, 1});
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/tasks/dp_poly_path/dp_road_graph.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/log.h"
+#include "modules/common/util/thread_pool.h"
+#include "modules/common/util/util.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/planning/common/obstacle.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+using apollo::common::util::ThreadPool;
+
+class DPRoadGraphTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    common::VehicleConfigHelper::Init();
+    ASSERT_EQ(0, hdmap_.LoadMapFromFile(map_file));
+    const std::string lane_id = "1_-1";
+    auto lane = hdmap_.GetLaneById(hdmap::MakeMapId(lane_id));
+    ASSERT_TRUE(lane != nullptr);
+    std::vector<ReferencePoint> ref_points;
+    for (std::size_t i = 0; i < lane->points().size(); ++i) {
+      std::vector<hdmap::LaneWaypoint> waypoint;
+      waypoint.emplace_back(lane, lane->accumulate_s()[i]);
+      hdmap::MapPathPoint map_path_point(lane->points()[i],
+                                         lane->headings()[i], waypoint);
+      ref_points.emplace_back(map_path_point, 0.0, 0.0, -2.0, 2.0);
+    }
+    reference_line_.reset(new ReferenceLine(ref_points));
+
+    const double speed = 10.0;
+    for (double t = 0.0; t <= 8.0; t += 0.1) {
+      speed_data_.AppendSpeedPoint(speed * t, t, speed, 0.0, 0.0);
+    }
+    Vec2d init_xy;
+    reference_line_->SLToXY(common::util::MakeSLPoint(1.0, 0.3), &init_xy);
+    init_point_.mutable_path_point()->set_x(init_xy.x());
+    init_point_.mutable_path_point()->set_y(init_xy.y());
+    init_point_.set_v(speed);
+
+    AddObstacle(20.0, 0.5);
+    AddObstacle(35.0, -1.0);
+    AddObstacle(50.0, 1.5);
+  }
+
+ protected:
+  void AddObstacle(const double s, const double l) {
+    Vec2d center;
+    reference_line_->SLToXY(common::util::MakeSLPoint(s, l), &center);
+    const double heading = reference_line_->GetReferencePoint(s).heading();
+    perception::PerceptionObstacle perception_obstacle;
+    perception_obstacle.set_id(static_cast<int>(obstacles_.size()));
+    perception_obstacle.mutable_position()->set_x(center.x());
+    perception_obstacle.mutable_position()->set_y(center.y());
+    perception_obstacle.set_theta(heading);
+    perception_obstacle.set_length(4.0);
+    perception_obstacle.set_width(2.0);
+    perception_obstacle.set_type(
+        perception::PerceptionObstacle::UNKNOWN_UNMOVABLE);
+    std::vector<Vec2d> corners;
+    Box2d(center, heading, 4.0, 2.0).GetAllCorners(&corners);
+    for (const auto& corner : corners) {
+      auto* point = perception_obstacle.add_polygon_point();
+      point->set_x(corner.x());
+      point->set_y(corner.y());
+    }
+    obstacles_.emplace_back(
+        new Obstacle(std::to_string(perception_obstacle.id()),
+                     perception_obstacle));
+    path_obstacles_.emplace_back(new PathObstacle(obstacles_.back().get()));
+  }
+
+  std::vector<const PathObstacle*> PathObstacles() const {
+    std::vector<const PathObstacle*> path_obstacles;
+    for (const auto& path_obstacle : path_obstacles_) {
+      path_obstacles.push_back(path_obstacle.get());
+    }
+    return path_obstacles;
+  }
+
+  bool FindPath(ThreadPool* thread_pool, PathData* path_data,
+                EdgeCostCache* edge_cost_cache = nullptr) {
+    DPRoadGraph dp_road_graph(config_, *reference_line_, speed_data_,
+                              thread_pool, edge_cost_cache);
+    return dp_road_graph.FindPathTunnel(init_point_, PathObstacles(),
+                                        path_data);
+  }
+
+  const std::string map_file =
+      "modules/planning/testdata/garage_map/base_map.txt";
+  hdmap::HDMap hdmap_;
+  DpPolyPathConfig config_;
+  std::unique_ptr<ReferenceLine> reference_line_;
+  SpeedData speed_data_;
+  common::TrajectoryPoint init_point_;
+  std::vector<std::unique_ptr<Obstacle>> obstacles_;
+  std::vector<std::unique_ptr<PathObstacle>> path_obstacles_;
+};
+
+TEST_F(DPRoadGraphTest, ParallelPathIsIdentical) {
+  PathData serial_path;
+  ASSERT_TRUE(FindPath(nullptr, &serial_path));
+  const auto& expected = serial_path.frenet_frame_path().points();
+  ASSERT_FALSE(expected.empty());
+
+  for (const size_t num_threads : {0, 1, 3, 16}) {
+    ThreadPool thread_pool(num_threads);
+    PathData parallel_path;
+    ASSERT_TRUE(FindPath(&thread_pool, &parallel_path));
+    const auto& points = parallel_path.frenet_frame_path().points();
+    ASSERT_EQ(expected.size(), points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      // Bitwise equality, not approximate.
+      EXPECT_EQ(expected[i].s(), points[i].s()) << "point " << i;
+      EXPECT_EQ(expected[i].l(), points[i].l()) << "point " << i;
+      EXPECT_EQ(expected[i].dl(), points[i].dl()) << "point " << i;
+      EXPECT_EQ(expected[i].ddl(), points[i].ddl()) << "point " << i;
+    }
+  }
+}
+
+TEST_F(DPRoadGraphTest, PassesObstaclesOnTheOtherSide) {
+  PathData path_data;
+  ASSERT_TRUE(FindPath(nullptr, &path_data));
+  const auto& points = path_data.frenet_frame_path().points();
+  ASSERT_FALSE(points.empty());
+  auto l_at = [&points](const double s) {
+    auto it = std::lower_bound(
+        points.begin(), points.end(), s,
+        [](const common::FrenetFramePoint& point, const double s) {
+          return point.s() < s;
+        });
+    return it == points.end() ? points.back().l() : it->l();
+  };
+  // The obstacles at s = 35 and s = 50 are passed on their other side.
+  EXPECT_GT(l_at(35.0), 0.5);
+  EXPECT_LT(l_at(50.0), -0.5);
+}
+
+TEST_F(DPRoadGraphTest, EdgeCostCache) {
+  EdgeCostCache edge_cost_cache(config_.edge_cost_cache_capacity(),
+                                config_.edge_cost_cache_resolution());
+  PathData first_path;
+  ASSERT_TRUE(FindPath(nullptr, &first_path, &edge_cost_cache));
+  planning_internal::DpPolyPathDebug first_stats;
+  edge_cost_cache.GetStats(&first_stats);
+  EXPECT_GT(first_stats.path_cost_cache_misses(), 0);
+
+  // The next cycle reuses all the costs, in parallel as well.
+  ThreadPool thread_pool(3);
+  PathData second_path;
+  ASSERT_TRUE(FindPath(&thread_pool, &second_path, &edge_cost_cache));
+  planning_internal::DpPolyPathDebug second_stats;
+  edge_cost_cache.GetStats(&second_stats);
+  EXPECT_EQ(0, second_stats.path_cost_cache_misses());
+  EXPECT_EQ(first_stats.path_cost_cache_hits() +
+                first_stats.path_cost_cache_misses(),
+            second_stats.path_cost_cache_hits());
+
+  const auto& expected = first_path.frenet_frame_path().points();
+  const auto& points = second_path.frenet_frame_path().points();
+  ASSERT_EQ(expected.size(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(expected[i].l(), points[i].l()) << "point " << i;
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file edge_cost_cache.cc
+ **/
+
+#include "modules/planning/tasks/dp_poly_path/edge_cost_cache.h"
+
+#include <cmath>
+
+#include "modules/common/log.h"
+#include "modules/common/util/util.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::util::HashCombine;
+
+size_t EdgeCostCache::EdgeKeyHash::operator()(const EdgeKey &key) const {
+  size_t seed = 0;
+  HashCombine(key.start_l, &seed);
+  HashCombine(key.length, &seed);
+  HashCombine(key.end_l, &seed);
+  return seed;
+}
+
+EdgeCostCache::EdgeCostCache(const size_t capacity, const double resolution)
+    : resolution_(resolution), path_costs_(capacity) {
+  CHECK_GT(resolution_, 0.0);
+}
+
+void EdgeCostCache::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  path_cost_hits_ = 0;
+  path_cost_misses_ = 0;
+}
+
+int64_t EdgeCostCache::Snap(const double value) const {
+  return std::llround(value / resolution_);
+}
+
+double EdgeCostCache::GetPathCost(const common::SLPoint &start,
+                                  const common::SLPoint &end,
+                                  const CostFunction &path_cost) {
+  // The path cost is invariant to a shift in s.
+  EdgeKey key;
+  key.start_l = Snap(start.l());
+  key.length = Snap(end.s() - start.s());
+  key.end_l = Snap(end.l());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double *cost = path_costs_.Get(key);
+    if (cost != nullptr) {
+      ++path_cost_hits_;
+      return *cost;
+    }
+    ++path_cost_misses_;
+  }
+  const double cost =
+      path_cost(common::util::MakeSLPoint(0.0, key.start_l * resolution_),
+                common::util::MakeSLPoint(key.length * resolution_,
+                                          key.end_l * resolution_));
+  std::lock_guard<std::mutex> lock(mutex_);
+  path_costs_.Put(key, cost);
+  return cost;
+}
+
+void EdgeCostCache::GetStats(planning_internal::DpPolyPathDebug *debug) const {
+  CHECK_NOTNULL(debug);
+  std::lock_guard<std::mutex> lock(mutex_);
+  debug->set_path_cost_cache_hits(path_cost_hits_);
+  debug->set_path_cost_cache_misses(path_cost_misses_);
+}
+
+}  // namespace planning
+}  // namespace apollo
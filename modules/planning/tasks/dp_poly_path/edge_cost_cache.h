@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file edge_cost_cache.h
+ **/
+
+#ifndef MODULES_PLANNING_TASKS_DP_POLY_PATH_EDGE_COST_CACHE_H_
+#define MODULES_PLANNING_TASKS_DP_POLY_PATH_EDGE_COST_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "modules/common/proto/pnc_point.pb.h"
+#include "modules/planning/proto/planning_internal.pb.h"
+
+#include "modules/common/util/lru_cache.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class EdgeCostCache
+ * @brief caches the path cost of the edges of the DP path graph across
+ * planning cycles.
+ *
+ * \par
+ * The edge endpoints are snapped to a grid of `resolution` meters, and the
+ * cost is always computed on the snapped endpoints, so the cost of an edge
+ * does not depend on whether it was found in the cache.
+ *
+ * \par
+ * The path cost of an edge only depends on the lateral offsets of its
+ * endpoints and on its length, so it is kept across reference lines and
+ * obstacle changes. The obstacle cost is not cached: it depends on the
+ * obstacles and the speed profile, which change nearly every cycle.
+ *
+ * \par
+ * All the methods are thread-safe. The path cost function is called without
+ * holding the lock.
+ */
+class EdgeCostCache {
+ public:
+  using CostFunction = std::function<double(const common::SLPoint &start,
+                                            const common::SLPoint &end)>;
+
+  EdgeCostCache(const size_t capacity, const double resolution);
+
+  /**
+   * @brief resets the counters for the graph of a new planning cycle.
+   */
+  void Reset();
+
+  /**
+   * @brief returns the path cost of the edge from start to end, calling
+   * path_cost with the snapped endpoints if it is not cached.
+   */
+  double GetPathCost(const common::SLPoint &start, const common::SLPoint &end,
+                     const CostFunction &path_cost);
+
+  /**
+   * @brief fills the hit and miss counters since the last Reset().
+   */
+  void GetStats(planning_internal::DpPolyPathDebug *debug) const;
+
+ private:
+  struct EdgeKey {
+    int64_t start_l = 0;
+    int64_t length = 0;
+    int64_t end_l = 0;
+
+    bool operator==(const EdgeKey &other) const {
+      return start_l == other.start_l && length == other.length &&
+             end_l == other.end_l;
+    }
+  };
+
+  struct EdgeKeyHash {
+    size_t operator()(const EdgeKey &key) const;
+  };
+
+  using Cache = common::util::LRUCache<EdgeKey, double, EdgeKeyHash>;
+
+  int64_t Snap(const double value) const;
+
+  const double resolution_;
+
+  mutable std::mutex mutex_;
+  Cache path_costs_;
+  uint32_t path_cost_hits_ = 0;
+  uint32_t path_cost_misses_ = 0;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_TASKS_DP_POLY_PATH_EDGE_COST_CACHE_H_
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/tasks/dp_poly_path/edge_cost_cache.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/util.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::SLPoint;
+using apollo::common::util::MakeSLPoint;
+
+class EdgeCostCacheTest : public ::testing::Test {
+ public:
+  EdgeCostCacheTest() : cache_(100, 0.01) {}
+
+ protected:
+  // A cost which records its calls and the endpoints it gets.
+  EdgeCostCache::CostFunction CountingCost() {
+    return [this](const SLPoint& start, const SLPoint& end) {
+      ++num_calls_;
+      last_start_ = start;
+      last_end_ = end;
+      return end.s() - start.s() + end.l() - start.l();
+    };
+  }
+
+  EdgeCostCache cache_;
+  int num_calls_ = 0;
+  SLPoint last_start_;
+  SLPoint last_end_;
+};
+
+TEST_F(EdgeCostCacheTest, PathCost) {
+  cache_.Reset();
+  const double cost = cache_.GetPathCost(
+      MakeSLPoint(3.0, 0.5), MakeSLPoint(13.0, -0.5), CountingCost());
+  EXPECT_EQ(1, num_calls_);
+  EXPECT_DOUBLE_EQ(9.0, cost);
+
+  // The same edge shifted in s, and snapped to the same grid point.
+  EXPECT_EQ(cost, cache_.GetPathCost(MakeSLPoint(20.0, 0.5),
+                                     MakeSLPoint(30.0, -0.5), CountingCost()));
+  EXPECT_EQ(cost,
+            cache_.GetPathCost(MakeSLPoint(20.0, 0.5001),
+                               MakeSLPoint(30.002, -0.5), CountingCost()));
+  EXPECT_EQ(1, num_calls_);
+
+  // Kept across planning cycles.
+  cache_.Reset();
+  EXPECT_EQ(cost, cache_.GetPathCost(MakeSLPoint(3.0, 0.5),
+                                     MakeSLPoint(13.0, -0.5), CountingCost()));
+  EXPECT_EQ(1, num_calls_);
+
+  // A different edge is computed on snapped endpoints.
+  cache_.GetPathCost(MakeSLPoint(3.0, 0.5), MakeSLPoint(13.1234, 0.0),
+                     CountingCost());
+  EXPECT_EQ(2, num_calls_);
+  EXPECT_DOUBLE_EQ(10.12, last_end_.s() - last_start_.s());
+
+  planning_internal::DpPolyPathDebug debug;
+  cache_.GetStats(&debug);
+  EXPECT_EQ(1, debug.path_cost_cache_hits());
+  EXPECT_EQ(1, debug.path_cost_cache_misses());
+}
+
+TEST_F(EdgeCostCacheTest, Reset) {
+  cache_.Reset();
+  const auto start = MakeSLPoint(3.0, 0.5);
+  const auto end = MakeSLPoint(13.0, -0.5);
+  cache_.GetPathCost(start, end, CountingCost());
+  cache_.GetPathCost(start, end, CountingCost());
+
+  // The counters are reset, the costs are kept.
+  cache_.Reset();
+  cache_.GetPathCost(start, end, CountingCost());
+  EXPECT_EQ(1, num_calls_);
+  planning_internal::DpPolyPathDebug debug;
+  cache_.GetStats(&debug);
+  EXPECT_EQ(1, debug.path_cost_cache_hits());
+  EXPECT_EQ(0, debug.path_cost_cache_misses());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cmath>
 
+#include "modules/common/log.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -38,11 +39,13 @@ TrajectoryCost::TrajectoryCost(
     const DpPolyPathConfig &config, const ReferenceLine &reference_line,
     const std::vector<const PathObstacle *> &obstacles,
     const common::VehicleParam &vehicle_param,
-    const SpeedData &heuristic_speed_data)
+    const SpeedData &heuristic_speed_data,
+    const common::SLPoint &init_sl_point)
     : config_(config),
       reference_line_(&reference_line),
       vehicle_param_(vehicle_param),
-      heuristic_speed_data_(heuristic_speed_data) {
+      heuristic_speed_data_(heuristic_speed_data),
+      init_sl_point_(init_sl_point) {
   const double total_time =
       std::min(heuristic_speed_data_.TotalTime(), FLAGS_prediction_total_time);
 
@@ -67,13 +70,34 @@ TrajectoryCost::TrajectoryCost(
     }
     obstacle_boxes_.push_back(box_by_time);
   }
+
+  common::math::AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 4;
+  obstacle_boxes_by_time_.resize(num_of_time_stamps_ + 1);
+  obstacle_kdtrees_.reserve(num_of_time_stamps_ + 1);
+  for (uint32_t t = 0; t <= num_of_time_stamps_; ++t) {
+    auto &boxes = obstacle_boxes_by_time_[t];
+    boxes.reserve(obstacle_boxes_.size());
+    for (size_t i = 0; i < obstacle_boxes_.size(); ++i) {
+      boxes.emplace_back(obstacle_boxes_[i][t], i);
+    }
+    // The kd-tree keeps pointers into boxes, which is not modified anymore.
+    obstacle_kdtrees_.emplace_back(boxes, params);
+  }
 }
 
 double TrajectoryCost::Calculate(const QuinticPolynomialCurve1d &curve,
                                  const double start_s,
                                  const double end_s) const {
+  return CalculatePathCost(curve, start_s, end_s) +
+         CalculateObstacleCost(curve, start_s, end_s);
+}
+
+double TrajectoryCost::CalculatePathCost(const QuinticPolynomialCurve1d &curve,
+                                         const double start_s,
+                                         const double end_s) const {
   double total_cost = 0.0;
-  // Path_cost
   double path_s = 0.0;
   while (path_s < (end_s - start_s)) {
     const double l = std::fabs(curve.Evaluate(0, path_s));
@@ -84,41 +108,42 @@ double TrajectoryCost::Calculate(const QuinticPolynomialCurve1d &curve,
 
     path_s += config_.path_resolution();
   }
+  return total_cost;
+}
 
-  // Obstacle cost
-  uint32_t start_index = 0;
-  bool is_found_start_index = false;
-  uint32_t end_index = 0;
-  uint32_t index = 0;
-  double time_stamp = 0.0;
-  while (end_index != 0) {
+double TrajectoryCost::CalculateObstacleCost(
+    const QuinticPolynomialCurve1d &curve, const double start_s,
+    const double end_s) const {
+  // The evaluation times at which the heuristic speed profile, which starts
+  // at the init point, is within [start_s, end_s] on the reference line.
+  auto s_at_index = [this](const uint32_t index) {
     common::SpeedPoint speed_point;
-    heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
-    if (speed_point.s() >= start_s && !is_found_start_index) {
-      start_index = index;
-      is_found_start_index = true;
-    }
-    if (speed_point.s() > end_s) {
-      end_index = index;
-    }
-    time_stamp += config_.eval_time_interval();
-    ++index;
+    heuristic_speed_data_.EvaluateByTime(index * config_.eval_time_interval(),
+                                         &speed_point);
+    return init_sl_point_.s() + speed_point.s();
+  };
+  uint32_t start_index = 0;
+  while (start_index <= num_of_time_stamps_ &&
+         s_at_index(start_index) < start_s) {
+    ++start_index;
+  }
+  uint32_t end_index = start_index;
+  while (end_index <= num_of_time_stamps_ && s_at_index(end_index) <= end_s) {
+    ++end_index;
   }
 
+  double total_cost = 0.0;
   for (; start_index < end_index; ++start_index) {
-    common::SpeedPoint speed_point;
-    heuristic_speed_data_.EvaluateByTime(
-        start_index * config_.eval_time_interval(), &speed_point);
-    const double s = speed_point.s() - start_s;
+    const double ref_s = s_at_index(start_index);
+    const double s = ref_s - start_s;
     const double l = curve.Evaluate(0, s);
     const double dl = curve.Evaluate(1, s);
     Vec2d ego_xy_point;
     common::SLPoint sl;
-    sl.set_s(speed_point.s());
+    sl.set_s(ref_s);
     sl.set_l(l);
     reference_line_->SLToXY(sl, &ego_xy_point);
-    ReferencePoint reference_point =
-        reference_line_->GetReferencePoint(speed_point.s());
+    ReferencePoint reference_point = reference_line_->GetReferencePoint(ref_s);
 
     double one_minus_kappa_r_d = 1 - reference_point.kappa() * l;
     double delta_theta = std::atan2(dl, one_minus_kappa_r_d);
@@ -126,24 +151,48 @@ double TrajectoryCost::Calculate(const QuinticPolynomialCurve1d &curve,
         common::math::NormalizeAngle(delta_theta + reference_point.heading());
     Box2d ego_box = {ego_xy_point, theta, vehicle_param_.length(),
                      vehicle_param_.width()};
-    for (const auto &obstacle_trajectory : obstacle_boxes_) {
-      auto &obstacle_box = obstacle_trajectory[start_index];
-      // Simple version: calculate obstacle cost by distance
-      double distance = obstacle_box.DistanceTo(ego_box);
-      if (distance > config_.obstacle_ignore_distance()) {
-        continue;
-      } else if (distance <= config_.obstacle_collision_distance()) {
-        total_cost += config_.obstacle_collision_cost();
-      } else if (distance <= config_.obstacle_risk_distance()) {
-        total_cost += RiskDistanceCost(distance);
-      } else {
-        total_cost += RegularDistanceCost(distance);
-      }
-    }
+    total_cost += CalculateObstacleCost(ego_box, start_index);
   }
   return total_cost;
 }
 
+double TrajectoryCost::CalculateObstacleCost(const Box2d &ego_box,
+                                             const uint32_t time_index) const {
+  DCHECK_LT(time_index, obstacle_kdtrees_.size());
+  // Any point of the ego box is within half of its diagonal of its center,
+  // so an obstacle farther than that plus the ignore distance from the center
+  // can not be within the ignore distance of the box.
+  const double search_radius =
+      config_.obstacle_ignore_distance() + ego_box.diagonal() / 2.0;
+  const auto candidates =
+      obstacle_kdtrees_[time_index].GetObjects(ego_box.center(), search_radius);
+
+  // In obstacle order, to add the costs as a scan of all the obstacles does.
+  std::vector<size_t> indices;
+  indices.reserve(candidates.size());
+  for (const auto *candidate : candidates) {
+    indices.push_back(candidate->index());
+  }
+  std::sort(indices.begin(), indices.end());
+
+  double cost = 0.0;
+  for (const size_t index : indices) {
+    const auto &obstacle_box = obstacle_boxes_[index][time_index];
+    // Simple version: calculate obstacle cost by distance
+    double distance = obstacle_box.DistanceTo(ego_box);
+    if (distance > config_.obstacle_ignore_distance()) {
+      continue;
+    } else if (distance <= config_.obstacle_collision_distance()) {
+      cost += config_.obstacle_collision_cost();
+    } else if (distance <= config_.obstacle_risk_distance()) {
+      cost += RiskDistanceCost(distance);
+    } else {
+      cost += RegularDistanceCost(distance);
+    }
+  }
+  return cost;
+}
+
 double TrajectoryCost::RiskDistanceCost(const double distance) const {
   return (5.0 - distance) * ((5.0 - distance)) * 10;
 }
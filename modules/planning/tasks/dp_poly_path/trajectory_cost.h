@@ -24,9 +24,12 @@
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
+#include "modules/common/proto/pnc_point.pb.h"
 #include "modules/planning/proto/dp_poly_path_config.pb.h"
 
+#include "modules/common/math/aaboxkdtree2d.h"
 #include "modules/common/math/box2d.h"
+#include "modules/common/math/flat_aaboxkdtree2d.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
@@ -42,20 +45,74 @@ class TrajectoryCost {
                           const ReferenceLine &reference_line,
                           const std::vector<const PathObstacle *> &obstacles,
                           const common::VehicleParam &vehicle_param,
-                          const SpeedData &heuristic_speed_data);
+                          const SpeedData &heuristic_speed_data,
+                          const common::SLPoint &init_sl_point);
+  /**
+   * @brief the cost of following curve from start_s to end_s, the sum of
+   * its path cost and its obstacle cost.
+   */
   double Calculate(const QuinticPolynomialCurve1d &curve, const double start_s,
                    const double end_s) const;
+
+  /**
+   * @brief the lateral offset and lateral speed part of the cost. It only
+   * depends on the curve and on end_s - start_s.
+   */
+  double CalculatePathCost(const QuinticPolynomialCurve1d &curve,
+                           const double start_s, const double end_s) const;
+
+  /**
+   * @brief the obstacle part of the cost.
+   */
+  double CalculateObstacleCost(const QuinticPolynomialCurve1d &curve,
+                               const double start_s, const double end_s) const;
+
+  /**
+   * @brief the cost of the ego box against the obstacles at the time_index-th
+   * evaluation time. The obstacles which can not be within
+   * obstacle_ignore_distance of the box are dropped by a kd-tree query before
+   * the box to box distances are computed.
+   */
+  double CalculateObstacleCost(const common::math::Box2d &ego_box,
+                               const uint32_t time_index) const;
+
   double RiskDistanceCost(const double distance) const;
   double RegularDistanceCost(const double distance) const;
 
  private:
+  /**
+   * The box of an obstacle at one evaluation time, as indexed by the kd-tree.
+   */
+  class ObstacleBox {
+   public:
+    ObstacleBox(const common::math::Box2d &box, const size_t index)
+        : box_(box), aabox_(box.GetAABox()), index_(index) {}
+    const common::math::AABox2d &aabox() const { return aabox_; }
+    double DistanceSquareTo(const common::math::Vec2d &point) const {
+      const double distance = box_.DistanceTo(point);
+      return distance * distance;
+    }
+    size_t index() const { return index_; }
+
+   private:
+    common::math::Box2d box_;
+    common::math::AABox2d aabox_;
+    size_t index_ = 0;
+  };
+  using ObstacleBoxKDTree = common::math::FlatAABoxKDTree2d<ObstacleBox>;
+
   const DpPolyPathConfig config_;
   const ReferenceLine *reference_line_ = nullptr;
   const common::VehicleParam vehicle_param_;
   SpeedData heuristic_speed_data_;
+  const common::SLPoint init_sl_point_;
   uint32_t num_of_time_stamps_ = 0;
   std::vector<std::vector<common::math::Box2d>> obstacle_boxes_;
   std::vector<double> obstacle_probabilities_;
+
+  // The obstacle boxes and their kd-tree at each evaluation time.
+  std::vector<std::vector<ObstacleBox>> obstacle_boxes_by_time_;
+  std::vector<ObstacleBoxKDTree> obstacle_kdtrees_;
 };
 
 }  // namespace planning
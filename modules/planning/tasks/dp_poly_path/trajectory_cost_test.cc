@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/tasks/dp_poly_path/trajectory_cost.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/util.h"
+#include "modules/planning/common/path_obstacle.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+class TrajectoryCostTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // A straight reference line along x.
+    std::vector<ReferencePoint> ref_points;
+    for (double x = 0.0; x <= 120.0; x += 1.0) {
+      ref_points.emplace_back(hdmap::MapPathPoint(Vec2d(x, 0.0), 0.0), 0.0,
+                              0.0, -2.0, 2.0);
+    }
+    reference_line_.reset(new ReferenceLine(ref_points));
+
+    for (double t = 0.0; t <= 8.0; t += 0.1) {
+      speed_data_.AppendSpeedPoint(10.0 * t, t, 10.0, 0.0, 0.0);
+    }
+    vehicle_param_.set_length(4.933);
+    vehicle_param_.set_width(2.11);
+
+    std::uniform_real_distribution<double> x_dist(0.0, 100.0);
+    std::uniform_real_distribution<double> y_dist(-10.0, 10.0);
+    std::uniform_real_distribution<double> heading_dist(-M_PI, M_PI);
+    for (int i = 0; i < 100; ++i) {
+      AddObstacle(Vec2d(x_dist(random_engine_), y_dist(random_engine_)),
+                  heading_dist(random_engine_));
+    }
+  }
+
+ protected:
+  void AddObstacle(const Vec2d& center, const double heading) {
+    perception::PerceptionObstacle perception_obstacle;
+    perception_obstacle.set_id(static_cast<int>(obstacles_.size()));
+    perception_obstacle.mutable_position()->set_x(center.x());
+    perception_obstacle.mutable_position()->set_y(center.y());
+    perception_obstacle.set_theta(heading);
+    perception_obstacle.set_length(4.0);
+    perception_obstacle.set_width(2.0);
+    perception_obstacle.set_type(
+        perception::PerceptionObstacle::UNKNOWN_UNMOVABLE);
+    std::vector<Vec2d> corners;
+    Box2d(center, heading, 4.0, 2.0).GetAllCorners(&corners);
+    for (const auto& corner : corners) {
+      auto* point = perception_obstacle.add_polygon_point();
+      point->set_x(corner.x());
+      point->set_y(corner.y());
+    }
+    obstacles_.emplace_back(
+        new Obstacle(std::to_string(perception_obstacle.id()),
+                     perception_obstacle));
+    path_obstacles_.emplace_back(new PathObstacle(obstacles_.back().get()));
+  }
+
+  // The cost of the ego box against every obstacle, one after the other.
+  double LinearScanCost(const TrajectoryCost& trajectory_cost,
+                        const Box2d& ego_box, const double time) const {
+    double cost = 0.0;
+    for (const auto& obstacle : obstacles_) {
+      const Box2d obstacle_box =
+          obstacle->GetBoundingBox(obstacle->GetPointAtTime(time));
+      const double distance = obstacle_box.DistanceTo(ego_box);
+      if (distance > config_.obstacle_ignore_distance()) {
+        continue;
+      } else if (distance <= config_.obstacle_collision_distance()) {
+        cost += config_.obstacle_collision_cost();
+      } else if (distance <= config_.obstacle_risk_distance()) {
+        cost += trajectory_cost.RiskDistanceCost(distance);
+      } else {
+        cost += trajectory_cost.RegularDistanceCost(distance);
+      }
+    }
+    return cost;
+  }
+
+  DpPolyPathConfig config_;
+  std::unique_ptr<ReferenceLine> reference_line_;
+  SpeedData speed_data_;
+  common::VehicleParam vehicle_param_;
+  std::mt19937 random_engine_{2017};
+  std::vector<std::unique_ptr<Obstacle>> obstacles_;
+  std::vector<std::unique_ptr<PathObstacle>> path_obstacles_;
+};
+
+TEST_F(TrajectoryCostTest, ObstacleCostIsTheLinearScanCost) {
+  std::vector<const PathObstacle*> path_obstacles;
+  for (const auto& path_obstacle : path_obstacles_) {
+    path_obstacles.push_back(path_obstacle.get());
+  }
+  const TrajectoryCost trajectory_cost(
+      config_, *reference_line_, path_obstacles, vehicle_param_, speed_data_,
+      common::util::MakeSLPoint(0.0, 0.0));
+
+  std::uniform_real_distribution<double> x_dist(-10.0, 110.0);
+  std::uniform_real_distribution<double> y_dist(-15.0, 15.0);
+  std::uniform_real_distribution<double> heading_dist(-M_PI, M_PI);
+  std::uniform_int_distribution<uint32_t> time_index_dist(0, 40);
+  int num_costs = 0;
+  for (int i = 0; i < 2000; ++i) {
+    const Box2d ego_box(Vec2d(x_dist(random_engine_), y_dist(random_engine_)),
+                        heading_dist(random_engine_), vehicle_param_.length(),
+                        vehicle_param_.width());
+    const uint32_t time_index = time_index_dist(random_engine_);
+    const double expected = LinearScanCost(
+        trajectory_cost, ego_box, time_index * config_.eval_time_interval());
+    // Bitwise equality, not approximate.
+    EXPECT_EQ(expected,
+              trajectory_cost.CalculateObstacleCost(ego_box, time_index))
+        << "ego box " << ego_box.DebugString() << " at " << time_index;
+    num_costs += expected > 0.0;
+  }
+  // Most of the ego boxes are near obstacles.
+  EXPECT_GT(num_costs, 1000);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -20,13 +20,47 @@
 
 #include "modules/planning/tasks/dp_st_speed/dp_st_cost.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
+#include "Eigen/Core"
+
+#include "modules/common/log.h"
 #include "modules/planning/common/speed/st_point.h"
 
 namespace apollo {
 namespace planning {
 
+namespace {
+
+// exp(x) is 0 for any x below, which is below log of the smallest denormal.
+constexpr double kMinExpArgument = -745.2;
+
+using ColumnIterator = std::vector<StGraphPoint>::const_iterator;
+
+// The first row of the column whose s is not less than s.
+size_t LowerRow(ColumnIterator begin, ColumnIterator end, const double s) {
+  return std::distance(begin,
+                       std::lower_bound(begin, end, s,
+                                        [](const StGraphPoint& point,
+                                           const double s) {
+                                          return point.point().s() < s;
+                                        }));
+}
+
+// The first row of the column whose s is greater than s.
+size_t UpperRow(ColumnIterator begin, ColumnIterator end, const double s) {
+  return std::distance(begin,
+                       std::upper_bound(begin, end, s,
+                                        [](const double s,
+                                           const StGraphPoint& point) {
+                                          return s < point.point().s();
+                                        }));
+}
+
+}  // namespace
+
 DpStCost::DpStCost(const DpStSpeedConfig& dp_st_speed_config)
     : dp_st_speed_config_(dp_st_speed_config),
       unit_s_(dp_st_speed_config_.total_path_length() /
@@ -66,6 +100,121 @@ double DpStCost::GetObstacleCost(
   return total_cost * unit_t_;
 }
 
+void DpStCost::GetObstacleCosts(
+    std::vector<StGraphPoint>::const_iterator column_begin,
+    std::vector<StGraphPoint>::const_iterator column_end,
+    const std::vector<const StBoundary*>& st_boundaries,
+    std::vector<double>* const costs) const {
+  CHECK_NOTNULL(costs);
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  const size_t num_rows = std::distance(column_begin, column_end);
+  costs->assign(num_rows, 0.0);
+  if (num_rows == 0) {
+    return;
+  }
+  const double unit_v = unit_s_ / unit_t_;
+  const double t = column_begin->point().t();
+
+  // Whether the rows are in the current boundary.
+  std::vector<bool> in_boundary;
+  Eigen::ArrayXd distance;
+  for (const StBoundary* boundary : st_boundaries) {
+    const double factor = dp_st_speed_config_.obstacle_cost_factor() /
+                          boundary->characteristic_length();
+    double s_upper = 0.0;
+    double s_lower = 0.0;
+    if (boundary->GetBoundarySRange(t, &s_upper, &s_lower)) {
+      // The rows which may be in the boundary, with one row of margin for the
+      // rounding errors of the polygon range.
+      size_t in_begin = 0;
+      size_t in_end = 0;
+      double polygon_s_upper = 0.0;
+      double polygon_s_lower = 0.0;
+      if (t > boundary->min_t() && t < boundary->max_t() &&
+          boundary->GetPolygonSRange(t, &polygon_s_upper, &polygon_s_lower)) {
+        const size_t lower_row =
+            LowerRow(column_begin, column_end,
+                     std::fmin(polygon_s_lower, polygon_s_upper));
+        in_begin = (lower_row > 0 ? lower_row - 1 : 0);
+        in_end = std::min(
+            UpperRow(column_begin, column_end,
+                     std::fmax(polygon_s_lower, polygon_s_upper)) +
+                1,
+            num_rows);
+        in_end = std::max(in_begin, in_end);
+      }
+      in_boundary.assign(num_rows, false);
+      for (size_t r = in_begin; r < in_end; ++r) {
+        const StGraphPoint& point = column_begin[r];
+        if (!boundary->IsPointInBoundary(point.point())) {
+          continue;
+        }
+        in_boundary[r] = true;
+        if (boundary->boundary_type() ==
+            StBoundary::BoundaryType::KEEP_CLEAR) {
+          (*costs)[r] += unit_v * ((point.index_s() + 1.0) /
+                                   (point.index_t() + 1.0)) *
+                         dp_st_speed_config_.keep_clear_cost_factor();
+        } else {
+          (*costs)[r] = inf;
+        }
+      }
+
+      // Within the time range of the boundary, DistanceS() is the same for
+      // all the rows out of it.
+      const double cost =
+          dp_st_speed_config_.default_obstacle_cost() *
+          std::exp(factor * boundary->DistanceS(column_begin->point()));
+      if (cost != 0.0) {
+        for (size_t r = 0; r < num_rows; ++r) {
+          if (!in_boundary[r]) {
+            (*costs)[r] += cost;
+          }
+        }
+      }
+      continue;
+    }
+
+    // Out of the time range of the boundary, no row is in it, and
+    // DistanceS() is the distance to an s range of [0, 0].
+    s_upper = 0.0;
+    s_lower = 0.0;
+    // The rows close enough to the boundary for their costs not to be 0,
+    // with one row of margin.
+    size_t near_begin = 0;
+    size_t near_end = num_rows;
+    if (factor < 0.0) {
+      const double max_distance = kMinExpArgument / factor;
+      const size_t lower_row =
+          LowerRow(column_begin, column_end, s_lower - max_distance);
+      near_begin = (lower_row > 0 ? lower_row - 1 : 0);
+      near_end = std::min(
+          UpperRow(column_begin, column_end, s_upper + max_distance) + 1,
+          num_rows);
+      near_end = std::max(near_begin, near_end);
+    }
+    distance.resize(near_end - near_begin);
+    for (size_t r = near_begin; r < near_end; ++r) {
+      const double s = column_begin[r].point().s();
+      distance[r - near_begin] =
+          (s < s_lower ? s_lower - s : (s > s_upper ? s - s_upper : 0.0));
+    }
+    const Eigen::ArrayXd cost = dp_st_speed_config_.default_obstacle_cost() *
+                                (factor * distance).exp();
+    for (size_t r = near_begin; r < near_end; ++r) {
+      (*costs)[r] += cost[r - near_begin];
+    }
+  }
+
+  for (size_t r = 0; r < num_rows; ++r) {
+    if (column_begin[r].point().s() < 0) {
+      (*costs)[r] = inf;
+    } else {
+      (*costs)[r] *= unit_t_;
+    }
+  }
+}
+
 double DpStCost::GetReferenceCost(const STPoint& point,
                                   const STPoint& reference_point) const {
   return dp_st_speed_config_.reference_weight() *
@@ -41,6 +41,19 @@ class DpStCost {
       const StGraphPoint& point,
       const std::vector<const StBoundary*>& st_boundaries) const;
 
+  /**
+   * @brief The obstacle costs of a column [column_begin, column_end) of the
+   * cost table, the points of the same t by increasing s, as
+   * GetObstacleCost() point by point up to the rounding of exp(). Each
+   * boundary only updates the range of rows it blocks or is close enough to
+   * have a cost, and evaluates the costs of the range at once.
+   */
+  void GetObstacleCosts(
+      std::vector<StGraphPoint>::const_iterator column_begin,
+      std::vector<StGraphPoint>::const_iterator column_end,
+      const std::vector<const StBoundary*>& st_boundaries,
+      std::vector<double>* const costs) const;
+
   double GetReferenceCost(const STPoint& point,
                           const STPoint& reference_point) const;
 
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file dp_st_cost_test.cc
+ **/
+
+#include "modules/planning/tasks/dp_st_speed/dp_st_cost.h"
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(DpStCostTest, GetObstacleCosts) {
+  DpStSpeedConfig config;
+  config.set_total_path_length(80.0);
+  config.set_total_time(8.0);
+  config.set_matrix_dimension_s(200);
+  config.set_matrix_dimension_t(20);
+  config.set_obstacle_cost_factor(-30.0);
+  const DpStCost cost(config);
+  const double unit_s =
+      config.total_path_length() / config.matrix_dimension_s();
+  const double unit_t = config.total_time() / config.matrix_dimension_t();
+
+  // Static, moving, keep clear boundaries, and boundaries starting and ending
+  // at the times of the columns.
+  std::mt19937 random_engine(2017);
+  std::uniform_real_distribution<double> s(0.0, 80.0);
+  std::uniform_real_distribution<double> length(0.5, 10.0);
+  std::uniform_real_distribution<double> speed(-5.0, 10.0);
+  std::uniform_int_distribution<int> column(0, 19);
+  std::vector<StBoundary> boundaries;
+  for (int i = 0; i < 20; ++i) {
+    double start_t = 0.0;
+    double end_t = 8.0;
+    if (i % 3 == 1) {
+      start_t = column(random_engine) * unit_t;
+      end_t = std::min(8.0, start_t + column(random_engine) * unit_t + 0.1);
+    }
+    const double start_s = s(random_engine);
+    const double end_s = start_s + speed(random_engine) * (end_t - start_t);
+    const double boundary_length = length(random_engine);
+    std::vector<std::pair<STPoint, STPoint>> point_pairs;
+    point_pairs.emplace_back(STPoint(start_s, start_t),
+                             STPoint(start_s + boundary_length, start_t));
+    point_pairs.emplace_back(STPoint(end_s, end_t),
+                             STPoint(end_s + boundary_length, end_t));
+    boundaries.emplace_back(point_pairs);
+    if (i % 5 == 2) {
+      boundaries.back().SetBoundaryType(StBoundary::BoundaryType::KEEP_CLEAR);
+    }
+    boundaries.back().SetCharacteristicLength(length(random_engine));
+  }
+  std::vector<const StBoundary*> st_boundaries;
+  for (const auto& boundary : boundaries) {
+    st_boundaries.push_back(&boundary);
+  }
+
+  double curr_t = 0.0;
+  for (uint32_t i = 0; i < config.matrix_dimension_t(); ++i) {
+    std::vector<StGraphPoint> points(config.matrix_dimension_s());
+    double curr_s = 0.0;
+    for (uint32_t j = 0; j < points.size(); ++j) {
+      points[j].Init(i, j, STPoint(curr_s, curr_t));
+      curr_s += unit_s;
+    }
+    std::vector<double> costs;
+    cost.GetObstacleCosts(points.begin(), points.end(), st_boundaries, &costs);
+    ASSERT_EQ(points.size(), costs.size());
+    for (uint32_t j = 0; j < points.size(); ++j) {
+      const double expected = cost.GetObstacleCost(points[j], st_boundaries);
+      if (std::isinf(expected)) {
+        EXPECT_TRUE(std::isinf(costs[j])) << "t: " << i << " s: " << j;
+      } else {
+        EXPECT_NEAR(expected, costs[j], 1e-12 * std::fmax(1.0, expected))
+            << "t: " << i << " s: " << j;
+      }
+    }
+    curr_t += unit_t;
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -59,13 +59,15 @@ DpStGraph::DpStGraph(const ReferenceLine& reference_line,
                      const StGraphData& st_graph_data,
                      const DpStSpeedConfig& dp_config,
                      const PathData& path_data,
-                     const SLBoundary& adc_sl_boundary)
+                     const SLBoundary& adc_sl_boundary,
+                     common::util::ThreadPool* thread_pool)
     : reference_line_(reference_line),
       dp_st_speed_config_(dp_config),
       st_graph_data_(st_graph_data),
       adc_sl_boundary_(adc_sl_boundary),
       dp_st_cost_(dp_config),
-      init_point_(st_graph_data.init_point()) {
+      init_point_(st_graph_data.init_point()),
+      thread_pool_(thread_pool) {
   dp_st_speed_config_.set_total_path_length(
       std::fmin(dp_st_speed_config_.total_path_length(),
                 st_graph_data_.path_data_length()));
@@ -97,22 +99,20 @@ Status DpStGraph::Search(PathDecision* const path_decision,
 }
 
 Status DpStGraph::InitCostTable() {
-  uint32_t dim_s = dp_st_speed_config_.matrix_dimension_s();
-  uint32_t dim_t = dp_st_speed_config_.matrix_dimension_t();
-  unit_s_ = dp_st_speed_config_.total_path_length() / dim_s;
+  dim_s_ = dp_st_speed_config_.matrix_dimension_s();
+  dim_t_ = dp_st_speed_config_.matrix_dimension_t();
+  unit_s_ = dp_st_speed_config_.total_path_length() / dim_s_;
   unit_t_ = dp_st_speed_config_.total_time() /
             dp_st_speed_config_.matrix_dimension_t();
-  DCHECK_GT(dim_s, 2);
-  DCHECK_GT(dim_t, 2);
-  cost_table_ = std::vector<std::vector<StGraphPoint>>(
-      dim_t, std::vector<StGraphPoint>(dim_s, StGraphPoint()));
+  DCHECK_GT(dim_s_, 2);
+  DCHECK_GT(dim_t_, 2);
+  cost_table_ = std::vector<StGraphPoint>(dim_t_ * dim_s_, StGraphPoint());
 
   double curr_t = 0.0;
-  for (uint32_t i = 0; i < cost_table_.size(); ++i, curr_t += unit_t_) {
-    auto& cost_table_i = cost_table_[i];
+  for (uint32_t i = 0; i < dim_t_; ++i, curr_t += unit_t_) {
     double curr_s = 0.0;
-    for (uint32_t j = 0; j < cost_table_i.size(); ++j, curr_s += unit_s_) {
-      cost_table_i[j].Init(i, j, STPoint(curr_s, curr_t));
+    for (uint32_t j = 0; j < dim_s_; ++j, curr_s += unit_s_) {
+      CostAt(i, j).Init(i, j, STPoint(curr_s, curr_t));
     }
   }
   return Status::OK();
@@ -123,22 +123,29 @@ void DpStGraph::CalculatePointwiseCost(
   // TODO(all): extract reference line from decision first
   std::vector<STPoint> reference_points;
   double curr_t = 0.0;
-  for (uint32_t i = 0; i < cost_table_.size(); ++i) {
+  for (uint32_t i = 0; i < dim_t_; ++i) {
     reference_points.emplace_back(curr_t * FLAGS_planning_upper_speed_limit,
                                   curr_t);
     curr_t += unit_t_;
   }
 
-  for (uint32_t i = 0; i < cost_table_.size(); ++i) {
-    for (auto& st_graph_point : cost_table_[i]) {
-      double ref_cost = dp_st_cost_.GetReferenceCost(st_graph_point.point(),
-                                                     reference_points[i]);
-      double obs_cost = dp_st_cost_.GetObstacleCost(st_graph_point, boundaries);
-      st_graph_point.SetReferenceCost(ref_cost);
-      st_graph_point.SetObstacleCost(obs_cost);
-      st_graph_point.SetTotalCost(std::numeric_limits<double>::infinity());
-    }
-  }
+  // The columns are independent.
+  common::util::ParallelFor(
+      thread_pool_, 0, dim_t_,
+      [this, &boundaries, &reference_points](const size_t i) {
+        const auto column_begin = cost_table_.begin() + i * dim_s_;
+        std::vector<double> obs_costs;
+        dp_st_cost_.GetObstacleCosts(column_begin, column_begin + dim_s_,
+                                     boundaries, &obs_costs);
+        for (uint32_t j = 0; j < dim_s_; ++j) {
+          auto& st_graph_point = CostAt(i, j);
+          double ref_cost = dp_st_cost_.GetReferenceCost(
+              st_graph_point.point(), reference_points[i]);
+          st_graph_point.SetReferenceCost(ref_cost);
+          st_graph_point.SetObstacleCost(obs_costs[j]);
+          st_graph_point.SetTotalCost(std::numeric_limits<double>::infinity());
+        }
+      });
 }
 
 Status DpStGraph::CalculateTotalCost() {
@@ -147,12 +154,19 @@ Status DpStGraph::CalculateTotalCost() {
   uint32_t next_highest_row = 0;
   uint32_t next_lowest_row = 0;
 
-  for (size_t c = 0; c < cost_table_.size(); ++c) {
+  for (uint32_t c = 0; c < dim_t_; ++c) {
+    // The rows of a column only depend on the previous columns, and each
+    // row is only written by its own task.
+    common::util::ParallelFor(
+        thread_pool_, next_lowest_row, next_highest_row + 1,
+        [this, c](const size_t r) { CalculateCostAt(c, r); });
+
+    // The row range of the next column is reduced in row order, so it does
+    // not depend on the order the rows were evaluated in.
     uint32_t highest_row = 0;
-    uint32_t lowest_row = cost_table_.back().size() - 1;
+    uint32_t lowest_row = dim_s_ - 1;
     for (uint32_t r = next_lowest_row; r <= next_highest_row; ++r) {
-      const auto& cost_cr = cost_table_[c][r];
-      CalculateCostAt(c, r);
+      const auto& cost_cr = CostAt(c, r);
       uint32_t h_r = 0;
       uint32_t l_r = 0;
       if (cost_cr.total_cost() < std::numeric_limits<double>::infinity()) {
@@ -183,21 +197,21 @@ void DpStGraph::GetRowRange(const StGraphPoint& point,
       v0 * unit_t_ + vehicle_param_.max_acceleration() * speed_coeff;
   *next_highest_row =
       point.index_s() + static_cast<uint32_t>(delta_s_upper_bound / unit_s_);
-  if (*next_highest_row >= cost_table_.back().size()) {
-    *next_highest_row = cost_table_.back().size() - 1;
+  if (*next_highest_row >= dim_s_) {
+    *next_highest_row = dim_s_ - 1;
   }
 
   const double delta_s_lower_bound = std::fmax(
       0.0, v0 * unit_t_ + vehicle_param_.max_deceleration() * speed_coeff);
   *next_lowest_row += static_cast<int32_t>(delta_s_lower_bound / unit_s_);
-  if (*next_lowest_row >= cost_table_.back().size()) {
-    *next_lowest_row = cost_table_.back().size() - 1;
+  if (*next_lowest_row >= dim_s_) {
+    *next_lowest_row = dim_s_ - 1;
   }
 }
 
 void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
-  auto& cost_cr = cost_table_[c][r];
-  const auto& cost_init = cost_table_[0][0];
+  auto& cost_cr = CostAt(c, r);
+  const auto& cost_init = CostAt(0, 0);
   if (c == 0) {
     DCHECK_EQ(r, 0) << "Incorrect. Row should be 0 with col = 0. row: " << r;
     cost_cr.SetTotalCost(0.0);
@@ -221,7 +235,7 @@ void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
       FLAGS_planning_upper_speed_limit * unit_t_ / unit_s_);
   const uint32_t r_low = (max_s_diff < r ? r - max_s_diff : 0);
 
-  const auto& pre_col = cost_table_[c - 1];
+  const StGraphPoint* const pre_col = &CostAt(c - 1, 0);
 
   if (c == 2) {
     for (uint32_t r_pre = r_low; r_pre <= r; ++r_pre) {
@@ -270,7 +284,7 @@ void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
     }
 
     for (uint32_t r_prepre = lower_bound; r_prepre <= upper_bound; ++r_prepre) {
-      const StGraphPoint& prepre_graph_point = cost_table_[c - 2][r_prepre];
+      const StGraphPoint& prepre_graph_point = CostAt(c - 2, r_prepre);
       if (std::isinf(prepre_graph_point.total_cost())) {
         continue;
       }
@@ -316,7 +330,8 @@ bool DpStGraph::CalculateFeasibleAccelRange(const double r_pre,
 Status DpStGraph::RetrieveSpeedProfile(SpeedData* const speed_data) const {
   double min_cost = std::numeric_limits<double>::infinity();
   const StGraphPoint* best_end_point = nullptr;
-  for (const StGraphPoint& cur_point : cost_table_.back()) {
+  for (uint32_t r = 0; r < dim_s_; ++r) {
+    const StGraphPoint& cur_point = CostAt(dim_t_ - 1, r);
     if (!std::isinf(cur_point.total_cost()) &&
         cur_point.total_cost() < min_cost) {
       best_end_point = &cur_point;
@@ -324,8 +339,8 @@ Status DpStGraph::RetrieveSpeedProfile(SpeedData* const speed_data) const {
     }
   }
 
-  for (const auto& row : cost_table_) {
-    const StGraphPoint& cur_point = row.back();
+  for (uint32_t c = 0; c < dim_t_; ++c) {
+    const StGraphPoint& cur_point = CostAt(c, dim_s_ - 1);
     if (!std::isinf(cur_point.total_cost()) &&
         cur_point.total_cost() < min_cost) {
       best_end_point = &cur_point;
@@ -373,8 +388,8 @@ double DpStGraph::CalculateEdgeCostForSecondCol(
     const uint32_t row, const double speed_limit) const {
   double init_speed = init_point_.v();
   double init_acc = init_point_.a();
-  const STPoint& pre_point = cost_table_[0][0].point();
-  const STPoint& curr_point = cost_table_[1][row].point();
+  const STPoint& pre_point = CostAt(0, 0).point();
+  const STPoint& curr_point = CostAt(1, row).point();
   return dp_st_cost_.GetSpeedCost(pre_point, curr_point, speed_limit) +
          dp_st_cost_.GetAccelCostByTwoPoints(init_speed, pre_point,
                                              curr_point) +
@@ -386,9 +401,9 @@ double DpStGraph::CalculateEdgeCostForThirdCol(const uint32_t curr_row,
                                                const uint32_t pre_row,
                                                const double speed_limit) const {
   double init_speed = init_point_.v();
-  const STPoint& first = cost_table_[0][0].point();
-  const STPoint& second = cost_table_[1][pre_row].point();
-  const STPoint& third = cost_table_[2][curr_row].point();
+  const STPoint& first = CostAt(0, 0).point();
+  const STPoint& second = CostAt(1, pre_row).point();
+  const STPoint& third = CostAt(2, curr_row).point();
   return dp_st_cost_.GetSpeedCost(second, third, speed_limit) +
          dp_st_cost_.GetAccelCostByThreePoints(first, second, third) +
          dp_st_cost_.GetJerkCostByThreePoints(init_speed, first, second, third);
@@ -28,6 +28,7 @@
 #include "modules/planning/proto/planning_config.pb.h"
 
 #include "modules/common/status/status.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
@@ -41,9 +42,15 @@ namespace planning {
 
 class DpStGraph {
  public:
+  /**
+   * @param thread_pool if not null, the rows of each column of the cost table
+   * are evaluated in parallel on this pool. The resulting speed profile is
+   * identical to the one found without a pool.
+   */
   DpStGraph(const ReferenceLine& reference_line,
             const StGraphData& st_graph_data, const DpStSpeedConfig& dp_config,
-            const PathData& path_data, const SLBoundary& adc_sl_boundary);
+            const PathData& path_data, const SLBoundary& adc_sl_boundary,
+            common::util::ThreadPool* thread_pool = nullptr);
 
   apollo::common::Status Search(PathDecision* const path_decision,
                                 SpeedData* const speed_data);
@@ -75,6 +82,13 @@ class DpStGraph {
   void GetRowRange(const StGraphPoint& point, uint32_t* highest_row,
                    uint32_t* lowest_row);
 
+  StGraphPoint& CostAt(const uint32_t c, const uint32_t r) {
+    return cost_table_[c * dim_s_ + r];
+  }
+  const StGraphPoint& CostAt(const uint32_t c, const uint32_t r) const {
+    return cost_table_[c * dim_s_ + r];
+  }
+
  private:
   const ReferenceLine& reference_line_;
   // dp st configuration
@@ -96,12 +110,16 @@ class DpStGraph {
   // mappign obstacle to st graph
   // std::unique_ptr<StBoundaryMapper> st_mapper_ = nullptr;
 
+  common::util::ThreadPool* thread_pool_ = nullptr;
+
   double unit_s_ = 0.0;
   double unit_t_ = 0.0;
+  uint32_t dim_s_ = 0;
+  uint32_t dim_t_ = 0;
 
-  // cost_table_[t][s]
+  // cost_table_[t * dim_s_ + s], the columns stored one after the other.
   // row: s, col: t --- NOTICE: Please do NOT change.
-  std::vector<std::vector<StGraphPoint>> cost_table_;
+  std::vector<StGraphPoint> cost_table_;
 };
 
 }  // namespace planning
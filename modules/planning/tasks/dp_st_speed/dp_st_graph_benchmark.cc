@@ -0,0 +1,193 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the DP ST speed search and its obstacle cost against the
+ * number of ST boundaries.
+ **/
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/log.h"
+#include "modules/common/util/thread_pool.h"
+#include "modules/planning/tasks/dp_st_speed/dp_st_cost.h"
+#include "modules/planning/tasks/dp_st_speed/dp_st_graph.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// The dp_st_speed_config of modules/planning/conf/planning_config.pb.txt.
+DpStSpeedConfig Config() {
+  DpStSpeedConfig config;
+  config.set_total_path_length(80.0);
+  config.set_total_time(8.0);
+  config.set_matrix_dimension_s(200);
+  config.set_matrix_dimension_t(20);
+  config.set_speed_weight(0.0);
+  config.set_accel_weight(10.0);
+  config.set_jerk_weight(10.0);
+  config.set_obstacle_weight(1.0);
+  config.set_reference_weight(0.0);
+  config.set_go_down_buffer(5.0);
+  config.set_go_up_buffer(5.0);
+  return config;
+}
+
+// Static and moving ST boundaries of vehicles, some of them keep clear zones.
+std::vector<std::unique_ptr<StBoundary>> StBoundaries(const int num) {
+  std::mt19937 random_engine(2017);
+  std::uniform_real_distribution<double> s(10.0, 80.0);
+  std::uniform_real_distribution<double> speed(-2.0, 8.0);
+  std::vector<std::unique_ptr<StBoundary>> boundaries;
+  for (int i = 0; i < num; ++i) {
+    const double start_s = s(random_engine);
+    const double end_s = start_s + (i % 2 == 0 ? 0.0 : speed(random_engine));
+    const double kLength = 5.0;
+    std::vector<std::pair<STPoint, STPoint>> point_pairs;
+    point_pairs.emplace_back(STPoint(start_s, 0.0),
+                             STPoint(start_s + kLength, 0.0));
+    point_pairs.emplace_back(STPoint(end_s, 8.0),
+                             STPoint(end_s + kLength, 8.0));
+    boundaries.emplace_back(new StBoundary(point_pairs));
+    if (i % 10 == 9) {
+      boundaries.back()->SetBoundaryType(StBoundary::BoundaryType::KEEP_CLEAR);
+    }
+    boundaries.back()->SetCharacteristicLength(kLength);
+  }
+  return boundaries;
+}
+
+std::vector<const StBoundary*> BoundaryPtrs(
+    const std::vector<std::unique_ptr<StBoundary>>& boundaries) {
+  std::vector<const StBoundary*> boundary_ptrs;
+  for (const auto& boundary : boundaries) {
+    boundary_ptrs.push_back(boundary.get());
+  }
+  return boundary_ptrs;
+}
+
+std::vector<std::vector<StGraphPoint>> CostTable(
+    const DpStSpeedConfig& config) {
+  const double unit_s =
+      config.total_path_length() / config.matrix_dimension_s();
+  const double unit_t = config.total_time() / config.matrix_dimension_t();
+  std::vector<std::vector<StGraphPoint>> cost_table(
+      config.matrix_dimension_t(),
+      std::vector<StGraphPoint>(config.matrix_dimension_s()));
+  for (uint32_t i = 0; i < cost_table.size(); ++i) {
+    for (uint32_t j = 0; j < cost_table[i].size(); ++j) {
+      cost_table[i][j].Init(i, j, STPoint(j * unit_s, i * unit_t));
+    }
+  }
+  return cost_table;
+}
+
+void Search(benchmark::State& state, const int num_boundaries,
+            common::util::ThreadPool* thread_pool) {
+  common::VehicleConfigHelper::Init();
+  const auto config = Config();
+  const auto boundaries = StBoundaries(num_boundaries);
+  common::TrajectoryPoint init_point;
+  init_point.set_v(5.0);
+  SpeedLimit speed_limit;
+  for (double s = 0.0; s <= config.total_path_length(); s += 1.0) {
+    speed_limit.AppendSpeedLimit(s, 15.0);
+  }
+  const StGraphData st_graph_data(BoundaryPtrs(boundaries), init_point,
+                                  speed_limit, config.total_path_length());
+  ReferenceLine reference_line;
+  PathData path_data;
+  SLBoundary adc_sl_boundary;
+  while (state.KeepRunning()) {
+    DpStGraph st_graph(reference_line, st_graph_data, config, path_data,
+                       adc_sl_boundary, thread_pool);
+    PathDecision path_decision;
+    SpeedData speed_data;
+    CHECK(st_graph.Search(&path_decision, &speed_data).ok());
+    benchmark::DoNotOptimize(speed_data);
+  }
+}
+
+}  // namespace
+
+// Arg: number of ST boundaries.
+void BM_DpStGraphSearch(benchmark::State& state) {
+  Search(state, state.range(0), nullptr);
+}
+BENCHMARK(BM_DpStGraphSearch)->Arg(5)->Arg(20)->Arg(80);
+
+// Args: {number of ST boundaries, number of worker threads}.
+void BM_DpStGraphSearchParallel(benchmark::State& state) {
+  common::util::ThreadPool thread_pool(state.range(1));
+  Search(state, state.range(0), &thread_pool);
+}
+BENCHMARK(BM_DpStGraphSearchParallel)
+    ->Args({20, 1})
+    ->Args({20, 3})
+    ->Args({80, 1})
+    ->Args({80, 3});
+
+// The obstacle costs of the cost table, cell by cell.
+// Arg: number of ST boundaries.
+void BM_GetObstacleCost(benchmark::State& state) {
+  const auto config = Config();
+  const DpStCost dp_st_cost(config);
+  const auto boundaries = StBoundaries(state.range(0));
+  const auto boundary_ptrs = BoundaryPtrs(boundaries);
+  const auto cost_table = CostTable(config);
+  while (state.KeepRunning()) {
+    for (const auto& column : cost_table) {
+      for (const auto& point : column) {
+        benchmark::DoNotOptimize(
+            dp_st_cost.GetObstacleCost(point, boundary_ptrs));
+      }
+    }
+  }
+}
+BENCHMARK(BM_GetObstacleCost)->Arg(5)->Arg(20)->Arg(80);
+
+// The obstacle costs of the cost table, column by column.
+// Arg: number of ST boundaries.
+void BM_GetObstacleCosts(benchmark::State& state) {
+  const auto config = Config();
+  const DpStCost dp_st_cost(config);
+  const auto boundaries = StBoundaries(state.range(0));
+  const auto boundary_ptrs = BoundaryPtrs(boundaries);
+  const auto cost_table = CostTable(config);
+  std::vector<double> costs;
+  while (state.KeepRunning()) {
+    for (const auto& column : cost_table) {
+      dp_st_cost.GetObstacleCosts(column.begin(), column.end(), boundary_ptrs,
+                                  &costs);
+      benchmark::DoNotOptimize(costs);
+    }
+  }
+}
+BENCHMARK(BM_GetObstacleCosts)->Arg(5)->Arg(20)->Arg(80);
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
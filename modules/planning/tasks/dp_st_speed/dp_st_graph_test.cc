@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file dp_st_graph_test.cc
+ **/
+
+#include "modules/planning/tasks/dp_st_speed/dp_st_graph.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/util/thread_pool.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::util::ThreadPool;
+
+class DpStGraphTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    common::VehicleConfigHelper::Init();
+    config_.set_total_path_length(80.0);
+    config_.set_total_time(8.0);
+    config_.set_matrix_dimension_s(200);
+    config_.set_matrix_dimension_t(20);
+    config_.set_accel_weight(10.0);
+    config_.set_jerk_weight(10.0);
+    config_.set_obstacle_weight(1.0);
+
+    // A static obstacle ahead, and a slower vehicle merging in.
+    AddBoundary(60.0, 60.0, 5.0);
+    AddBoundary(20.0, 44.0, 4.0);
+    std::vector<const StBoundary*> boundaries;
+    for (const auto& boundary : boundaries_) {
+      boundaries.push_back(boundary.get());
+    }
+    init_point_.set_v(8.0);
+    SpeedLimit speed_limit;
+    for (double s = 0.0; s <= config_.total_path_length(); s += 1.0) {
+      speed_limit.AppendSpeedLimit(s, 15.0);
+    }
+    st_graph_data_.reset(new StGraphData(boundaries, init_point_, speed_limit,
+                                         config_.total_path_length()));
+  }
+
+ protected:
+  void AddBoundary(const double start_s, const double end_s,
+                   const double length) {
+    std::vector<std::pair<STPoint, STPoint>> point_pairs;
+    point_pairs.emplace_back(STPoint(start_s, 0.0),
+                             STPoint(start_s + length, 0.0));
+    point_pairs.emplace_back(STPoint(end_s, 8.0), STPoint(end_s + length, 8.0));
+    boundaries_.emplace_back(new StBoundary(point_pairs));
+    boundaries_.back()->SetCharacteristicLength(length);
+  }
+
+  bool Search(ThreadPool* thread_pool, SpeedData* speed_data) {
+    DpStGraph st_graph(reference_line_, *st_graph_data_, config_, path_data_,
+                       adc_sl_boundary_, thread_pool);
+    PathDecision path_decision;
+    return st_graph.Search(&path_decision, speed_data).ok();
+  }
+
+  DpStSpeedConfig config_;
+  common::TrajectoryPoint init_point_;
+  std::vector<std::unique_ptr<StBoundary>> boundaries_;
+  std::unique_ptr<StGraphData> st_graph_data_;
+  ReferenceLine reference_line_;
+  PathData path_data_;
+  SLBoundary adc_sl_boundary_;
+};
+
+TEST_F(DpStGraphTest, ParallelSpeedProfileIsIdentical) {
+  SpeedData serial_speed;
+  ASSERT_TRUE(Search(nullptr, &serial_speed));
+  const auto& expected = serial_speed.speed_vector();
+  ASSERT_EQ(config_.matrix_dimension_t(), expected.size());
+  // Stops behind the static obstacle.
+  EXPECT_LT(expected.back().s(), 60.0);
+
+  for (const size_t num_threads : {0, 1, 3, 16}) {
+    ThreadPool thread_pool(num_threads);
+    SpeedData parallel_speed;
+    ASSERT_TRUE(Search(&thread_pool, &parallel_speed));
+    const auto& points = parallel_speed.speed_vector();
+    ASSERT_EQ(expected.size(), points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      // Bitwise equality, not approximate.
+      EXPECT_EQ(expected[i].s(), points[i].s()) << "point " << i;
+      EXPECT_EQ(expected[i].t(), points[i].t()) << "point " << i;
+    }
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
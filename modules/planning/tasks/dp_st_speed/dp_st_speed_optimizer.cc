@@ -48,6 +48,10 @@ DpStSpeedOptimizer::DpStSpeedOptimizer()
 bool DpStSpeedOptimizer::Init(const PlanningConfig& config) {
   dp_st_speed_config_ = config.em_planner_config().dp_st_speed_config();
   st_boundary_config_ = dp_st_speed_config_.st_boundary_config();
+  if (FLAGS_enable_parallel_dp_st_graph) {
+    thread_pool_.reset(
+        new common::util::ThreadPool(FLAGS_dp_st_graph_threads));
+  }
   is_init_ = true;
   return true;
 }
@@ -103,7 +107,7 @@ Status DpStSpeedOptimizer::Process(const SLBoundary& adc_sl_boundary,
   StGraphData st_graph_data(boundaries, init_point, speed_limit, path_length);
 
   DpStGraph st_graph(reference_line, st_graph_data, dp_st_speed_config_,
-                     path_data, adc_sl_boundary);
+                     path_data, adc_sl_boundary, thread_pool_.get());
   auto* debug = reference_line_info_->mutable_debug();
   STGraphDebug* st_graph_debug = debug->mutable_planning_data()->add_st_graph();
 
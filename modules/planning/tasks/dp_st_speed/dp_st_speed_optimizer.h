@@ -21,11 +21,13 @@
 #ifndef MODULES_PLANNING_TASKS_DP_ST_SPEED_OPTIMIZER_H_
 #define MODULES_PLANNING_TASKS_DP_ST_SPEED_OPTIMIZER_H_
 
+#include <memory>
 #include <string>
 
 #include "modules/planning/proto/dp_st_speed_config.pb.h"
 #include "modules/planning/proto/st_boundary_config.pb.h"
 
+#include "modules/common/util/thread_pool.h"
 #include "modules/planning/tasks/speed_optimizer.h"
 #include "modules/planning/tasks/st_graph/st_boundary_mapper.h"
 
@@ -47,6 +49,7 @@ class DpStSpeedOptimizer : public SpeedOptimizer {
                                  SpeedData* const speed_data) override;
   DpStSpeedConfig dp_st_speed_config_;
   StBoundaryConfig st_boundary_config_;
+  std::unique_ptr<common::util::ThreadPool> thread_pool_;
 };
 
 }  // namespace planning
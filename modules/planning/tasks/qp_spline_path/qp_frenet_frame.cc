@@ -158,17 +158,14 @@ bool QpFrenetFrame::MapDynamicObstacleWithDecision(
     std::vector<common::math::Vec2d> corners;
     obs_box.GetAllCorners(&corners);
     std::vector<common::SLPoint> sl_corners;
-
-    for (const auto& corner_xy : corners) {
-      common::SLPoint cur_point;
-      if (!reference_line_.XYToSL(corner_xy, &cur_point)) {
-        AERROR << "Fail to map xy point " << corner_xy.DebugString() << " to "
-               << cur_point.ShortDebugString();
-        return false;
-      }
+    if (!reference_line_.XYToSL(corners, &sl_corners)) {
+      AERROR << "Fail to map box " << obs_box.DebugString()
+             << " to the reference line";
+      return false;
+    }
+    for (auto& cur_point : sl_corners) {
       // shift box base on buffer
       cur_point.set_l(cur_point.l() + nudge.distance_l());
-      sl_corners.push_back(std::move(cur_point));
     }
 
     for (uint32_t i = 0; i < sl_corners.size(); ++i) {
@@ -234,16 +231,14 @@ bool QpFrenetFrame::MapNudgePolygon(
     const common::math::Polygon2d& polygon, const ObjectNudge& nudge,
     std::vector<std::pair<double, double>>* const bound_map) {
   std::vector<common::SLPoint> sl_corners;
-  for (const auto& corner_xy : polygon.points()) {
-    common::SLPoint cur_point;
-    if (!reference_line_.XYToSL(corner_xy, &cur_point)) {
-      AERROR << "Fail to map xy point " << corner_xy.DebugString() << " to "
-             << cur_point.DebugString();
-      return false;
-    }
+  if (!reference_line_.XYToSL(polygon.points(), &sl_corners)) {
+    AERROR << "Fail to map polygon " << polygon.DebugString()
+           << " to the reference line";
+    return false;
+  }
+  for (auto& cur_point : sl_corners) {
     // shift box based on buffer
     cur_point.set_l(cur_point.l() + nudge.distance_l());
-    sl_corners.push_back(std::move(cur_point));
   }
 
   const auto corner_size = sl_corners.size();
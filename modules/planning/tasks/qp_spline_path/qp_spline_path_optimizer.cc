@@ -55,9 +55,17 @@ Status QpSplinePathOptimizer::Process(const SpeedData& speed_data,
                                        reference_line_info_->AdcSlBoundary());
   path_generator.SetDebugLogger(reference_line_info_->mutable_debug());
 
-  if (!path_generator.Generate(
-          reference_line_info_->path_decision()->path_obstacles().Items(),
-          speed_data, init_point, path_data)) {
+  const bool generated = path_generator.Generate(
+      reference_line_info_->path_decision()->path_obstacles().Items(),
+      speed_data, init_point, path_data);
+  if (FLAGS_enable_record_debug) {
+    auto* qp_solver_debug = reference_line_info_->mutable_debug()
+                                ->mutable_planning_data()
+                                ->add_qp_solver();
+    qp_solver_debug->set_name(Name());
+    spline_generator_->qp_solver_context().GetStats(qp_solver_debug);
+  }
+  if (!generated) {
     const std::string msg = "failed to generate spline path!";
     AERROR << msg;
     return Status(ErrorCode::PLANNING_ERROR, msg);
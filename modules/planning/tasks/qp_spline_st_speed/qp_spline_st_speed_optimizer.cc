@@ -125,19 +125,26 @@ Status QpSplineStSpeedOptimizer::Process(const SLBoundary& adc_sl_boundary,
     accel_bound.first = qp_st_speed_config_.min_deceleration();
     accel_bound.second = qp_st_speed_config_.max_acceleration();
     ret = st_graph.Search(st_graph_data, speed_data, accel_bound);
+  }
+  if (FLAGS_enable_record_debug) {
+    auto* qp_solver_debug = reference_line_info_->mutable_debug()
+                                ->mutable_planning_data()
+                                ->add_qp_solver();
+    qp_solver_debug->set_name(Name());
+    spline_generator_->qp_solver_context().GetStats(qp_solver_debug);
+  }
+
+  // backup plan: use piecewise_st_graph
+  if (ret != Status::OK()) {
+    QpPiecewiseStGraph piecewise_st_graph(qp_st_speed_config_);
+    ret = piecewise_st_graph.Search(st_graph_data, speed_data, accel_bound);
 
-    // backup plan: use piecewise_st_graph
     if (ret != Status::OK()) {
-      QpPiecewiseStGraph piecewise_st_graph(qp_st_speed_config_);
-      ret = piecewise_st_graph.Search(st_graph_data, speed_data, accel_bound);
-
-      if (ret != Status::OK()) {
-        std::string msg = common::util::StrCat(
-            Name(), ": Failed to search graph with quadratic programming!");
-        AERROR << msg;
-        RecordSTGraphDebug(st_graph_data, st_graph_debug);
-        return Status(ErrorCode::PLANNING_ERROR, msg);
-      }
+      std::string msg = common::util::StrCat(
+          Name(), ": Failed to search graph with quadratic programming!");
+      AERROR << msg;
+      RecordSTGraphDebug(st_graph_data, st_graph_debug);
+      return Status(ErrorCode::PLANNING_ERROR, msg);
     }
   }
 
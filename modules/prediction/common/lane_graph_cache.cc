@@ -0,0 +1,210 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_graph_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "modules/common/log.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_map.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::hdmap::HDMapUtil;
+using apollo::hdmap::LaneInfo;
+
+namespace {
+
+// Walks a lane sequence the way RoadGraph::ComputeLaneSequence() does for
+// start_s and length. Returns false if a lane before the last one would end
+// it, otherwise sets if the length ends it in the last lane, and the
+// accumulated s and the start s of the last lane.
+bool WalkLaneSequence(const LaneSequence& lane_sequence,
+                      const double last_lane_length, const double start_s,
+                      const double length, bool* ended_by_length,
+                      double* last_accumulated_s, double* last_start_s) {
+  const int num_lane_segments = lane_sequence.lane_segment_size();
+  double accumulated_s = 0.0;
+  double lane_start_s = start_s;
+  for (int i = 0; i + 1 < num_lane_segments; ++i) {
+    // the lanes before the last one are not ended, so they end at their
+    // total length.
+    const double total_length = lane_sequence.lane_segment(i).end_s();
+    if (accumulated_s + total_length - lane_start_s >= length) {
+      return false;
+    }
+    accumulated_s = accumulated_s + total_length - lane_start_s;
+    lane_start_s = 0.0;
+  }
+  *ended_by_length =
+      accumulated_s + last_lane_length - lane_start_s >= length;
+  *last_accumulated_s = accumulated_s;
+  *last_start_s = lane_start_s;
+  return true;
+}
+
+}  // namespace
+
+LaneGraphCache::LaneGraphCache()
+    : cache_(std::max(1, FLAGS_lane_graph_cache_capacity)),
+      num_hits_(0),
+      num_misses_(0) {}
+
+bool LaneGraphCache::GetLaneGraph(std::shared_ptr<const LaneInfo> lane_info_ptr,
+                                  const double start_s, const double length,
+                                  LaneGraph* const lane_graph_ptr) {
+  CHECK_NOTNULL(lane_info_ptr);
+  CHECK_NOTNULL(lane_graph_ptr);
+  const Key key = MakeKey(lane_info_ptr.get(), start_s, length);
+  const uint64_t map_version = HDMapUtil::BaseMapVersion();
+  std::shared_ptr<const CachedLaneGraph> cached_lane_graph;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (map_version != map_version_) {
+      ADEBUG << "Base map version " << map_version << " drops "
+             << cache_.size() << " lane graphs.";
+      cache_.Clear();
+      map_version_ = map_version;
+    }
+    std::shared_ptr<const CachedLaneGraph>* cached = cache_.Get(key);
+    if (cached != nullptr) {
+      cached_lane_graph = *cached;
+    }
+  }
+  if (cached_lane_graph == nullptr) {
+    ++num_misses_;
+    return false;
+  }
+
+  // the same lane sequences only if they end on the same lanes, in the same
+  // way.
+  const size_t num_lane_sequences = cached_lane_graph->lane_sequences.size();
+  bool ended_by_length = false;
+  double last_accumulated_s = 0.0;
+  double last_start_s = 0.0;
+  for (size_t i = 0; i < num_lane_sequences; ++i) {
+    if (!WalkLaneSequence(cached_lane_graph->lane_sequences[i],
+                          cached_lane_graph->last_lane_lengths[i], start_s,
+                          length, &ended_by_length, &last_accumulated_s,
+                          &last_start_s) ||
+        ended_by_length != cached_lane_graph->ended_by_length[i]) {
+      ++num_misses_;
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < num_lane_sequences; ++i) {
+    const LaneSequence& cached_lane_sequence =
+        cached_lane_graph->lane_sequences[i];
+    LaneSequence* lane_sequence = lane_graph_ptr->add_lane_sequence();
+    lane_sequence->CopyFrom(cached_lane_sequence);
+    lane_sequence->mutable_lane_segment(0)->set_start_s(start_s);
+    if (cached_lane_graph->ended_by_length[i]) {
+      WalkLaneSequence(cached_lane_sequence,
+                       cached_lane_graph->last_lane_lengths[i], start_s,
+                       length, &ended_by_length, &last_accumulated_s,
+                       &last_start_s);
+      const int last = lane_sequence->lane_segment_size() - 1;
+      lane_sequence->mutable_lane_segment(last)->set_end_s(
+          length - last_accumulated_s + last_start_s);
+    }
+  }
+  ++num_hits_;
+  return true;
+}
+
+void LaneGraphCache::PutLaneGraph(
+    std::shared_ptr<const LaneInfo> lane_info_ptr, const double start_s,
+    const double length, const LaneGraph& lane_graph,
+    const int first_lane_sequence) {
+  CHECK_NOTNULL(lane_info_ptr);
+  std::shared_ptr<CachedLaneGraph> cached_lane_graph(new CachedLaneGraph());
+  for (int i = first_lane_sequence; i < lane_graph.lane_sequence_size(); ++i) {
+    const LaneSequence& lane_sequence = lane_graph.lane_sequence(i);
+    if (lane_sequence.lane_segment_size() == 0) {
+      return;
+    }
+    const std::string& last_lane_id =
+        lane_sequence.lane_segment(lane_sequence.lane_segment_size() - 1)
+            .lane_id();
+    std::shared_ptr<const LaneInfo> last_lane =
+        PredictionMap::LaneById(last_lane_id);
+    if (last_lane == nullptr) {
+      return;
+    }
+    bool ended_by_length = false;
+    double last_accumulated_s = 0.0;
+    double last_start_s = 0.0;
+    if (!WalkLaneSequence(lane_sequence, last_lane->total_length(), start_s,
+                          length, &ended_by_length, &last_accumulated_s,
+                          &last_start_s)) {
+      return;
+    }
+    cached_lane_graph->lane_sequences.push_back(lane_sequence);
+    cached_lane_graph->last_lane_lengths.push_back(last_lane->total_length());
+    cached_lane_graph->ended_by_length.push_back(ended_by_length);
+  }
+
+  const Key key = MakeKey(lane_info_ptr.get(), start_s, length);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (HDMapUtil::BaseMapVersion() == map_version_) {
+    cache_.Put(key, std::shared_ptr<const CachedLaneGraph>(cached_lane_graph));
+  }
+}
+
+void LaneGraphCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.Clear();
+  num_hits_ = 0;
+  num_misses_ = 0;
+}
+
+double LaneGraphCache::HitRate() const {
+  const uint64_t num_hits = num_hits_;
+  const uint64_t num_lookups = num_hits + num_misses_;
+  if (num_lookups == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(num_hits) / static_cast<double>(num_lookups);
+}
+
+size_t LaneGraphCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = std::hash<const LaneInfo*>()(key.lane_info);
+  hash = hash * 31 + std::hash<int64_t>()(key.s_bucket);
+  return hash * 31 + std::hash<int64_t>()(key.length_bucket);
+}
+
+LaneGraphCache::Key LaneGraphCache::MakeKey(const LaneInfo* lane_info,
+                                            const double start_s,
+                                            const double length) {
+  CHECK_GT(FLAGS_lane_graph_cache_s_resolution, 0.0);
+  CHECK_GT(FLAGS_lane_graph_cache_length_resolution, 0.0);
+  Key key;
+  key.lane_info = lane_info;
+  key.s_bucket = static_cast<int64_t>(
+      std::floor(start_s / FLAGS_lane_graph_cache_s_resolution));
+  key.length_bucket = static_cast<int64_t>(
+      std::floor(length / FLAGS_lane_graph_cache_length_resolution));
+  return key;
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A cache of the lane graphs built by the road graphs.
+ */
+
+#ifndef MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
+#define MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "modules/prediction/proto/lane_graph.pb.h"
+
+#include "modules/common/macro.h"
+#include "modules/common/util/lru_cache.h"
+#include "modules/map/hdmap/hdmap_common.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class LaneGraphCache
+ * @brief Caches the lane graphs by their starting lane and the buckets of
+ * their start s and length.
+ *
+ * \par
+ * A cached lane graph is only used for a start s and a length which end the
+ * same lane sequences on the same lanes, and its start s and end s are then
+ * computed again, so a lane graph from the cache is the same as the one built
+ * from the map. The cache is bounded, thread safe, and dropped when the base
+ * map is reloaded.
+ */
+class LaneGraphCache {
+ public:
+  /**
+   * @brief Get a lane graph from the cache.
+   * @param The starting lane.
+   * @param The starting longitudinal s value.
+   * @param The length of the lane graph.
+   * @param The lane graph to add the lane sequences to.
+   * @return If the lane graph is found.
+   */
+  bool GetLaneGraph(std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr,
+                    const double start_s, const double length,
+                    LaneGraph* const lane_graph_ptr);
+
+  /**
+   * @brief Put a lane graph built from the map in the cache.
+   * @param The starting lane.
+   * @param The starting longitudinal s value.
+   * @param The length of the lane graph.
+   * @param The lane graph.
+   * @param The index of the first lane sequence of the lane graph to put.
+   */
+  void PutLaneGraph(std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr,
+                    const double start_s, const double length,
+                    const LaneGraph& lane_graph,
+                    const int first_lane_sequence);
+
+  /**
+   * @brief Drop the cached lane graphs and reset the counters.
+   */
+  void Clear();
+
+  uint64_t num_hits() const { return num_hits_; }
+
+  uint64_t num_misses() const { return num_misses_; }
+
+  /**
+   * @brief Get the ratio of the lookups found in the cache.
+   * @return The hit rate, 0 without lookups.
+   */
+  double HitRate() const;
+
+ private:
+  // the starting lane of the base map, and the buckets of start s and
+  // length.
+  struct Key {
+    const hdmap::LaneInfo* lane_info;
+    int64_t s_bucket;
+    int64_t length_bucket;
+
+    bool operator==(const Key& other) const {
+      return lane_info == other.lane_info && s_bucket == other.s_bucket &&
+             length_bucket == other.length_bucket;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct CachedLaneGraph {
+    std::vector<LaneSequence> lane_sequences;
+    // for each lane sequence, the total length of its last lane, and if the
+    // length of the lane graph, rather than the end of the lanes, ends it.
+    std::vector<double> last_lane_lengths;
+    std::vector<bool> ended_by_length;
+  };
+
+  static Key MakeKey(const hdmap::LaneInfo* lane_info, const double start_s,
+                     const double length);
+
+  std::mutex mutex_;
+  common::util::LRUCache<Key, std::shared_ptr<const CachedLaneGraph>, KeyHash>
+      cache_;
+  uint64_t map_version_ = 0;
+
+  std::atomic<uint64_t> num_hits_;
+  std::atomic<uint64_t> num_misses_;
+
+  DECLARE_SINGLETON(LaneGraphCache);
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
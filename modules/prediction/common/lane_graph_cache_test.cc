@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_graph_cache.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "modules/prediction/proto/lane_graph.pb.h"
+
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_map.h"
+#include "modules/prediction/common/road_graph.h"
+
+namespace apollo {
+namespace prediction {
+
+class LaneGraphCacheTest : public KMLMapBasedTest {
+ public:
+  virtual void SetUp() {
+    map_ = PredictionMap::instance();
+    cache_ = LaneGraphCache::instance();
+    cache_->Clear();
+  }
+
+  virtual void TearDown() { FLAGS_enable_lane_graph_cache = true; }
+
+ protected:
+  std::string BuildLaneGraph(const std::string &lane_id, const double start_s,
+                             const double length, const bool enable_cache) {
+    FLAGS_enable_lane_graph_cache = enable_cache;
+    RoadGraph road_graph(start_s, length, map_->LaneById(lane_id));
+    LaneGraph lane_graph;
+    EXPECT_TRUE(road_graph.BuildLaneGraph(&lane_graph).ok());
+    return lane_graph.SerializeAsString();
+  }
+
+  PredictionMap *map_;
+  LaneGraphCache *cache_;
+};
+
+TEST_F(LaneGraphCacheTest, SameLaneGraph) {
+  for (const std::string lane_id : {"l9", "l20", "l22"}) {
+    for (double start_s = -10.0; start_s < 250.0; start_s += 3.7) {
+      for (double length = 0.0; length < 250.0; length += 4.3) {
+        EXPECT_EQ(BuildLaneGraph(lane_id, start_s, length, false),
+                  BuildLaneGraph(lane_id, start_s, length, true))
+            << lane_id << " " << start_s << " " << length;
+      }
+    }
+  }
+  EXPECT_GT(cache_->num_hits(), 0u);
+  EXPECT_GT(cache_->num_misses(), 0u);
+}
+
+TEST_F(LaneGraphCacheTest, HitRate) {
+  EXPECT_DOUBLE_EQ(0.0, cache_->HitRate());
+  BuildLaneGraph("l20", 200.0, 200.0, true);
+  EXPECT_EQ(0u, cache_->num_hits());
+  EXPECT_EQ(1u, cache_->num_misses());
+
+  // the same buckets.
+  BuildLaneGraph("l20", 200.5, 201.0, true);
+  EXPECT_EQ(1u, cache_->num_hits());
+  EXPECT_EQ(1u, cache_->num_misses());
+  EXPECT_DOUBLE_EQ(0.5, cache_->HitRate());
+
+  // another start s bucket.
+  BuildLaneGraph("l20", 210.0, 200.0, true);
+  EXPECT_EQ(2u, cache_->num_misses());
+
+  // without the cache.
+  BuildLaneGraph("l20", 200.0, 200.0, false);
+  EXPECT_EQ(3u, cache_->num_hits() + cache_->num_misses());
+}
+
+TEST_F(LaneGraphCacheTest, AppendToLaneGraph) {
+  for (const bool enable_cache : {false, true, true}) {
+    FLAGS_enable_lane_graph_cache = enable_cache;
+    LaneGraph lane_graph;
+    RoadGraph road_graph_l9(99.0, 100.0, map_->LaneById("l9"));
+    EXPECT_TRUE(road_graph_l9.BuildLaneGraph(&lane_graph).ok());
+    RoadGraph road_graph_l20(200.0, 200.0, map_->LaneById("l20"));
+    EXPECT_TRUE(road_graph_l20.BuildLaneGraph(&lane_graph).ok());
+    ASSERT_EQ(3, lane_graph.lane_sequence_size());
+    EXPECT_EQ("l9", lane_graph.lane_sequence(0).lane_segment(0).lane_id());
+    EXPECT_EQ("l20", lane_graph.lane_sequence(1).lane_segment(0).lane_id());
+    EXPECT_EQ("l20", lane_graph.lane_sequence(2).lane_segment(0).lane_id());
+  }
+  EXPECT_EQ(2u, cache_->num_hits());
+}
+
+TEST_F(LaneGraphCacheTest, ReloadBaseMap) {
+  BuildLaneGraph("l9", 99.0, 100.0, true);
+  BuildLaneGraph("l9", 99.0, 100.0, true);
+  EXPECT_EQ(1u, cache_->num_hits());
+
+  EXPECT_TRUE(hdmap::HDMapUtil::ReloadBaseMap());
+  const std::string lane_graph = BuildLaneGraph("l9", 99.0, 100.0, true);
+  EXPECT_EQ(1u, cache_->num_hits());
+  EXPECT_EQ(2u, cache_->num_misses());
+  EXPECT_EQ(BuildLaneGraph("l9", 99.0, 100.0, false), lane_graph);
+}
+
+}  // namespace prediction
+}  // namespace apollo
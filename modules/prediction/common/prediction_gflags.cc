@@ -34,12 +34,26 @@ DEFINE_double(double_precision, 1e-6, "precision of double");
 DEFINE_double(min_prediction_length, 5.0,
               "Minimal length of prediction trajectory");
 
+DEFINE_bool(enable_parallel_prediction, false,
+            "Update, evaluate and predict the obstacles in parallel.");
+DEFINE_int32(prediction_threads, 2,
+             "Number of worker threads, besides the callback thread, used "
+             "to process the obstacles in parallel.");
+
 // Bag replay timestamp gap
 DEFINE_double(replay_timestamp_gap, 10.0,
               "Max timestamp gap for rosbag replay");
 
 // Map
 DEFINE_double(search_radius, 3.0, "Search radius for a candidate lane");
+DEFINE_bool(enable_lane_graph_cache, true,
+            "Reuse the lane graphs of the same lanes from a cache.");
+DEFINE_int32(lane_graph_cache_capacity, 1000,
+             "Max number of lane graphs in the lane graph cache.");
+DEFINE_double(lane_graph_cache_s_resolution, 5.0,
+              "Start s bucket size of the lane graph cache.");
+DEFINE_double(lane_graph_cache_length_resolution, 10.0,
+              "Length bucket size of the lane graph cache.");
 
 // Obstacle features
 DEFINE_bool(enable_kf_tracking, false, "Use measurements with KF tracking");
@@ -29,12 +29,18 @@ DECLARE_double(prediction_duration);
 DECLARE_double(prediction_freq);
 DECLARE_double(double_precision);
 DECLARE_double(min_prediction_length);
+DECLARE_bool(enable_parallel_prediction);
+DECLARE_int32(prediction_threads);
 
 // Bag replay timestamp gap
 DECLARE_double(replay_timestamp_gap);
 
 // Map
 DECLARE_double(search_radius);
+DECLARE_bool(enable_lane_graph_cache);
+DECLARE_int32(lane_graph_cache_capacity);
+DECLARE_double(lane_graph_cache_s_resolution);
+DECLARE_double(lane_graph_cache_length_resolution);
 
 // Obstacle features
 DECLARE_bool(enable_kf_tracking);
@@ -20,6 +20,8 @@
 #include <utility>
 
 #include "modules/common/util/string_util.h"
+#include "modules/prediction/common/lane_graph_cache.h"
+#include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_map.h"
 
 namespace apollo {
@@ -48,10 +50,22 @@ Status RoadGraph::BuildLaneGraph(LaneGraph* const lane_graph_ptr) {
     return Status(ErrorCode::PREDICTION_ERROR, error_msg);
   }
 
+  LaneGraphCache* cache = LaneGraphCache::instance();
+  if (FLAGS_enable_lane_graph_cache &&
+      cache->GetLaneGraph(lane_info_ptr_, start_s_, length_, lane_graph_ptr)) {
+    return Status::OK();
+  }
+
+  const int first_lane_sequence = lane_graph_ptr->lane_sequence_size();
   std::vector<LaneSegment> lane_segments;
   double accumulated_s = 0.0;
-  ComputeLaneSequence(accumulated_s, start_s_, lane_info_ptr_, &lane_segments,
-                      lane_graph_ptr);
+  const bool found_all_lanes =
+      ComputeLaneSequence(accumulated_s, start_s_, lane_info_ptr_,
+                          &lane_segments, lane_graph_ptr);
+  if (FLAGS_enable_lane_graph_cache && found_all_lanes) {
+    cache->PutLaneGraph(lane_info_ptr_, start_s_, length_, *lane_graph_ptr,
+                        first_lane_sequence);
+  }
 
   return Status::OK();
 }
@@ -74,14 +88,14 @@ bool RoadGraph::IsOnLaneGraph(std::shared_ptr<const LaneInfo> lane_info_ptr,
   return false;
 }
 
-void RoadGraph::ComputeLaneSequence(
+bool RoadGraph::ComputeLaneSequence(
     const double accumulated_s, const double start_s,
     std::shared_ptr<const LaneInfo> lane_info_ptr,
     std::vector<LaneSegment>* const lane_segments,
     LaneGraph* const lane_graph_ptr) const {
   if (lane_info_ptr == nullptr) {
     AERROR << "Invalid lane.";
-    return;
+    return false;
   }
   PredictionMap* map = PredictionMap::instance();
 
@@ -97,6 +111,7 @@ void RoadGraph::ComputeLaneSequence(
 
   lane_segments->push_back(std::move(lane_segment));
 
+  bool found_all_lanes = true;
   if (accumulated_s + lane_info_ptr->total_length() - start_s >= length_ ||
       lane_info_ptr->lane().successor_id_size() == 0) {
     LaneSequence* sequence = lane_graph_ptr->add_lane_sequence();
@@ -108,11 +123,13 @@ void RoadGraph::ComputeLaneSequence(
         accumulated_s + lane_info_ptr->total_length() - start_s;
     for (const auto& successor_lane_id : lane_info_ptr->lane().successor_id()) {
       auto successor_lane = map->LaneById(successor_lane_id.id());
-      ComputeLaneSequence(successor_accumulated_s, 0.0, successor_lane,
-                          lane_segments, lane_graph_ptr);
+      found_all_lanes &=
+          ComputeLaneSequence(successor_accumulated_s, 0.0, successor_lane,
+                              lane_segments, lane_graph_ptr);
     }
   }
   lane_segments->pop_back();
+  return found_all_lanes;
 }
 
 }  // namespace prediction
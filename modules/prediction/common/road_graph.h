@@ -40,8 +40,9 @@ class RoadGraph {
             std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr);
 
   /**
-   * @brief Build the lane graph.
-   * @param The built lane graph.
+   * @brief Build the lane graph, from the lane graph cache if
+   *        --enable_lane_graph_cache.
+   * @param The lane graph to add the lane sequences to.
    * @return The status of the road graph building.
    */
   common::Status BuildLaneGraph(LaneGraph* const lane_graph);
@@ -57,7 +58,8 @@ class RoadGraph {
                      const LaneGraph& lane_graph);
 
  private:
-  void ComputeLaneSequence(const double accumulated_s, const double start_s,
+  // Returns false if a lane is not found in the map.
+  bool ComputeLaneSequence(const double accumulated_s, const double start_s,
                            std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr,
                            std::vector<LaneSegment>* const lane_segments,
                            LaneGraph* const lane_graph_ptr) const;
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the lane graphs of the obstacles of a frame, with and
+ * without the lane graph cache.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/prediction/proto/lane_graph.pb.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/util/string_util.h"
+#include "modules/prediction/common/lane_graph_cache.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_map.h"
+#include "modules/prediction/common/road_graph.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+struct LaneGraphQuery {
+  std::shared_ptr<const hdmap::LaneInfo> lane_info;
+  double start_s;
+  double length;
+};
+
+// The obstacles of a frame: kNumObstacles per lane, 8 m apart, at speeds
+// from 0 to 14 m/s, moved by their speed for `num_frames` frames of 0.1 s.
+std::vector<LaneGraphQuery> Frame(const int num_frames) {
+  constexpr int kNumObstacles = 15;
+  std::vector<LaneGraphQuery> queries;
+  for (const std::string lane_id : {"l9", "l20", "l22", "l31", "l98"}) {
+    auto lane_info = PredictionMap::LaneById(lane_id);
+    CHECK_NOTNULL(lane_info);
+    for (int i = 0; i < kNumObstacles; ++i) {
+      const double speed = i;
+      LaneGraphQuery query;
+      query.lane_info = lane_info;
+      query.start_s = i * 8.0 + speed * num_frames * 0.1;
+      query.length = speed * FLAGS_prediction_duration +
+                     FLAGS_min_prediction_length;
+      queries.push_back(query);
+    }
+  }
+  return queries;
+}
+
+}  // namespace
+
+// Arg: whether to use the lane graph cache.
+void BM_BuildLaneGraphs(benchmark::State& state) {
+  FLAGS_map_dir = "modules/prediction/testdata";
+  FLAGS_base_map_filename = "kml_map.bin";
+  FLAGS_enable_lane_graph_cache = state.range(0) != 0;
+
+  constexpr int kNumFrames = 100;
+  std::vector<std::vector<LaneGraphQuery>> frames;
+  for (int i = 0; i < kNumFrames; ++i) {
+    frames.push_back(Frame(i));
+  }
+  int frame_index = 0;
+  while (state.KeepRunning()) {
+    if (frame_index == 0) {
+      // the obstacles are only seen once at each place.
+      state.PauseTiming();
+      LaneGraphCache::instance()->Clear();
+      state.ResumeTiming();
+    }
+    for (const LaneGraphQuery& query : frames[frame_index]) {
+      RoadGraph road_graph(query.start_s, query.length, query.lane_info);
+      LaneGraph lane_graph;
+      road_graph.BuildLaneGraph(&lane_graph);
+      benchmark::DoNotOptimize(lane_graph);
+    }
+    frame_index = (frame_index + 1) % kNumFrames;
+  }
+  state.SetItemsProcessed(state.iterations() * frames[0].size());
+  if (FLAGS_enable_lane_graph_cache) {
+    state.SetLabel(common::util::StrCat(
+        "hit rate ", LaneGraphCache::instance()->HitRate()));
+  }
+  FLAGS_enable_lane_graph_cache = true;
+}
+BENCHMARK(BM_BuildLaneGraphs)->Arg(0)->Arg(1);
+
+}  // namespace prediction
+}  // namespace apollo
+
+BENCHMARK_MAIN();
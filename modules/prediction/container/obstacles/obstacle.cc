@@ -39,25 +39,43 @@ using apollo::common::ErrorCode;
 using apollo::common::Point3D;
 using apollo::hdmap::LaneInfo;
 
-std::mutex Obstacle::mutex_;
-
 namespace {
 
 double Damp(const double x, const double sigma) {
   return 1 / (1 + exp(1 / (std::fabs(x) + sigma)));
 }
 
+// The number of features in the history at the prediction frequency.
+size_t HistoryCapacity() {
+  if (FLAGS_prediction_freq <= 0.0) {
+    return 1;
+  }
+  return static_cast<size_t>(
+             std::ceil(FLAGS_max_history_time / FLAGS_prediction_freq)) +
+         1;
+}
+
 }  // namespace
 
+Obstacle::Obstacle() : feature_history_(HistoryCapacity()) {}
+
+void Obstacle::Clear() {
+  id_ = -1;
+  type_ = PerceptionObstacle::UNKNOWN_UNMOVABLE;
+  feature_history_.Clear();
+  kf_motion_tracker_ = KalmanFilter<double, 6, 2, 0>();
+  kf_pedestrian_tracker_ = KalmanFilter<double, 2, 2, 4>();
+  kf_motion_tracker_enabled_ = false;
+  kf_pedestrian_tracker_enabled_ = false;
+  kf_lane_trackers_.clear();
+  current_lanes_.clear();
+}
+
 PerceptionObstacle::Type Obstacle::type() const { return type_; }
 
-int Obstacle::id() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return id_;
-}
+int Obstacle::id() const { return id_; }
 
 double Obstacle::timestamp() const {
-  std::lock_guard<std::mutex> lock(mutex_);
   if (feature_history_.size() > 0) {
     return feature_history_.front().timestamp();
   } else {
@@ -66,54 +84,42 @@ double Obstacle::timestamp() const {
 }
 
 const Feature& Obstacle::feature(size_t i) const {
-  std::lock_guard<std::mutex> lock(mutex_);
   CHECK(i < feature_history_.size());
   return feature_history_[i];
 }
 
 Feature* Obstacle::mutable_feature(size_t i) {
-  std::lock_guard<std::mutex> lock(mutex_);
   CHECK(i < feature_history_.size());
   return &feature_history_[i];
 }
 
 const Feature& Obstacle::latest_feature() const {
-  std::lock_guard<std::mutex> lock(mutex_);
   CHECK_GT(feature_history_.size(), 0);
   return feature_history_.front();
 }
 
 Feature* Obstacle::mutable_latest_feature() {
-  std::lock_guard<std::mutex> lock(mutex_);
-
   CHECK_GT(feature_history_.size(), 0);
   return &(feature_history_.front());
 }
 
-size_t Obstacle::history_size() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return feature_history_.size();
-}
+size_t Obstacle::history_size() const { return feature_history_.size(); }
 
 const KalmanFilter<double, 4, 2, 0>& Obstacle::kf_lane_tracker(
     const std::string& lane_id) {
-  std::lock_guard<std::mutex> lock(mutex_);
   CHECK(kf_lane_trackers_.find(lane_id) != kf_lane_trackers_.end());
   return kf_lane_trackers_[lane_id];
 }
 
 const KalmanFilter<double, 6, 2, 0>& Obstacle::kf_motion_tracker() const {
-  std::lock_guard<std::mutex> lock(mutex_);
   return kf_motion_tracker_;
 }
 
 const KalmanFilter<double, 2, 2, 4>& Obstacle::kf_pedestrian_tracker() const {
-  std::lock_guard<std::mutex> lock(mutex_);
   return kf_pedestrian_tracker_;
 }
 
 bool Obstacle::IsOnLane() {
-  std::lock_guard<std::mutex> lock(mutex_);
   if (feature_history_.size() > 0) {
     if (feature_history_.front().has_lane() &&
         feature_history_.front().lane().has_lane_feature()) {
@@ -127,7 +133,6 @@ bool Obstacle::IsOnLane() {
 
 void Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
                       const double timestamp) {
-  std::lock_guard<std::mutex> lock(mutex_);
   if (feature_history_.size() > 0 &&
       timestamp <= feature_history_.front().timestamp()) {
     AERROR << "Obstacle [" << id_ << "] received an older frame ["
@@ -137,33 +142,36 @@ void Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
     return;
   }
 
-  Feature feature;
-  if (SetId(perception_obstacle, &feature) == ErrorCode::PREDICTION_ERROR) {
+  // the feature is built in place in the history, and reuses the memory of
+  // a trimmed one.
+  Feature* feature = feature_history_.NextFront();
+  feature->Clear();
+  if (SetId(perception_obstacle, feature) == ErrorCode::PREDICTION_ERROR) {
     return;
   }
   if (SetType(perception_obstacle) == ErrorCode::PREDICTION_ERROR) {
     return;
   }
-  SetTimestamp(perception_obstacle, timestamp, &feature);
-  SetPosition(perception_obstacle, &feature);
-  SetVelocity(perception_obstacle, &feature);
-  SetAcceleration(&feature);
-  SetTheta(perception_obstacle, &feature);
+  SetTimestamp(perception_obstacle, timestamp, feature);
+  SetPosition(perception_obstacle, feature);
+  SetVelocity(perception_obstacle, feature);
+  SetAcceleration(feature);
+  SetTheta(perception_obstacle, feature);
   if (!kf_motion_tracker_enabled_) {
-    InitKFMotionTracker(&feature);
+    InitKFMotionTracker(feature);
   }
-  UpdateKFMotionTracker(&feature);
-  SetCurrentLanes(&feature);
-  SetNearbyLanes(&feature);
-  SetLaneGraphFeature(&feature);
-  UpdateKFLaneTrackers(&feature);
+  UpdateKFMotionTracker(feature);
+  SetCurrentLanes(feature);
+  SetNearbyLanes(feature);
+  SetLaneGraphFeature(feature);
+  UpdateKFLaneTrackers(feature);
   if (type_ == PerceptionObstacle::PEDESTRIAN) {
     if (!kf_pedestrian_tracker_enabled_) {
-      InitKFPedestrianTracker(&feature);
+      InitKFPedestrianTracker(feature);
     }
-    UpdateKFPedestrianTracker(&feature);
+    UpdateKFPedestrianTracker(feature);
   }
-  InsertFeatureToHistory(&feature);
+  InsertFeatureToHistory(feature);
   SetMotionStatus();
   Trim();
 }
@@ -854,33 +862,29 @@ void Obstacle::SetLaneGraphFeature(Feature* feature) {
       speed * FLAGS_prediction_duration +
       0.5 * acc * FLAGS_prediction_duration * FLAGS_prediction_duration +
       FLAGS_min_prediction_length;
-  for (auto& lane : feature->lane().current_lane_feature()) {
-    std::shared_ptr<const LaneInfo> lane_info = map->LaneById(lane.lane_id());
-    RoadGraph road_graph(lane.lane_s(), road_graph_distance, lane_info);
-    LaneGraph lane_graph;
-    road_graph.BuildLaneGraph(&lane_graph);
-    for (const auto& lane_seq : lane_graph.lane_sequence()) {
-      feature->mutable_lane()
-          ->mutable_lane_graph()
-          ->add_lane_sequence()
-          ->CopyFrom(lane_seq);
-      ADEBUG << "Obstacle [" << id_ << "] set a lane sequence ["
-             << lane_seq.ShortDebugString() << "].";
+  if (feature->has_lane()) {
+    // the road graphs add their lane sequences to the lane graph of the
+    // feature.
+    LaneGraph* lane_graph = feature->mutable_lane()->mutable_lane_graph();
+    for (auto& lane : feature->lane().current_lane_feature()) {
+      std::shared_ptr<const LaneInfo> lane_info =
+          map->LaneById(lane.lane_id());
+      RoadGraph road_graph(lane.lane_s(), road_graph_distance, lane_info);
+      road_graph.BuildLaneGraph(lane_graph);
     }
-  }
-  for (auto& lane : feature->lane().nearby_lane_feature()) {
-    std::shared_ptr<const LaneInfo> lane_info = map->LaneById(lane.lane_id());
-    RoadGraph road_graph(lane.lane_s(), road_graph_distance, lane_info);
-    LaneGraph lane_graph;
-    road_graph.BuildLaneGraph(&lane_graph);
-    for (const auto& lane_seq : lane_graph.lane_sequence()) {
-      feature->mutable_lane()
-          ->mutable_lane_graph()
-          ->add_lane_sequence()
-          ->CopyFrom(lane_seq);
+    for (auto& lane : feature->lane().nearby_lane_feature()) {
+      std::shared_ptr<const LaneInfo> lane_info =
+          map->LaneById(lane.lane_id());
+      RoadGraph road_graph(lane.lane_s(), road_graph_distance, lane_info);
+      road_graph.BuildLaneGraph(lane_graph);
+    }
+    for (const auto& lane_seq : lane_graph->lane_sequence()) {
       ADEBUG << "Obstacle [" << id_ << "] set a lane sequence ["
              << lane_seq.ShortDebugString() << "].";
     }
+    if (lane_graph->lane_sequence_size() == 0) {
+      feature->mutable_lane()->clear_lane_graph();
+    }
   }
 
   if (feature->has_lane() && feature->lane().has_lane_graph()) {
@@ -977,24 +981,23 @@ void Obstacle::SetMotionStatus() {
   int len = std::min(history_size, FLAGS_still_obstacle_history_length);
   CHECK_GT(len, 1);
 
-  auto feature_riter = feature_history_.rbegin();
+  const Feature& start_feature = feature_history_.back();
   if (FLAGS_enable_kf_tracking) {
-    start_x = feature_riter->t_position().x();
-    start_y = feature_riter->t_position().y();
+    start_x = start_feature.t_position().x();
+    start_y = start_feature.t_position().y();
   } else {
-    start_x = feature_riter->position().x();
-    start_y = feature_riter->position().y();
+    start_x = start_feature.position().x();
+    start_y = start_feature.position().y();
   }
-  ++feature_riter;
-  while (feature_riter != feature_history_.rend()) {
+  for (int i = history_size - 2; i >= 0; --i) {
+    const Feature& feature = feature_history_[i];
     if (FLAGS_enable_kf_tracking) {
-      avg_drift_x += (feature_riter->t_position().x() - start_x) / (len - 1);
-      avg_drift_y += (feature_riter->t_position().y() - start_y) / (len - 1);
+      avg_drift_x += (feature.t_position().x() - start_x) / (len - 1);
+      avg_drift_y += (feature.t_position().y() - start_y) / (len - 1);
     } else {
-      avg_drift_x += (feature_riter->position().x() - start_x) / (len - 1);
-      avg_drift_y += (feature_riter->position().y() - start_y) / (len - 1);
+      avg_drift_x += (feature.position().x() - start_x) / (len - 1);
+      avg_drift_y += (feature.position().y() - start_y) / (len - 1);
     }
-    ++feature_riter;
   }
 
   double delta_ts = feature_history_.front().timestamp() -
@@ -1024,7 +1027,8 @@ void Obstacle::SetMotionStatus() {
 }
 
 void Obstacle::InsertFeatureToHistory(Feature* feature) {
-  feature_history_.push_front(std::move(*feature));
+  CHECK_EQ(feature, feature_history_.NextFront());
+  feature_history_.PushFront();
   ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
 }
 
@@ -1037,7 +1041,7 @@ void Obstacle::Trim() {
   while (!feature_history_.empty() &&
          latest_ts - feature_history_.back().timestamp() >=
              FLAGS_max_history_time) {
-    feature_history_.pop_back();
+    feature_history_.PopBack();
     ++count;
   }
   if (count > 0) {
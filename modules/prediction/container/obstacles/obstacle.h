@@ -22,9 +22,7 @@
 #ifndef MODULES_PREDICTION_CONTAINER_OBSTACLES_OBSTACLE_H_
 #define MODULES_PREDICTION_CONTAINER_OBSTACLES_OBSTACLE_H_
 
-#include <deque>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -34,6 +32,7 @@
 #include "modules/prediction/proto/feature.pb.h"
 
 #include "modules/common/math/kalman_filter.h"
+#include "modules/common/util/ring_buffer.h"
 #include "modules/map/hdmap/hdmap_common.h"
 
 /**
@@ -45,20 +44,33 @@ namespace prediction {
 
 /**
  * @class Obstacle
- * @brief Prediction obstacle.
+ * @brief Prediction obstacle. An obstacle only holds its own history and
+ *        trackers, so different obstacles can be updated, evaluated and
+ *        predicted in different threads; a single obstacle is not thread safe.
  */
 class Obstacle {
  public:
   /**
    * @brief Constructor
    */
-  Obstacle() = default;
+  Obstacle();
+
+  Obstacle(const Obstacle&) = default;
+  Obstacle& operator=(const Obstacle&) = default;
+  Obstacle(Obstacle&&) = default;
+  Obstacle& operator=(Obstacle&&) = default;
 
   /**
    * @brief Destructor
    */
   virtual ~Obstacle() = default;
 
+  /**
+   * @brief Clear the obstacle to be reused for another one. The features of
+   *        the history are kept to be reused by the next insertions.
+   */
+  void Clear();
+
   /**
    * @brief Insert a perception obstacle with its timestamp.
    * @param perception_obstacle The obstacle from perception.
@@ -209,7 +221,8 @@ class Obstacle {
   int id_ = -1;
   perception::PerceptionObstacle::Type type_ =
       perception::PerceptionObstacle::UNKNOWN_UNMOVABLE;
-  std::deque<Feature> feature_history_;
+  // the features from latest to earliest.
+  common::util::RingBuffer<Feature> feature_history_;
   common::math::KalmanFilter<double, 6, 2, 0> kf_motion_tracker_;
   common::math::KalmanFilter<double, 2, 2, 4> kf_pedestrian_tracker_;
   bool kf_motion_tracker_enabled_ = false;
@@ -217,7 +230,6 @@ class Obstacle {
   std::unordered_map<std::string, common::math::KalmanFilter<double, 4, 2, 0>>
       kf_lane_trackers_;
   std::vector<std::shared_ptr<const hdmap::LaneInfo>> current_lanes_;
-  static std::mutex mutex_;
 };
 
 }  // namespace prediction
@@ -16,7 +16,9 @@
 
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "modules/common/math/math_utils.h"
 #include "modules/prediction/common/prediction_gflags.h"
@@ -27,8 +29,6 @@ namespace prediction {
 using apollo::perception::PerceptionObstacle;
 using apollo::perception::PerceptionObstacles;
 
-std::mutex ObstaclesContainer::g_mutex_;
-
 ObstaclesContainer::ObstaclesContainer()
     : obstacles_(FLAGS_max_num_obstacles) {}
 
@@ -36,6 +36,7 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
   ADEBUG << "message: " << message.ShortDebugString();
   const PerceptionObstacles& perception_obstacles =
       dynamic_cast<const PerceptionObstacles&>(message);
+  std::lock_guard<std::mutex> lock(mutex_);
   double timestamp = 0.0;
   if (perception_obstacles.has_header() &&
       perception_obstacles.header().has_timestamp_sec()) {
@@ -52,13 +53,42 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
 
   timestamp_ = timestamp;
   ADEBUG << "Current timestamp is [" << timestamp_ << "]";
+
+  // The cache is only modified here, before the obstacles are updated.
+  std::vector<const PerceptionObstacle*> predictable_obstacles;
   for (const PerceptionObstacle& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
            << "was detected";
-    InsertPerceptionObstacle(perception_obstacle, timestamp_);
-    ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
+    if (GetOrCreateObstacle(perception_obstacle) != nullptr) {
+      predictable_obstacles.push_back(&perception_obstacle);
+    }
+  }
+
+  // An obstacle created later in the message may have evicted an earlier one,
+  // which is then skipped. A repeated ID is updated after the first one.
+  std::vector<std::pair<const PerceptionObstacle*, Obstacle*>> updates;
+  std::vector<std::pair<const PerceptionObstacle*, Obstacle*>> repeated_updates;
+  std::unordered_set<int> ids;
+  for (const PerceptionObstacle* perception_obstacle : predictable_obstacles) {
+    const int id = perception_obstacle->id();
+    Obstacle* obstacle_ptr = obstacles_.GetSilently(id);
+    if (obstacle_ptr == nullptr) {
+      continue;
+    }
+    if (ids.insert(id).second) {
+      updates.emplace_back(perception_obstacle, obstacle_ptr);
+    } else {
+      repeated_updates.emplace_back(perception_obstacle, obstacle_ptr);
+    }
+  }
+  common::util::ParallelFor(thread_pool_, 0, updates.size(), [&](size_t i) {
+    updates[i].second->Insert(*updates[i].first, timestamp_);
+    ADEBUG << "Perception obstacle [" << updates[i].first->id() << "] "
            << "was inserted";
+  });
+  for (const auto& update : repeated_updates) {
+    update.second->Insert(*update.first, timestamp_);
   }
 }
 
@@ -67,30 +97,49 @@ Obstacle* ObstaclesContainer::GetObstacle(const int id) {
 }
 
 void ObstaclesContainer::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
   obstacles_.Clear();
   timestamp_ = -1.0;
 }
 
+void ObstaclesContainer::SetThreadPool(common::util::ThreadPool* thread_pool) {
+  thread_pool_ = thread_pool;
+}
+
 void ObstaclesContainer::InsertPerceptionObstacle(
     const PerceptionObstacle& perception_obstacle, const double timestamp) {
-  std::lock_guard<std::mutex> lock(g_mutex_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  Obstacle* obstacle_ptr = GetOrCreateObstacle(perception_obstacle);
+  if (obstacle_ptr != nullptr) {
+    obstacle_ptr->Insert(perception_obstacle, timestamp);
+  }
+}
+
+Obstacle* ObstaclesContainer::GetOrCreateObstacle(
+    const PerceptionObstacle& perception_obstacle) {
   const int id = perception_obstacle.id();
   if (id < -1) {
     AERROR << "Invalid ID [" << id << "]";
-    return;
+    return nullptr;
   }
   if (!IsPredictable(perception_obstacle)) {
     ADEBUG << "Perception obstacle [" << id << "] is not predictable.";
-    return;
+    return nullptr;
   }
   Obstacle* obstacle_ptr = obstacles_.GetSilently(id);
-  if (obstacle_ptr != nullptr) {
-    obstacle_ptr->Insert(perception_obstacle, timestamp);
-  } else {
-    Obstacle obstacle;
-    obstacle.Insert(perception_obstacle, timestamp);
-    obstacles_.Put(id, std::move(obstacle));
+  if (obstacle_ptr == nullptr) {
+    if (obstacles_.Full()) {
+      // reuse the least recently used obstacle, which the new one evicts,
+      // with the memory of its history.
+      Obstacle obstacle(std::move(obstacles_.Last()->val));
+      obstacle.Clear();
+      obstacles_.Put(id, std::move(obstacle));
+    } else {
+      obstacles_.Put(id, Obstacle());
+    }
+    obstacle_ptr = obstacles_.GetSilently(id);
   }
+  return obstacle_ptr;
 }
 
 bool ObstaclesContainer::IsPredictable(
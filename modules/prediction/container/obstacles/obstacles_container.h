@@ -25,6 +25,7 @@
 #include <mutex>
 
 #include "modules/common/util/lru_cache.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/prediction/container/container.h"
 #include "modules/prediction/container/obstacles/obstacle.h"
 #include "modules/prediction/container/pose/pose_container.h"
@@ -71,6 +72,13 @@ class ObstaclesContainer : public Container {
    */
   void Clear();
 
+  /**
+   * @brief Set the thread pool updating the obstacles of a perception
+   *        message in parallel, one obstacle per task
+   * @param Thread pool, or nullptr to update them one by one
+   */
+  void SetThreadPool(common::util::ThreadPool* thread_pool);
+
  private:
   /**
    * @brief Check if an obstacle is predictable
@@ -79,10 +87,20 @@ class ObstaclesContainer : public Container {
    */
   bool IsPredictable(const perception::PerceptionObstacle& perception_obstacle);
 
+  /**
+   * @brief Get an obstacle, or create it if it is new
+   * @param Perception obstacle
+   * @return Obstacle pointer, nullptr if the obstacle is not to be predicted
+   */
+  Obstacle* GetOrCreateObstacle(
+      const perception::PerceptionObstacle& perception_obstacle);
+
  private:
   double timestamp_ = -1.0;
   common::util::LRUCache<int, Obstacle> obstacles_;
-  static std::mutex g_mutex_;
+  // guards obstacles_ against the localization and perception callbacks
+  std::mutex mutex_;
+  common::util::ThreadPool* thread_pool_ = nullptr;
 };
 
 }  // namespace prediction
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the insertion of dense traffic frames into the obstacles
+ * container, and counts the heap allocations per frame.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/proto/perception_obstacle.pb.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/util/string_util.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
+
+namespace {
+
+std::atomic<uint64_t> num_allocations(0);
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++num_allocations;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+using apollo::perception::PerceptionObstacle;
+using apollo::perception::PerceptionObstacles;
+
+constexpr int kNumObstacles = 60;
+constexpr double kPeriod = 0.1;
+
+// A frame of kNumObstacles vehicles in rows along the road of the test map.
+// With `churn`, each obstacle is replaced by one with a new ID every 50
+// frames, so the IDs go beyond the capacity of the container.
+void MakeFrame(const int frame, const bool churn,
+               PerceptionObstacles* perception_obstacles) {
+  perception_obstacles->Clear();
+  const double timestamp = 1501183430.0 + frame * kPeriod;
+  perception_obstacles->mutable_header()->set_timestamp_sec(timestamp);
+  for (int i = 0; i < kNumObstacles; ++i) {
+    const int generation = churn ? (frame + i) / 50 : 0;
+    const int age = churn ? (frame + i) % 50 : frame;
+    PerceptionObstacle* obstacle =
+        perception_obstacles->add_perception_obstacle();
+    obstacle->set_id(i + generation * kNumObstacles);
+    obstacle->set_type(PerceptionObstacle::VEHICLE);
+    const double speed_x = 18.794 * (i % 3) / 2.0;
+    const double speed_y = -6.839 * (i % 3) / 2.0;
+    const double x = -449.952 - 9.5 * (i / 3) + 0.5 * (i % 3);
+    const double y = -161.917 + 2.7 * (i / 3) + 1.5 * (i % 3);
+    obstacle->mutable_position()->set_x(x + speed_x * age * kPeriod);
+    obstacle->mutable_position()->set_y(y + speed_y * age * kPeriod);
+    obstacle->mutable_position()->set_z(0.0);
+    obstacle->mutable_velocity()->set_x(speed_x);
+    obstacle->mutable_velocity()->set_y(speed_y);
+    obstacle->mutable_velocity()->set_z(0.0);
+    obstacle->set_theta(-0.349);
+    obstacle->set_length(4.0);
+    obstacle->set_width(2.0);
+    obstacle->set_height(1.0);
+    obstacle->set_tracking_time(age * kPeriod);
+    obstacle->set_timestamp(timestamp);
+  }
+}
+
+}  // namespace
+
+// Arg: whether the obstacle IDs change.
+void BM_InsertFrames(benchmark::State& state) {
+  FLAGS_map_dir = "modules/prediction/testdata";
+  FLAGS_base_map_filename = "kml_map.bin";
+  const bool churn = state.range(0) != 0;
+
+  ObstaclesContainer container;
+  PerceptionObstacles perception_obstacles;
+  // fills the histories first, to count the allocations of the steady state.
+  constexpr int kNumWarmUpFrames = 100;
+  int frame = 0;
+  for (; frame < kNumWarmUpFrames; ++frame) {
+    MakeFrame(frame, churn, &perception_obstacles);
+    container.Insert(perception_obstacles);
+  }
+
+  uint64_t allocations = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    MakeFrame(frame++, churn, &perception_obstacles);
+    state.ResumeTiming();
+    const uint64_t start_allocations = num_allocations;
+    container.Insert(perception_obstacles);
+    allocations += num_allocations - start_allocations;
+  }
+  state.SetItemsProcessed(state.iterations() * kNumObstacles);
+  state.SetLabel(common::util::StrCat(
+      "allocations/frame ",
+      static_cast<double>(allocations) / state.iterations()));
+}
+BENCHMARK(BM_InsertFrames)->Arg(0)->Arg(1);
+
+}  // namespace prediction
+}  // namespace apollo
+
+BENCHMARK_MAIN();
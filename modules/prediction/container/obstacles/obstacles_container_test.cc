@@ -23,6 +23,7 @@
 #include "modules/perception/proto/perception_obstacle.pb.h"
 
 #include "modules/common/util/file.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/map/hdmap/hdmap.h"
 #include "modules/prediction/common/kml_map_based_test.h"
 #include "modules/prediction/common/prediction_gflags.h"
@@ -36,12 +37,12 @@ class ObstaclesContainerTest : public KMLMapBasedTest {
   virtual void SetUp() {
     std::string file =
         "modules/prediction/testdata/perception_vehicles_pedestrians.pb.txt";
-    perception::PerceptionObstacles perception_obstacles;
-    common::util::GetProtoFromFile(file, &perception_obstacles);
-    container_.Insert(perception_obstacles);
+    common::util::GetProtoFromFile(file, &perception_obstacles_);
+    container_.Insert(perception_obstacles_);
   }
 
  protected:
+  perception::PerceptionObstacles perception_obstacles_;
   ObstaclesContainer container_;
 };
 
@@ -91,5 +92,44 @@ TEST_F(ObstaclesContainerTest, ClearAll) {
   EXPECT_TRUE(container_.GetObstacle(102) == nullptr);
 }
 
+TEST_F(ObstaclesContainerTest, ParallelInsert) {
+  common::util::ThreadPool thread_pool(2);
+  ObstaclesContainer container;
+  container.SetThreadPool(&thread_pool);
+  container.Insert(perception_obstacles_);
+  for (const int id : {0, 1, 2, 3, 101, 102}) {
+    Obstacle* obstacle_ptr = container.GetObstacle(id);
+    ASSERT_TRUE(obstacle_ptr != nullptr);
+    EXPECT_EQ(obstacle_ptr->history_size(), 1u);
+    EXPECT_EQ(obstacle_ptr->latest_feature().SerializeAsString(),
+              container_.GetObstacle(id)->latest_feature().SerializeAsString());
+  }
+  EXPECT_TRUE(container.GetObstacle(4) == nullptr);
+}
+
+TEST_F(ObstaclesContainerTest, ReuseEvictedObstacles) {
+  const int max_num_obstacles = FLAGS_max_num_obstacles;
+  FLAGS_max_num_obstacles = 2;
+  ObstaclesContainer container;
+  FLAGS_max_num_obstacles = max_num_obstacles;
+  // the obstacles of the message evict each other, and the last ones are
+  // reused from the evicted ones.
+  container.Insert(perception_obstacles_);
+  int num_obstacles = 0;
+  for (const int id : {0, 1, 2, 3, 101, 102}) {
+    Obstacle* obstacle_ptr = container.GetObstacle(id);
+    if (obstacle_ptr == nullptr) {
+      continue;
+    }
+    ++num_obstacles;
+    EXPECT_EQ(obstacle_ptr->id(), id);
+    EXPECT_EQ(obstacle_ptr->type(), container_.GetObstacle(id)->type());
+    EXPECT_EQ(obstacle_ptr->history_size(), 1u);
+    EXPECT_EQ(obstacle_ptr->latest_feature().SerializeAsString(),
+              container_.GetObstacle(id)->latest_feature().SerializeAsString());
+  }
+  EXPECT_EQ(num_obstacles, 2);
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "google/protobuf/message.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/prediction/container/obstacles/obstacle.h"
 /**
  * @namespace apollo::prediction
@@ -51,6 +52,18 @@ class Evaluator {
    * @param Obstacle pointer
    */
   virtual void Evaluate(Obstacle* obstacle) = 0;
+
+  /**
+   * @brief Evaluate the obstacles of a frame, one by one unless overridden
+   * @param Obstacle pointers
+   *        Thread pool an overriding evaluator may use, or nullptr
+   */
+  virtual void BatchEvaluate(const std::vector<Obstacle*>& obstacles,
+                             common::util::ThreadPool* thread_pool) {
+    for (Obstacle* obstacle : obstacles) {
+      Evaluate(obstacle);
+    }
+  }
 };
 
 }  // namespace prediction
@@ -16,6 +16,10 @@
 
 #include "modules/prediction/evaluator/evaluator_manager.h"
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "modules/common/log.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
@@ -72,6 +76,10 @@ void EvaluatorManager::Run(
           AdapterConfig::PERCEPTION_OBSTACLES));
   CHECK_NOTNULL(container);
 
+  // the obstacles of each evaluator, to evaluate them in one batch; a
+  // repeated obstacle is evaluated once
+  std::unordered_map<Evaluator*, std::vector<Obstacle*>> evaluator_obstacles;
+  std::unordered_set<Obstacle*> obstacles;
   Evaluator* evaluator = nullptr;
   for (const auto& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
@@ -98,10 +106,17 @@ void EvaluatorManager::Run(
         break;
       }
     }
-    if (evaluator != nullptr) {
-      evaluator->Evaluate(obstacle);
+    if (evaluator != nullptr && obstacles.insert(obstacle).second) {
+      evaluator_obstacles[evaluator].push_back(obstacle);
     }
   }
+  for (const auto& batch : evaluator_obstacles) {
+    batch.first->BatchEvaluate(batch.second, thread_pool_);
+  }
+}
+
+void EvaluatorManager::SetThreadPool(common::util::ThreadPool* thread_pool) {
+  thread_pool_ = thread_pool;
 }
 
 std::unique_ptr<Evaluator> EvaluatorManager::CreateEvaluator(
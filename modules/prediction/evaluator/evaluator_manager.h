@@ -29,6 +29,7 @@
 #include "modules/prediction/proto/prediction_conf.pb.h"
 
 #include "modules/common/macro.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/prediction/evaluator/evaluator.h"
 
 /**
@@ -63,6 +64,12 @@ class EvaluatorManager {
    */
   void Run(const perception::PerceptionObstacles& perception_obstacles);
 
+  /**
+   * @brief Set the thread pool the evaluators may use
+   * @param Thread pool, or nullptr to evaluate in the calling thread
+   */
+  void SetThreadPool(common::util::ThreadPool* thread_pool);
+
  private:
   /**
    * @brief Register an evaluator by type
@@ -89,6 +96,8 @@ class EvaluatorManager {
   ObstacleConf::EvaluatorType vehicle_on_lane_evaluator_ =
       ObstacleConf::MLP_EVALUATOR;
 
+  common::util::ThreadPool* thread_pool_ = nullptr;
+
   DECLARE_SINGLETON(EvaluatorManager)
 };
 
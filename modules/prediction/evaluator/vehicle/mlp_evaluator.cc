@@ -51,8 +51,55 @@ MLPEvaluator::MLPEvaluator() { LoadModel(FLAGS_vehicle_model_file); }
 void MLPEvaluator::Clear() { obstacle_feature_values_map_.clear(); }
 
 void MLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
+  BatchEvaluate({obstacle_ptr}, nullptr);
+}
+
+void MLPEvaluator::BatchEvaluate(const std::vector<Obstacle*>& obstacles,
+                                 common::util::ThreadPool* thread_pool) {
   Clear();
+  CHECK_NOTNULL(mlp_model_.get());
+  const int dim_input = mlp_model_->dim_input();
+
+  // the lane sequences of each obstacle and their feature values, one row each
+  std::vector<std::vector<LaneSequence*>> obstacle_lane_sequences(
+      obstacles.size());
+  std::vector<std::vector<double>> obstacle_features(obstacles.size());
+  common::util::ParallelFor(thread_pool, 0, obstacles.size(), [&](size_t i) {
+    ExtractObstacleFeatureValues(obstacles[i], &obstacle_lane_sequences[i],
+                                 &obstacle_features[i]);
+  });
+
+  std::vector<LaneSequence*> lane_sequences;
+  std::vector<double> features;
+  for (std::size_t i = 0; i < obstacles.size(); ++i) {
+    lane_sequences.insert(lane_sequences.end(),
+                          obstacle_lane_sequences[i].begin(),
+                          obstacle_lane_sequences[i].end());
+    features.insert(features.end(), obstacle_features[i].begin(),
+                    obstacle_features[i].end());
+  }
+  if (lane_sequences.empty()) {
+    return;
+  }
+
+  MLPModel::RowMajorMatrixXd outputs;
+  mlp_model_->Run(Eigen::Map<const MLPModel::RowMajorMatrixXd>(
+                      features.data(), lane_sequences.size(), dim_input),
+                  &outputs);
+  if (outputs.cols() != 1) {
+    AERROR << "Model output layer has incorrect # outputs: " << outputs.cols();
+  }
+  for (std::size_t i = 0; i < lane_sequences.size(); ++i) {
+    const double probability = outputs.cols() == 1 ? outputs(i, 0) : 0.0;
+    lane_sequences[i]->set_probability(probability);
+  }
+}
+
+void MLPEvaluator::ExtractObstacleFeatureValues(
+    Obstacle* obstacle_ptr, std::vector<LaneSequence*>* lane_sequences,
+    std::vector<double>* feature_values) {
   CHECK_NOTNULL(obstacle_ptr);
+  const int dim_input = mlp_model_->dim_input();
 
   int id = obstacle_ptr->id();
   if (!obstacle_ptr->latest_feature().IsInitialized()) {
@@ -76,13 +123,26 @@ void MLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
     return;
   }
 
+  std::vector<double> obstacle_feature_values;
+  SetObstacleFeatureValues(obstacle_ptr, &obstacle_feature_values);
   for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
     LaneSequence* lane_sequence_ptr = lane_graph_ptr->mutable_lane_sequence(i);
     CHECK(lane_sequence_ptr != nullptr);
-    std::vector<double> feature_values;
-    ExtractFeatureValues(obstacle_ptr, lane_sequence_ptr, &feature_values);
-    double probability = ComputeProbability(feature_values);
-    lane_sequence_ptr->set_probability(probability);
+    std::vector<double> lane_sequence_feature_values;
+    ExtractFeatureValues(obstacle_ptr, obstacle_feature_values,
+                         lane_sequence_ptr, &lane_sequence_feature_values);
+    if (static_cast<int>(lane_sequence_feature_values.size()) != dim_input) {
+      ADEBUG << "Model feature size not consistent with model proto "
+             << "definition. model input dim = " << dim_input
+             << "; feature value size = "
+             << lane_sequence_feature_values.size();
+      lane_sequence_ptr->set_probability(0.0);
+      continue;
+    }
+    lane_sequences->push_back(lane_sequence_ptr);
+    feature_values->insert(feature_values->end(),
+                           lane_sequence_feature_values.begin(),
+                           lane_sequence_feature_values.end());
   }
 }
 
@@ -99,7 +159,14 @@ void MLPEvaluator::ExtractFeatureValues(Obstacle* obstacle_ptr,
   } else {
     obstacle_feature_values = it->second;
   }
+  ExtractFeatureValues(obstacle_ptr, obstacle_feature_values,
+                       lane_sequence_ptr, feature_values);
+}
 
+void MLPEvaluator::ExtractFeatureValues(
+    Obstacle* obstacle_ptr, const std::vector<double>& obstacle_feature_values,
+    LaneSequence* lane_sequence_ptr, std::vector<double>* feature_values) {
+  int id = obstacle_ptr->id();
   if (obstacle_feature_values.size() != OBSTACLE_FEATURE_SIZE) {
     ADEBUG << "Obstacle [" << id << "] has fewer than "
            << "expected obstacle feature_values "
@@ -313,74 +380,13 @@ void MLPEvaluator::SetLaneFeatureValues(Obstacle* obstacle_ptr,
 }
 
 void MLPEvaluator::LoadModel(const std::string& model_file) {
-  model_ptr_.reset(new FnnVehicleModel());
-  CHECK(model_ptr_ != nullptr);
-  CHECK(common::util::GetProtoFromFile(model_file, model_ptr_.get()))
+  FnnVehicleModel model;
+  CHECK(common::util::GetProtoFromFile(model_file, &model))
       << "Unable to load model file: " << model_file << ".";
+  mlp_model_.reset(new MLPModel(model));
 
   AINFO << "Succeeded in loading the model file: " << model_file << ".";
 }
 
-double MLPEvaluator::ComputeProbability(
-    const std::vector<double>& feature_values) {
-  CHECK_NOTNULL(model_ptr_.get());
-  double probability = 0.0;
-
-  if (model_ptr_->dim_input() != static_cast<int>(feature_values.size())) {
-    ADEBUG << "Model feature size not consistent with model proto definition. "
-           << "model input dim = " << model_ptr_->dim_input()
-           << "; feature value size = " << feature_values.size();
-    return probability;
-  }
-  std::vector<double> layer_input;
-  layer_input.reserve(model_ptr_->dim_input());
-  std::vector<double> layer_output;
-
-  // normalization
-  for (int i = 0; i < model_ptr_->dim_input(); ++i) {
-    double mean = model_ptr_->samples_mean().columns(i);
-    double std = model_ptr_->samples_std().columns(i);
-    layer_input.push_back(
-        apollo::prediction::math_util::Normalize(feature_values[i], mean, std));
-  }
-
-  for (int i = 0; i < model_ptr_->num_layer(); ++i) {
-    if (i > 0) {
-      layer_input.swap(layer_output);
-      layer_output.clear();
-    }
-    const Layer& layer = model_ptr_->layer(i);
-    for (int col = 0; col < layer.layer_output_dim(); ++col) {
-      double neuron_output = layer.layer_bias().columns(col);
-      for (int row = 0; row < layer.layer_input_dim(); ++row) {
-        double weight = layer.layer_input_weight().rows(row).columns(col);
-        neuron_output += (layer_input[row] * weight);
-      }
-      if (layer.layer_activation_func() == Layer::RELU) {
-        neuron_output = apollo::prediction::math_util::Relu(neuron_output);
-      } else if (layer.layer_activation_func() == Layer::SIGMOID) {
-        neuron_output = apollo::prediction::math_util::Sigmoid(neuron_output);
-      } else if (layer.layer_activation_func() == Layer::TANH) {
-        neuron_output = std::tanh(neuron_output);
-      } else {
-        AERROR << "Undefined activation function ["
-               << layer.layer_activation_func()
-               << "]. A default sigmoid will be used instead.";
-        neuron_output = apollo::prediction::math_util::Sigmoid(neuron_output);
-      }
-      layer_output.push_back(neuron_output);
-    }
-  }
-
-  if (layer_output.size() != 1) {
-    AERROR << "Model output layer has incorrect # outputs: "
-           << layer_output.size();
-  } else {
-    probability = layer_output[0];
-  }
-
-  return probability;
-}
-
 }  // namespace prediction
 }  // namespace apollo
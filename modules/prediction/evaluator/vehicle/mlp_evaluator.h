@@ -22,11 +22,11 @@
 #include <unordered_map>
 #include <vector>
 
-#include "modules/prediction/proto/fnn_vehicle_model.pb.h"
 #include "modules/prediction/proto/lane_graph.pb.h"
 
 #include "modules/prediction/container/obstacles/obstacle.h"
 #include "modules/prediction/evaluator/evaluator.h"
+#include "modules/prediction/evaluator/vehicle/mlp_model.h"
 
 namespace apollo {
 namespace prediction {
@@ -49,6 +49,16 @@ class MLPEvaluator : public Evaluator {
    */
   void Evaluate(Obstacle* obstacle_ptr) override;
 
+  /**
+   * @brief Override BatchEvaluate, extracts the feature values of the
+   *        obstacles in parallel and runs the model once on all their lane
+   *        sequences
+   * @param Obstacle pointers
+   *        Thread pool, or nullptr
+   */
+  void BatchEvaluate(const std::vector<Obstacle*>& obstacles,
+                     common::util::ThreadPool* thread_pool) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -64,6 +74,29 @@ class MLPEvaluator : public Evaluator {
   void Clear();
 
  private:
+  /**
+   * @brief Extract the feature vectors of all the lane sequences of an
+   *        obstacle, without the obstacle feature map
+   * @param Obstacle pointer
+   *        Lane sequences receiving a feature vector
+   *        Feature vectors of the lane sequences, one after another
+   */
+  void ExtractObstacleFeatureValues(Obstacle* obstacle_ptr,
+                                    std::vector<LaneSequence*>* lane_sequences,
+                                    std::vector<double>* feature_values);
+
+  /**
+   * @brief Concatenate the obstacle and lane feature vectors
+   * @param Obstacle pointer
+   *        Obstacle feature vector
+   *        Lane Sequence pointer
+   *        Feature container in a vector for receiving the feature values
+   */
+  void ExtractFeatureValues(Obstacle* obstacle_ptr,
+                            const std::vector<double>& obstacle_feature_values,
+                            LaneSequence* lane_sequence_ptr,
+                            std::vector<double>* feature_values);
+
   /**
    * @brief Set obstacle feature vector
    * @param Obstacle pointer
@@ -88,17 +121,12 @@ class MLPEvaluator : public Evaluator {
    */
   void LoadModel(const std::string& model_file);
 
-  /**
-   * @brief Compute probability
-   */
-  double ComputeProbability(const std::vector<double>& feature_values);
-
  private:
   std::unordered_map<int, std::vector<double>> obstacle_feature_values_map_;
   static const size_t OBSTACLE_FEATURE_SIZE = 22;
   static const size_t LANE_FEATURE_SIZE = 40;
 
-  std::unique_ptr<FnnVehicleModel> model_ptr_;
+  std::unique_ptr<MLPModel> mlp_model_;
 };
 
 }  // namespace prediction
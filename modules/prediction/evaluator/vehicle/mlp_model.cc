@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/evaluator/vehicle/mlp_model.h"
+
+#include <cmath>
+#include <utility>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+MLPModel::MLPModel(const FnnVehicleModel& model) {
+  const int dim_input = model.dim_input();
+  CHECK_GT(dim_input, 0);
+  CHECK_EQ(model.samples_mean().columns_size(), dim_input);
+  CHECK_EQ(model.samples_std().columns_size(), dim_input);
+  samples_mean_.resize(dim_input);
+  samples_std_.resize(dim_input);
+  // the epsilon of math_util::Normalize
+  constexpr double eps = 1e-10;
+  for (int i = 0; i < dim_input; ++i) {
+    samples_mean_(i) = model.samples_mean().columns(i);
+    samples_std_(i) = model.samples_std().columns(i) + eps;
+  }
+
+  CHECK_GT(model.layer_size(), 0);
+  CHECK_EQ(model.num_layer(), model.layer_size());
+  int layer_input_dim = dim_input;
+  for (const Layer& layer : model.layer()) {
+    CHECK_EQ(layer.layer_input_dim(), layer_input_dim);
+    const int layer_output_dim = layer.layer_output_dim();
+    CHECK_EQ(layer.layer_input_weight().rows_size(), layer_input_dim);
+    CHECK_EQ(layer.layer_bias().columns_size(), layer_output_dim);
+
+    CompiledLayer compiled_layer;
+    compiled_layer.weights.resize(layer_input_dim, layer_output_dim);
+    for (int row = 0; row < layer_input_dim; ++row) {
+      const Vector& weights = layer.layer_input_weight().rows(row);
+      CHECK_EQ(weights.columns_size(), layer_output_dim);
+      for (int col = 0; col < layer_output_dim; ++col) {
+        compiled_layer.weights(row, col) = weights.columns(col);
+      }
+    }
+    compiled_layer.bias.resize(layer_output_dim);
+    for (int col = 0; col < layer_output_dim; ++col) {
+      compiled_layer.bias(col) = layer.layer_bias().columns(col);
+    }
+    compiled_layer.activation_func = layer.layer_activation_func();
+    if (compiled_layer.activation_func != Layer::RELU &&
+        compiled_layer.activation_func != Layer::SIGMOID &&
+        compiled_layer.activation_func != Layer::TANH) {
+      AERROR << "Undefined activation function ["
+             << layer.layer_activation_func()
+             << "]. A default sigmoid will be used instead.";
+      compiled_layer.activation_func = Layer::SIGMOID;
+    }
+    layers_.push_back(std::move(compiled_layer));
+    layer_input_dim = layer_output_dim;
+  }
+}
+
+int MLPModel::dim_input() const { return samples_mean_.size(); }
+
+int MLPModel::dim_output() const { return layers_.back().bias.size(); }
+
+void MLPModel::Run(const Eigen::Ref<const RowMajorMatrixXd>& features,
+                   RowMajorMatrixXd* outputs) const {
+  CHECK_NOTNULL(outputs);
+  CHECK_EQ(features.cols(), dim_input());
+
+  // normalization
+  RowMajorMatrixXd layer_input =
+      (features.rowwise() - samples_mean_).array().rowwise() /
+      samples_std_.array();
+
+  for (const CompiledLayer& layer : layers_) {
+    RowMajorMatrixXd layer_output = layer_input * layer.weights;
+    layer_output.rowwise() += layer.bias;
+    switch (layer.activation_func) {
+      case Layer::RELU:
+        layer_output = layer_output.array().max(0.0);
+        break;
+      case Layer::TANH:
+        layer_output = layer_output.unaryExpr(
+            [](const double value) { return std::tanh(value); });
+        break;
+      default:
+        layer_output = (1.0 + (-layer_output.array()).exp()).inverse();
+        break;
+    }
+    layer_input.swap(layer_output);
+  }
+  outputs->swap(layer_input);
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A feed forward network compiled from its model proto.
+ */
+
+#ifndef MODULES_PREDICTION_EVALUATOR_VEHICLE_MLP_MODEL_H_
+#define MODULES_PREDICTION_EVALUATOR_VEHICLE_MLP_MODEL_H_
+
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "modules/prediction/proto/fnn_vehicle_model.pb.h"
+
+/**
+ * @namespace apollo::prediction
+ * @brief apollo::prediction
+ */
+namespace apollo {
+namespace prediction {
+
+class MLPModel {
+ public:
+  using RowMajorMatrixXd =
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /**
+   * @brief Constructor, copies the normalization and the layers of the model
+   *        into contiguous matrices
+   * @param Model proto, its dimensions must be consistent
+   */
+  explicit MLPModel(const FnnVehicleModel& model);
+
+  /**
+   * @brief Get the number of inputs
+   * @return The number of inputs
+   */
+  int dim_input() const;
+
+  /**
+   * @brief Get the number of outputs
+   * @return The number of outputs
+   */
+  int dim_output() const;
+
+  /**
+   * @brief Run the network on a batch of samples
+   * @param Samples, one per row, of dim_input() raw feature values
+   *        Outputs, one row of dim_output() values per sample
+   */
+  void Run(const Eigen::Ref<const RowMajorMatrixXd>& features,
+           RowMajorMatrixXd* outputs) const;
+
+ private:
+  struct CompiledLayer {
+    // layer_input_dim x layer_output_dim
+    RowMajorMatrixXd weights;
+    Eigen::RowVectorXd bias;
+    Layer::ActivationFunc activation_func;
+  };
+
+  Eigen::RowVectorXd samples_mean_;
+  // samples_std plus the epsilon of math_util::Normalize
+  Eigen::RowVectorXd samples_std_;
+  std::vector<CompiledLayer> layers_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_EVALUATOR_VEHICLE_MLP_MODEL_H_
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks the vehicle model on the lane sequences of a frame, by
+ * walking the model proto, with the compiled model per lane sequence, and
+ * with the compiled model on all of them at once.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/evaluator/vehicle/mlp_model.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+// 50 obstacles with 6 lane sequences each.
+constexpr int kNumLaneSequences = 50 * 6;
+
+const FnnVehicleModel& Model() {
+  static FnnVehicleModel* model = [] {
+    FnnVehicleModel* model = new FnnVehicleModel();
+    CHECK(common::util::GetProtoFromFile(FLAGS_vehicle_model_file, model));
+    return model;
+  }();
+  return *model;
+}
+
+MLPModel::RowMajorMatrixXd Features(const FnnVehicleModel& model) {
+  std::mt19937 random_engine(2017);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  MLPModel::RowMajorMatrixXd features(kNumLaneSequences, model.dim_input());
+  for (int i = 0; i < features.rows(); ++i) {
+    for (int j = 0; j < features.cols(); ++j) {
+      features(i, j) = model.samples_mean().columns(j) +
+                       normal(random_engine) * model.samples_std().columns(j);
+    }
+  }
+  return features;
+}
+
+// The layer by layer walk of the model proto, as the MLP evaluator used to do.
+double ProtoModelOutput(const FnnVehicleModel& model, const double* features) {
+  std::vector<double> layer_input;
+  for (int i = 0; i < model.dim_input(); ++i) {
+    layer_input.push_back((features[i] - model.samples_mean().columns(i)) /
+                          (model.samples_std().columns(i) + 1e-10));
+  }
+  std::vector<double> layer_output;
+  for (const Layer& layer : model.layer()) {
+    layer_output.clear();
+    for (int col = 0; col < layer.layer_output_dim(); ++col) {
+      double neuron_output = layer.layer_bias().columns(col);
+      for (int row = 0; row < layer.layer_input_dim(); ++row) {
+        const double weight = layer.layer_input_weight().rows(row).columns(col);
+        neuron_output += layer_input[row] * weight;
+      }
+      if (layer.layer_activation_func() == Layer::RELU) {
+        neuron_output = std::max(neuron_output, 0.0);
+      } else if (layer.layer_activation_func() == Layer::TANH) {
+        neuron_output = std::tanh(neuron_output);
+      } else {
+        neuron_output = 1.0 / (1.0 + std::exp(-neuron_output));
+      }
+      layer_output.push_back(neuron_output);
+    }
+    layer_input.swap(layer_output);
+  }
+  return layer_input[0];
+}
+
+void BM_ProtoModel(benchmark::State& state) {
+  const FnnVehicleModel& model = Model();
+  const MLPModel::RowMajorMatrixXd features = Features(model);
+  while (state.KeepRunning()) {
+    double sum = 0.0;
+    for (int i = 0; i < features.rows(); ++i) {
+      sum += ProtoModelOutput(model, features.row(i).data());
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLaneSequences);
+}
+BENCHMARK(BM_ProtoModel);
+
+void BM_MLPModelPerLaneSequence(benchmark::State& state) {
+  const MLPModel mlp_model(Model());
+  const MLPModel::RowMajorMatrixXd features = Features(Model());
+  MLPModel::RowMajorMatrixXd outputs;
+  while (state.KeepRunning()) {
+    double sum = 0.0;
+    for (int i = 0; i < features.rows(); ++i) {
+      mlp_model.Run(features.row(i), &outputs);
+      sum += outputs(0, 0);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLaneSequences);
+}
+BENCHMARK(BM_MLPModelPerLaneSequence);
+
+void BM_MLPModelBatch(benchmark::State& state) {
+  const MLPModel mlp_model(Model());
+  const MLPModel::RowMajorMatrixXd features = Features(Model());
+  MLPModel::RowMajorMatrixXd outputs;
+  while (state.KeepRunning()) {
+    mlp_model.Run(features, &outputs);
+    benchmark::DoNotOptimize(outputs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLaneSequences);
+}
+BENCHMARK(BM_MLPModelBatch);
+
+}  // namespace
+
+}  // namespace prediction
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/evaluator/vehicle/mlp_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/file.h"
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+// The layer by layer walk of the model proto, as the MLP evaluator used to do.
+double ProtoModelOutput(const FnnVehicleModel& model,
+                        const std::vector<double>& feature_values) {
+  std::vector<double> layer_input;
+  for (int i = 0; i < model.dim_input(); ++i) {
+    layer_input.push_back(
+        (feature_values[i] - model.samples_mean().columns(i)) /
+        (model.samples_std().columns(i) + 1e-10));
+  }
+  std::vector<double> layer_output;
+  for (const Layer& layer : model.layer()) {
+    layer_output.clear();
+    for (int col = 0; col < layer.layer_output_dim(); ++col) {
+      double neuron_output = layer.layer_bias().columns(col);
+      for (int row = 0; row < layer.layer_input_dim(); ++row) {
+        const double weight = layer.layer_input_weight().rows(row).columns(col);
+        neuron_output += layer_input[row] * weight;
+      }
+      if (layer.layer_activation_func() == Layer::RELU) {
+        neuron_output = std::max(neuron_output, 0.0);
+      } else if (layer.layer_activation_func() == Layer::TANH) {
+        neuron_output = std::tanh(neuron_output);
+      } else {
+        neuron_output = 1.0 / (1.0 + std::exp(-neuron_output));
+      }
+      layer_output.push_back(neuron_output);
+    }
+    layer_input.swap(layer_output);
+  }
+  return layer_input[0];
+}
+
+void AddLayer(const int dim_input, const int dim_output,
+              const Layer::ActivationFunc activation_func,
+              std::mt19937* random_engine, FnnVehicleModel* model) {
+  std::uniform_real_distribution<double> weight(-1.0, 1.0);
+  Layer* layer = model->add_layer();
+  layer->set_layer_input_dim(dim_input);
+  layer->set_layer_output_dim(dim_output);
+  for (int row = 0; row < dim_input; ++row) {
+    Vector* weights = layer->mutable_layer_input_weight()->add_rows();
+    for (int col = 0; col < dim_output; ++col) {
+      weights->add_columns(weight(*random_engine));
+    }
+  }
+  for (int col = 0; col < dim_output; ++col) {
+    layer->mutable_layer_bias()->add_columns(weight(*random_engine));
+  }
+  layer->set_layer_activation_func(activation_func);
+  model->set_num_layer(model->layer_size());
+}
+
+// Random samples around the normalization of the model.
+MLPModel::RowMajorMatrixXd Samples(const FnnVehicleModel& model,
+                                   const int num_samples,
+                                   std::mt19937* random_engine) {
+  std::normal_distribution<double> normal(0.0, 1.5);
+  MLPModel::RowMajorMatrixXd samples(num_samples, model.dim_input());
+  for (int i = 0; i < num_samples; ++i) {
+    for (int j = 0; j < model.dim_input(); ++j) {
+      samples(i, j) = model.samples_mean().columns(j) +
+                      normal(*random_engine) * model.samples_std().columns(j);
+    }
+  }
+  return samples;
+}
+
+void ExpectSameOutputs(const FnnVehicleModel& model, const int num_samples) {
+  std::mt19937 random_engine(2017);
+  const MLPModel::RowMajorMatrixXd samples =
+      Samples(model, num_samples, &random_engine);
+  const MLPModel mlp_model(model);
+  EXPECT_EQ(model.dim_input(), mlp_model.dim_input());
+  EXPECT_EQ(1, mlp_model.dim_output());
+
+  MLPModel::RowMajorMatrixXd outputs;
+  mlp_model.Run(samples, &outputs);
+  ASSERT_EQ(num_samples, outputs.rows());
+  ASSERT_EQ(1, outputs.cols());
+  for (int i = 0; i < num_samples; ++i) {
+    const std::vector<double> feature_values(
+        samples.row(i).data(), samples.row(i).data() + samples.cols());
+    EXPECT_NEAR(ProtoModelOutput(model, feature_values), outputs(i, 0), 1e-10);
+
+    // a batch of one sample gives the same output.
+    MLPModel::RowMajorMatrixXd output;
+    mlp_model.Run(samples.row(i), &output);
+    EXPECT_NEAR(outputs(i, 0), output(0, 0), 1e-10);
+  }
+}
+
+}  // namespace
+
+TEST(MLPModelTest, VehicleModel) {
+  FnnVehicleModel model;
+  ASSERT_TRUE(
+      common::util::GetProtoFromFile(FLAGS_vehicle_model_file, &model));
+  ExpectSameOutputs(model, 300);
+}
+
+TEST(MLPModelTest, ActivationFunctions) {
+  std::mt19937 random_engine(2017);
+  FnnVehicleModel model;
+  const int dim_input = 8;
+  model.set_dim_input(dim_input);
+  for (int i = 0; i < dim_input; ++i) {
+    model.mutable_samples_mean()->add_columns(0.5 * i);
+    model.mutable_samples_std()->add_columns(1.0 + 0.1 * i);
+  }
+  AddLayer(dim_input, 6, Layer::RELU, &random_engine, &model);
+  AddLayer(6, 4, Layer::TANH, &random_engine, &model);
+  AddLayer(4, 3, Layer::RELU, &random_engine, &model);
+  AddLayer(3, 1, Layer::SIGMOID, &random_engine, &model);
+  model.set_dim_output(1);
+  ExpectSameOutputs(model, 50);
+}
+
+}  // namespace prediction
+}  // namespace apollo
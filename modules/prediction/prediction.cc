@@ -16,10 +16,13 @@
 
 #include "modules/prediction/prediction.h"
 
+#include <algorithm>
+
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
 
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/util/file.h"
+#include "modules/prediction/common/lane_graph_cache.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
@@ -69,6 +72,11 @@ Status Prediction::Init() {
   ContainerManager::instance()->Init(adapter_conf_);
   EvaluatorManager::instance()->Init(prediction_conf_);
   PredictorManager::instance()->Init(prediction_conf_);
+  if (FLAGS_enable_parallel_prediction) {
+    thread_pool_.reset(new common::util::ThreadPool(
+        std::max(0, FLAGS_prediction_threads)));
+    SetThreadPool(thread_pool_.get());
+  }
 
   CHECK(AdapterManager::GetLocalization()) << "Localization is not ready.";
   CHECK(AdapterManager::GetPerceptionObstacles()) << "Perception is not ready.";
@@ -86,7 +94,21 @@ Status Prediction::Start() {
   return Status::OK();
 }
 
-void Prediction::Stop() {}
+void Prediction::Stop() {
+  SetThreadPool(nullptr);
+  thread_pool_.reset(nullptr);
+}
+
+void Prediction::SetThreadPool(common::util::ThreadPool* thread_pool) {
+  ObstaclesContainer* obstacles_container = dynamic_cast<ObstaclesContainer*>(
+      ContainerManager::instance()->GetContainer(
+          AdapterConfig::PERCEPTION_OBSTACLES));
+  if (obstacles_container != nullptr) {
+    obstacles_container->SetThreadPool(thread_pool);
+  }
+  EvaluatorManager::instance()->SetThreadPool(thread_pool);
+  PredictorManager::instance()->SetThreadPool(thread_pool);
+}
 
 void Prediction::OnLocalization(const LocalizationEstimate& localization) {
   ObstaclesContainer* obstacles_container = dynamic_cast<ObstaclesContainer*>(
@@ -126,6 +148,8 @@ void Prediction::OnPerception(const PerceptionObstacles& perception_obstacles) {
   AdapterManager::PublishPrediction(prediction_obstacles);
   ADEBUG << "Published a prediction message ["
          << prediction_obstacles.ShortDebugString() << "].";
+  ADEBUG << "Lane graph cache hit rate: "
+         << LaneGraphCache::instance()->HitRate();
 }
 
 Status Prediction::OnError(const std::string& error_msg) {
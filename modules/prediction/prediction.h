@@ -21,6 +21,7 @@
 #ifndef MODULES_PREDICTION_PREDICTION_H_
 #define MODULES_PREDICTION_PREDICTION_H_
 
+#include <memory>
 #include <string>
 
 #include "ros/include/ros/ros.h"
@@ -31,6 +32,7 @@
 #include "modules/prediction/proto/prediction_conf.pb.h"
 
 #include "modules/common/apollo_app.h"
+#include "modules/common/util/thread_pool.h"
 
 /**
  * @namespace apollo::prediction
@@ -81,9 +83,12 @@ class Prediction : public apollo::common::ApolloApp {
 
   void OnLocalization(const localization::LocalizationEstimate &localization);
 
+  void SetThreadPool(common::util::ThreadPool *thread_pool);
+
  private:
   PredictionConf prediction_conf_;
   common::adapter::AdapterManagerConfig adapter_conf_;
+  std::unique_ptr<common::util::ThreadPool> thread_pool_;
 };
 
 }  // namespace prediction
@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Benchmarks a perception frame through the obstacle container, the
+ * evaluators and the predictors, with and without a thread pool, on a dense
+ * traffic sequence built from the test perception obstacles.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/adapters/proto/adapter_config.pb.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/prediction/proto/prediction_conf.pb.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+#include "modules/common/util/thread_pool.h"
+#include "modules/prediction/container/container_manager.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
+#include "modules/prediction/evaluator/evaluator_manager.h"
+#include "modules/prediction/predictor/predictor_manager.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+using apollo::common::adapter::AdapterConfig;
+using apollo::perception::PerceptionObstacle;
+using apollo::perception::PerceptionObstacles;
+
+// Copies of each test obstacle, spread along its heading, and the distance
+// between two copies.
+constexpr int kNumCopies = 15;
+constexpr double kCopyGap = 8.0;
+constexpr double kFrameTime = 0.1;
+
+ObstaclesContainer* Init() {
+  FLAGS_map_dir = "modules/prediction/testdata";
+  FLAGS_base_map_filename = "kml_map.bin";
+  common::adapter::AdapterManagerConfig adapter_conf;
+  CHECK(common::util::GetProtoFromFile(
+      "modules/prediction/testdata/adapter_conf.pb.txt", &adapter_conf));
+  PredictionConf conf;
+  CHECK(common::util::GetProtoFromFile(
+      "modules/prediction/testdata/prediction_conf.pb.txt", &conf));
+  ContainerManager::instance()->Init(adapter_conf);
+  EvaluatorManager::instance()->Init(conf);
+  PredictorManager::instance()->Init(conf);
+  ObstaclesContainer* container = dynamic_cast<ObstaclesContainer*>(
+      ContainerManager::instance()->GetContainer(
+          AdapterConfig::PERCEPTION_OBSTACLES));
+  CHECK_NOTNULL(container);
+  return container;
+}
+
+// The test vehicles and pedestrians, each copied along its heading.
+PerceptionObstacles DenseTraffic() {
+  PerceptionObstacles perception_obstacles;
+  CHECK(common::util::GetProtoFromFile(
+      "modules/prediction/testdata/perception_vehicles_pedestrians.pb.txt",
+      &perception_obstacles));
+  PerceptionObstacles dense_traffic;
+  dense_traffic.mutable_header()->CopyFrom(perception_obstacles.header());
+  for (const PerceptionObstacle& obstacle :
+       perception_obstacles.perception_obstacle()) {
+    for (int i = 0; i < kNumCopies; ++i) {
+      PerceptionObstacle* copy = dense_traffic.add_perception_obstacle();
+      copy->CopyFrom(obstacle);
+      copy->set_id(obstacle.id() * kNumCopies + i);
+      const double shift = (i - kNumCopies / 2) * kCopyGap;
+      copy->mutable_position()->set_x(obstacle.position().x() +
+                                      shift * std::cos(obstacle.theta()));
+      copy->mutable_position()->set_y(obstacle.position().y() +
+                                      shift * std::sin(obstacle.theta()));
+    }
+  }
+  return dense_traffic;
+}
+
+// The obstacles moved by their velocity for `num_frames` frames.
+PerceptionObstacles Frame(const PerceptionObstacles& first_frame,
+                          const int num_frames) {
+  const double time = num_frames * kFrameTime;
+  PerceptionObstacles frame = first_frame;
+  frame.mutable_header()->set_timestamp_sec(
+      first_frame.header().timestamp_sec() + time);
+  for (PerceptionObstacle& obstacle : *frame.mutable_perception_obstacle()) {
+    obstacle.mutable_position()->set_x(obstacle.position().x() +
+                                       obstacle.velocity().x() * time);
+    obstacle.mutable_position()->set_y(obstacle.position().y() +
+                                       obstacle.velocity().y() * time);
+    obstacle.set_timestamp(frame.header().timestamp_sec());
+  }
+  return frame;
+}
+
+void Run(benchmark::State& state, common::util::ThreadPool* thread_pool) {
+  ObstaclesContainer* container = Init();
+  container->Clear();
+  container->SetThreadPool(thread_pool);
+  EvaluatorManager::instance()->SetThreadPool(thread_pool);
+  PredictorManager::instance()->SetThreadPool(thread_pool);
+
+  const PerceptionObstacles first_frame = DenseTraffic();
+  // The frames repeat after a longer time than FLAGS_max_history_time, and
+  // are all processed once before the timing, so that the map is loaded and
+  // the histories of the obstacles are full.
+  constexpr int kNumFrames = 100;
+  std::vector<PerceptionObstacles> frames;
+  for (int i = 0; i < kNumFrames; ++i) {
+    frames.push_back(Frame(first_frame, i));
+  }
+  auto process = [container](const PerceptionObstacles& frame) {
+    container->Insert(frame);
+    EvaluatorManager::instance()->Run(frame);
+    PredictorManager::instance()->Run(frame);
+  };
+  for (const PerceptionObstacles& frame : frames) {
+    process(frame);
+  }
+
+  double timestamp_offset = 0.0;
+  int frame_index = 0;
+  std::vector<double> latencies_ms;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    if (frame_index == 0) {
+      timestamp_offset += kNumFrames * kFrameTime;
+    }
+    PerceptionObstacles frame = frames[frame_index];
+    frame.mutable_header()->set_timestamp_sec(frame.header().timestamp_sec() +
+                                              timestamp_offset);
+    frame_index = (frame_index + 1) % kNumFrames;
+    state.ResumeTiming();
+
+    const auto start = std::chrono::steady_clock::now();
+    process(frame);
+    latencies_ms.push_back(std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count());
+  }
+
+  container->SetThreadPool(nullptr);
+  EvaluatorManager::instance()->SetThreadPool(nullptr);
+  PredictorManager::instance()->SetThreadPool(nullptr);
+  if (latencies_ms.empty()) {
+    return;
+  }
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  auto percentile = [&latencies_ms](const double p) {
+    return latencies_ms[static_cast<size_t>(p * (latencies_ms.size() - 1))];
+  };
+  state.SetLabel(common::util::StrCat(
+      first_frame.perception_obstacle_size(), " obstacles, p50 ",
+      percentile(0.5), " ms, p95 ", percentile(0.95), " ms, p99 ",
+      percentile(0.99), " ms"));
+  state.SetItemsProcessed(state.iterations() *
+                          first_frame.perception_obstacle_size());
+}
+
+}  // namespace
+
+void BM_PredictionFrame(benchmark::State& state) {
+  Run(state, nullptr);
+}
+BENCHMARK(BM_PredictionFrame);
+
+// Arg: number of worker threads.
+void BM_PredictionFrameParallel(benchmark::State& state) {
+  common::util::ThreadPool thread_pool(state.range(0));
+  Run(state, &thread_pool);
+}
+BENCHMARK(BM_PredictionFrameParallel)->Arg(1)->Arg(3);
+
+}  // namespace prediction
+}  // namespace apollo
+
+BENCHMARK_MAIN();
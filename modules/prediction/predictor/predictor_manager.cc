@@ -90,57 +90,72 @@ void PredictorManager::Run(const PerceptionObstacles& perception_obstacles) {
           AdapterConfig::PERCEPTION_OBSTACLES));
   CHECK_NOTNULL(container);
 
-  Predictor* predictor = nullptr;
-  for (const auto& perception_obstacle :
-       perception_obstacles.perception_obstacle()) {
-    PredictionObstacle prediction_obstacle;
-    prediction_obstacle.set_timestamp(perception_obstacle.timestamp());
+  const int num_obstacles = perception_obstacles.perception_obstacle_size();
+  for (int i = 0; i < num_obstacles; ++i) {
+    prediction_obstacles_.add_prediction_obstacle();
+  }
+  // The registered predictors keep the trajectories of their last obstacle,
+  // so a parallel prediction uses predictors of its own.
+  common::util::ParallelFor(thread_pool_, 0, num_obstacles, [&](size_t i) {
+    const PerceptionObstacle& perception_obstacle =
+        perception_obstacles.perception_obstacle(i);
+    PredictionObstacle* prediction_obstacle =
+        prediction_obstacles_.mutable_prediction_obstacle(i);
+    prediction_obstacle->set_timestamp(perception_obstacle.timestamp());
     int id = perception_obstacle.id();
     Obstacle* obstacle = container->GetObstacle(id);
     if (obstacle != nullptr) {
+      ObstacleConf::PredictorType predictor_type;
       switch (perception_obstacle.type()) {
         case PerceptionObstacle::VEHICLE: {
           if (obstacle->IsOnLane()) {
-            predictor = GetPredictor(vehicle_on_lane_predictor_);
+            predictor_type = vehicle_on_lane_predictor_;
           } else {
-            predictor = GetPredictor(vehicle_off_lane_predictor_);
+            predictor_type = vehicle_off_lane_predictor_;
           }
           break;
         }
         case PerceptionObstacle::PEDESTRIAN: {
-          predictor = GetPredictor(pedestrian_predictor_);
+          predictor_type = pedestrian_predictor_;
           break;
         }
         default: {
           if (obstacle->IsOnLane()) {
-            predictor = GetPredictor(vehicle_on_lane_predictor_);
+            predictor_type = vehicle_on_lane_predictor_;
           } else {
-            predictor = GetPredictor(vehicle_off_lane_predictor_);
+            predictor_type = vehicle_off_lane_predictor_;
           }
           break;
         }
       }
 
+      std::unique_ptr<Predictor> parallel_predictor;
+      Predictor* predictor = GetPredictor(predictor_type);
+      if (predictor != nullptr && thread_pool_ != nullptr) {
+        parallel_predictor = CreatePredictor(predictor_type);
+        predictor = parallel_predictor.get();
+      }
       if (predictor != nullptr) {
         predictor->Predict(obstacle);
         for (const auto& trajectory : predictor->trajectories()) {
-          prediction_obstacle.add_trajectory()->CopyFrom(trajectory);
+          prediction_obstacle->add_trajectory()->CopyFrom(trajectory);
         }
       }
-      prediction_obstacle.set_timestamp(obstacle->timestamp());
+      prediction_obstacle->set_timestamp(obstacle->timestamp());
     }
 
-    prediction_obstacle.set_predicted_period(FLAGS_prediction_duration);
-    prediction_obstacle.mutable_perception_obstacle()->CopyFrom(
+    prediction_obstacle->set_predicted_period(FLAGS_prediction_duration);
+    prediction_obstacle->mutable_perception_obstacle()->CopyFrom(
         perception_obstacle);
-
-    prediction_obstacles_.add_prediction_obstacle()->CopyFrom(
-        prediction_obstacle);
-  }
+  });
   prediction_obstacles_.set_perception_error_code(
       perception_obstacles.error_code());
 }
 
+void PredictorManager::SetThreadPool(common::util::ThreadPool* thread_pool) {
+  thread_pool_ = thread_pool;
+}
+
 std::unique_ptr<Predictor> PredictorManager::CreatePredictor(
     const ObstacleConf::PredictorType& type) {
   std::unique_ptr<Predictor> predictor_ptr(nullptr);
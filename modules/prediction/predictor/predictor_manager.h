@@ -30,6 +30,7 @@
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
 
 #include "modules/common/macro.h"
+#include "modules/common/util/thread_pool.h"
 #include "modules/prediction/predictor/predictor.h"
 
 /**
@@ -64,6 +65,12 @@ class PredictorManager {
    */
   void Run(const perception::PerceptionObstacles& perception_obstacles);
 
+  /**
+   * @brief Set the thread pool predicting the obstacles in parallel
+   * @param Thread pool, or nullptr to predict them in the calling thread
+   */
+  void SetThreadPool(common::util::ThreadPool* thread_pool);
+
   /**
    * @brief Get prediction obstacles
    * @return Prediction obstacles
@@ -107,6 +114,8 @@ class PredictorManager {
 
   PredictionObstacles prediction_obstacles_;
 
+  common::util::ThreadPool* thread_pool_ = nullptr;
+
   DECLARE_SINGLETON(PredictorManager)
 };
 
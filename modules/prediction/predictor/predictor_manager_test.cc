@@ -22,11 +22,17 @@
 
 #include "gtest/gtest.h"
 #include "modules/common/util/file.h"
+#include "modules/common/util/thread_pool.h"
+#include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/container/container_manager.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
 
 namespace apollo {
 namespace prediction {
 
-class PredictorManagerTest : public ::testing::Test {
+using apollo::common::adapter::AdapterConfig;
+
+class PredictorManagerTest : public KMLMapBasedTest {
  public:
   void SetUp() override { manager_ = PredictorManager::instance(); }
 
@@ -46,5 +52,43 @@ TEST_F(PredictorManagerTest, GetPredictor) {
   EXPECT_TRUE(manager_->GetPredictor(type) != nullptr);
 }
 
+TEST_F(PredictorManagerTest, ParallelRun) {
+  std::string conf_file = "modules/prediction/testdata/prediction_conf.pb.txt";
+  CHECK(apollo::common::util::GetProtoFromFile(conf_file, &conf_))
+      << "Failed to load " << conf_file;
+  manager_->Init(conf_);
+
+  std::string adapter_conf_file =
+      "modules/prediction/testdata/adapter_conf.pb.txt";
+  common::adapter::AdapterManagerConfig adapter_conf;
+  CHECK(apollo::common::util::GetProtoFromFile(adapter_conf_file,
+                                               &adapter_conf))
+      << "Failed to load " << adapter_conf_file;
+  ContainerManager::instance()->Init(adapter_conf);
+  ObstaclesContainer* container = dynamic_cast<ObstaclesContainer*>(
+      ContainerManager::instance()->GetContainer(
+          AdapterConfig::PERCEPTION_OBSTACLES));
+  ASSERT_TRUE(container != nullptr);
+
+  std::string file =
+      "modules/prediction/testdata/perception_vehicles_pedestrians.pb.txt";
+  perception::PerceptionObstacles perception_obstacles;
+  CHECK(apollo::common::util::GetProtoFromFile(file, &perception_obstacles));
+  container->Insert(perception_obstacles);
+
+  manager_->Run(perception_obstacles);
+  const PredictionObstacles prediction_obstacles =
+      manager_->prediction_obstacles();
+  EXPECT_EQ(prediction_obstacles.prediction_obstacle_size(),
+            perception_obstacles.perception_obstacle_size());
+
+  common::util::ThreadPool thread_pool(2);
+  manager_->SetThreadPool(&thread_pool);
+  manager_->Run(perception_obstacles);
+  manager_->SetThreadPool(nullptr);
+  EXPECT_EQ(manager_->prediction_obstacles().SerializeAsString(),
+            prediction_obstacles.SerializeAsString());
+}
+
 }  // namespace prediction
 }  // namespace apollo